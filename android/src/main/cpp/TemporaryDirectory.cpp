@@ -0,0 +1,36 @@
+#include "mapped_file.hpp"
+#include <fbjni/fbjni.h>
+#include <stdexcept>
+
+namespace margelo::nitro::metamask_nativeutils {
+
+namespace {
+
+struct JNativeUtilsPaths : public facebook::jni::JavaClass<JNativeUtilsPaths> {
+  static constexpr auto kJavaDescriptor = "Lcom/margelo/nitro/metamask/nativeutils/NativeUtilsPaths;";
+};
+
+} // namespace
+
+std::string temporaryDirectory() {
+  std::string path;
+  // Worker threads attached from native code only see the system class
+  // loader, which cannot find app classes
+  facebook::jni::ThreadScope::WithClassLoader([&path]() {
+    static const auto cls = JNativeUtilsPaths::javaClassStatic();
+    static const auto cacheDirectory = cls->getStaticMethod<jstring()>("cacheDirectory");
+    auto result = cacheDirectory(cls);
+    if (result) {
+      path = result->toStdString();
+    }
+  });
+  if (path.empty()) {
+    throw std::runtime_error("The app cache directory is not available yet");
+  }
+  while (path.size() > 1 && path.back() == '/') {
+    path.pop_back();
+  }
+  return path;
+}
+
+} // namespace margelo::nitro::metamask_nativeutils
@@ -0,0 +1,19 @@
+package com.margelo.nitro.metamask.nativeutils
+
+import androidx.annotation.Keep
+import com.facebook.proguard.annotations.DoNotStrip
+import com.margelo.nitro.NitroModules
+
+/**
+ * App directories for native code, which cannot resolve them on its own:
+ * they differ per user, work profile and package.
+ */
+@DoNotStrip
+@Keep
+object NativeUtilsPaths {
+  /** The app's cache directory, or null before Nitro has a context. */
+  @JvmStatic
+  @DoNotStrip
+  @Keep
+  fun cacheDirectory(): String? = NitroModules.applicationContext?.cacheDir?.absolutePath
+}
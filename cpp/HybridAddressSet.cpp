@@ -0,0 +1,255 @@
+#include "HybridAddressSet.hpp"
+#include "simd_utils.hpp"
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+namespace margelo::nitro::metamask_nativeutils {
+
+// Control byte values; a full slot holds the low 7 bits of its key's hash
+static constexpr uint8_t kEmpty = 0x80;
+static constexpr uint8_t kDeleted = 0xfe;
+
+static constexpr size_t kMaxCapacity = size_t(1) << 28;
+// Lookups are issued this many addresses ahead of the probes in contains()
+static constexpr size_t kPrefetchDistance = 8;
+
+static uint64_t load64(const uint8_t* p) {
+  uint64_t value;
+  std::memcpy(&value, p, sizeof(value));
+  return value;
+}
+
+static uint32_t load32(const uint8_t* p) {
+  uint32_t value;
+  std::memcpy(&value, p, sizeof(value));
+  return value;
+}
+
+// Fold the 128-bit product of a and b into 64 bits
+static uint64_t foldedMultiply(uint64_t a, uint64_t b) {
+#if defined(__SIZEOF_INT128__)
+  unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+  return static_cast<uint64_t>(product) ^ static_cast<uint64_t>(product >> 64);
+#else
+  // 32-bit targets: schoolbook multiply on 32-bit halves
+  uint64_t aLo = a & 0xffffffff, aHi = a >> 32, bLo = b & 0xffffffff, bHi = b >> 32;
+  uint64_t lolo = aLo * bLo, lohi = aLo * bHi, hilo = aHi * bLo, hihi = aHi * bHi;
+  uint64_t cross = (lolo >> 32) + (lohi & 0xffffffff) + hilo;
+  uint64_t low = (cross << 32) | (lolo & 0xffffffff);
+  uint64_t high = hihi + (lohi >> 32) + (cross >> 32);
+  return low ^ high;
+#endif
+}
+
+static size_t capacityFor(size_t count) {
+  // Keep the load factor at or below 7/8
+  size_t needed = std::max<size_t>(HybridAddressSet::kGroupSize, count + count / 7 + 1);
+  size_t capacity = HybridAddressSet::kGroupSize;
+  while (capacity < needed) {
+    capacity *= 2;
+  }
+  return capacity;
+}
+
+static size_t addressCount(const std::shared_ptr<ArrayBuffer>& addresses) {
+  if (addresses->size() % HybridAddressSet::kAddressSize != 0) {
+    throw std::runtime_error("Packed addresses must be a multiple of 20 bytes, got " +
+                             std::to_string(addresses->size()));
+  }
+  return addresses->size() / HybridAddressSet::kAddressSize;
+}
+
+HybridAddressSet::HybridAddressSet(size_t capacityHint) : HybridObject(TAG) {
+  // Addresses can be chosen by anyone (vanity and CREATE2 addresses), so the
+  // hash is keyed per set to keep probe chains from being forced long
+  std::random_device random;
+  seed_ = (static_cast<uint64_t>(random()) << 32) ^ random();
+  allocateSlots(capacityFor(capacityHint));
+}
+
+uint64_t HybridAddressSet::hash(const uint8_t* address) const {
+  uint64_t a = load64(address) ^ seed_;
+  uint64_t b = load64(address + 8) ^ 0x9e3779b97f4a7c15ULL;
+  uint64_t c = load32(address + 16) ^ (seed_ >> 32);
+  return foldedMultiply(foldedMultiply(a, b) ^ c, 0xd6e8feb86659fd93ULL ^ seed_);
+}
+
+void HybridAddressSet::allocateSlots(size_t capacity) {
+  if (capacity > kMaxCapacity) {
+    throw std::runtime_error("Address set cannot hold more than " + std::to_string(kMaxCapacity / 8 * 7) + " addresses");
+  }
+  control_.reset(new uint8_t[capacity]);
+  std::memset(control_.get(), kEmpty, capacity);
+  keys_.reset(new uint8_t[capacity * kAddressSize]);
+  capacity_ = capacity;
+  size_ = 0;
+  deleted_ = 0;
+  growthLeft_ = capacity - capacity / 8;
+}
+
+size_t HybridAddressSet::find(const uint8_t* address, uint64_t h) const {
+  size_t groupMask = capacity_ / kGroupSize - 1;
+  size_t group = (h >> 7) & groupMask;
+  uint8_t tag = static_cast<uint8_t>(h & 0x7f);
+
+  for (size_t step = 1;; step++) {
+    const uint8_t* control = control_.get() + group * kGroupSize;
+    for (uint32_t match = simd::matchByte16(control, tag); match != 0; match &= match - 1) {
+      size_t slot = group * kGroupSize + simd::lowestBit(match);
+      if (simd::equal20(keyAt(slot), address)) {
+        return slot;
+      }
+    }
+    // An empty slot ends the probe: the key would have been placed there
+    if (simd::matchByte16(control, kEmpty) != 0) {
+      return npos;
+    }
+    // Triangular steps visit every group of a power-of-two table
+    group = (group + step) & groupMask;
+  }
+}
+
+bool HybridAddressSet::insertOne(const uint8_t* address) {
+  uint64_t h = hash(address);
+  if (find(address, h) != npos) {
+    return false;
+  }
+
+  if (growthLeft_ == 0) {
+    // Grow when live keys fill more than half the table; otherwise the
+    // table is mostly tombstones and rehashing in place reclaims them
+    rehash(size_ + 1 > capacity_ / 16 * 7 ? capacity_ * 2 : capacity_);
+  }
+
+  size_t groupMask = capacity_ / kGroupSize - 1;
+  size_t group = (h >> 7) & groupMask;
+  for (size_t step = 1;; step++) {
+    uint8_t* control = control_.get() + group * kGroupSize;
+    uint32_t available = simd::highBits16(control);
+    if (available != 0) {
+      size_t index = simd::lowestBit(available);
+      if (control[index] == kEmpty) {
+        growthLeft_--;
+      } else {
+        deleted_--;
+      }
+      control[index] = static_cast<uint8_t>(h & 0x7f);
+      std::memcpy(keyAt(group * kGroupSize + index), address, kAddressSize);
+      size_++;
+      return true;
+    }
+    group = (group + step) & groupMask;
+  }
+}
+
+bool HybridAddressSet::removeOne(const uint8_t* address) {
+  size_t slot = find(address, hash(address));
+  if (slot == npos) {
+    return false;
+  }
+
+  uint8_t* control = control_.get() + (slot & ~(kGroupSize - 1));
+  // Probes stop at a group with an empty slot, so no key was placed past this
+  // group if it already has one and the slot can become empty again.
+  // Otherwise leave a tombstone to keep longer probe chains intact.
+  if (simd::matchByte16(control, kEmpty) != 0) {
+    control_[slot] = kEmpty;
+    growthLeft_++;
+  } else {
+    control_[slot] = kDeleted;
+    deleted_++;
+  }
+  size_--;
+  return true;
+}
+
+void HybridAddressSet::rehash(size_t capacity) {
+  std::unique_ptr<uint8_t[]> oldControl = std::move(control_);
+  std::unique_ptr<uint8_t[]> oldKeys = std::move(keys_);
+  size_t oldCapacity = capacity_;
+
+  allocateSlots(capacity);
+  for (size_t slot = 0; slot < oldCapacity; slot++) {
+    if (oldControl[slot] < kEmpty) {
+      insertOne(oldKeys.get() + slot * kAddressSize);
+    }
+  }
+}
+
+double HybridAddressSet::getSize() {
+  return static_cast<double>(size_);
+}
+
+double HybridAddressSet::insert(const std::shared_ptr<ArrayBuffer>& addresses) {
+  size_t count = addressCount(addresses);
+  const uint8_t* input = static_cast<const uint8_t*>(addresses->data());
+
+  // Grow once up front rather than repeatedly during a large batch
+  if (size_ + count > capacity_ - capacity_ / 8) {
+    rehash(std::max(capacity_, capacityFor(size_ + count)));
+  }
+
+  size_t inserted = 0;
+  for (size_t i = 0; i < count; i++) {
+    inserted += insertOne(input + i * kAddressSize);
+  }
+  return static_cast<double>(inserted);
+}
+
+double HybridAddressSet::remove(const std::shared_ptr<ArrayBuffer>& addresses) {
+  size_t count = addressCount(addresses);
+  const uint8_t* input = static_cast<const uint8_t*>(addresses->data());
+
+  size_t removed = 0;
+  for (size_t i = 0; i < count; i++) {
+    removed += removeOne(input + i * kAddressSize);
+  }
+  return static_cast<double>(removed);
+}
+
+std::shared_ptr<ArrayBuffer> HybridAddressSet::contains(const std::shared_ptr<ArrayBuffer>& addresses) {
+  size_t count = addressCount(addresses);
+  const uint8_t* input = static_cast<const uint8_t*>(addresses->data());
+
+  auto result = ArrayBuffer::allocate((count + 7) / 8);
+  uint8_t* bitmap = static_cast<uint8_t*>(result->data());
+  std::memset(bitmap, 0, result->size());
+
+  // Large sets do not fit in cache, so the control group of each address is
+  // requested a few lookups before it is probed
+  size_t groupMask = capacity_ / kGroupSize - 1;
+  uint64_t hashes[kPrefetchDistance];
+  for (size_t i = 0; i < std::min(count, kPrefetchDistance); i++) {
+    hashes[i] = hash(input + i * kAddressSize);
+    __builtin_prefetch(control_.get() + ((hashes[i] >> 7) & groupMask) * kGroupSize);
+  }
+
+  for (size_t i = 0; i < count; i++) {
+    uint64_t h = hashes[i % kPrefetchDistance];
+    size_t ahead = i + kPrefetchDistance;
+    if (ahead < count) {
+      uint64_t next = hash(input + ahead * kAddressSize);
+      hashes[ahead % kPrefetchDistance] = next;
+      __builtin_prefetch(control_.get() + ((next >> 7) & groupMask) * kGroupSize);
+    }
+
+    if (find(input + i * kAddressSize, h) != npos) {
+      bitmap[i / 8] |= static_cast<uint8_t>(1u << (i % 8));
+    }
+  }
+
+  return result;
+}
+
+void HybridAddressSet::clear() {
+  allocateSlots(capacityFor(0));
+}
+
+size_t HybridAddressSet::getExternalMemorySize() noexcept {
+  return capacity_ * (1 + kAddressSize);
+}
+
+} // namespace margelo::nitro::metamask_nativeutils
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "HybridAddressSetSpec.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace margelo::nitro::metamask_nativeutils {
+
+/**
+ * Open-addressing hash set of raw 20-byte addresses.
+ *
+ * Slots are grouped by 16. Each group has 16 control bytes (a 7-bit hash tag
+ * for a full slot, or an empty/deleted marker) that fit one cache line, so a
+ * lookup compares a whole group of tags with one vector compare and only
+ * touches the 20-byte keys whose tags match. Groups are probed triangularly
+ * until one with an empty slot is found.
+ *
+ * Like every HybridObject it is used from the JS thread only, so there is no
+ * locking.
+ */
+class HybridAddressSet : public HybridAddressSetSpec {
+public:
+  explicit HybridAddressSet(size_t capacityHint);
+
+public:
+  double getSize() override;
+  double insert(const std::shared_ptr<ArrayBuffer>& addresses) override;
+  double remove(const std::shared_ptr<ArrayBuffer>& addresses) override;
+  std::shared_ptr<ArrayBuffer> contains(const std::shared_ptr<ArrayBuffer>& addresses) override;
+  void clear() override;
+
+  size_t getExternalMemorySize() noexcept override;
+
+public:
+  static constexpr size_t kAddressSize = 20;
+  static constexpr size_t kGroupSize = 16;
+
+private:
+  // Result of a lookup: the slot holding the key, or npos
+  static constexpr size_t npos = static_cast<size_t>(-1);
+
+  uint64_t hash(const uint8_t* address) const;
+  size_t find(const uint8_t* address, uint64_t h) const;
+  bool insertOne(const uint8_t* address);
+  bool removeOne(const uint8_t* address);
+  void allocateSlots(size_t capacity);
+  void rehash(size_t capacity);
+
+  uint8_t* keyAt(size_t slot) const { return keys_.get() + slot * kAddressSize; }
+
+  std::unique_ptr<uint8_t[]> control_;
+  std::unique_ptr<uint8_t[]> keys_;
+  size_t capacity_ = 0; // slots, a power of two and a multiple of kGroupSize
+  size_t size_ = 0;
+  size_t deleted_ = 0;
+  size_t growthLeft_ = 0; // inserts into empty slots before a rehash is needed
+  uint64_t seed_ = 0;
+};
+
+} // namespace margelo::nitro::metamask_nativeutils
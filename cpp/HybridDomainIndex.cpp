@@ -0,0 +1,169 @@
+#include "HybridDomainIndex.hpp"
+#include "keccak_utils.hpp"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+namespace margelo::nitro::metamask_nativeutils {
+
+static constexpr char kMagic[8] = {'D', 'O', 'M', 'I', 'D', 'X', '0', '1'};
+static constexpr size_t kMaxDomainLength = 253;
+
+static uint32_t readU32(const uint8_t* p) {
+  // All supported targets are little-endian
+  uint32_t value;
+  std::memcpy(&value, p, sizeof(value));
+  return value;
+}
+
+static void appendBytes(std::vector<uint8_t>& out, const void* data, size_t size) {
+  const uint8_t* bytes = static_cast<const uint8_t*>(data);
+  out.insert(out.end(), bytes, bytes + size);
+}
+
+// Lowercase ASCII and drop one trailing dot; returns false for names that
+// cannot be domains. Non-ASCII names are expected in punycode, as in URLs.
+static bool normalizeDomain(const std::string& domain, std::string& out) {
+  out.assign(domain);
+  if (!out.empty() && out.back() == '.') {
+    out.pop_back();
+  }
+  if (out.empty() || out.size() > kMaxDomainLength || out.front() == '.' || out.find("..") != std::string::npos) {
+    return false;
+  }
+  for (char& c : out) {
+    if (c >= 'A' && c <= 'Z') {
+      c = static_cast<char>(c - 'A' + 'a');
+    }
+  }
+  return true;
+}
+
+static uint64_t domainKey(const char* domain, size_t size) {
+  uint8_t hash[32];
+  keccak256(reinterpret_cast<const uint8_t*>(domain), size, hash);
+  uint64_t key = 0;
+  for (int i = 0; i < 8; i++) {
+    key = (key << 8) | hash[i];
+  }
+  return key;
+}
+
+// About 4 keys per bucket, so a lookup reads one or two cache lines of keys
+static uint32_t directoryBitsFor(size_t count) {
+  uint32_t bits = 0;
+  while (bits < HybridDomainIndex::kMaxDirectoryBits && (size_t(4) << bits) < count) {
+    bits++;
+  }
+  return bits;
+}
+
+HybridDomainIndex::HybridDomainIndex(const std::string& path) : HybridObject(TAG), path_(path), mapping_(map(path)) {}
+
+HybridDomainIndex::Mapping HybridDomainIndex::map(const std::string& path) {
+  Mapping mapping;
+  mapping.file = MappedFile::open(path);
+  const uint8_t* base = mapping.file->data();
+  size_t size = mapping.file->size();
+
+  if (size < kHeaderSize || std::memcmp(base, kMagic, sizeof(kMagic)) != 0) {
+    throw std::runtime_error("'" + path + "' is not a domain index");
+  }
+  mapping.count = readU32(base + 8);
+  mapping.directoryBits = readU32(base + 12);
+  // 64-bit arithmetic: counts come from the file and are untrusted
+  uint64_t expected = kHeaderSize + 8ull * mapping.count + 4ull * ((1ull << std::min<uint32_t>(mapping.directoryBits, 32)) + 1);
+  if (mapping.directoryBits > kMaxDirectoryBits || expected != size) {
+    throw std::runtime_error("Domain index '" + path + "' is truncated or corrupt");
+  }
+
+  // The mapping is page-aligned and the keys start at a multiple of 8
+  mapping.keys = reinterpret_cast<const uint64_t*>(base + kHeaderSize);
+  mapping.directory = reinterpret_cast<const uint32_t*>(mapping.keys + mapping.count);
+  return mapping;
+}
+
+bool HybridDomainIndex::contains(uint64_t key) const {
+  size_t bucket = mapping_.directoryBits == 0 ? 0 : static_cast<size_t>(key >> (64 - mapping_.directoryBits));
+  uint32_t begin = mapping_.directory[bucket], end = mapping_.directory[bucket + 1];
+  if (begin > end || end > mapping_.count) {
+    throw std::runtime_error("Domain index is corrupt at bucket " + std::to_string(bucket));
+  }
+  return std::binary_search(mapping_.keys + begin, mapping_.keys + end, key);
+}
+
+double HybridDomainIndex::getSize() {
+  return static_cast<double>(mapping_.count);
+}
+
+std::shared_ptr<ArrayBuffer> HybridDomainIndex::matches(const std::vector<std::string>& hostnames) {
+  auto result = ArrayBuffer::allocate((hostnames.size() + 7) / 8);
+  uint8_t* bitmap = static_cast<uint8_t*>(result->data());
+  std::memset(bitmap, 0, result->size());
+
+  std::string host;
+  for (size_t i = 0; i < hostnames.size(); i++) {
+    if (!normalizeDomain(hostnames[i], host)) {
+      continue;
+    }
+    // The host itself, then each parent domain after a dot
+    for (size_t start = 0; start != std::string::npos;) {
+      if (contains(domainKey(host.data() + start, host.size() - start))) {
+        bitmap[i / 8] |= static_cast<uint8_t>(1u << (i % 8));
+        break;
+      }
+      start = host.find('.', start);
+      start = start == std::string::npos ? start : start + 1;
+    }
+  }
+  return result;
+}
+
+void HybridDomainIndex::reload() {
+  // Map and validate first, so a bad file leaves the current list in place.
+  // build() renames a new file over the old one, so the old mapping stays
+  // consistent until it is released here.
+  mapping_ = map(path_);
+}
+
+size_t HybridDomainIndex::build(const std::vector<std::string>& domains, const std::string& path) {
+  std::vector<uint64_t> keys;
+  keys.reserve(domains.size());
+  std::string normalized;
+  for (const auto& domain : domains) {
+    if (normalizeDomain(domain, normalized)) {
+      keys.push_back(domainKey(normalized.data(), normalized.size()));
+    }
+  }
+  std::sort(keys.begin(), keys.end());
+  keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+  if (keys.size() > std::numeric_limits<uint32_t>::max()) {
+    throw std::runtime_error("Domain index cannot hold more than 2^32 - 1 domains");
+  }
+
+  uint32_t bits = directoryBitsFor(keys.size());
+  std::vector<uint32_t> directory((size_t(1) << bits) + 1);
+  size_t index = 0;
+  for (size_t bucket = 0; bucket < directory.size() - 1; bucket++) {
+    directory[bucket] = static_cast<uint32_t>(index);
+    while (index < keys.size() && (bits == 0 || (keys[index] >> (64 - bits)) == bucket)) {
+      index++;
+    }
+  }
+  directory.back() = static_cast<uint32_t>(keys.size());
+
+  std::vector<uint8_t> file;
+  file.reserve(kHeaderSize + 8 * keys.size() + 4 * directory.size());
+  uint32_t count = static_cast<uint32_t>(keys.size());
+  appendBytes(file, kMagic, sizeof(kMagic));
+  appendBytes(file, &count, sizeof(count));
+  appendBytes(file, &bits, sizeof(bits));
+  appendBytes(file, keys.data(), keys.size() * sizeof(uint64_t));
+  appendBytes(file, directory.data(), directory.size() * sizeof(uint32_t));
+
+  writeFileAtomically(path, file.data(), file.size());
+  return keys.size();
+}
+
+} // namespace margelo::nitro::metamask_nativeutils
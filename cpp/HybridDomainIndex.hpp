@@ -0,0 +1,70 @@
+#pragma once
+
+#include "HybridDomainIndexSpec.hpp"
+#include "mapped_file.hpp"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace margelo::nitro::metamask_nativeutils {
+
+/**
+ * Read-only set of domains backed by a memory-mapped file, for checking
+ * navigations against large phishing and allow lists without parsing them
+ * at startup or keeping them on the JS heap. A hostname matches if it or any
+ * of its parent domains is listed.
+ *
+ * Domains are stored as the first 8 bytes of the Keccak-256 hash of their
+ * normalized form, so a lookup hashes each suffix of the hostname and looks
+ * it up; with 64-bit keys a false match is vanishingly unlikely even for
+ * millions of domains.
+ *
+ * File layout (integers are little-endian):
+ * - header (16 bytes): magic "DOMIDX01", u32 domain count, u32 directory bits
+ * - keys: one u64 per domain, the hash read big-endian, sorted ascending
+ * - directory: 2^bits + 1 u32 key indices; keys whose top `bits` bits are b
+ *   are [directory[b], directory[b + 1]), so a lookup searches one small bucket
+ */
+class HybridDomainIndex : public HybridDomainIndexSpec {
+public:
+  explicit HybridDomainIndex(const std::string& path);
+
+public:
+  double getSize() override;
+  std::shared_ptr<ArrayBuffer> matches(const std::vector<std::string>& hostnames) override;
+  void reload() override;
+
+public:
+  static constexpr size_t kHeaderSize = 16;
+  static constexpr uint32_t kMaxDirectoryBits = 20;
+
+  /**
+   * Build an index file from domains. Domains are lowercased and a trailing
+   * dot is removed; duplicates are stored once and invalid domains (empty,
+   * with empty labels or longer than 253 characters) are skipped.
+   * @param domains Domain names, e.g. "example.com"
+   * @param path Absolute path of the index file, replaced atomically
+   * @return Number of domains indexed
+   * @throws std::runtime_error if the index cannot be written
+   */
+  static size_t build(const std::vector<std::string>& domains, const std::string& path);
+
+private:
+  // One opened file; reload() swaps in a new one only after it validates
+  struct Mapping {
+    std::shared_ptr<MappedFile> file;
+    const uint64_t* keys = nullptr;
+    const uint32_t* directory = nullptr;
+    size_t count = 0;
+    uint32_t directoryBits = 0;
+  };
+
+  static Mapping map(const std::string& path);
+  bool contains(uint64_t key) const;
+
+  std::string path_;
+  Mapping mapping_;
+};
+
+} // namespace margelo::nitro::metamask_nativeutils
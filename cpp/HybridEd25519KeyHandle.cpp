@@ -0,0 +1,45 @@
+#include "HybridEd25519KeyHandle.hpp"
+#include "ed25519.hpp"
+#include "packed_items.hpp"
+#include "parallel_for.hpp"
+#include <vector>
+
+namespace margelo::nitro::metamask_nativeutils {
+
+// Messages per parallel chunk; one signature is two or three SHA-512s and a
+// fixed-base multiplication
+static constexpr size_t kSignGrain = 32;
+
+HybridEd25519KeyHandle::HybridEd25519KeyHandle(const uint8_t* seed)
+    : HybridObject(TAG), expanded_(kEd25519ExpandedKeySize) {
+  ed25519ExpandKey(seed, expanded_.data());
+}
+
+std::shared_ptr<ArrayBuffer> HybridEd25519KeyHandle::publicKey() {
+  return ArrayBuffer::copy(expanded_.data() + kEd25519ExpandedKeySize - 32, 32);
+}
+
+std::shared_ptr<ArrayBuffer> HybridEd25519KeyHandle::sign(const std::shared_ptr<ArrayBuffer>& message) {
+  auto result = ArrayBuffer::allocate(64);
+  ed25519Sign(expanded_.data(), static_cast<const uint8_t*>(message->data()), message->size(),
+              static_cast<uint8_t*>(result->data()));
+  return result;
+}
+
+std::shared_ptr<ArrayBuffer> HybridEd25519KeyHandle::signBatch(const std::shared_ptr<ArrayBuffer>& messages,
+                                                               const std::vector<double>& messageLengths) {
+  std::vector<size_t> offsets = packedOffsets(messageLengths, messages->size(), "message");
+
+  auto result = ArrayBuffer::allocate(messageLengths.size() * 64);
+  const uint8_t* data = static_cast<const uint8_t*>(messages->data());
+  uint8_t* signatures = static_cast<uint8_t*>(result->data());
+  const uint8_t* key = expanded_.data();
+  parallelFor(messageLengths.size(), kSignGrain, [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) {
+      ed25519Sign(key, data + offsets[i], offsets[i + 1] - offsets[i], signatures + i * 64);
+    }
+  });
+  return result;
+}
+
+} // namespace margelo::nitro::metamask_nativeutils
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "HybridEd25519KeyHandleSpec.hpp"
+#include "secure_arena.hpp"
+#include <memory>
+#include <vector>
+
+namespace margelo::nitro::metamask_nativeutils {
+
+/**
+ * Ed25519 key held in secure memory (see ed25519ExpandKey), so the seed is
+ * never copied back into JS. With the table backend, signing also skips the
+ * SHA-512 of the seed. The key is wiped when the handle is released.
+ */
+class HybridEd25519KeyHandle : public HybridEd25519KeyHandleSpec {
+public:
+  /** @param seed 32-byte private key, copied and expanded */
+  explicit HybridEd25519KeyHandle(const uint8_t* seed);
+
+public:
+  std::shared_ptr<ArrayBuffer> publicKey() override;
+  std::shared_ptr<ArrayBuffer> sign(const std::shared_ptr<ArrayBuffer>& message) override;
+  std::shared_ptr<ArrayBuffer> signBatch(const std::shared_ptr<ArrayBuffer>& messages,
+                                         const std::vector<double>& messageLengths) override;
+
+private:
+  SecureBuffer expanded_;
+};
+
+} // namespace margelo::nitro::metamask_nativeutils
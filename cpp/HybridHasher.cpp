@@ -0,0 +1,49 @@
+#include "HybridHasher.hpp"
+#include "botan_conditional.h"
+#include <stdexcept>
+
+namespace margelo::nitro::metamask_nativeutils {
+
+HashKind HybridHasher::hashKind(HashAlgorithm algorithm) {
+  switch (algorithm) {
+    case HashAlgorithm::SHA256: return HashKind::Sha256;
+    case HashAlgorithm::SHA512: return HashKind::Sha512;
+    case HashAlgorithm::SHA3_256: return HashKind::Sha3_256;
+    case HashAlgorithm::KECCAK256: return HashKind::Keccak256;
+    case HashAlgorithm::RIPEMD160: return HashKind::Ripemd160;
+    case HashAlgorithm::BLAKE2B256: return HashKind::Blake2b256;
+    case HashAlgorithm::BLAKE2B512: return HashKind::Blake2b512;
+  }
+  throw std::runtime_error("Unknown hash algorithm");
+}
+
+HybridHasher::HybridHasher(HashAlgorithm algorithm)
+    : HybridObject(TAG), algorithm_(algorithm), kind_(hashKind(algorithm)), hasher_(createHashFunction(kind_)) {}
+
+// Defined here, where Botan::HashFunction is complete
+HybridHasher::~HybridHasher() = default;
+
+HashAlgorithm HybridHasher::getAlgorithm() {
+  return algorithm_;
+}
+
+double HybridHasher::getOutputSize() {
+  return static_cast<double>(hashOutputSize(kind_));
+}
+
+void HybridHasher::update(const std::shared_ptr<ArrayBuffer>& data) {
+  hasher_->update(static_cast<const uint8_t*>(data->data()), data->size());
+}
+
+std::shared_ptr<ArrayBuffer> HybridHasher::digest() {
+  auto result = ArrayBuffer::allocate(hashOutputSize(kind_));
+  // Botan resets the state after final()
+  hasher_->final(static_cast<uint8_t*>(result->data()));
+  return result;
+}
+
+void HybridHasher::reset() {
+  hasher_->clear();
+}
+
+} // namespace margelo::nitro::metamask_nativeutils
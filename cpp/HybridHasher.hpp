@@ -0,0 +1,38 @@
+#pragma once
+
+#include "HybridHasherSpec.hpp"
+#include "hash_utils.hpp"
+#include <memory>
+
+namespace Botan {
+class HashFunction;
+}
+
+namespace margelo::nitro::metamask_nativeutils {
+
+/**
+ * Incremental hash over one Botan hash object. Like every HybridObject it is
+ * used from the JS thread only, so there is no locking.
+ */
+class HybridHasher : public HybridHasherSpec {
+public:
+  explicit HybridHasher(HashAlgorithm algorithm);
+  ~HybridHasher() override;
+
+public:
+  HashAlgorithm getAlgorithm() override;
+  double getOutputSize() override;
+  void update(const std::shared_ptr<ArrayBuffer>& data) override;
+  std::shared_ptr<ArrayBuffer> digest() override;
+  void reset() override;
+
+  /** The registry entry of a JS hash algorithm. */
+  static HashKind hashKind(HashAlgorithm algorithm);
+
+private:
+  HashAlgorithm algorithm_;
+  HashKind kind_;
+  std::unique_ptr<Botan::HashFunction> hasher_;
+};
+
+} // namespace margelo::nitro::metamask_nativeutils
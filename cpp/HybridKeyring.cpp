@@ -0,0 +1,156 @@
+#include "HybridKeyring.hpp"
+#include "hex_utils.hpp"
+#include "keccak_utils.hpp"
+#include "parallel_for.hpp"
+#include "secp256k1_utils.hpp"
+#include "secp256k1/include/secp256k1_recovery.h"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace margelo::nitro::metamask_nativeutils {
+
+// Keys per parallel chunk when adding; one key is a fixed-base
+// multiplication and a keccak256
+static constexpr size_t kDeriveGrain = 16;
+
+HybridKeyring::HybridKeyring() : HybridObject(TAG) {}
+
+double HybridKeyring::getSize() {
+  return static_cast<double>(accounts_.size());
+}
+
+std::shared_ptr<ArrayBuffer> HybridKeyring::addKeys(const std::shared_ptr<ArrayBuffer>& privateKeys) {
+  if (privateKeys->size() % 32 != 0) {
+    throw std::runtime_error("Private keys must be a multiple of 32 bytes");
+  }
+  size_t count = privateKeys->size() / 32;
+  const uint8_t* keys = static_cast<const uint8_t*>(privateKeys->data());
+  const secp256k1_context* ctx = secp256k1Context();
+  // Check every key before deriving any, so a bad key adds nothing
+  for (size_t i = 0; i < count; i++) {
+    if (!secp256k1_ec_seckey_verify(ctx, keys + i * 32)) {
+      throw std::runtime_error("Private key at index " + std::to_string(i) + " is invalid");
+    }
+  }
+
+  std::vector<Account> added(count);
+  parallelFor(count, kDeriveGrain, [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) {
+      Account& account = added[i];
+      account.privateKey = SecureBuffer(keys + i * 32, 32);
+      derivePublicKeyInto(account.privateKey.data(), account.publicKey, false);
+      uint8_t hash[32];
+      keccak256(account.publicKey + 1, 64, hash);
+      std::memcpy(account.address.data(), hash + 12, kAddressSize);
+    }
+  });
+
+  auto result = ArrayBuffer::allocate(count * kAddressSize);
+  uint8_t* addresses = static_cast<uint8_t*>(result->data());
+  accounts_.reserve(accounts_.size() + count);
+  for (size_t i = 0; i < count; i++) {
+    std::memcpy(addresses + i * kAddressSize, added[i].address.data(), kAddressSize);
+    if (index_.emplace(added[i].address, accounts_.size()).second) {
+      accounts_.push_back(std::move(added[i]));
+    }
+  }
+  return result;
+}
+
+double HybridKeyring::removeAccounts(const std::shared_ptr<ArrayBuffer>& addresses) {
+  if (addresses->size() % kAddressSize != 0) {
+    throw std::runtime_error("Packed addresses must be a multiple of 20 bytes, got " +
+                             std::to_string(addresses->size()));
+  }
+  const uint8_t* bytes = static_cast<const uint8_t*>(addresses->data());
+  size_t removed = 0;
+  for (size_t offset = 0; offset < addresses->size(); offset += kAddressSize) {
+    Address address;
+    std::memcpy(address.data(), bytes + offset, kAddressSize);
+    removed += index_.erase(address);
+  }
+  if (removed > 0) {
+    // Compact in place to keep the insertion order; the keys of removed
+    // accounts are wiped as their buffers are destroyed
+    accounts_.erase(std::remove_if(accounts_.begin(), accounts_.end(),
+                                   [&](const Account& account) { return index_.count(account.address) == 0; }),
+                    accounts_.end());
+    reindex();
+  }
+  return static_cast<double>(removed);
+}
+
+std::shared_ptr<ArrayBuffer> HybridKeyring::getAddresses() {
+  auto result = ArrayBuffer::allocate(accounts_.size() * kAddressSize);
+  uint8_t* addresses = static_cast<uint8_t*>(result->data());
+  for (size_t i = 0; i < accounts_.size(); i++) {
+    std::memcpy(addresses + i * kAddressSize, accounts_[i].address.data(), kAddressSize);
+  }
+  return result;
+}
+
+std::shared_ptr<ArrayBuffer> HybridKeyring::publicKeyByAddress(const std::shared_ptr<ArrayBuffer>& address, bool isCompressed) {
+  const Account& account = accountFor(address);
+  if (!isCompressed) {
+    return ArrayBuffer::copy(account.publicKey, 65);
+  }
+  // The compressed form is the x coordinate behind the parity of y
+  auto result = ArrayBuffer::allocate(33);
+  uint8_t* compressed = static_cast<uint8_t*>(result->data());
+  compressed[0] = static_cast<uint8_t>(0x02 | (account.publicKey[64] & 1));
+  std::memcpy(compressed + 1, account.publicKey + 1, 32);
+  return result;
+}
+
+std::shared_ptr<ArrayBuffer> HybridKeyring::signByAddress(const std::shared_ptr<ArrayBuffer>& address,
+                                                          const std::shared_ptr<ArrayBuffer>& hash) {
+  if (hash->size() != 32) {
+    throw std::runtime_error("Hash must be 32 bytes, got " + std::to_string(hash->size()));
+  }
+  const Account& account = accountFor(address);
+  const secp256k1_context* ctx = secp256k1Context();
+  secp256k1_ecdsa_recoverable_signature signature;
+  if (!secp256k1_ecdsa_sign_recoverable(ctx, &signature, static_cast<const uint8_t*>(hash->data()),
+                                        account.privateKey.data(), nullptr, nullptr)) {
+    throw std::runtime_error("Failed to sign hash");
+  }
+  auto result = ArrayBuffer::allocate(65);
+  uint8_t* output = static_cast<uint8_t*>(result->data());
+  int recoveryId = 0;
+  secp256k1_ecdsa_recoverable_signature_serialize_compact(ctx, output, &recoveryId, &signature);
+  output[64] = static_cast<uint8_t>(recoveryId);
+  return result;
+}
+
+void HybridKeyring::clear() {
+  accounts_.clear();
+  index_.clear();
+}
+
+size_t HybridKeyring::getExternalMemorySize() noexcept {
+  return accounts_.capacity() * sizeof(Account) + index_.size() * (sizeof(Address) + 2 * sizeof(size_t));
+}
+
+const HybridKeyring::Account& HybridKeyring::accountFor(const std::shared_ptr<ArrayBuffer>& address) const {
+  if (address->size() != kAddressSize) {
+    throw std::runtime_error("Address must be 20 bytes, got " + std::to_string(address->size()));
+  }
+  Address key;
+  std::memcpy(key.data(), address->data(), kAddressSize);
+  auto it = index_.find(key);
+  if (it == index_.end()) {
+    char hex[kAddressSize * 2];
+    bytesToHex(key.data(), kAddressSize, hex);
+    throw std::runtime_error("No account for address 0x" + std::string(hex, kAddressSize * 2));
+  }
+  return accounts_[it->second];
+}
+
+void HybridKeyring::reindex() {
+  for (size_t i = 0; i < accounts_.size(); i++) {
+    index_[accounts_[i].address] = i;
+  }
+}
+
+} // namespace margelo::nitro::metamask_nativeutils
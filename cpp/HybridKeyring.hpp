@@ -0,0 +1,71 @@
+#pragma once
+
+#include "HybridKeyringSpec.hpp"
+#include "secure_arena.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace margelo::nitro::metamask_nativeutils {
+
+/**
+ * secp256k1 account keys in secure memory, indexed by address.
+ *
+ * Each account keeps its private key in its own SecureBuffer, next to the
+ * uncompressed public key and address derived when it was added, so a lookup
+ * is one hash of the 20-byte address and signing only touches the key in
+ * place. Accounts are kept in insertion order for listing.
+ *
+ * Like every HybridObject it is used from the JS thread only, so there is no
+ * locking.
+ */
+class HybridKeyring : public HybridKeyringSpec {
+public:
+  HybridKeyring();
+
+public:
+  double getSize() override;
+  std::shared_ptr<ArrayBuffer> addKeys(const std::shared_ptr<ArrayBuffer>& privateKeys) override;
+  double removeAccounts(const std::shared_ptr<ArrayBuffer>& addresses) override;
+  std::shared_ptr<ArrayBuffer> getAddresses() override;
+  std::shared_ptr<ArrayBuffer> publicKeyByAddress(const std::shared_ptr<ArrayBuffer>& address, bool isCompressed) override;
+  std::shared_ptr<ArrayBuffer> signByAddress(const std::shared_ptr<ArrayBuffer>& address,
+                                             const std::shared_ptr<ArrayBuffer>& hash) override;
+  void clear() override;
+
+  size_t getExternalMemorySize() noexcept override;
+
+public:
+  static constexpr size_t kAddressSize = 20;
+
+private:
+  using Address = std::array<uint8_t, kAddressSize>;
+
+  // Addresses are the tail of a keccak256 of our own public keys, so their
+  // first bytes are already uniformly distributed
+  struct AddressHash {
+    size_t operator()(const Address& address) const noexcept {
+      size_t h;
+      std::memcpy(&h, address.data(), sizeof(h));
+      return h;
+    }
+  };
+
+  struct Account {
+    SecureBuffer privateKey;
+    uint8_t publicKey[65]; // uncompressed, with the 0x04 prefix
+    Address address;
+  };
+
+  const Account& accountFor(const std::shared_ptr<ArrayBuffer>& address) const;
+  void reindex();
+
+  std::vector<Account> accounts_;
+  std::unordered_map<Address, size_t, AddressHash> index_;
+};
+
+} // namespace margelo::nitro::metamask_nativeutils
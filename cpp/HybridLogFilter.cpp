@@ -0,0 +1,131 @@
+#include "HybridLogFilter.hpp"
+#include "keccak_utils.hpp"
+#include "simd_utils.hpp"
+#include <cstring>
+#include <stdexcept>
+
+namespace margelo::nitro::metamask_nativeutils {
+
+static uint32_t readWord(const uint8_t* p) {
+  // All supported targets are little-endian, matching DataView(..., true) in JS
+  uint32_t value;
+  std::memcpy(&value, p, sizeof(value));
+  return value;
+}
+
+static void appendWord(std::vector<uint8_t>& out, uint32_t value) {
+  uint8_t bytes[4];
+  std::memcpy(bytes, &value, sizeof(bytes));
+  out.insert(out.end(), bytes, bytes + 4);
+}
+
+static std::shared_ptr<ArrayBuffer> toArrayBuffer(const std::vector<uint8_t>& bytes) {
+  return ArrayBuffer::copy(bytes.data(), bytes.size());
+}
+
+HybridLogFilter::HybridLogFilter(const std::vector<std::string>& events) : HybridObject(TAG) {
+  if (events.empty()) {
+    throw std::runtime_error("Log filter needs at least one event");
+  }
+
+  for (const auto& text : events) {
+    Event event;
+    event.signature = parseAbiSignature(text);
+    keccak256(reinterpret_cast<const uint8_t*>(event.signature.canonical.data()), event.signature.canonical.size(),
+              event.topic);
+
+    // Anonymous events log no topic0, so their indexed parameters start at
+    // topic 0 and the signature hash is never compared
+    event.topicCount = event.signature.anonymous ? 0 : 1;
+    event.dataHeadSize = 0;
+    for (const auto& param : event.signature.params) {
+      if (param.indexed) {
+        // Indexed dynamic values, arrays and tuples are stored as their hash
+        if (param.wordKind != AbiWordKind::None) {
+          event.fields.push_back({true, static_cast<uint32_t>(event.topicCount), param.wordKind});
+        }
+        event.topicCount++;
+      } else {
+        if (param.wordKind != AbiWordKind::None) {
+          event.fields.push_back({false, static_cast<uint32_t>(event.dataHeadSize), param.wordKind});
+        }
+        if (param.headSize > kAbiMaxHeadSize - event.dataHeadSize) {
+          throw std::runtime_error("Event '" + text + "' has non-indexed parameters larger than 4 GiB");
+        }
+        event.dataHeadSize += param.headSize;
+      }
+    }
+    if (event.topicCount > kMaxTopics) {
+      throw std::runtime_error("Event '" + text + "' has more than " +
+                               std::to_string(event.signature.anonymous ? kMaxTopics : kMaxTopics - 1) +
+                               " indexed parameters");
+    }
+    events_.push_back(std::move(event));
+  }
+}
+
+std::vector<LogFilterEvent> HybridLogFilter::getEvents() {
+  std::vector<LogFilterEvent> result;
+  for (const auto& event : events_) {
+    std::vector<std::string> names, types;
+    for (const auto& param : event.signature.params) {
+      if (param.wordKind != AbiWordKind::None) {
+        names.push_back(param.name);
+        types.push_back(param.type);
+      }
+    }
+    auto topic = event.signature.anonymous ? ArrayBuffer::allocate(0) : ArrayBuffer::copy(event.topic, 32);
+    result.emplace_back(event.signature.name, event.signature.canonical, topic, names, types);
+  }
+  return result;
+}
+
+LogFilterMatches HybridLogFilter::filter(const std::shared_ptr<ArrayBuffer>& logs, const std::shared_ptr<ArrayBuffer>& data) {
+  if (logs->size() % kRecordSize != 0) {
+    throw std::runtime_error("Packed logs must be a multiple of 160 bytes");
+  }
+  size_t count = logs->size() / kRecordSize;
+  const uint8_t* records = static_cast<const uint8_t*>(logs->data());
+  const uint8_t* dataBytes = static_cast<const uint8_t*>(data->data());
+  size_t dataSize = data->size();
+
+  std::vector<uint8_t> logIndices, eventIndices, addresses, values;
+  for (size_t i = 0; i < count; i++) {
+    const uint8_t* record = records + i * kRecordSize;
+    size_t topicCount = record[kTopicCountOffset];
+    if (topicCount > kMaxTopics) {
+      throw std::runtime_error("Log at index " + std::to_string(i) + " has more than 4 topics");
+    }
+    uint32_t dataOffset = readWord(record + kDataOffsetOffset);
+    uint32_t dataLength = readWord(record + kDataLengthOffset);
+    if (dataOffset > dataSize || dataLength > dataSize - dataOffset) {
+      throw std::runtime_error("Log at index " + std::to_string(i) + " has data outside the data buffer");
+    }
+
+    const uint8_t* topics = record + kTopicsOffset;
+    for (size_t e = 0; e < events_.size(); e++) {
+      const Event& event = events_[e];
+      if (event.topicCount != topicCount || event.dataHeadSize > dataLength ||
+          (!event.signature.anonymous && !simd::equal32(topics, event.topic))) {
+        continue;
+      }
+
+      appendWord(logIndices, static_cast<uint32_t>(i));
+      appendWord(eventIndices, static_cast<uint32_t>(e));
+      for (const Field& field : event.fields) {
+        const uint8_t* word = field.fromTopic ? topics + field.offset * 32 : dataBytes + dataOffset + field.offset;
+        if (field.kind == AbiWordKind::Address) {
+          addresses.insert(addresses.end(), word + 12, word + 32);
+        } else {
+          values.insert(values.end(), word, word + 32);
+        }
+      }
+      break;
+    }
+  }
+
+  return LogFilterMatches(toArrayBuffer(logIndices), toArrayBuffer(eventIndices), toArrayBuffer(addresses),
+                          toArrayBuffer(values));
+}
+
+} // namespace margelo::nitro::metamask_nativeutils
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "HybridLogFilterSpec.hpp"
+#include "abi_signature.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace margelo::nitro::metamask_nativeutils {
+
+/**
+ * Matches packed logs against a fixed set of events by topic0 and decodes
+ * their single-word parameters (addresses, integers, booleans, bytesN).
+ *
+ * An event only matches a log whose topic count equals 1 + its indexed
+ * parameter count and whose data covers its non-indexed parameters, so
+ * events sharing a signature hash (ERC-20 and ERC-721 `Transfer`) are told
+ * apart by their indexed layout. Anonymous events have no topic0 and match
+ * on that layout alone; each log takes the first event that matches it.
+ */
+class HybridLogFilter : public HybridLogFilterSpec {
+public:
+  explicit HybridLogFilter(const std::vector<std::string>& events);
+
+public:
+  std::vector<LogFilterEvent> getEvents() override;
+  LogFilterMatches filter(const std::shared_ptr<ArrayBuffer>& logs, const std::shared_ptr<ArrayBuffer>& data) override;
+
+public:
+  static constexpr size_t kRecordSize = 160;
+  static constexpr size_t kTopicCountOffset = 20;
+  static constexpr size_t kDataOffsetOffset = 24;
+  static constexpr size_t kDataLengthOffset = 28;
+  static constexpr size_t kTopicsOffset = 32;
+  static constexpr size_t kMaxTopics = 4;
+
+private:
+  struct Field {
+    bool fromTopic;  // otherwise from data
+    uint32_t offset; // topic index, or byte offset of the word in data
+    AbiWordKind kind;
+  };
+
+  struct Event {
+    AbiSignature signature;
+    uint8_t topic[32];
+    size_t topicCount;   // including topic0, unless anonymous
+    size_t dataHeadSize; // bytes of data the non-indexed parameters need
+    std::vector<Field> fields;
+  };
+
+  std::vector<Event> events_;
+};
+
+} // namespace margelo::nitro::metamask_nativeutils
@@ -0,0 +1,101 @@
+#include "HybridMerkleTree.hpp"
+#include "merkle_utils.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+
+namespace margelo::nitro::metamask_nativeutils {
+
+HybridMerkleTree::HybridMerkleTree(std::vector<uint8_t> leafHashes, bool sortLeaves) : HybridObject(TAG) {
+  size_t leafCount = leafHashes.size() / 32;
+  if (leafCount == 0) {
+    throw std::runtime_error("Merkle tree needs at least one leaf");
+  }
+  if (leafCount > UINT32_MAX / 2) {
+    throw std::runtime_error("Merkle tree cannot hold " + std::to_string(leafCount) + " leaves");
+  }
+
+  // Leaf position i (after the optional sort) is stored at node nodeCount - 1 - i
+  std::vector<uint32_t> order(leafCount);
+  std::iota(order.begin(), order.end(), 0);
+  if (sortLeaves) {
+    const uint8_t* hashes = leafHashes.data();
+    std::sort(order.begin(), order.end(), [hashes](uint32_t a, uint32_t b) {
+      return std::memcmp(hashes + a * 32, hashes + b * 32, 32) < 0;
+    });
+  }
+
+  size_t nodeCount = merkleNodeCount(leafCount);
+  nodes_.resize(nodeCount * 32);
+  leafNodes_.resize(leafCount);
+  for (size_t position = 0; position < leafCount; position++) {
+    size_t nodeIndex = nodeCount - 1 - position;
+    std::memcpy(nodes_.data() + nodeIndex * 32, leafHashes.data() + order[position] * 32, 32);
+    leafNodes_[order[position]] = static_cast<uint32_t>(nodeIndex);
+  }
+
+  merkleBuildTree(nodes_.data(), leafCount);
+}
+
+size_t HybridMerkleTree::treeIndex(double index) const {
+  if (!(index >= 0 && index < static_cast<double>(leafNodes_.size()) && std::floor(index) == index)) {
+    throw std::runtime_error("Leaf index must be an integer below " + std::to_string(leafNodes_.size()));
+  }
+  return leafNodes_[static_cast<size_t>(index)];
+}
+
+std::shared_ptr<ArrayBuffer> HybridMerkleTree::getRoot() {
+  return ArrayBuffer::copy(node(0), 32);
+}
+
+double HybridMerkleTree::getLeafCount() {
+  return static_cast<double>(leafNodes_.size());
+}
+
+std::shared_ptr<ArrayBuffer> HybridMerkleTree::getNodes() {
+  return ArrayBuffer::copy(nodes_.data(), nodes_.size());
+}
+
+std::shared_ptr<ArrayBuffer> HybridMerkleTree::getLeafHashes() {
+  auto result = ArrayBuffer::allocate(leafNodes_.size() * 32);
+  uint8_t* output = static_cast<uint8_t*>(result->data());
+  for (size_t i = 0; i < leafNodes_.size(); i++) {
+    std::memcpy(output + i * 32, node(leafNodes_[i]), 32);
+  }
+  return result;
+}
+
+std::shared_ptr<ArrayBuffer> HybridMerkleTree::getProof(double index) {
+  size_t current = treeIndex(index);
+  size_t depth = 0;
+  for (size_t i = current; i > 0; i = (i - 1) / 2) {
+    depth++;
+  }
+
+  auto result = ArrayBuffer::allocate(depth * 32);
+  uint8_t* output = static_cast<uint8_t*>(result->data());
+  for (size_t i = 0; current > 0; i++, current = (current - 1) / 2) {
+    // Left children have odd indices
+    size_t sibling = current % 2 == 1 ? current + 1 : current - 1;
+    std::memcpy(output + i * 32, node(sibling), 32);
+  }
+  return result;
+}
+
+std::vector<std::shared_ptr<ArrayBuffer>> HybridMerkleTree::getProofs(const std::vector<double>& indices) {
+  std::vector<std::shared_ptr<ArrayBuffer>> proofs;
+  proofs.reserve(indices.size());
+  for (double index : indices) {
+    proofs.push_back(getProof(index));
+  }
+  return proofs;
+}
+
+size_t HybridMerkleTree::getExternalMemorySize() noexcept {
+  return nodes_.size() + leafNodes_.size() * sizeof(uint32_t);
+}
+
+} // namespace margelo::nitro::metamask_nativeutils
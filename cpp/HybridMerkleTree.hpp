@@ -0,0 +1,44 @@
+#pragma once
+
+#include "HybridMerkleTreeSpec.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace margelo::nitro::metamask_nativeutils {
+
+/**
+ * Immutable Keccak-256 sorted-pair Merkle tree, stored as one flat array of
+ * 32-byte nodes in the layout of OpenZeppelin's @openzeppelin/merkle-tree
+ * (see merkle_utils.hpp), so roots, proofs and node dumps match it exactly.
+ */
+class HybridMerkleTree : public HybridMerkleTreeSpec {
+public:
+  /**
+   * Build a tree from leaf hashes.
+   * @param leafHashes Packed 32-byte leaf hashes, in input order
+   * @param sortLeaves Whether to order leaves by hash first, as OpenZeppelin
+   *   does by default; indices still refer to the input order
+   */
+  HybridMerkleTree(std::vector<uint8_t> leafHashes, bool sortLeaves);
+
+public:
+  std::shared_ptr<ArrayBuffer> getRoot() override;
+  double getLeafCount() override;
+  std::shared_ptr<ArrayBuffer> getNodes() override;
+  std::shared_ptr<ArrayBuffer> getLeafHashes() override;
+  std::shared_ptr<ArrayBuffer> getProof(double index) override;
+  std::vector<std::shared_ptr<ArrayBuffer>> getProofs(const std::vector<double>& indices) override;
+
+  size_t getExternalMemorySize() noexcept override;
+
+private:
+  const uint8_t* node(size_t index) const { return nodes_.data() + index * 32; }
+  size_t treeIndex(double index) const;
+
+  std::vector<uint8_t> nodes_;
+  // Node index of each leaf, in input order
+  std::vector<uint32_t> leafNodes_;
+};
+
+} // namespace margelo::nitro::metamask_nativeutils
@@ -1,70 +1,73 @@
 #include "HybridNativeUtils.hpp"
-#include "secp256k1/include/secp256k1.h"
+#include "secp256k1_utils.hpp"
+#include "keccak_utils.hpp"
+#include "hash_utils.hpp"
+#include "ed25519.hpp"
+#include "HybridHasher.hpp"
 #include "hex_utils.hpp"
 #include "botan_conditional.h"
+#include "adaptive_dispatch.hpp"
+#include "chunk_stream.hpp"
+#include "HybridPipeline.hpp"
+#include "HybridSubmissionRing.hpp"
+#include "HybridAddressSet.hpp"
+#include "bloom_utils.hpp"
+#include "HybridLogFilter.hpp"
+#include "HybridSelectorIndex.hpp"
+#include "HybridDomainIndex.hpp"
+#include "HybridEd25519KeyHandle.hpp"
+#include "HybridKeyring.hpp"
+#include "base58.hpp"
+#include "bip32.hpp"
+#include "bip322.hpp"
+#include "solana_message.hpp"
+#include "token_accounts.hpp"
+#include "base64.hpp"
+#include "decimal_format.hpp"
+#include "mapped_file.hpp"
+#include "ens_utils.hpp"
+#include "HybridMerkleTree.hpp"
+#include "merkle_utils.hpp"
+#include "parallel_for.hpp"
+#include "packed_items.hpp"
+#include "mpt_proof.hpp"
+#include "mpt_builder.hpp"
+#include "ssz.hpp"
+#include "secure_arena.hpp"
+#include "memory_trim.hpp"
+#include <NitroModules/ThreadPool.hpp>
 #include <stdexcept>
+#include <algorithm>
+#include <cmath>
 #include <mutex>
+#include <string>
+#include <vector>
 
 namespace margelo::nitro::metamask_nativeutils {
 
-// Static global context for maximum performance.
-// Made const and initialized with a call-once guard for thread safety.
-static std::once_flag g_ctx_once;
-static const secp256k1_context* g_ctx = nullptr;
-
-static void initializeContext() {
-    std::call_once(g_ctx_once, []() {
-        g_ctx = secp256k1_context_create(SECP256K1_CONTEXT_NONE);
-    });
-
-    if (!g_ctx) {
-        throw std::runtime_error("Failed to initialize secp256k1 context");
-    }
-}
-
-// Helper that wraps secp256k1_ec_pubkey_serialize and enforces the expected output length.
-// libsecp256k1 treats the length parameter as an in/out value: on input it is the buffer
-// capacity, on output it is the actual number of bytes written. We defensively verify that
-// the actual length matches the format we requested (33 or 65 bytes) so that future changes
-// in libsecp256k1 cannot cause us to read uninitialized or truncated public key data.
-static void serializeSecp256k1PubkeyChecked(
-    const secp256k1_pubkey* pubkey,
-    uint8_t* output,
-    size_t expectedLen,
-    unsigned int flags) {
-  size_t outputLen = expectedLen;
-  if (!secp256k1_ec_pubkey_serialize(g_ctx, output, &outputLen, pubkey, flags)) {
-    throw std::runtime_error("Failed to serialize public key");
-  }
-  if (outputLen != expectedLen) {
-    throw std::runtime_error("Unexpected public key length from secp256k1");
-  }
-}
-
 // Common function to generate public key from raw private key bytes
 static std::shared_ptr<ArrayBuffer> generatePublicKeyFromBytes(const uint8_t* privateKeyBytes, bool isCompressed) {
-  initializeContext();
-  
-  // Use secp256k1's built-in validation (checks if key is not 0 and < curve order)
-  if (!secp256k1_ec_seckey_verify(g_ctx, privateKeyBytes)) {
-      throw std::runtime_error("Private key is invalid");
-  }
-  
-  // Create public key from private key
-  secp256k1_pubkey pubkey;
-  if (!secp256k1_ec_pubkey_create(g_ctx, &pubkey, privateKeyBytes)) {
-      throw std::runtime_error("Failed to create public key from private key");
-  }
-  
-  // Serialize the public key
   size_t keySize = isCompressed ? 33 : 65;
   auto buffer = ArrayBuffer::allocate(keySize);
+  derivePublicKeyInto(privateKeyBytes, static_cast<uint8_t*>(buffer->data()), isCompressed);
+  
+  return buffer;
+}
+
+// Derive public keys for `count` packed 32-byte private keys into one packed buffer
+static std::shared_ptr<ArrayBuffer> generatePublicKeysFromBytes(const uint8_t* privateKeys, size_t count, bool isCompressed) {
+  size_t keySize = isCompressed ? 33 : 65;
+  auto buffer = ArrayBuffer::allocate(keySize * count);
   auto data = static_cast<uint8_t*>(buffer->data());
 
-  unsigned int flags = isCompressed ? SECP256K1_EC_COMPRESSED : SECP256K1_EC_UNCOMPRESSED;
+  for (size_t i = 0; i < count; i++) {
+    try {
+      derivePublicKeyInto(privateKeys + i * 32, data + i * keySize, isCompressed);
+    } catch (const std::runtime_error& e) {
+      throw std::runtime_error(std::string(e.what()) + " at index " + std::to_string(i));
+    }
+  }
 
-  serializeSecp256k1PubkeyChecked(&pubkey, data, keySize, flags);
-  
   return buffer;
 }
 
@@ -74,10 +77,10 @@ std::shared_ptr<ArrayBuffer> HybridNativeUtils::toPublicKey(const std::string& p
       throw std::runtime_error("Private key must be 64 hex characters (32 bytes)");
   }
   
-  uint8_t privateKeyBytes[32];
-  hexToBytes(privateKey, privateKeyBytes, 32);
+  SecureBuffer privateKeyBytes(32);
+  hexToBytes(privateKey, privateKeyBytes.data(), 32);
   
-  return generatePublicKeyFromBytes(privateKeyBytes, isCompressed);
+  return generatePublicKeyFromBytes(privateKeyBytes.data(), isCompressed);
 }
 
 std::shared_ptr<ArrayBuffer> HybridNativeUtils::toPublicKeyFromBytes(const std::shared_ptr<ArrayBuffer>& privateKey, bool isCompressed) {
@@ -95,19 +98,27 @@ std::shared_ptr<ArrayBuffer> HybridNativeUtils::toPublicKeyFromBytes(const std::
 // Common function to generate ed25519 public key from private key bytes (seed)
 static std::shared_ptr<ArrayBuffer> generateEd25519PublicKeyFromBytes(const uint8_t* privateKeyBytes) {
   auto buffer = ArrayBuffer::allocate(32);
-  uint8_t* publicKey = static_cast<uint8_t*>(buffer->data());
-  uint8_t secretKey[64];
-  
-  Botan::ed25519_gen_keypair(publicKey, secretKey, privateKeyBytes);
-  
+  ed25519PublicKey(privateKeyBytes, static_cast<uint8_t*>(buffer->data()));
+  return buffer;
+}
+
+// Derive ed25519 public keys for `count` packed 32-byte seeds into one packed buffer
+static std::shared_ptr<ArrayBuffer> generateEd25519PublicKeysFromBytes(const uint8_t* seeds, size_t count) {
+  auto buffer = ArrayBuffer::allocate(32 * count);
+  uint8_t* publicKeys = static_cast<uint8_t*>(buffer->data());
+
+  for (size_t i = 0; i < count; i++) {
+    ed25519PublicKey(seeds + i * 32, publicKeys + i * 32);
+  }
+
   return buffer;
 }
 
 std::shared_ptr<ArrayBuffer> HybridNativeUtils::getPublicKeyEd25519(const std::string& privateKey) {
-  uint8_t seed[32];
-  hexToBytes(privateKey, seed, 32);
+  SecureBuffer seed(32);
+  hexToBytes(privateKey, seed.data(), 32);
   
-  return generateEd25519PublicKeyFromBytes(seed);
+  return generateEd25519PublicKeyFromBytes(seed.data());
 }
 
 std::shared_ptr<ArrayBuffer> HybridNativeUtils::getPublicKeyEd25519FromBytes(const std::shared_ptr<ArrayBuffer>& privateKey) {
@@ -119,16 +130,253 @@ std::shared_ptr<ArrayBuffer> HybridNativeUtils::getPublicKeyEd25519FromBytes(con
   return generateEd25519PublicKeyFromBytes(seed);
 }
 
-static std::shared_ptr<ArrayBuffer> keccak256Hash(const uint8_t* dataBytes, size_t dataLen) {
-  auto hasher = Botan::HashFunction::create("Keccak-1600(256)");
-  if (!hasher) {
-    throw std::runtime_error("Failed to create Keccak-256 hasher");
+std::shared_ptr<HybridEd25519KeyHandleSpec> HybridNativeUtils::createEd25519KeyHandle(const std::shared_ptr<ArrayBuffer>& privateKey) {
+  if (privateKey->size() != 32) {
+    throw std::runtime_error("Private key must be 32 bytes");
   }
+  return std::make_shared<HybridEd25519KeyHandle>(static_cast<const uint8_t*>(privateKey->data()));
+}
 
-  hasher->update(dataBytes, dataLen);
+// Decode every 32-byte encoding in `points`, filling the validity bitmap and,
+// when given, 64 bytes of coordinates per point.
+static void decodeEd25519Points(const std::shared_ptr<ArrayBuffer>& points, uint8_t* bitmap, uint8_t* coordinates) {
+  const uint8_t* encoded = static_cast<const uint8_t*>(points->data());
+  parallelBitmap(points->size() / 32, 128, bitmap, [&](size_t i) {
+    uint8_t* x = coordinates != nullptr ? coordinates + i * 64 : nullptr;
+    uint8_t* y = coordinates != nullptr ? coordinates + i * 64 + 32 : nullptr;
+    if (ed25519DecodePoint(encoded + i * 32, x, y)) {
+      return true;
+    }
+    if (coordinates != nullptr) {
+      std::fill(x, x + 64, 0);
+    }
+    return false;
+  });
+}
 
+std::shared_ptr<ArrayBuffer> HybridNativeUtils::ed25519IsOnCurve(const std::shared_ptr<ArrayBuffer>& points) {
+  if (points->size() % 32 != 0) {
+    throw std::runtime_error("Points must be a multiple of 32 bytes");
+  }
+  auto result = ArrayBuffer::allocate((points->size() / 32 + 7) / 8);
+  decodeEd25519Points(points, static_cast<uint8_t*>(result->data()), nullptr);
+  return result;
+}
+
+Ed25519Points HybridNativeUtils::ed25519DecompressPoints(const std::shared_ptr<ArrayBuffer>& points) {
+  if (points->size() % 32 != 0) {
+    throw std::runtime_error("Points must be a multiple of 32 bytes");
+  }
+  size_t count = points->size() / 32;
+  auto coordinates = ArrayBuffer::allocate(count * 64);
+  auto valid = ArrayBuffer::allocate((count + 7) / 8);
+  decodeEd25519Points(points, static_cast<uint8_t*>(valid->data()), static_cast<uint8_t*>(coordinates->data()));
+  return Ed25519Points(coordinates, valid);
+}
+
+std::shared_ptr<HybridKeyringSpec> HybridNativeUtils::createKeyring() {
+  return std::make_shared<HybridKeyring>();
+}
+
+// Extended keys per parallel chunk; checking one costs a point parse or a
+// scalar check, plus a fingerprint when parsing
+static constexpr size_t kExtendedKeyGrain = 32;
+
+std::vector<std::string> HybridNativeUtils::serializeExtendedKeys(const std::shared_ptr<ArrayBuffer>& keys) {
+  if (keys->size() % kExtendedKeySize != 0) {
+    throw std::runtime_error("Extended keys must be a multiple of 78 bytes");
+  }
+  size_t count = keys->size() / kExtendedKeySize;
+  const uint8_t* bytes = static_cast<const uint8_t*>(keys->data());
+  for (size_t i = 0; i < count; i++) {
+    if (const char* error = extendedKeyError(bytes + i * kExtendedKeySize)) {
+      throw std::runtime_error("Extended key at index " + std::to_string(i) + " is invalid: " + error);
+    }
+  }
+
+  std::vector<std::string> encoded(count);
+  parallelFor(count, kExtendedKeyGrain, [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) {
+      encoded[i] = base58CheckEncode(bytes + i * kExtendedKeySize, kExtendedKeySize);
+    }
+  });
+  return encoded;
+}
+
+ExtendedKeys HybridNativeUtils::parseExtendedKeys(const std::vector<std::string>& encoded) {
+  size_t count = encoded.size();
+  auto keys = ArrayBuffer::allocate(count * kExtendedKeySize);
+  auto fingerprints = ArrayBuffer::allocate(count * 4);
+  auto valid = ArrayBuffer::allocate((count + 7) / 8);
+  uint8_t* keyBytes = static_cast<uint8_t*>(keys->data());
+  uint8_t* fingerprintBytes = static_cast<uint8_t*>(fingerprints->data());
+  parallelBitmap(count, kExtendedKeyGrain, static_cast<uint8_t*>(valid->data()), [&](size_t i) {
+    uint8_t* key = keyBytes + i * kExtendedKeySize;
+    uint8_t* fingerprint = fingerprintBytes + i * 4;
+    const std::string& text = encoded[i];
+    if (base58CheckDecode(text.data(), text.size(), key, kExtendedKeySize) && extendedKeyError(key) == nullptr) {
+      extendedKeyFingerprint(key, fingerprint);
+      return true;
+    }
+    std::fill(key, key + kExtendedKeySize, 0);
+    std::fill(fingerprint, fingerprint + 4, 0);
+    return false;
+  });
+  return ExtendedKeys(keys, fingerprints, valid);
+}
+
+std::string HybridNativeUtils::bip322Sign(const std::shared_ptr<ArrayBuffer>& privateKey, const std::string& address,
+                                          const std::shared_ptr<ArrayBuffer>& message) {
+  if (privateKey->size() != 32) {
+    throw std::runtime_error("Private key must be 32 bytes, got " + std::to_string(privateKey->size()));
+  }
+  return metamask_nativeutils::bip322Sign(static_cast<const uint8_t*>(privateKey->data()), address,
+                                          static_cast<const uint8_t*>(message->data()), message->size());
+}
+
+bool HybridNativeUtils::bip322Verify(const std::string& address, const std::shared_ptr<ArrayBuffer>& message,
+                                     const std::string& signature) {
+  return metamask_nativeutils::bip322Verify(address, static_cast<const uint8_t*>(message->data()), message->size(),
+                                            signature);
+}
+
+// Proofs per parallel chunk; one is a few hashes and a signature verification
+static constexpr size_t kBip322Grain = 16;
+
+std::shared_ptr<ArrayBuffer> HybridNativeUtils::bip322VerifyBatch(const std::vector<std::string>& addresses,
+                                                                  const std::shared_ptr<ArrayBuffer>& messages,
+                                                                  const std::vector<double>& messageLengths,
+                                                                  const std::vector<std::string>& signatures) {
+  size_t count = addresses.size();
+  if (messageLengths.size() != count || signatures.size() != count) {
+    throw std::runtime_error("Addresses, message lengths and signatures must have the same length");
+  }
+  std::vector<size_t> offsets = packedOffsets(messageLengths, messages->size(), "message");
+
+  const uint8_t* bytes = static_cast<const uint8_t*>(messages->data());
+  auto result = ArrayBuffer::allocate((count + 7) / 8);
+  parallelBitmap(count, kBip322Grain, static_cast<uint8_t*>(result->data()), [&](size_t i) {
+    return metamask_nativeutils::bip322Verify(addresses[i], bytes + offsets[i], offsets[i + 1] - offsets[i],
+                                              signatures[i]);
+  });
+  return result;
+}
+
+std::shared_ptr<ArrayBuffer> HybridNativeUtils::compileSolanaMessage(const std::vector<std::string>& addresses,
+                                                                     const std::shared_ptr<ArrayBuffer>& message) {
+  std::vector<uint8_t> compiled = metamask_nativeutils::compileSolanaMessage(
+      addresses, static_cast<const uint8_t*>(message->data()), message->size());
+  return ArrayBuffer::copy(compiled.data(), compiled.size());
+}
+
+// Solana's MAX_PERMITTED_DATA_LENGTH; no field of a real account lies beyond it
+static constexpr double kMaxAccountDataSize = 10 * 1024 * 1024;
+
+static size_t layoutField(double value, const char* name) {
+  // Written so NaN fails too, and the cast below is always in range
+  if (!(value >= 0 && value <= kMaxAccountDataSize && std::floor(value) == value)) {
+    throw std::runtime_error(std::string("Layout ") + name + " must be an integer from 0 to 10485760");
+  }
+  return static_cast<size_t>(value);
+}
+
+static AccountLayout accountLayout(const TokenAccountLayout& layout) {
+  AccountLayout result;
+  result.mintOffset = layoutField(layout.mintOffset, "mintOffset");
+  result.ownerOffset = layoutField(layout.ownerOffset, "ownerOffset");
+  result.amountOffset = layoutField(layout.amountOffset, "amountOffset");
+  result.amountSize = layoutField(layout.amountSize, "amountSize");
+  if (result.amountSize != 8 && result.amountSize != 16) {
+    throw std::runtime_error("Layout amountSize must be 8 or 16");
+  }
+  const uint8_t* discriminator = static_cast<const uint8_t*>(layout.discriminator->data());
+  result.discriminator.assign(discriminator, discriminator + layout.discriminator->size());
+  result.minSize = std::max({layoutField(layout.minSize, "minSize"), result.mintOffset + 32, result.ownerOffset + 32,
+                             result.amountOffset + result.amountSize, result.discriminator.size()});
+  return result;
+}
+
+// Accounts per parallel chunk; raw accounts are a few copies each, base64
+// ones a decode of about 220 characters first
+static constexpr size_t kTokenAccountGrain = 64;
+
+// Decode `count` accounts into packed fields. `dataOf(i, scratch, data,
+// size)` points `data` at account i's bytes, decoding into `scratch` if it
+// needs to, and returns false if it cannot.
+template <typename DataOf>
+static TokenAccounts decodeTokenAccountBatch(size_t count, const TokenAccountLayout& layout,
+                                             const std::vector<double>& decimals, DataOf dataOf) {
+  AccountLayout fields = accountLayout(layout);
+  if (!decimals.empty() && decimals.size() != count) {
+    throw std::runtime_error("Decimals must be empty or one per account");
+  }
+  for (size_t i = 0; i < decimals.size(); i++) {
+    if (!(decimals[i] >= 0 && decimals[i] <= 255 && std::floor(decimals[i]) == decimals[i])) {
+      throw std::runtime_error("Decimals at index " + std::to_string(i) + " must be an integer from 0 to 255");
+    }
+  }
+
+  auto mints = ArrayBuffer::allocate(count * 32);
+  auto owners = ArrayBuffer::allocate(count * 32);
+  auto amounts = ArrayBuffer::allocate(count * 16);
+  auto valid = ArrayBuffer::allocate((count + 7) / 8);
+  uint8_t* mintBytes = static_cast<uint8_t*>(mints->data());
+  uint8_t* ownerBytes = static_cast<uint8_t*>(owners->data());
+  uint8_t* amountBytes = static_cast<uint8_t*>(amounts->data());
+  std::vector<std::string> formatted(decimals.size());
+  parallelBitmap(count, kTokenAccountGrain, static_cast<uint8_t*>(valid->data()), [&](size_t i) {
+    // Reused by every account decoded on this thread; account data is public
+    thread_local std::vector<uint8_t> scratch;
+    uint8_t* mint = mintBytes + i * 32;
+    uint8_t* owner = ownerBytes + i * 32;
+    uint8_t* amount = amountBytes + i * 16;
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+    if (dataOf(i, scratch, data, size) && decodeTokenAccount(fields, data, size, mint, owner, amount)) {
+      if (!formatted.empty()) {
+        formatted[i] = formatDecimalAmount(amount, 16, static_cast<unsigned>(decimals[i]));
+      }
+      return true;
+    }
+    std::fill(mint, mint + 32, 0);
+    std::fill(owner, owner + 32, 0);
+    std::fill(amount, amount + 16, 0);
+    return false;
+  });
+  return TokenAccounts(mints, owners, amounts, valid, std::move(formatted));
+}
+
+TokenAccounts HybridNativeUtils::decodeTokenAccounts(const std::shared_ptr<ArrayBuffer>& data,
+                                                     const std::vector<double>& dataLengths,
+                                                     const TokenAccountLayout& layout,
+                                                     const std::vector<double>& decimals) {
+  std::vector<size_t> offsets = packedOffsets(dataLengths, data->size(), "account data");
+  const uint8_t* bytes = static_cast<const uint8_t*>(data->data());
+  return decodeTokenAccountBatch(dataLengths.size(), layout, decimals,
+                                 [&](size_t i, std::vector<uint8_t>&, const uint8_t*& account, size_t& size) {
+                                   account = bytes + offsets[i];
+                                   size = offsets[i + 1] - offsets[i];
+                                   return true;
+                                 });
+}
+
+TokenAccounts HybridNativeUtils::decodeTokenAccountsBase64(const std::vector<std::string>& data,
+                                                           const TokenAccountLayout& layout,
+                                                           const std::vector<double>& decimals) {
+  return decodeTokenAccountBatch(data.size(), layout, decimals,
+                                 [&](size_t i, std::vector<uint8_t>& scratch, const uint8_t*& account, size_t& size) {
+                                   if (!base64Decode(data[i].data(), data[i].size(), scratch)) {
+                                     return false;
+                                   }
+                                   account = scratch.data();
+                                   size = scratch.size();
+                                   return true;
+                                 });
+}
+
+static std::shared_ptr<ArrayBuffer> keccak256Hash(const uint8_t* dataBytes, size_t dataLen) {
   auto result = ArrayBuffer::allocate(32);
-  hasher->final(static_cast<uint8_t*>(result->data()));
+  keccak256(dataBytes, dataLen, static_cast<uint8_t*>(result->data()));
 
   return result;
 }
@@ -141,9 +389,28 @@ std::shared_ptr<ArrayBuffer> HybridNativeUtils::keccak256FromBytes(const std::sh
   return keccak256Hash(dataBytes, dataLen);
 }
 
+std::shared_ptr<ArrayBuffer> HybridNativeUtils::hash(HashAlgorithm algorithm, const std::shared_ptr<ArrayBuffer>& data) {
+  HashKind kind = HybridHasher::hashKind(algorithm);
+  auto result = ArrayBuffer::allocate(hashOutputSize(kind));
+  hashInto(kind, static_cast<const uint8_t*>(data->data()), data->size(), static_cast<uint8_t*>(result->data()));
+  return result;
+}
+
+std::shared_ptr<ArrayBuffer> HybridNativeUtils::hashMany(HashAlgorithm algorithm, const std::shared_ptr<ArrayBuffer>& items, const std::vector<double>& itemLengths) {
+  HashKind kind = HybridHasher::hashKind(algorithm);
+  std::vector<size_t> offsets = packedOffsets(itemLengths, items->size(), "item");
+
+  auto result = ArrayBuffer::allocate(itemLengths.size() * hashOutputSize(kind));
+  metamask_nativeutils::hashMany(kind, static_cast<const uint8_t*>(items->data()), offsets.data(), itemLengths.size(),
+                                 static_cast<uint8_t*>(result->data()));
+  return result;
+}
+
+std::shared_ptr<HybridHasherSpec> HybridNativeUtils::createHasher(HashAlgorithm algorithm) {
+  return std::make_shared<HybridHasher>(algorithm);
+}
+
 std::shared_ptr<ArrayBuffer> HybridNativeUtils::pubToAddress(const std::shared_ptr<ArrayBuffer>& pubKey, bool sanitize) {
-  initializeContext();
-  
   const uint8_t* pubKeyBytes = static_cast<const uint8_t*>(pubKey->data());
   size_t pubKeySize = pubKey->size();
   
@@ -155,7 +422,7 @@ std::shared_ptr<ArrayBuffer> HybridNativeUtils::pubToAddress(const std::shared_p
       secp256k1_pubkey parsedPubkey;
       
       // Parse SEC1-encoded public key with libsecp256k1 to ensure validity
-      if (!secp256k1_ec_pubkey_parse(g_ctx, &parsedPubkey, pubKeyBytes, pubKeySize)) {
+      if (!secp256k1_ec_pubkey_parse(secp256k1Context(), &parsedPubkey, pubKeyBytes, pubKeySize)) {
           throw std::runtime_error("Invalid public key format");
       }
       
@@ -177,25 +444,21 @@ std::shared_ptr<ArrayBuffer> HybridNativeUtils::pubToAddress(const std::shared_p
       }
   }
   
-  auto hashResult = keccak256Hash(pubKeyBytes, 64);
+  uint8_t hash[32];
+  keccak256(pubKeyBytes, 64, hash);
   
   // Return the last 20 bytes (Ethereum address)
   auto result = ArrayBuffer::allocate(20);
-  memcpy(result->data(), static_cast<const uint8_t*>(hashResult->data()) + 12, 20);
+  memcpy(result->data(), hash + 12, 20);
   
   return result;
 }
 
-std::shared_ptr<ArrayBuffer> HybridNativeUtils::hmacSha512(const std::shared_ptr<ArrayBuffer>& key, const std::shared_ptr<ArrayBuffer>& data) {
-  const uint8_t* keyBytes = static_cast<const uint8_t*>(key->data());
-  const uint8_t* dataBytes = static_cast<const uint8_t*>(data->data());
-
-  const auto keyLen = key->size();
-
+static std::shared_ptr<ArrayBuffer> hmacSha512Mac(const uint8_t* keyBytes, size_t keyLen, const uint8_t* dataBytes, size_t dataLen) {
   auto mac = Botan::MessageAuthenticationCode::create_or_throw("HMAC(SHA-512)");
 
   mac->set_key(keyBytes, keyLen);
-  mac->update(dataBytes, data->size());
+  mac->update(dataBytes, dataLen);
 
   auto buffer = ArrayBuffer::allocate(mac->output_length());
   mac->final(static_cast<uint8_t*>(buffer->data()));
@@ -203,6 +466,597 @@ std::shared_ptr<ArrayBuffer> HybridNativeUtils::hmacSha512(const std::shared_ptr
   return buffer;
 }
 
+std::shared_ptr<ArrayBuffer> HybridNativeUtils::hmacSha512(const std::shared_ptr<ArrayBuffer>& key, const std::shared_ptr<ArrayBuffer>& data) {
+  const uint8_t* keyBytes = static_cast<const uint8_t*>(key->data());
+  const uint8_t* dataBytes = static_cast<const uint8_t*>(data->data());
+
+  return hmacSha512Mac(keyBytes, key->size(), dataBytes, data->size());
+}
+
+// Seed the adaptive dispatcher's cost models once, on a pool thread so module
+// creation never waits for it. Until a model is seeded its requests are offloaded.
+// Probes run the same code paths as the real requests on synthetic inputs.
+static void startDispatcherCalibration() {
+  static std::once_flag calibrateOnce;
+  std::call_once(calibrateOnce, []() {
+    ThreadPool::shared().run([]() {
+      secp256k1Context();
+      auto& dispatcher = AdaptiveDispatcher::shared();
+      dispatcher.measureOffloadCost();
+
+      std::vector<uint8_t> scratch(4096, 0x01);
+      dispatcher.calibrate(DispatchOp::Keccak256, 64, scratch.size(), [&scratch](size_t units) {
+        keccak256Hash(scratch.data(), units);
+      });
+      dispatcher.calibrate(DispatchOp::HmacSha512, 64, scratch.size(), [&scratch](size_t units) {
+        hmacSha512Mac(scratch.data(), 64, scratch.data(), units);
+      });
+      // 0x0101...01 is a valid secp256k1 scalar and a valid ed25519 seed
+      dispatcher.calibrate(DispatchOp::Secp256k1PublicKey, 1, 8, [&scratch](size_t units) {
+        generatePublicKeysFromBytes(scratch.data(), units, true);
+      });
+      dispatcher.calibrate(DispatchOp::Ed25519PublicKey, 1, 8, [&scratch](size_t units) {
+        generateEd25519PublicKeysFromBytes(scratch.data(), units);
+      });
+    });
+  });
+}
+
+HybridNativeUtils::HybridNativeUtils() : HybridObject(TAG) {
+  startDispatcherCalibration();
+}
+
+// Copy a JS-owned buffer so it can be read from a worker thread
+static std::vector<uint8_t> copyForOffload(const std::shared_ptr<ArrayBuffer>& buffer) {
+  const uint8_t* bytes = static_cast<const uint8_t*>(buffer->data());
+  return std::vector<uint8_t>(bytes, bytes + buffer->size());
+}
+
+// Copy JS-owned secret material into the secure arena for a worker thread.
+// Shared so the copy can be captured by the copyable std::function Nitro expects.
+static std::shared_ptr<const SecureBuffer> copySecretForOffload(const std::shared_ptr<ArrayBuffer>& buffer) {
+  return std::make_shared<const SecureBuffer>(static_cast<const uint8_t*>(buffer->data()), buffer->size());
+}
+
+std::shared_ptr<Promise<std::shared_ptr<ArrayBuffer>>> HybridNativeUtils::keccak256Async(const std::shared_ptr<ArrayBuffer>& data) {
+  size_t units = data->size();
+
+  if (!AdaptiveDispatcher::shared().shouldOffload(DispatchOp::Keccak256, units)) {
+    return runInline<std::shared_ptr<ArrayBuffer>>(DispatchOp::Keccak256, units, [&data]() {
+      return keccak256Hash(static_cast<const uint8_t*>(data->data()), data->size());
+    });
+  }
+
+  return runOffloaded<std::shared_ptr<ArrayBuffer>>(DispatchOp::Keccak256, units, [input = copyForOffload(data)]() {
+    return keccak256Hash(input.data(), input.size());
+  });
+}
+
+std::shared_ptr<Promise<std::shared_ptr<ArrayBuffer>>> HybridNativeUtils::hmacSha512Async(const std::shared_ptr<ArrayBuffer>& key, const std::shared_ptr<ArrayBuffer>& data) {
+  size_t units = data->size();
+
+  if (!AdaptiveDispatcher::shared().shouldOffload(DispatchOp::HmacSha512, units)) {
+    return runInline<std::shared_ptr<ArrayBuffer>>(DispatchOp::HmacSha512, units, [&key, &data]() {
+      return hmacSha512Mac(static_cast<const uint8_t*>(key->data()), key->size(),
+                           static_cast<const uint8_t*>(data->data()), data->size());
+    });
+  }
+
+  return runOffloaded<std::shared_ptr<ArrayBuffer>>(DispatchOp::HmacSha512, units,
+      [keyBytes = copySecretForOffload(key), dataBytes = copySecretForOffload(data)]() {
+    // BIP32 hardened derivation puts the parent private key in `data`
+    return hmacSha512Mac(keyBytes->data(), keyBytes->size(), dataBytes->data(), dataBytes->size());
+  });
+}
+
+std::shared_ptr<Promise<std::shared_ptr<ArrayBuffer>>> HybridNativeUtils::toPublicKeysAsync(const std::shared_ptr<ArrayBuffer>& privateKeys, bool isCompressed) {
+  // Validate input size (packed 32-byte secp256k1 private keys)
+  if (privateKeys->size() % 32 != 0) {
+      throw std::runtime_error("Private keys must be a multiple of 32 bytes");
+  }
+
+  size_t count = privateKeys->size() / 32;
+
+  if (!AdaptiveDispatcher::shared().shouldOffload(DispatchOp::Secp256k1PublicKey, count)) {
+    return runInline<std::shared_ptr<ArrayBuffer>>(DispatchOp::Secp256k1PublicKey, count, [&privateKeys, count, isCompressed]() {
+      return generatePublicKeysFromBytes(static_cast<const uint8_t*>(privateKeys->data()), count, isCompressed);
+    });
+  }
+
+  return runOffloaded<std::shared_ptr<ArrayBuffer>>(DispatchOp::Secp256k1PublicKey, count,
+      [keys = copySecretForOffload(privateKeys), count, isCompressed]() {
+    return generatePublicKeysFromBytes(keys->data(), count, isCompressed);
+  });
+}
+
+std::shared_ptr<Promise<std::shared_ptr<ArrayBuffer>>> HybridNativeUtils::getPublicKeysEd25519Async(const std::shared_ptr<ArrayBuffer>& privateKeys) {
+  if (privateKeys->size() % 32 != 0) {
+    throw std::runtime_error("Private keys must be a multiple of 32 bytes");
+  }
+
+  size_t count = privateKeys->size() / 32;
+
+  if (!AdaptiveDispatcher::shared().shouldOffload(DispatchOp::Ed25519PublicKey, count)) {
+    return runInline<std::shared_ptr<ArrayBuffer>>(DispatchOp::Ed25519PublicKey, count, [&privateKeys, count]() {
+      return generateEd25519PublicKeysFromBytes(static_cast<const uint8_t*>(privateKeys->data()), count);
+    });
+  }
+
+  return runOffloaded<std::shared_ptr<ArrayBuffer>>(DispatchOp::Ed25519PublicKey, count,
+      [seeds = copySecretForOffload(privateKeys), count]() {
+    return generateEd25519PublicKeysFromBytes(seeds->data(), count);
+  });
+}
+
+// Number of result chunks that may wait on the JS thread before the worker pauses
+static constexpr size_t kMaxChunksInFlight = 2;
+
+using ChunkCallback = std::function<std::shared_ptr<Promise<bool>>(double, const std::shared_ptr<ArrayBuffer>&)>;
+using ChunkDeriveFunction = std::function<std::shared_ptr<ArrayBuffer>(const uint8_t*, size_t)>;
+
+// Derive `count` packed 32-byte inputs on the thread pool, handing each finished chunk
+// to `onChunk` with bounded queueing. Resolves with the number of items delivered.
+static std::shared_ptr<Promise<double>> streamBatch(std::shared_ptr<const SecureBuffer>&& inputs,
+                                                    size_t count,
+                                                    double chunkSize,
+                                                    const ChunkCallback& onChunk,
+                                                    ChunkDeriveFunction&& deriveChunk) {
+  if (!(chunkSize >= 1 && chunkSize <= 9007199254740992.0 && std::floor(chunkSize) == chunkSize)) {
+    throw std::runtime_error("Chunk size must be a positive integer");
+  }
+  size_t itemsPerChunk = static_cast<size_t>(chunkSize);
+
+  return Promise<double>::async([inputs = std::move(inputs), count, itemsPerChunk, onChunk, deriveChunk = std::move(deriveChunk)]() {
+    auto stream = std::make_shared<ChunkStream>(kMaxChunksInFlight);
+    size_t delivered = 0;
+
+    for (size_t start = 0; start < count; start += itemsPerChunk) {
+      if (!stream->acquire()) {
+        break;
+      }
+      try {
+        size_t items = std::min(itemsPerChunk, count - start);
+        auto chunk = deriveChunk(inputs->data() + start * 32, items);
+        stream->track(onChunk(static_cast<double>(start), chunk));
+        delivered += items;
+      } catch (...) {
+        stream->fail(std::current_exception());
+        break;
+      }
+    }
+
+    stream->drain();
+    return static_cast<double>(delivered);
+  });
+}
+
+std::shared_ptr<Promise<double>> HybridNativeUtils::toPublicKeysStreaming(const std::shared_ptr<ArrayBuffer>& privateKeys, bool isCompressed, double chunkSize, const ChunkCallback& onChunk) {
+  if (privateKeys->size() % 32 != 0) {
+      throw std::runtime_error("Private keys must be a multiple of 32 bytes");
+  }
+
+  return streamBatch(copySecretForOffload(privateKeys), privateKeys->size() / 32, chunkSize, onChunk,
+      [isCompressed](const uint8_t* keys, size_t items) {
+    return generatePublicKeysFromBytes(keys, items, isCompressed);
+  });
+}
+
+std::shared_ptr<Promise<double>> HybridNativeUtils::getPublicKeysEd25519Streaming(const std::shared_ptr<ArrayBuffer>& privateKeys, double chunkSize, const ChunkCallback& onChunk) {
+  if (privateKeys->size() % 32 != 0) {
+    throw std::runtime_error("Private keys must be a multiple of 32 bytes");
+  }
+
+  return streamBatch(copySecretForOffload(privateKeys), privateKeys->size() / 32, chunkSize, onChunk,
+      [](const uint8_t* seeds, size_t items) {
+    return generateEd25519PublicKeysFromBytes(seeds, items);
+  });
+}
+
+std::vector<DispatchThreshold> HybridNativeUtils::getDispatchThresholds() {
+  std::vector<DispatchThreshold> thresholds;
+  for (const auto& model : AdaptiveDispatcher::shared().snapshot()) {
+    thresholds.emplace_back(model.op,
+                            model.fixedCostNs,
+                            model.perUnitCostNs,
+                            model.offloadCostNs,
+                            model.inlineMaxUnits,
+                            static_cast<double>(model.samples));
+  }
+  return thresholds;
+}
+
+std::shared_ptr<HybridPipelineSpec> HybridNativeUtils::createPipeline(const std::vector<PipelineStage>& stages, double inputSize) {
+  if (!(inputSize >= 1 && inputSize <= 9007199254740992.0 && std::floor(inputSize) == inputSize)) {
+    throw std::runtime_error("Pipeline input size must be a positive integer");
+  }
+
+  return std::make_shared<HybridPipeline>(stages, static_cast<size_t>(inputSize));
+}
+
+std::shared_ptr<HybridSubmissionRingSpec> HybridNativeUtils::createSubmissionRing(double capacity, double dataSize) {
+  // Offsets and lengths in request slots are 32-bit
+  if (!(capacity >= 1 && capacity <= 65536 && std::floor(capacity) == capacity)) {
+    throw std::runtime_error("Submission ring capacity must be an integer between 1 and 65536");
+  }
+  if (!(dataSize >= 0 && dataSize <= 64.0 * 1024 * 1024 && std::floor(dataSize) == dataSize)) {
+    throw std::runtime_error("Submission ring data size must be an integer of at most 64 MiB");
+  }
+
+  return std::make_shared<HybridSubmissionRing>(static_cast<size_t>(capacity), static_cast<size_t>(dataSize));
+}
+
+std::shared_ptr<HybridAddressSetSpec> HybridNativeUtils::createAddressSet(double capacityHint) {
+  if (!(capacityHint >= 0 && capacityHint <= 16.0 * 1024 * 1024 && std::floor(capacityHint) == capacityHint)) {
+    throw std::runtime_error("Address set capacity hint must be an integer of at most 16777216");
+  }
+
+  return std::make_shared<HybridAddressSet>(static_cast<size_t>(capacityHint));
+}
+
+// Validate a packed batch of `itemSize`-byte items and return the item count
+static size_t packedItemCount(const std::shared_ptr<ArrayBuffer>& items, double itemSize, const char* what) {
+  if (!(itemSize >= 1 && itemSize <= 9007199254740992.0 && std::floor(itemSize) == itemSize)) {
+    throw std::runtime_error(std::string(what) + " size must be a positive integer");
+  }
+  size_t size = static_cast<size_t>(itemSize);
+  if (items->size() % size != 0) {
+    throw std::runtime_error(std::string(what) + "s must be a multiple of " + std::to_string(size) + " bytes");
+  }
+  return items->size() / size;
+}
+
+void HybridNativeUtils::bloomAdd(const std::shared_ptr<ArrayBuffer>& bloom, const std::shared_ptr<ArrayBuffer>& items, double itemSize) {
+  if (bloom->size() != kBloomSize) {
+    throw std::runtime_error("Bloom must be 256 bytes");
+  }
+  size_t count = packedItemCount(items, itemSize, "Item");
+
+  bloomAddItems(static_cast<uint8_t*>(bloom->data()), static_cast<const uint8_t*>(items->data()), count,
+                static_cast<size_t>(itemSize));
+}
+
+std::shared_ptr<ArrayBuffer> HybridNativeUtils::bloomBuild(const std::shared_ptr<ArrayBuffer>& items, double itemSize) {
+  size_t count = packedItemCount(items, itemSize, "Item");
+
+  auto result = ArrayBuffer::allocate(kBloomSize);
+  uint8_t* bloom = static_cast<uint8_t*>(result->data());
+  std::fill(bloom, bloom + kBloomSize, 0);
+  bloomAddItems(bloom, static_cast<const uint8_t*>(items->data()), count, static_cast<size_t>(itemSize));
+
+  return result;
+}
+
+std::shared_ptr<ArrayBuffer> HybridNativeUtils::bloomMatches(const std::shared_ptr<ArrayBuffer>& blooms, const std::shared_ptr<ArrayBuffer>& queries, double querySize) {
+  if (blooms->size() % kBloomSize != 0) {
+    throw std::runtime_error("Blooms must be a multiple of 256 bytes");
+  }
+  size_t bloomCount = blooms->size() / kBloomSize;
+  size_t queryCount = packedItemCount(queries, querySize, "Query");
+
+  // Hash each query once, however many blooms are scanned
+  std::vector<BloomBits> queryBits;
+  queryBits.reserve(queryCount);
+  const uint8_t* queryBytes = static_cast<const uint8_t*>(queries->data());
+  for (size_t i = 0; i < queryCount; i++) {
+    queryBits.push_back(bloomBits(queryBytes + i * static_cast<size_t>(querySize), static_cast<size_t>(querySize)));
+  }
+
+  auto result = ArrayBuffer::allocate((bloomCount + 7) / 8);
+  uint8_t* bitmap = static_cast<uint8_t*>(result->data());
+  std::fill(bitmap, bitmap + result->size(), 0);
+  bloomMatchAny(static_cast<const uint8_t*>(blooms->data()), bloomCount, queryBits, bitmap);
+
+  return result;
+}
+
+std::shared_ptr<HybridLogFilterSpec> HybridNativeUtils::createLogFilter(const std::vector<std::string>& events) {
+  return std::make_shared<HybridLogFilter>(events);
+}
+
+std::shared_ptr<HybridSelectorIndexSpec> HybridNativeUtils::openSelectorIndex(const std::string& path) {
+  return std::make_shared<HybridSelectorIndex>(path);
+}
+
+std::shared_ptr<Promise<double>> HybridNativeUtils::buildSelectorIndex(const std::vector<std::string>& signatures, const std::string& path) {
+  // Hashing and sorting a million signatures takes a while; keep it off the JS thread
+  return Promise<double>::async([signatures, path]() {
+    return static_cast<double>(HybridSelectorIndex::build(signatures, path));
+  });
+}
+
+std::string HybridNativeUtils::getTemporaryDirectory() {
+  return temporaryDirectory();
+}
+
+std::shared_ptr<HybridDomainIndexSpec> HybridNativeUtils::openDomainIndex(const std::string& path) {
+  return std::make_shared<HybridDomainIndex>(path);
+}
+
+std::shared_ptr<Promise<double>> HybridNativeUtils::buildDomainIndex(const std::vector<std::string>& domains, const std::string& path) {
+  // Phishing lists have hundreds of thousands of entries; hash them off the JS thread
+  return Promise<double>::async([domains, path]() {
+    return static_cast<double>(HybridDomainIndex::build(domains, path));
+  });
+}
+
+std::shared_ptr<ArrayBuffer> HybridNativeUtils::namehash(const std::string& name) {
+  auto result = ArrayBuffer::allocate(32);
+  ensNamehash(name, static_cast<uint8_t*>(result->data()));
+  return result;
+}
+
+std::shared_ptr<ArrayBuffer> HybridNativeUtils::namehashMany(const std::vector<std::string>& names) {
+  auto result = ArrayBuffer::allocate(names.size() * 32);
+  ensNamehashMany(names, static_cast<uint8_t*>(result->data()));
+  return result;
+}
+
+// Keccak-256 rounds applied to each leaf; unhashed leaves must already be hashes
+static int merkleLeafRounds(MerkleLeafHash leafHash, double leafSize) {
+  switch (leafHash) {
+    case MerkleLeafHash::NONE:
+      if (leafSize != 32) {
+        throw std::runtime_error("Unhashed Merkle leaves must be 32 bytes");
+      }
+      return 0;
+    case MerkleLeafHash::KECCAK256: return 1;
+    case MerkleLeafHash::DOUBLEKECCAK256: return 2;
+  }
+  throw std::runtime_error("Unknown Merkle leaf hash");
+}
+
+static void hashMerkleLeaves(const uint8_t* leaves, size_t count, size_t leafSize, int rounds, uint8_t* output) {
+  if (rounds == 0) {
+    std::copy(leaves, leaves + count * 32, output);
+  } else {
+    merkleHashLeaves(leaves, count, leafSize, rounds, output);
+  }
+}
+
+std::shared_ptr<Promise<std::shared_ptr<HybridMerkleTreeSpec>>> HybridNativeUtils::buildMerkleTree(const std::shared_ptr<ArrayBuffer>& leaves, double leafSize, MerkleLeafHash leafHash, bool sortLeaves) {
+  size_t count = packedItemCount(leaves, leafSize, "Leaf");
+  int rounds = merkleLeafRounds(leafHash, leafSize);
+
+  // Copy the JS-owned leaves so they can be read from a worker thread
+  auto leafCopy = std::make_shared<std::vector<uint8_t>>(static_cast<const uint8_t*>(leaves->data()),
+                                                         static_cast<const uint8_t*>(leaves->data()) + leaves->size());
+
+  return Promise<std::shared_ptr<HybridMerkleTreeSpec>>::async([leafCopy, count, size = static_cast<size_t>(leafSize), rounds, sortLeaves]() {
+    std::vector<uint8_t> leafHashes(count * 32);
+    hashMerkleLeaves(leafCopy->data(), count, size, rounds, leafHashes.data());
+    return std::static_pointer_cast<HybridMerkleTreeSpec>(std::make_shared<HybridMerkleTree>(std::move(leafHashes), sortLeaves));
+  });
+}
+
+std::shared_ptr<ArrayBuffer> HybridNativeUtils::merkleVerifyMany(const std::shared_ptr<ArrayBuffer>& root, const std::shared_ptr<ArrayBuffer>& leaves, double leafSize, MerkleLeafHash leafHash, const std::shared_ptr<ArrayBuffer>& proofs, const std::vector<double>& proofLengths) {
+  if (root->size() != 32) {
+    throw std::runtime_error("Merkle root must be 32 bytes");
+  }
+  size_t count = packedItemCount(leaves, leafSize, "Leaf");
+  int rounds = merkleLeafRounds(leafHash, leafSize);
+  if (proofLengths.size() != count) {
+    throw std::runtime_error("Expected " + std::to_string(count) + " proof lengths, got " + std::to_string(proofLengths.size()));
+  }
+
+  // Locate every proof up front so a bad length fails before any hashing
+  std::vector<size_t> proofOffsets(count + 1, 0);
+  for (size_t i = 0; i < count; i++) {
+    double length = proofLengths[i];
+    if (!(length >= 0 && length <= 256 && std::floor(length) == length)) {
+      throw std::runtime_error("Invalid proof length at index " + std::to_string(i));
+    }
+    proofOffsets[i + 1] = proofOffsets[i] + static_cast<size_t>(length) * 32;
+  }
+  if (proofOffsets[count] != proofs->size()) {
+    throw std::runtime_error("Proofs must be " + std::to_string(proofOffsets[count]) + " bytes, got " +
+                             std::to_string(proofs->size()));
+  }
+
+  std::vector<uint8_t> leafHashes(count * 32);
+  hashMerkleLeaves(static_cast<const uint8_t*>(leaves->data()), count, static_cast<size_t>(leafSize), rounds, leafHashes.data());
+
+  auto result = ArrayBuffer::allocate((count + 7) / 8);
+  const uint8_t* rootBytes = static_cast<const uint8_t*>(root->data());
+  const uint8_t* proofBytes = static_cast<const uint8_t*>(proofs->data());
+  parallelBitmap(count, 64, static_cast<uint8_t*>(result->data()), [&](size_t i) {
+    size_t proofLength = (proofOffsets[i + 1] - proofOffsets[i]) / 32;
+    return merkleVerify(rootBytes, leafHashes.data() + i * 32, proofBytes + proofOffsets[i], proofLength);
+  });
+  return result;
+}
+
+static std::vector<MptProofNode> proofNodes(const std::vector<std::shared_ptr<ArrayBuffer>>& buffers, size_t begin, size_t end) {
+  std::vector<MptProofNode> nodes;
+  nodes.reserve(end - begin);
+  for (size_t i = begin; i < end; i++) {
+    nodes.push_back({static_cast<const uint8_t*>(buffers[i]->data()), buffers[i]->size()});
+  }
+  return nodes;
+}
+
+// keccak256 of empty code, the code hash of accounts without code
+static const uint8_t kEmptyCodeHash[32] = {0xc5, 0xd2, 0x46, 0x01, 0x86, 0xf7, 0x23, 0x3c, 0x92, 0x7e, 0x7d,
+                                           0xb2, 0xdc, 0xc7, 0x03, 0xc0, 0xe5, 0x00, 0xb6, 0x53, 0xca, 0x82,
+                                           0x27, 0x3b, 0x7b, 0xfa, 0xd8, 0x04, 0x5d, 0x85, 0xa4, 0x70};
+
+// A big-endian integer of at most maxSize bytes without leading zeros
+static const RlpItem& checkRlpInteger(const RlpItem& item, size_t maxSize, const char* what) {
+  if (item.isList || item.size > maxSize || (item.size > 0 && item.data[0] == 0)) {
+    throw std::runtime_error(std::string("Invalid account ") + what);
+  }
+  return item;
+}
+
+VerifiedAccount HybridNativeUtils::verifyStorageProofs(const std::shared_ptr<ArrayBuffer>& stateRoot, const std::shared_ptr<ArrayBuffer>& address, const std::vector<std::shared_ptr<ArrayBuffer>>& accountProof, const std::shared_ptr<ArrayBuffer>& slots, const std::vector<std::shared_ptr<ArrayBuffer>>& storageProofs, const std::vector<double>& storageProofLengths) {
+  if (stateRoot->size() != 32) {
+    throw std::runtime_error("State root must be 32 bytes");
+  }
+  if (address->size() != 20) {
+    throw std::runtime_error("Address must be 20 bytes");
+  }
+  size_t slotCount = packedItemCount(slots, 32, "Slot");
+  if (storageProofLengths.size() != slotCount) {
+    throw std::runtime_error("Expected " + std::to_string(slotCount) + " storage proof lengths, got " +
+                             std::to_string(storageProofLengths.size()));
+  }
+  // Lengths count nodes, so the batch size is the number of nodes given
+  std::vector<size_t> proofOffsets = packedOffsets(storageProofLengths, storageProofs.size(), "storage proof");
+
+  // The account proof is walked once for all slots
+  uint8_t path[32];
+  keccak256(static_cast<const uint8_t*>(address->data()), 20, path);
+  std::optional<RlpItem> account =
+      mptVerifyProof(static_cast<const uint8_t*>(stateRoot->data()), path, proofNodes(accountProof, 0, accountProof.size()));
+
+  std::shared_ptr<ArrayBuffer> nonce = ArrayBuffer::allocate(0);
+  std::shared_ptr<ArrayBuffer> balance = ArrayBuffer::allocate(0);
+  std::shared_ptr<ArrayBuffer> storageRoot = ArrayBuffer::copy(kEmptyTrieRoot, 32);
+  std::shared_ptr<ArrayBuffer> codeHash = ArrayBuffer::copy(kEmptyCodeHash, 32);
+  if (account) {
+    // The leaf value is the RLP string wrapping rlp([nonce, balance, storageRoot, codeHash])
+    if (account->isList) {
+      throw std::runtime_error("Invalid account in state trie");
+    }
+    std::vector<RlpItem> fields = rlpListItems(rlpDecode(account->data, account->size));
+    if (fields.size() != 4 || fields[2].isList || fields[2].size != 32 || fields[3].isList || fields[3].size != 32) {
+      throw std::runtime_error("Invalid account in state trie");
+    }
+    const RlpItem& nonceItem = checkRlpInteger(fields[0], 8, "nonce");
+    const RlpItem& balanceItem = checkRlpInteger(fields[1], 32, "balance");
+    nonce = ArrayBuffer::copy(nonceItem.data, nonceItem.size);
+    balance = ArrayBuffer::copy(balanceItem.data, balanceItem.size);
+    storageRoot = ArrayBuffer::copy(fields[2].data, 32);
+    codeHash = ArrayBuffer::copy(fields[3].data, 32);
+  }
+
+  // Each slot is checked on its own, so one bad proof does not fail the batch
+  auto values = ArrayBuffer::allocate(slotCount * 32);
+  auto valid = ArrayBuffer::allocate((slotCount + 7) / 8);
+  uint8_t* valueBytes = static_cast<uint8_t*>(values->data());
+  uint8_t* validBits = static_cast<uint8_t*>(valid->data());
+  std::fill(valueBytes, valueBytes + values->size(), 0);
+  std::fill(validBits, validBits + valid->size(), 0);
+  const uint8_t* slotBytes = static_cast<const uint8_t*>(slots->data());
+  const uint8_t* root = static_cast<const uint8_t*>(storageRoot->data());
+  for (size_t i = 0; i < slotCount; i++) {
+    try {
+      keccak256(slotBytes + i * 32, 32, path);
+      std::optional<RlpItem> stored = mptVerifyProof(root, path, proofNodes(storageProofs, proofOffsets[i], proofOffsets[i + 1]));
+      if (stored) {
+        // Values are stored as RLP strings of the trimmed big-endian word
+        if (stored->isList) {
+          continue;
+        }
+        RlpItem word = rlpDecode(stored->data, stored->size);
+        if (word.isList || word.size == 0 || word.size > 32 || word.data[0] == 0) {
+          continue;
+        }
+        std::copy(word.data, word.data + word.size, valueBytes + i * 32 + 32 - word.size);
+      }
+      validBits[i / 8] |= static_cast<uint8_t>(1u << (i % 8));
+    } catch (const std::exception&) {
+      // Leave the slot zeroed and marked invalid
+    }
+  }
+
+  return VerifiedAccount(account.has_value(), nonce, balance, storageRoot, codeHash, values, valid);
+}
+
+std::shared_ptr<ArrayBuffer> HybridNativeUtils::orderedTrieRoot(const std::shared_ptr<ArrayBuffer>& items, const std::vector<double>& itemLengths) {
+  std::vector<size_t> offsets = packedOffsets(itemLengths, items->size(), "item");
+
+  auto result = ArrayBuffer::allocate(32);
+  mptOrderedTrieRoot(static_cast<const uint8_t*>(items->data()), offsets, itemLengths.size(), static_cast<uint8_t*>(result->data()));
+  return result;
+}
+
+// SSZ limits and lengths are uint64; JS numbers are exact up to 2^53
+static uint64_t sszInteger(double value, const char* what) {
+  if (!(value >= 0 && value <= 9007199254740992.0 && std::floor(value) == value)) {
+    throw std::runtime_error(std::string(what) + " must be a non-negative integer of at most 2^53");
+  }
+  return static_cast<uint64_t>(value);
+}
+
+static SszContainerType sszContainerType(SszContainer type) {
+  switch (type) {
+    case SszContainer::VALIDATOR: return SszContainerType::Validator;
+    case SszContainer::DEPOSITMESSAGE: return SszContainerType::DepositMessage;
+    case SszContainer::DEPOSITDATA: return SszContainerType::DepositData;
+  }
+  throw std::runtime_error("Unknown SSZ container type");
+}
+
+std::shared_ptr<ArrayBuffer> HybridNativeUtils::sszMerkleize(const std::shared_ptr<ArrayBuffer>& data, double limit) {
+  uint64_t chunkLimit = sszInteger(limit, "SSZ chunk limit");
+  auto result = ArrayBuffer::allocate(32);
+  metamask_nativeutils::sszMerkleize(static_cast<const uint8_t*>(data->data()), data->size(), chunkLimit,
+                                     static_cast<uint8_t*>(result->data()));
+  return result;
+}
+
+std::shared_ptr<ArrayBuffer> HybridNativeUtils::sszMixInLength(const std::shared_ptr<ArrayBuffer>& root, double length) {
+  if (root->size() != 32) {
+    throw std::runtime_error("SSZ root must be 32 bytes");
+  }
+  auto result = ArrayBuffer::allocate(32);
+  metamask_nativeutils::sszMixInLength(static_cast<const uint8_t*>(root->data()), sszInteger(length, "SSZ list length"),
+                                       static_cast<uint8_t*>(result->data()));
+  return result;
+}
+
+std::shared_ptr<ArrayBuffer> HybridNativeUtils::sszContainerRoots(SszContainer type, const std::shared_ptr<ArrayBuffer>& items) {
+  SszContainerType containerType = sszContainerType(type);
+  size_t count = packedItemCount(items, static_cast<double>(sszContainerSize(containerType)), "Container");
+  auto result = ArrayBuffer::allocate(count * 32);
+  metamask_nativeutils::sszContainerRoots(containerType, static_cast<const uint8_t*>(items->data()), count,
+                                          static_cast<uint8_t*>(result->data()));
+  return result;
+}
+
+std::shared_ptr<Promise<std::shared_ptr<ArrayBuffer>>> HybridNativeUtils::sszContainerListRoot(SszContainer type, const std::shared_ptr<ArrayBuffer>& items, double limit) {
+  SszContainerType containerType = sszContainerType(type);
+  size_t count = packedItemCount(items, static_cast<double>(sszContainerSize(containerType)), "Container");
+  uint64_t listLimit = sszInteger(limit, "SSZ list limit");
+
+  // Copy the JS-owned items so they can be read from a worker thread
+  auto itemCopy = std::make_shared<std::vector<uint8_t>>(static_cast<const uint8_t*>(items->data()),
+                                                         static_cast<const uint8_t*>(items->data()) + items->size());
+
+  return Promise<std::shared_ptr<ArrayBuffer>>::async([itemCopy, containerType, count, listLimit]() {
+    auto result = ArrayBuffer::allocate(32);
+    metamask_nativeutils::sszContainerListRoot(containerType, itemCopy->data(), count, listLimit,
+                                               static_cast<uint8_t*>(result->data()));
+    return result;
+  });
+}
+
+double HybridNativeUtils::trimMemory(MemoryTrimLevel level) {
+  TrimLevel trimLevel = TrimLevel::Critical;
+  switch (level) {
+    case MemoryTrimLevel::MODERATE: trimLevel = TrimLevel::Moderate; break;
+    case MemoryTrimLevel::LOW: trimLevel = TrimLevel::Low; break;
+    case MemoryTrimLevel::CRITICAL: trimLevel = TrimLevel::Critical; break;
+  }
+
+  return static_cast<double>(MemoryTrimRegistry::shared().trim(trimLevel));
+}
+
+std::vector<CacheUsage> HybridNativeUtils::getCacheUsage() {
+  std::vector<CacheUsage> result;
+  for (const auto& cache : MemoryTrimRegistry::shared().usage()) {
+    result.emplace_back(cache.name, static_cast<double>(cache.bytes), static_cast<double>(cache.budgetBytes));
+  }
+  return result;
+}
+
+double HybridNativeUtils::setCacheBudget(const std::string& name, double budgetBytes) {
+  if (!(budgetBytes >= 0 && budgetBytes <= 9007199254740992.0 && std::floor(budgetBytes) == budgetBytes)) {
+    throw std::runtime_error("Cache budget must be a non-negative integer");
+  }
+  return static_cast<double>(MemoryTrimRegistry::shared().setBudget(name, static_cast<size_t>(budgetBytes)));
+}
+
 double HybridNativeUtils::multiply(double a, double b) {
   return a * b;
 }
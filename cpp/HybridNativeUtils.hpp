@@ -6,7 +6,7 @@ namespace margelo::nitro::metamask_nativeutils {
 
 class HybridNativeUtils : public HybridNativeUtilsSpec {
 public:
-  HybridNativeUtils() : HybridObject(TAG) {}
+  HybridNativeUtils();
 
 public:
   double multiply(double a, double b) override;
@@ -14,9 +14,62 @@ public:
   std::shared_ptr<ArrayBuffer> toPublicKeyFromBytes(const std::shared_ptr<ArrayBuffer>& privateKey, bool isCompressed) override;
   std::shared_ptr<ArrayBuffer> getPublicKeyEd25519(const std::string& privateKey) override;
   std::shared_ptr<ArrayBuffer> getPublicKeyEd25519FromBytes(const std::shared_ptr<ArrayBuffer>& privateKey) override;
+  std::shared_ptr<HybridEd25519KeyHandleSpec> createEd25519KeyHandle(const std::shared_ptr<ArrayBuffer>& privateKey) override;
+  std::shared_ptr<ArrayBuffer> ed25519IsOnCurve(const std::shared_ptr<ArrayBuffer>& points) override;
+  Ed25519Points ed25519DecompressPoints(const std::shared_ptr<ArrayBuffer>& points) override;
+  std::shared_ptr<HybridKeyringSpec> createKeyring() override;
+  std::vector<std::string> serializeExtendedKeys(const std::shared_ptr<ArrayBuffer>& keys) override;
+  ExtendedKeys parseExtendedKeys(const std::vector<std::string>& encoded) override;
+  std::string bip322Sign(const std::shared_ptr<ArrayBuffer>& privateKey, const std::string& address,
+                         const std::shared_ptr<ArrayBuffer>& message) override;
+  bool bip322Verify(const std::string& address, const std::shared_ptr<ArrayBuffer>& message, const std::string& signature) override;
+  std::shared_ptr<ArrayBuffer> bip322VerifyBatch(const std::vector<std::string>& addresses, const std::shared_ptr<ArrayBuffer>& messages,
+                                                 const std::vector<double>& messageLengths,
+                                                 const std::vector<std::string>& signatures) override;
+  std::shared_ptr<ArrayBuffer> compileSolanaMessage(const std::vector<std::string>& addresses,
+                                                    const std::shared_ptr<ArrayBuffer>& message) override;
+  TokenAccounts decodeTokenAccounts(const std::shared_ptr<ArrayBuffer>& data, const std::vector<double>& dataLengths,
+                                    const TokenAccountLayout& layout, const std::vector<double>& decimals) override;
+  TokenAccounts decodeTokenAccountsBase64(const std::vector<std::string>& data, const TokenAccountLayout& layout,
+                                          const std::vector<double>& decimals) override;
   std::shared_ptr<ArrayBuffer> keccak256FromBytes(const std::shared_ptr<ArrayBuffer>& data) override;
+  std::shared_ptr<ArrayBuffer> hash(HashAlgorithm algorithm, const std::shared_ptr<ArrayBuffer>& data) override;
+  std::shared_ptr<ArrayBuffer> hashMany(HashAlgorithm algorithm, const std::shared_ptr<ArrayBuffer>& items, const std::vector<double>& itemLengths) override;
+  std::shared_ptr<HybridHasherSpec> createHasher(HashAlgorithm algorithm) override;
   std::shared_ptr<ArrayBuffer> pubToAddress(const std::shared_ptr<ArrayBuffer>& pubKey, bool sanitize = false) override;
   std::shared_ptr<ArrayBuffer> hmacSha512(const std::shared_ptr<ArrayBuffer>& key, const std::shared_ptr<ArrayBuffer>& data) override;
+  std::shared_ptr<Promise<std::shared_ptr<ArrayBuffer>>> keccak256Async(const std::shared_ptr<ArrayBuffer>& data) override;
+  std::shared_ptr<Promise<std::shared_ptr<ArrayBuffer>>> hmacSha512Async(const std::shared_ptr<ArrayBuffer>& key, const std::shared_ptr<ArrayBuffer>& data) override;
+  std::shared_ptr<Promise<std::shared_ptr<ArrayBuffer>>> toPublicKeysAsync(const std::shared_ptr<ArrayBuffer>& privateKeys, bool isCompressed) override;
+  std::shared_ptr<Promise<std::shared_ptr<ArrayBuffer>>> getPublicKeysEd25519Async(const std::shared_ptr<ArrayBuffer>& privateKeys) override;
+  std::shared_ptr<Promise<double>> toPublicKeysStreaming(const std::shared_ptr<ArrayBuffer>& privateKeys, bool isCompressed, double chunkSize, const std::function<std::shared_ptr<Promise<bool>>(double /* startIndex */, const std::shared_ptr<ArrayBuffer>& /* publicKeys */)>& onChunk) override;
+  std::shared_ptr<Promise<double>> getPublicKeysEd25519Streaming(const std::shared_ptr<ArrayBuffer>& privateKeys, double chunkSize, const std::function<std::shared_ptr<Promise<bool>>(double /* startIndex */, const std::shared_ptr<ArrayBuffer>& /* publicKeys */)>& onChunk) override;
+  std::vector<DispatchThreshold> getDispatchThresholds() override;
+  std::shared_ptr<HybridPipelineSpec> createPipeline(const std::vector<PipelineStage>& stages, double inputSize) override;
+  std::shared_ptr<HybridSubmissionRingSpec> createSubmissionRing(double capacity, double dataSize) override;
+  std::shared_ptr<HybridAddressSetSpec> createAddressSet(double capacityHint) override;
+  std::shared_ptr<HybridLogFilterSpec> createLogFilter(const std::vector<std::string>& events) override;
+  void bloomAdd(const std::shared_ptr<ArrayBuffer>& bloom, const std::shared_ptr<ArrayBuffer>& items, double itemSize) override;
+  std::shared_ptr<ArrayBuffer> bloomBuild(const std::shared_ptr<ArrayBuffer>& items, double itemSize) override;
+  std::shared_ptr<ArrayBuffer> bloomMatches(const std::shared_ptr<ArrayBuffer>& blooms, const std::shared_ptr<ArrayBuffer>& queries, double querySize) override;
+  std::shared_ptr<HybridSelectorIndexSpec> openSelectorIndex(const std::string& path) override;
+  std::shared_ptr<Promise<double>> buildSelectorIndex(const std::vector<std::string>& signatures, const std::string& path) override;
+  std::string getTemporaryDirectory() override;
+  std::shared_ptr<HybridDomainIndexSpec> openDomainIndex(const std::string& path) override;
+  std::shared_ptr<Promise<double>> buildDomainIndex(const std::vector<std::string>& domains, const std::string& path) override;
+  std::shared_ptr<ArrayBuffer> namehash(const std::string& name) override;
+  std::shared_ptr<ArrayBuffer> namehashMany(const std::vector<std::string>& names) override;
+  std::shared_ptr<Promise<std::shared_ptr<HybridMerkleTreeSpec>>> buildMerkleTree(const std::shared_ptr<ArrayBuffer>& leaves, double leafSize, MerkleLeafHash leafHash, bool sortLeaves) override;
+  std::shared_ptr<ArrayBuffer> merkleVerifyMany(const std::shared_ptr<ArrayBuffer>& root, const std::shared_ptr<ArrayBuffer>& leaves, double leafSize, MerkleLeafHash leafHash, const std::shared_ptr<ArrayBuffer>& proofs, const std::vector<double>& proofLengths) override;
+  VerifiedAccount verifyStorageProofs(const std::shared_ptr<ArrayBuffer>& stateRoot, const std::shared_ptr<ArrayBuffer>& address, const std::vector<std::shared_ptr<ArrayBuffer>>& accountProof, const std::shared_ptr<ArrayBuffer>& slots, const std::vector<std::shared_ptr<ArrayBuffer>>& storageProofs, const std::vector<double>& storageProofLengths) override;
+  std::shared_ptr<ArrayBuffer> orderedTrieRoot(const std::shared_ptr<ArrayBuffer>& items, const std::vector<double>& itemLengths) override;
+  std::shared_ptr<ArrayBuffer> sszMerkleize(const std::shared_ptr<ArrayBuffer>& data, double limit) override;
+  std::shared_ptr<ArrayBuffer> sszMixInLength(const std::shared_ptr<ArrayBuffer>& root, double length) override;
+  std::shared_ptr<ArrayBuffer> sszContainerRoots(SszContainer type, const std::shared_ptr<ArrayBuffer>& items) override;
+  std::shared_ptr<Promise<std::shared_ptr<ArrayBuffer>>> sszContainerListRoot(SszContainer type, const std::shared_ptr<ArrayBuffer>& items, double limit) override;
+  double trimMemory(MemoryTrimLevel level) override;
+  std::vector<CacheUsage> getCacheUsage() override;
+  double setCacheBudget(const std::string& name, double budgetBytes) override;
 };
 
 } // namespace margelo::nitro::metamask_nativeutils
@@ -0,0 +1,256 @@
+#include "HybridPipeline.hpp"
+#include "secp256k1_utils.hpp"
+#include "keccak_utils.hpp"
+#include "ed25519.hpp"
+#include "hex_utils.hpp"
+#include "secure_arena.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace margelo::nitro::metamask_nativeutils {
+
+// Scratch budget per intermediate buffer; two of them stay resident in L1/L2
+static constexpr size_t kChunkBytes = 16 * 1024;
+
+static const char* stageName(PipelineStage stage) {
+  switch (stage) {
+    case PipelineStage::HEXDECODE: return "hexDecode";
+    case PipelineStage::HEXENCODE: return "hexEncode";
+    case PipelineStage::SECKEYVERIFY: return "seckeyVerify";
+    case PipelineStage::SECP256K1PUBLICKEY: return "secp256k1PublicKey";
+    case PipelineStage::SECP256K1PUBLICKEYCOMPRESSED: return "secp256k1PublicKeyCompressed";
+    case PipelineStage::STRIPPREFIX: return "stripPrefix";
+    case PipelineStage::KECCAK256: return "keccak256";
+    case PipelineStage::LAST20: return "last20";
+    case PipelineStage::CHECKSUMHEX: return "checksumHex";
+    case PipelineStage::ED25519PUBLICKEY: return "ed25519PublicKey";
+  }
+  return "unknown";
+}
+
+static void requireInputSize(PipelineStage stage, size_t inputSize, size_t expected) {
+  if (inputSize != expected) {
+    throw std::runtime_error(std::string("Stage '") + stageName(stage) + "' expects " + std::to_string(expected) +
+                             "-byte items but receives " + std::to_string(inputSize) + " bytes");
+  }
+}
+
+// Resolve the output size of a stage for a given input size, rejecting chains that cannot work
+static size_t stageOutputSize(PipelineStage stage, size_t inputSize) {
+  switch (stage) {
+    case PipelineStage::HEXDECODE:
+      if (inputSize == 0 || inputSize % 2 != 0) {
+        throw std::runtime_error("Stage 'hexDecode' expects an even number of hex characters");
+      }
+      return inputSize / 2;
+    case PipelineStage::HEXENCODE:
+      return inputSize * 2;
+    case PipelineStage::SECKEYVERIFY:
+      requireInputSize(stage, inputSize, 32);
+      return 32;
+    case PipelineStage::SECP256K1PUBLICKEY:
+      requireInputSize(stage, inputSize, 32);
+      return 65;
+    case PipelineStage::SECP256K1PUBLICKEYCOMPRESSED:
+      requireInputSize(stage, inputSize, 32);
+      return 33;
+    case PipelineStage::STRIPPREFIX:
+      if (inputSize < 2) {
+        throw std::runtime_error("Stage 'stripPrefix' expects items of at least 2 bytes");
+      }
+      return inputSize - 1;
+    case PipelineStage::KECCAK256:
+      return 32;
+    case PipelineStage::LAST20:
+      if (inputSize < 20) {
+        throw std::runtime_error("Stage 'last20' expects items of at least 20 bytes");
+      }
+      return 20;
+    case PipelineStage::CHECKSUMHEX:
+      requireInputSize(stage, inputSize, 20);
+      return 40;
+    case PipelineStage::ED25519PUBLICKEY:
+      requireInputSize(stage, inputSize, 32);
+      return 32;
+  }
+  throw std::runtime_error("Unknown pipeline stage");
+}
+
+// EIP-55 mixed-case checksum encoding of a 20-byte address (40 characters, no prefix)
+static void checksumHex(const uint8_t* address, uint8_t* output) {
+  char* hex = reinterpret_cast<char*>(output);
+  bytesToHex(address, 20, hex);
+
+  uint8_t hash[32];
+  keccak256(output, 40, hash);
+
+  for (size_t i = 0; i < 40; i++) {
+    uint8_t nibble = (i % 2 == 0) ? (hash[i / 2] >> 4) : (hash[i / 2] & 0x0f);
+    if (hex[i] >= 'a' && nibble >= 8) {
+      hex[i] = static_cast<char>(hex[i] - 'a' + 'A');
+    }
+  }
+}
+
+// Run one stage over `items` packed items. Each case is its own loop so the
+// stage dispatch happens once per chunk rather than once per item.
+// Errors name the absolute item index (`baseIndex` + position in the chunk).
+static void runStage(PipelineStage stage, size_t inSize, size_t outSize, const uint8_t* in, uint8_t* out, size_t items, size_t baseIndex) {
+  switch (stage) {
+    case PipelineStage::HEXDECODE:
+      for (size_t i = 0; i < items; i++) {
+        try {
+          hexToBytes(reinterpret_cast<const char*>(in + i * inSize), out + i * outSize, outSize);
+        } catch (const std::runtime_error& e) {
+          throw std::runtime_error(std::string(e.what()) + " at index " + std::to_string(baseIndex + i));
+        }
+      }
+      break;
+    case PipelineStage::HEXENCODE:
+      for (size_t i = 0; i < items; i++) {
+        bytesToHex(in + i * inSize, inSize, reinterpret_cast<char*>(out + i * outSize));
+      }
+      break;
+    case PipelineStage::SECKEYVERIFY: {
+      const secp256k1_context* ctx = secp256k1Context();
+      for (size_t i = 0; i < items; i++) {
+        if (!secp256k1_ec_seckey_verify(ctx, in + i * 32)) {
+          throw std::runtime_error("Private key is invalid at index " + std::to_string(baseIndex + i));
+        }
+      }
+      std::copy(in, in + items * 32, out);
+      break;
+    }
+    case PipelineStage::SECP256K1PUBLICKEY:
+    case PipelineStage::SECP256K1PUBLICKEYCOMPRESSED: {
+      bool isCompressed = stage == PipelineStage::SECP256K1PUBLICKEYCOMPRESSED;
+      for (size_t i = 0; i < items; i++) {
+        try {
+          derivePublicKeyInto(in + i * 32, out + i * outSize, isCompressed);
+        } catch (const std::runtime_error& e) {
+          throw std::runtime_error(std::string(e.what()) + " at index " + std::to_string(baseIndex + i));
+        }
+      }
+      break;
+    }
+    case PipelineStage::STRIPPREFIX:
+      for (size_t i = 0; i < items; i++) {
+        std::copy(in + i * inSize + 1, in + (i + 1) * inSize, out + i * outSize);
+      }
+      break;
+    case PipelineStage::KECCAK256:
+      for (size_t i = 0; i < items; i++) {
+        keccak256(in + i * inSize, inSize, out + i * 32);
+      }
+      break;
+    case PipelineStage::LAST20:
+      for (size_t i = 0; i < items; i++) {
+        std::copy(in + (i + 1) * inSize - 20, in + (i + 1) * inSize, out + i * 20);
+      }
+      break;
+    case PipelineStage::CHECKSUMHEX:
+      for (size_t i = 0; i < items; i++) {
+        checksumHex(in + i * 20, out + i * 40);
+      }
+      break;
+    case PipelineStage::ED25519PUBLICKEY:
+      for (size_t i = 0; i < items; i++) {
+        ed25519PublicKey(in + i * 32, out + i * 32);
+      }
+      break;
+  }
+}
+
+HybridPipeline::HybridPipeline(const std::vector<PipelineStage>& stages, size_t inputSize) : HybridObject(TAG) {
+  if (stages.empty()) {
+    throw std::runtime_error("Pipeline must have at least one stage");
+  }
+  if (inputSize == 0) {
+    throw std::runtime_error("Pipeline input size must be positive");
+  }
+
+  auto plan = std::make_shared<Plan>();
+  plan->inputSize = inputSize;
+
+  size_t size = inputSize;
+  size_t maxWidth = inputSize;
+  for (PipelineStage stage : stages) {
+    size_t outputSize = stageOutputSize(stage, size);
+    plan->stages.push_back({stage, size, outputSize});
+    maxWidth = std::max(maxWidth, outputSize);
+    size = outputSize;
+  }
+
+  plan->outputSize = size;
+  plan->chunkItems = std::max<size_t>(1, kChunkBytes / maxWidth);
+  plan->scratchSize = plan->chunkItems * maxWidth;
+  plan_ = plan;
+}
+
+void HybridPipeline::Plan::run(const uint8_t* inputs, size_t count, uint8_t* outputs) const {
+  // Ping-pong buffers for intermediate results, which may be private keys;
+  // only needed between stages
+  SecureBuffer scratch[2];
+  if (stages.size() > 1) {
+    scratch[0] = SecureBuffer(scratchSize);
+    scratch[1] = SecureBuffer(scratchSize);
+  }
+
+  for (size_t base = 0; base < count; base += chunkItems) {
+    size_t items = std::min(chunkItems, count - base);
+    const uint8_t* source = inputs + base * inputSize;
+
+    for (size_t s = 0; s < stages.size(); s++) {
+      const auto& stage = stages[s];
+      bool isLast = s + 1 == stages.size();
+      uint8_t* destination = isLast ? outputs + base * outputSize : scratch[s % 2].data();
+
+      try {
+        runStage(stage.stage, stage.inputSize, stage.outputSize, source, destination, items, base);
+      } catch (const std::runtime_error& e) {
+        throw std::runtime_error(std::string("Pipeline stage '") + stageName(stage.stage) + "' failed: " + e.what());
+      }
+      source = destination;
+    }
+  }
+}
+
+size_t HybridPipeline::itemCount(const std::shared_ptr<ArrayBuffer>& inputs) const {
+  if (inputs->size() % plan_->inputSize != 0) {
+    throw std::runtime_error("Pipeline input must be a multiple of " + std::to_string(plan_->inputSize) + " bytes");
+  }
+  return inputs->size() / plan_->inputSize;
+}
+
+double HybridPipeline::getInputSize() {
+  return static_cast<double>(plan_->inputSize);
+}
+
+double HybridPipeline::getOutputSize() {
+  return static_cast<double>(plan_->outputSize);
+}
+
+std::shared_ptr<ArrayBuffer> HybridPipeline::run(const std::shared_ptr<ArrayBuffer>& inputs) {
+  size_t count = itemCount(inputs);
+
+  auto result = ArrayBuffer::allocate(count * plan_->outputSize);
+  plan_->run(static_cast<const uint8_t*>(inputs->data()), count, static_cast<uint8_t*>(result->data()));
+
+  return result;
+}
+
+std::shared_ptr<Promise<std::shared_ptr<ArrayBuffer>>> HybridPipeline::runAsync(const std::shared_ptr<ArrayBuffer>& inputs) {
+  size_t count = itemCount(inputs);
+
+  // Copy the JS-owned input so it can be read from a worker thread
+  auto inputCopy = std::make_shared<const SecureBuffer>(static_cast<const uint8_t*>(inputs->data()), inputs->size());
+
+  return Promise<std::shared_ptr<ArrayBuffer>>::async([plan = plan_, inputCopy, count]() {
+    auto result = ArrayBuffer::allocate(count * plan->outputSize);
+    plan->run(inputCopy->data(), count, static_cast<uint8_t*>(result->data()));
+    return result;
+  });
+}
+
+} // namespace margelo::nitro::metamask_nativeutils
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "HybridPipelineSpec.hpp"
+#include <vector>
+
+namespace margelo::nitro::metamask_nativeutils {
+
+/**
+ * A chain of built-in stages compiled once and run over packed batches.
+ *
+ * Stage sizes are resolved at construction, so running a batch is a series
+ * of tight per-stage loops over cache-sized chunks of items. Intermediate
+ * results live in two reused scratch buffers instead of crossing JSI.
+ */
+class HybridPipeline : public HybridPipelineSpec {
+public:
+  HybridPipeline(const std::vector<PipelineStage>& stages, size_t inputSize);
+
+public:
+  double getInputSize() override;
+  double getOutputSize() override;
+  std::shared_ptr<ArrayBuffer> run(const std::shared_ptr<ArrayBuffer>& inputs) override;
+  std::shared_ptr<Promise<std::shared_ptr<ArrayBuffer>>> runAsync(const std::shared_ptr<ArrayBuffer>& inputs) override;
+
+private:
+  struct CompiledStage {
+    PipelineStage stage;
+    size_t inputSize;
+    size_t outputSize;
+  };
+
+  // Immutable once compiled; shared with async runs that may outlive the call
+  struct Plan {
+    std::vector<CompiledStage> stages;
+    size_t inputSize = 0;
+    size_t outputSize = 0;
+    size_t chunkItems = 0;
+    size_t scratchSize = 0;
+
+    void run(const uint8_t* inputs, size_t count, uint8_t* outputs) const;
+  };
+
+  size_t itemCount(const std::shared_ptr<ArrayBuffer>& inputs) const;
+
+  std::shared_ptr<const Plan> plan_;
+};
+
+} // namespace margelo::nitro::metamask_nativeutils
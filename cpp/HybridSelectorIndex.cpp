@@ -0,0 +1,129 @@
+#include "HybridSelectorIndex.hpp"
+#include "abi_signature.hpp"
+#include "keccak_utils.hpp"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+namespace margelo::nitro::metamask_nativeutils {
+
+static constexpr char kMagic[8] = {'S', 'E', 'L', 'I', 'D', 'X', '0', '1'};
+
+static uint32_t readU32(const uint8_t* p) {
+  // All supported targets are little-endian
+  uint32_t value;
+  std::memcpy(&value, p, sizeof(value));
+  return value;
+}
+
+static void appendU32(std::vector<uint8_t>& out, uint32_t value) {
+  uint8_t bytes[4];
+  std::memcpy(bytes, &value, sizeof(bytes));
+  out.insert(out.end(), bytes, bytes + 4);
+}
+
+static uint32_t selectorKey(const uint8_t* selector) {
+  return (static_cast<uint32_t>(selector[0]) << 24) | (static_cast<uint32_t>(selector[1]) << 16) |
+         (static_cast<uint32_t>(selector[2]) << 8) | selector[3];
+}
+
+HybridSelectorIndex::HybridSelectorIndex(const std::string& path) : HybridObject(TAG) {
+  file_ = MappedFile::open(path);
+  const uint8_t* base = file_->data();
+  size_t size = file_->size();
+
+  if (size < kHeaderSize || std::memcmp(base, kMagic, sizeof(kMagic)) != 0) {
+    throw std::runtime_error("'" + path + "' is not a selector index");
+  }
+  count_ = readU32(base + 8);
+  poolSize_ = readU32(base + 12);
+  // 64-bit arithmetic: counts come from the file and are untrusted
+  uint64_t expected = kHeaderSize + 4ull * count_ + 4ull * (count_ + 1) + poolSize_;
+  if (expected != size) {
+    throw std::runtime_error("Selector index '" + path + "' is truncated or corrupt");
+  }
+
+  // The mapping is page-aligned and every section starts at a multiple of 4
+  keys_ = reinterpret_cast<const uint32_t*>(base + kHeaderSize);
+  offsets_ = keys_ + count_;
+  pool_ = reinterpret_cast<const char*>(offsets_ + count_ + 1);
+}
+
+double HybridSelectorIndex::getSize() {
+  return static_cast<double>(count_);
+}
+
+std::vector<std::vector<std::string>> HybridSelectorIndex::lookup(const std::shared_ptr<ArrayBuffer>& selectors) {
+  if (selectors->size() % 4 != 0) {
+    throw std::runtime_error("Packed selectors must be a multiple of 4 bytes");
+  }
+  size_t count = selectors->size() / 4;
+  const uint8_t* input = static_cast<const uint8_t*>(selectors->data());
+
+  std::vector<std::vector<std::string>> result(count);
+  for (size_t i = 0; i < count; i++) {
+    uint32_t key = selectorKey(input + i * 4);
+    const uint32_t* entry = std::lower_bound(keys_, keys_ + count_, key);
+    for (; entry != keys_ + count_ && *entry == key; entry++) {
+      size_t index = static_cast<size_t>(entry - keys_);
+      uint32_t begin = offsets_[index], end = offsets_[index + 1];
+      if (begin > end || end > poolSize_) {
+        throw std::runtime_error("Selector index is corrupt at entry " + std::to_string(index));
+      }
+      result[i].emplace_back(pool_ + begin, end - begin);
+    }
+  }
+  return result;
+}
+
+size_t HybridSelectorIndex::build(const std::vector<std::string>& signatures, const std::string& path) {
+  std::vector<std::pair<uint32_t, std::string>> entries;
+  entries.reserve(signatures.size());
+  for (const auto& signature : signatures) {
+    std::string canonical;
+    try {
+      canonical = parseAbiSignature(signature).canonical;
+    } catch (const std::runtime_error&) {
+      continue;
+    }
+    uint8_t hash[32];
+    keccak256(reinterpret_cast<const uint8_t*>(canonical.data()), canonical.size(), hash);
+    entries.emplace_back(selectorKey(hash), std::move(canonical));
+  }
+
+  std::sort(entries.begin(), entries.end());
+  entries.erase(std::unique(entries.begin(), entries.end()), entries.end());
+
+  size_t poolSize = 0;
+  for (const auto& entry : entries) {
+    poolSize += entry.second.size();
+  }
+  if (poolSize > std::numeric_limits<uint32_t>::max()) {
+    throw std::runtime_error("Selector index string pool exceeds 4 GiB");
+  }
+
+  std::vector<uint8_t> file;
+  file.reserve(kHeaderSize + 8 * entries.size() + 4 + poolSize);
+  file.insert(file.end(), kMagic, kMagic + sizeof(kMagic));
+  appendU32(file, static_cast<uint32_t>(entries.size()));
+  appendU32(file, static_cast<uint32_t>(poolSize));
+  for (const auto& entry : entries) {
+    appendU32(file, entry.first);
+  }
+  uint32_t offset = 0;
+  for (const auto& entry : entries) {
+    appendU32(file, offset);
+    offset += static_cast<uint32_t>(entry.second.size());
+  }
+  appendU32(file, offset);
+  for (const auto& entry : entries) {
+    file.insert(file.end(), entry.second.begin(), entry.second.end());
+  }
+
+  writeFileAtomically(path, file.data(), file.size());
+  return entries.size();
+}
+
+} // namespace margelo::nitro::metamask_nativeutils
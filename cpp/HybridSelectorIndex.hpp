@@ -0,0 +1,54 @@
+#pragma once
+
+#include "HybridSelectorIndexSpec.hpp"
+#include "mapped_file.hpp"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace margelo::nitro::metamask_nativeutils {
+
+/**
+ * Read-only index from 4-byte function selectors to signatures, backed by a
+ * memory-mapped file so opening it parses nothing.
+ *
+ * File layout (integers are little-endian u32):
+ * - header (16 bytes): magic "SELIDX01", entry count, string pool size
+ * - keys: one selector per entry, as a big-endian number, sorted ascending;
+ *   colliding signatures are adjacent entries with the same key
+ * - offsets: count + 1 string pool offsets; entry i is [offsets[i], offsets[i + 1])
+ * - string pool: canonical signatures, UTF-8, back to back
+ */
+class HybridSelectorIndex : public HybridSelectorIndexSpec {
+public:
+  explicit HybridSelectorIndex(const std::string& path);
+
+public:
+  double getSize() override;
+  std::vector<std::vector<std::string>> lookup(const std::shared_ptr<ArrayBuffer>& selectors) override;
+
+public:
+  static constexpr size_t kHeaderSize = 16;
+
+  /**
+   * Build an index file from signatures. Signatures are canonicalized
+   * (names and `uint` aliases removed) before hashing; duplicates are stored
+   * once and signatures that cannot be parsed are skipped.
+   * @param signatures Human-readable function signatures
+   * @param path Absolute path of the index file, replaced atomically
+   * @return Number of signatures indexed
+   * @throws std::runtime_error if the index cannot be written
+   */
+  static size_t build(const std::vector<std::string>& signatures, const std::string& path);
+
+private:
+  std::shared_ptr<MappedFile> file_;
+  const uint32_t* keys_ = nullptr;
+  const uint32_t* offsets_ = nullptr;
+  const char* pool_ = nullptr;
+  size_t count_ = 0;
+  size_t poolSize_ = 0;
+};
+
+} // namespace margelo::nitro::metamask_nativeutils
@@ -0,0 +1,252 @@
+#include "HybridSubmissionRing.hpp"
+#include "secp256k1_utils.hpp"
+#include "keccak_utils.hpp"
+#include "ed25519.hpp"
+#include "secure_arena.hpp"
+#include "botan_conditional.h"
+#include <NitroModules/ThreadPool.hpp>
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace margelo::nitro::metamask_nativeutils {
+
+static constexpr size_t kMaxWorkers = 4;
+static constexpr std::align_val_t kBufferAlignment{64};
+
+// The shared buffer is plain memory on the JS side, so native stores to the
+// completion words go through compiler atomics rather than std::atomic objects.
+// All supported targets are little-endian, matching DataView(..., true) in JS.
+static void storeWord(uint8_t* address, uint32_t value) {
+  __atomic_store_n(reinterpret_cast<uint32_t*>(address), value, __ATOMIC_RELEASE);
+}
+
+static Botan::MessageAuthenticationCode& threadHmacSha512() {
+  thread_local std::unique_ptr<Botan::MessageAuthenticationCode> mac =
+      Botan::MessageAuthenticationCode::create_or_throw("HMAC(SHA-512)");
+  return *mac;
+}
+
+HybridSubmissionRing::HybridSubmissionRing(size_t capacity, size_t dataSize) : HybridObject(TAG) {
+  if (capacity == 0 || (capacity & (capacity - 1)) != 0) {
+    throw std::runtime_error("Submission ring capacity must be a power of two");
+  }
+
+  size_t totalSize = kHeaderSize + capacity * kSlotSize + dataSize;
+  auto* memory = static_cast<uint8_t*>(::operator new(totalSize, kBufferAlignment));
+  std::memset(memory, 0, totalSize);
+
+  auto state = std::make_shared<State>();
+  state->buffer = ArrayBuffer::wrap(memory, totalSize, [memory]() {
+    ::operator delete(memory, kBufferAlignment);
+  });
+  state->base = memory;
+  state->data = memory + kHeaderSize + capacity * kSlotSize;
+  state->capacity = capacity;
+  state->dataSize = dataSize;
+  state->finished.assign(capacity, false);
+  state->maxWorkers = std::max<size_t>(1, std::min<size_t>(kMaxWorkers, std::thread::hardware_concurrency()));
+  state_ = state;
+}
+
+std::shared_ptr<ArrayBuffer> HybridSubmissionRing::getBuffer() {
+  return state_->buffer;
+}
+
+double HybridSubmissionRing::getCapacity() {
+  return static_cast<double>(state_->capacity);
+}
+
+double HybridSubmissionRing::getDataSize() {
+  return static_cast<double>(state_->dataSize);
+}
+
+double HybridSubmissionRing::getCompleted() {
+  return static_cast<double>(state_->completed.load(std::memory_order_acquire));
+}
+
+void HybridSubmissionRing::submit() {
+  auto state = state_;
+  // Written by JS on this thread, so a plain read observes the latest value
+  uint32_t head;
+  std::memcpy(&head, state->base + kHeadOffset, sizeof(head));
+
+  size_t spawn = 0;
+  {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    uint32_t published = state->published.load(std::memory_order_relaxed);
+    if (head == published) {
+      return;
+    }
+    uint32_t inFlight = head - state->completed.load(std::memory_order_acquire);
+    if (inFlight > state->capacity) {
+      throw std::runtime_error("Submission ring overflow: " + std::to_string(inFlight) +
+                               " requests outstanding for " + std::to_string(state->capacity) + " slots");
+    }
+    state->published.store(head, std::memory_order_release);
+
+    uint32_t pending = head - state->claimed.load(std::memory_order_relaxed);
+    spawn = std::min<size_t>(state->maxWorkers - state->activeWorkers, pending);
+    state->activeWorkers += spawn;
+  }
+
+  for (size_t i = 0; i < spawn; i++) {
+    ThreadPool::shared().run([state]() { state->work(); });
+  }
+}
+
+std::shared_ptr<Promise<double>> HybridSubmissionRing::drain() {
+  auto state = state_;
+  uint32_t target;
+  auto promise = Promise<double>::create();
+  {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    target = state->published.load(std::memory_order_relaxed);
+    if (state->completed.load(std::memory_order_acquire) == target) {
+      return Promise<double>::resolved(static_cast<double>(target));
+    }
+    state->waiters.emplace_back(target, promise);
+    state->hasWaiters.store(true, std::memory_order_release);
+  }
+
+  // A worker may have completed the last request before the waiter was registered
+  state->resolveWaiters();
+  return promise;
+}
+
+void HybridSubmissionRing::State::work() {
+  // Private keys are copied here first so request outputs may overlap inputs
+  SecureBuffer secret(96);
+
+  for (;;) {
+    uint32_t index = claimed.load(std::memory_order_relaxed);
+    if (index == published.load(std::memory_order_acquire)) {
+      // Retire under the lock so a concurrent submit() either sees this worker
+      // as gone and spawns another, or publishes before this check
+      std::lock_guard<std::mutex> lock(mutex);
+      if (claimed.load(std::memory_order_relaxed) == published.load(std::memory_order_relaxed)) {
+        activeWorkers--;
+        return;
+      }
+      continue;
+    }
+    if (!claimed.compare_exchange_weak(index, index + 1, std::memory_order_acq_rel)) {
+      continue;
+    }
+
+    process(index, secret.data());
+    finish(index);
+  }
+}
+
+void HybridSubmissionRing::State::finish(uint32_t index) {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    finished[index & (capacity - 1)] = true;
+
+    // submit() keeps at most `capacity` requests past `completed`, so a set
+    // flag always belongs to the request that is due next in its slot
+    uint32_t done = completed.load(std::memory_order_relaxed);
+    uint32_t start = done;
+    while (finished[done & (capacity - 1)]) {
+      finished[done & (capacity - 1)] = false;
+      done++;
+    }
+    if (done == start) {
+      return;
+    }
+    completed.store(done, std::memory_order_release);
+    storeWord(base + kCompletedOffset, done);
+  }
+
+  if (hasWaiters.load(std::memory_order_acquire)) {
+    resolveWaiters();
+  }
+}
+
+void HybridSubmissionRing::State::process(uint32_t index, uint8_t* secret) {
+  uint8_t* slot = base + kHeaderSize + (index & (capacity - 1)) * kSlotSize;
+
+  // Read the request once; JS owns this memory and every field is untrusted
+  uint32_t words[8];
+  std::memcpy(words, slot, sizeof(words));
+  auto op = static_cast<Op>(words[0]);
+  uint32_t inputOffset = words[2], inputLength = words[3];
+  uint32_t auxOffset = words[4], auxLength = words[5];
+  uint32_t outputOffset = words[6], outputLength = words[7];
+
+  auto inRange = [this](uint32_t offset, uint32_t length) {
+    return offset <= dataSize && length <= dataSize - offset;
+  };
+
+  Status status = Status::Error;
+  if (inRange(inputOffset, inputLength) && inRange(auxOffset, auxLength) && inRange(outputOffset, outputLength)) {
+    const uint8_t* input = data + inputOffset;
+    uint8_t* output = data + outputOffset;
+    try {
+      switch (op) {
+        case Op::Keccak256:
+          if (outputLength == 32) {
+            keccak256(input, inputLength, output);
+            status = Status::Ok;
+          }
+          break;
+        case Op::HmacSha512:
+          if (outputLength == 64) {
+            auto& mac = threadHmacSha512();
+            mac.set_key(data + auxOffset, auxLength);
+            mac.update(input, inputLength);
+            mac.final(output);
+            status = Status::Ok;
+          }
+          break;
+        case Op::Secp256k1PublicKey:
+        case Op::Secp256k1PublicKeyCompressed: {
+          bool isCompressed = op == Op::Secp256k1PublicKeyCompressed;
+          if (inputLength == 32 && outputLength == (isCompressed ? 33u : 65u)) {
+            std::memcpy(secret, input, 32);
+            derivePublicKeyInto(secret, output, isCompressed);
+            status = Status::Ok;
+          }
+          break;
+        }
+        case Op::Ed25519PublicKey:
+          if (inputLength == 32 && outputLength == 32) {
+            std::memcpy(secret, input, 32);
+            ed25519PublicKey(secret, output);
+            status = Status::Ok;
+          }
+          break;
+      }
+    } catch (const std::exception&) {
+      status = Status::Error;
+    }
+  }
+
+  Botan::secure_scrub_memory(secret, 96);
+  storeWord(slot + 4, static_cast<uint32_t>(status));
+}
+
+void HybridSubmissionRing::State::resolveWaiters() {
+  std::vector<std::pair<uint32_t, std::shared_ptr<Promise<double>>>> ready;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    uint32_t done = completed.load(std::memory_order_acquire);
+    auto it = std::partition(waiters.begin(), waiters.end(), [done](const auto& waiter) {
+      // Wrap-safe "done < target"
+      return static_cast<int32_t>(done - waiter.first) < 0;
+    });
+    ready.assign(std::make_move_iterator(it), std::make_move_iterator(waiters.end()));
+    waiters.erase(it, waiters.end());
+    hasWaiters.store(!waiters.empty(), std::memory_order_release);
+  }
+
+  for (auto& [target, promise] : ready) {
+    promise->resolve(static_cast<double>(target));
+  }
+}
+
+} // namespace margelo::nitro::metamask_nativeutils
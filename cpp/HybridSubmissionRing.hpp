@@ -0,0 +1,95 @@
+#pragma once
+
+#include "HybridSubmissionRingSpec.hpp"
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace margelo::nitro::metamask_nativeutils {
+
+/**
+ * Request ring shared between one JS producer and native worker threads.
+ *
+ * The shared buffer is laid out as:
+ * - header (128 bytes): `head` (u32 at 0, written by JS) and `completed`
+ *   (u32 at 64, written natively), on separate cache lines
+ * - `capacity` request slots of 32 bytes, each eight u32 words:
+ *   op, status, inputOffset, inputLength, auxOffset, auxLength, outputOffset, outputLength
+ * - the data region holding request inputs and outputs; slot offsets are
+ *   relative to its start
+ *
+ * JS writes slots and data, advances `head`, then rings the doorbell with
+ * submit(). Workers claim slots in order with an atomic cursor, write the
+ * output and publish the slot status with release semantics. Slots finish in
+ * any order, but `completed` only advances past a run of finished slots, so
+ * every request before it is done. JS reads results after completed() or
+ * drain() reports them, which orders the reads after the worker writes.
+ */
+class HybridSubmissionRing : public HybridSubmissionRingSpec {
+public:
+  HybridSubmissionRing(size_t capacity, size_t dataSize);
+
+public:
+  std::shared_ptr<ArrayBuffer> getBuffer() override;
+  double getCapacity() override;
+  double getDataSize() override;
+  double getCompleted() override;
+  void submit() override;
+  std::shared_ptr<Promise<double>> drain() override;
+
+public:
+  static constexpr size_t kHeaderSize = 128;
+  static constexpr size_t kSlotSize = 32;
+  static constexpr size_t kHeadOffset = 0;
+  static constexpr size_t kCompletedOffset = 64;
+
+  enum class Op : uint32_t {
+    Keccak256 = 0,
+    HmacSha512 = 1,
+    Secp256k1PublicKey = 2,
+    Secp256k1PublicKeyCompressed = 3,
+    Ed25519PublicKey = 4,
+  };
+
+  enum class Status : uint32_t {
+    Pending = 0,
+    Ok = 1,
+    Error = 2,
+  };
+
+private:
+  // Outlives the HybridObject while workers are still running
+  struct State {
+    std::shared_ptr<ArrayBuffer> buffer;
+    uint8_t* base = nullptr;
+    uint8_t* data = nullptr;
+    size_t capacity = 0;
+    size_t dataSize = 0;
+
+    // Published head; only changed by submit() under `mutex`
+    std::atomic<uint32_t> published{0};
+    // Next slot to be claimed by a worker
+    std::atomic<uint32_t> claimed{0};
+    // Every request before this one is done; only changed under `mutex`
+    std::atomic<uint32_t> completed{0};
+    std::atomic<bool> hasWaiters{false};
+
+    std::mutex mutex;
+    size_t activeWorkers = 0;
+    size_t maxWorkers = 1;
+    // Slots finished ahead of `completed`, indexed like the slots
+    std::vector<bool> finished;
+    std::vector<std::pair<uint32_t, std::shared_ptr<Promise<double>>>> waiters;
+
+    void work();
+    void process(uint32_t index, uint8_t* secret);
+    void finish(uint32_t index);
+    void resolveWaiters();
+  };
+
+  std::shared_ptr<State> state_;
+};
+
+} // namespace margelo::nitro::metamask_nativeutils
@@ -0,0 +1,281 @@
+#include "abi_signature.hpp"
+#include <cctype>
+#include <stdexcept>
+
+namespace margelo::nitro::metamask_nativeutils {
+
+namespace {
+
+class SignatureParser {
+public:
+  explicit SignatureParser(const std::string& text) : text_(text) {}
+
+  AbiSignature parse() {
+    AbiSignature signature;
+    skipSpaces();
+    std::string keyword = identifier();
+    std::string word = keyword;
+    if (keyword == "event" || keyword == "function") {
+      skipSpaces();
+      word = identifier();
+    } else {
+      keyword.clear();
+    }
+    if (word.empty()) {
+      fail("expected a name");
+    }
+    signature.name = word;
+
+    skipSpaces();
+    signature.params = paramList(true);
+    modifiers(keyword, signature);
+    signature.canonical = signature.name + "(";
+    for (size_t i = 0; i < signature.params.size(); i++) {
+      signature.canonical += (i > 0 ? "," : "") + signature.params[i].type;
+    }
+    signature.canonical += ")";
+    return signature;
+  }
+
+private:
+  [[noreturn]] void fail(const std::string& reason) const {
+    throw std::runtime_error("Invalid ABI signature '" + text_ + "': " + reason + " at position " +
+                             std::to_string(pos_));
+  }
+
+  // Trailing modifiers do not change the canonical form. `anonymous` is the
+  // only one events have; functions may have visibility, mutability and
+  // `returns (...)`. Anything else after the parameters is an error.
+  void modifiers(const std::string& keyword, AbiSignature& signature) {
+    bool isFunction = false;
+    for (;;) {
+      skipSpaces();
+      if (atEnd()) {
+        break;
+      }
+      size_t start = pos_;
+      std::string word = identifier();
+      if (word == "anonymous" && keyword != "function" && !isFunction && !signature.anonymous) {
+        signature.anonymous = true;
+      } else if (keyword != "event" && !signature.anonymous && isFunctionModifier(word)) {
+        isFunction = true;
+      } else if (keyword != "event" && !signature.anonymous && word == "returns") {
+        isFunction = true;
+        skipSpaces();
+        paramList(false);
+      } else {
+        pos_ = start;
+        fail(word.empty() ? "unexpected '" + std::string(1, peek()) + "'" : "unexpected '" + word + "'");
+      }
+    }
+  }
+
+  static bool isFunctionModifier(const std::string& word) {
+    return word == "external" || word == "public" || word == "internal" || word == "private" || word == "view" ||
+           word == "pure" || word == "payable" || word == "nonpayable" || word == "virtual" || word == "override";
+  }
+
+  bool atEnd() const { return pos_ >= text_.size(); }
+  char peek() const { return atEnd() ? '\0' : text_[pos_]; }
+
+  void skipSpaces() {
+    while (!atEnd() && std::isspace(static_cast<unsigned char>(text_[pos_]))) {
+      pos_++;
+    }
+  }
+
+  void expect(char c) {
+    skipSpaces();
+    if (peek() != c) {
+      fail(std::string("expected '") + c + "'");
+    }
+    pos_++;
+  }
+
+  std::string identifier() {
+    size_t start = pos_;
+    while (!atEnd() && (std::isalnum(static_cast<unsigned char>(text_[pos_])) || text_[pos_] == '_' || text_[pos_] == '$')) {
+      pos_++;
+    }
+    return text_.substr(start, pos_ - start);
+  }
+
+  // "(param, param, ...)"; top-level parameters may be indexed
+  std::vector<AbiParam> paramList(bool allowIndexed) {
+    expect('(');
+    std::vector<AbiParam> params;
+    skipSpaces();
+    if (peek() == ')') {
+      pos_++;
+      return params;
+    }
+    for (;;) {
+      params.push_back(param(allowIndexed));
+      skipSpaces();
+      if (peek() == ',') {
+        pos_++;
+        continue;
+      }
+      expect(')');
+      return params;
+    }
+  }
+
+  AbiParam param(bool allowIndexed) {
+    AbiParam result = type();
+    skipSpaces();
+    std::string word = identifier();
+    if (word == "indexed") {
+      if (!allowIndexed) {
+        fail("'indexed' is only valid on event parameters");
+      }
+      result.indexed = true;
+      skipSpaces();
+      word = identifier();
+    } else if (word == "memory" || word == "calldata" || word == "storage") {
+      skipSpaces();
+      word = identifier();
+    }
+    result.name = word;
+    return result;
+  }
+
+  AbiParam type() {
+    skipSpaces();
+    AbiParam result;
+    if (peek() == '(' || text_.compare(pos_, 5, "tuple") == 0) {
+      if (peek() != '(') {
+        pos_ += 5;
+      }
+      std::vector<AbiParam> components = paramList(false);
+      result.type = "(";
+      result.headSize = 0;
+      for (size_t i = 0; i < components.size(); i++) {
+        result.type += (i > 0 ? "," : "") + components[i].type;
+        result.isDynamic = result.isDynamic || components[i].isDynamic;
+        if (components[i].headSize > kAbiMaxHeadSize - result.headSize) {
+          fail("tuple too large");
+        }
+        result.headSize += components[i].headSize;
+      }
+      result.type += ")";
+      if (result.isDynamic) {
+        result.headSize = 32;
+      }
+    } else {
+      result = elementary(identifier());
+    }
+
+    // Array suffixes
+    for (;;) {
+      skipSpaces();
+      if (peek() != '[') {
+        return result;
+      }
+      pos_++;
+      size_t start = pos_;
+      while (!atEnd() && std::isdigit(static_cast<unsigned char>(text_[pos_]))) {
+        pos_++;
+      }
+      std::string length = text_.substr(start, pos_ - start);
+      if (length.size() > 6) {
+        fail("array length too large");
+      }
+      expect(']');
+
+      result.wordKind = AbiWordKind::None;
+      result.type += "[" + length + "]";
+      if (length.empty() || result.isDynamic) {
+        result.isDynamic = true;
+        result.headSize = 32;
+      } else {
+        size_t count = std::stoul(length);
+        if (count != 0 && result.headSize > kAbiMaxHeadSize / count) {
+          fail("array too large");
+        }
+        result.headSize *= count;
+      }
+    }
+  }
+
+  AbiParam elementary(const std::string& name) {
+    AbiParam result;
+    result.type = name;
+    if (name == "address") {
+      result.wordKind = AbiWordKind::Address;
+    } else if (name == "bool") {
+      result.wordKind = AbiWordKind::Value;
+    } else if (name == "string" || name == "bytes") {
+      result.isDynamic = true;
+    } else if (name == "function") {
+      // 24-byte address + selector, left-aligned; not a single value
+    } else if (name == "uint" || name == "int") {
+      result.type = name + "256";
+      result.wordKind = AbiWordKind::Value;
+    } else if (name == "fixed" || name == "ufixed") {
+      result.type = name + "128x18";
+      result.wordKind = AbiWordKind::Value;
+    } else if (validFixed(name)) {
+      result.wordKind = AbiWordKind::Value;
+    } else if (name.rfind("uint", 0) == 0 && validBits(name.substr(4))) {
+      result.wordKind = AbiWordKind::Value;
+    } else if (name.rfind("int", 0) == 0 && validBits(name.substr(3))) {
+      result.wordKind = AbiWordKind::Value;
+    } else if (name.rfind("bytes", 0) == 0 && validByteLength(name.substr(5))) {
+      result.wordKind = AbiWordKind::Value;
+    } else {
+      fail(name.empty() ? "expected a type" : "unknown type '" + name + "'");
+    }
+    return result;
+  }
+
+  static bool isNumber(const std::string& digits) {
+    if (digits.empty() || digits.size() > 3 || digits[0] == '0') {
+      return false;
+    }
+    for (char c : digits) {
+      if (!std::isdigit(static_cast<unsigned char>(c))) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  static bool validBits(const std::string& digits) {
+    if (!isNumber(digits)) {
+      return false;
+    }
+    int bits = std::stoi(digits);
+    return bits >= 8 && bits <= 256 && bits % 8 == 0;
+  }
+
+  // fixed<M>x<N> / ufixed<M>x<N>: M bits as for intN, 0 < N <= 80 decimals
+  static bool validFixed(const std::string& name) {
+    size_t prefix = name.rfind("ufixed", 0) == 0 ? 6 : name.rfind("fixed", 0) == 0 ? 5 : 0;
+    size_t separator = name.find('x', prefix);
+    if (prefix == 0 || separator == std::string::npos) {
+      return false;
+    }
+    std::string decimals = name.substr(separator + 1);
+    return validBits(name.substr(prefix, separator - prefix)) && isNumber(decimals) && std::stoi(decimals) <= 80;
+  }
+
+  static bool validByteLength(const std::string& digits) {
+    if (!isNumber(digits)) {
+      return false;
+    }
+    int length = std::stoi(digits);
+    return length >= 1 && length <= 32;
+  }
+
+  const std::string& text_;
+  size_t pos_ = 0;
+};
+
+} // namespace
+
+AbiSignature parseAbiSignature(const std::string& signature) {
+  return SignatureParser(signature).parse();
+}
+
+} // namespace margelo::nitro::metamask_nativeutils
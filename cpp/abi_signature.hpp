@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace margelo::nitro::metamask_nativeutils {
+
+/** How a parameter value can be read from a single 32-byte ABI word. */
+enum class AbiWordKind {
+  None,    // dynamic, array or tuple: not a single word
+  Address, // low 20 bytes of the word
+  Value,   // the word itself (bool, intN, uintN, bytesN)
+};
+
+/** Largest head size a parameter may take; offsets into the head are 32-bit. */
+static constexpr size_t kAbiMaxHeadSize = UINT32_MAX;
+
+struct AbiParam {
+  std::string type; // canonical type, e.g. "uint256" or "(address,bytes)[]"
+  std::string name; // may be empty
+  bool indexed = false;
+  bool isDynamic = false;
+  size_t headSize = 32; // bytes taken in the head of the encoding
+  AbiWordKind wordKind = AbiWordKind::None;
+};
+
+struct AbiSignature {
+  std::string name;
+  std::vector<AbiParam> params;
+  std::string canonical; // "name(type1,type2)", the Keccak-256 preimage
+  bool anonymous = false; // an anonymous event, logged without topic0
+};
+
+/**
+ * Parse a human-readable event or function signature such as
+ * `event Transfer(address indexed from, address indexed to, uint256 value)`
+ * or `transfer(address,uint256)`. Parameter names, `indexed` and the
+ * `event`/`function` keyword are optional; `uint`/`int` are normalized to
+ * their 256-bit forms and tuple components may be named. Events may end in
+ * `anonymous`; functions in visibility and mutability keywords and
+ * `returns (...)`. Any other trailing text is rejected.
+ * @param signature Signature text
+ * @return The parsed signature with its canonical form
+ * @throws std::runtime_error if the signature is malformed or a parameter's
+ *   head is larger than kAbiMaxHeadSize
+ */
+AbiSignature parseAbiSignature(const std::string& signature);
+
+} // namespace margelo::nitro::metamask_nativeutils
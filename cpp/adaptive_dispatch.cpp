@@ -0,0 +1,162 @@
+#include "adaptive_dispatch.hpp"
+#include <NitroModules/ThreadPool.hpp>
+#include <algorithm>
+#include <condition_variable>
+#include <limits>
+
+namespace margelo::nitro::metamask_nativeutils {
+
+// Weight kept by older samples each time a new one arrives (~50 sample window).
+static constexpr double kDecay = 0.98;
+// A request is only offloaded once its inline cost dwarfs the thread hop,
+// since the hop figure does not include resolving the Promise on the JS side.
+static constexpr double kOffloadFactor = 4.0;
+// Never offload work cheaper than this; it is shorter than any frame budget.
+static constexpr double kMinInlineBudgetNs = 50'000.0;
+// Samples this much slower than predicted (preemption, page faults) are clamped.
+static constexpr double kOutlierFactor = 8.0;
+static constexpr int kCalibrationRuns = 3;
+
+static const char* opName(DispatchOp op) {
+  switch (op) {
+    case DispatchOp::Keccak256: return "keccak256";
+    case DispatchOp::HmacSha512: return "hmacSha512";
+    case DispatchOp::Secp256k1PublicKey: return "secp256k1PublicKey";
+    case DispatchOp::Ed25519PublicKey: return "ed25519PublicKey";
+    case DispatchOp::Count: break;
+  }
+  return "unknown";
+}
+
+static uint64_t nanosSince(std::chrono::steady_clock::time_point start) {
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+}
+
+AdaptiveDispatcher& AdaptiveDispatcher::shared() {
+  static AdaptiveDispatcher dispatcher;
+  return dispatcher;
+}
+
+void AdaptiveDispatcher::calibrate(DispatchOp op, size_t smallUnits, size_t largeUnits, const std::function<void(size_t)>& probe) {
+  uint64_t smallNs = std::numeric_limits<uint64_t>::max();
+  uint64_t largeNs = std::numeric_limits<uint64_t>::max();
+
+  // The minimum of a few runs filters out scheduler noise
+  for (int i = 0; i < kCalibrationRuns; i++) {
+    auto start = std::chrono::steady_clock::now();
+    probe(smallUnits);
+    smallNs = std::min(smallNs, nanosSince(start));
+
+    start = std::chrono::steady_clock::now();
+    probe(largeUnits);
+    largeNs = std::min(largeNs, nanosSince(start));
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& model = models_[static_cast<size_t>(op)];
+  addSample(model, static_cast<double>(smallUnits), static_cast<double>(smallNs));
+  addSample(model, static_cast<double>(largeUnits), static_cast<double>(largeNs));
+}
+
+void AdaptiveDispatcher::measureOffloadCost() {
+  struct HopState {
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool done = false;
+  };
+
+  uint64_t bestNs = std::numeric_limits<uint64_t>::max();
+  for (int i = 0; i < kCalibrationRuns + 2; i++) {
+    auto state = std::make_shared<HopState>();
+    auto start = std::chrono::steady_clock::now();
+    ThreadPool::shared().run([state]() {
+      std::lock_guard<std::mutex> lock(state->mutex);
+      state->done = true;
+      state->cv.notify_one();
+    });
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->cv.wait(lock, [&state]() { return state->done; });
+    bestNs = std::min(bestNs, nanosSince(start));
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  offloadCostNs_ = static_cast<double>(bestNs);
+}
+
+bool AdaptiveDispatcher::shouldOffload(DispatchOp op, size_t units) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  const auto& model = models_[static_cast<size_t>(op)];
+  if (model.samples == 0) {
+    // Without a model we cannot prove the work is cheap, so keep it off the JS thread
+    return true;
+  }
+  double predictedNs = model.fixedNs + model.perUnitNs * static_cast<double>(units);
+  return predictedNs > inlineBudgetNs();
+}
+
+void AdaptiveDispatcher::record(DispatchOp op, size_t units, uint64_t elapsedNs) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  addSample(models_[static_cast<size_t>(op)], static_cast<double>(units), static_cast<double>(elapsedNs));
+}
+
+std::vector<DispatchModelSnapshot> AdaptiveDispatcher::snapshot() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::vector<DispatchModelSnapshot> result;
+  result.reserve(models_.size());
+
+  double budgetNs = inlineBudgetNs();
+  for (size_t i = 0; i < models_.size(); i++) {
+    const auto& model = models_[i];
+    double inlineMaxUnits = 0;
+    if (model.samples > 0 && budgetNs > model.fixedNs) {
+      inlineMaxUnits = model.perUnitNs > 0
+          ? (budgetNs - model.fixedNs) / model.perUnitNs
+          : std::numeric_limits<double>::infinity();
+    }
+    result.push_back({
+        opName(static_cast<DispatchOp>(i)),
+        model.fixedNs,
+        model.perUnitNs,
+        offloadCostNs_,
+        inlineMaxUnits,
+        model.samples,
+    });
+  }
+  return result;
+}
+
+void AdaptiveDispatcher::addSample(CostModel& model, double units, double elapsedNs) {
+  if (model.samples > 0) {
+    double predictedNs = model.fixedNs + model.perUnitNs * units;
+    elapsedNs = std::min(elapsedNs, predictedNs * kOutlierFactor);
+  }
+
+  model.sumW = model.sumW * kDecay + 1.0;
+  model.sumX = model.sumX * kDecay + units;
+  model.sumY = model.sumY * kDecay + elapsedNs;
+  model.sumXX = model.sumXX * kDecay + units * units;
+  model.sumXY = model.sumXY * kDecay + units * elapsedNs;
+  model.samples++;
+
+  double meanX = model.sumX / model.sumW;
+  double meanY = model.sumY / model.sumW;
+  double varianceX = model.sumXX / model.sumW - meanX * meanX;
+
+  if (varianceX > 1e-9 * std::max(1.0, meanX * meanX)) {
+    double covarianceXY = model.sumXY / model.sumW - meanX * meanY;
+    model.perUnitNs = std::max(0.0, covarianceXY / varianceX);
+    model.fixedNs = std::max(0.0, meanY - model.perUnitNs * meanX);
+  } else if (meanX > 0) {
+    // All recent samples had the same size; keep the fixed cost and refit the slope
+    model.perUnitNs = std::max(0.0, (meanY - model.fixedNs) / meanX);
+  } else {
+    model.fixedNs = meanY;
+  }
+}
+
+double AdaptiveDispatcher::inlineBudgetNs() const {
+  return std::max(kMinInlineBudgetNs, offloadCostNs_ * kOffloadFactor);
+}
+
+} // namespace margelo::nitro::metamask_nativeutils
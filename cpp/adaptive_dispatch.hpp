@@ -0,0 +1,142 @@
+#pragma once
+
+#include <NitroModules/Promise.hpp>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace margelo::nitro::metamask_nativeutils {
+
+/**
+ * Operations whose cost is modelled by the adaptive dispatcher.
+ * "Units" are bytes for hashing operations and keys for key derivation.
+ */
+enum class DispatchOp : size_t {
+  Keccak256 = 0,
+  HmacSha512,
+  Secp256k1PublicKey,
+  Ed25519PublicKey,
+  Count,
+};
+
+/**
+ * Point-in-time view of a cost model, used for diagnostics.
+ */
+struct DispatchModelSnapshot {
+  const char* op;
+  double fixedCostNs;
+  double perUnitCostNs;
+  double offloadCostNs;
+  double inlineMaxUnits;
+  uint64_t samples;
+};
+
+/**
+ * Decides whether a request runs inline on the calling (JS) thread or is
+ * offloaded to the Nitro thread pool.
+ *
+ * Each operation has a linear cost model `fixed + perUnit * units` that is
+ * seeded by calibration probes and refined with every completed request
+ * (exponentially weighted least squares). A request is offloaded when its
+ * predicted inline cost exceeds the measured cost of a thread hop by a
+ * safety factor, so tiny inputs never pay for a context switch while large
+ * batches never block the JS thread.
+ */
+class AdaptiveDispatcher {
+public:
+  static AdaptiveDispatcher& shared();
+
+  /**
+   * Seed the cost model of an operation by timing a probe at two sizes.
+   * @param op Operation to calibrate
+   * @param smallUnits Size of the small probe
+   * @param largeUnits Size of the large probe
+   * @param probe Function that performs the operation on the given number of units
+   */
+  void calibrate(DispatchOp op, size_t smallUnits, size_t largeUnits, const std::function<void(size_t)>& probe);
+
+  /**
+   * Measure the round trip of posting an empty task to the Nitro thread pool.
+   * Called once during calibration; the minimum of a few runs is kept.
+   * Blocks until each task has run, so it must not be called on the JS thread.
+   */
+  void measureOffloadCost();
+
+  /**
+   * @param op Operation to run
+   * @param units Size of the request
+   * @return true if the request should run on the thread pool, which is
+   *         always the case until the operation's model has a sample
+   */
+  bool shouldOffload(DispatchOp op, size_t units);
+
+  /**
+   * Feed the measured duration of a completed request back into the model.
+   */
+  void record(DispatchOp op, size_t units, uint64_t elapsedNs);
+
+  /**
+   * @return One snapshot per operation, in DispatchOp order
+   */
+  std::vector<DispatchModelSnapshot> snapshot();
+
+private:
+  struct CostModel {
+    // Exponentially decayed sums for a weighted least squares fit of
+    // elapsedNs = fixed + perUnit * units.
+    double sumW = 0;
+    double sumX = 0;
+    double sumY = 0;
+    double sumXX = 0;
+    double sumXY = 0;
+    double fixedNs = 0;
+    double perUnitNs = 0;
+    uint64_t samples = 0;
+  };
+
+  void addSample(CostModel& model, double units, double elapsedNs);
+  double inlineBudgetNs() const;
+
+  std::mutex mutex_;
+  std::array<CostModel, static_cast<size_t>(DispatchOp::Count)> models_;
+  double offloadCostNs_ = 0;
+};
+
+/**
+ * Run `work` on the calling thread and wrap its result in an already settled Promise.
+ */
+template <typename TResult>
+std::shared_ptr<Promise<TResult>> runInline(DispatchOp op, size_t units, const std::function<TResult()>& work) {
+  try {
+    auto start = std::chrono::steady_clock::now();
+    TResult result = work();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    AdaptiveDispatcher::shared().record(op, units, std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    return Promise<TResult>::resolved(std::move(result));
+  } catch (...) {
+    return Promise<TResult>::rejected(std::current_exception());
+  }
+}
+
+/**
+ * Run `work` on the Nitro thread pool. `work` must not touch JS-owned
+ * ArrayBuffers; callers copy their inputs before offloading.
+ */
+template <typename TResult>
+std::shared_ptr<Promise<TResult>> runOffloaded(DispatchOp op, size_t units, std::function<TResult()>&& work) {
+  return Promise<TResult>::async([op, units, work = std::move(work)]() {
+    auto start = std::chrono::steady_clock::now();
+    TResult result = work();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    AdaptiveDispatcher::shared().record(op, units, std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    return result;
+  });
+}
+
+} // namespace margelo::nitro::metamask_nativeutils
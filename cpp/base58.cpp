@@ -0,0 +1,173 @@
+#include "base58.hpp"
+#include "botan_conditional.h"
+#include "hash_utils.hpp"
+#include <cstring>
+#include <vector>
+
+namespace margelo::nitro::metamask_nativeutils {
+
+static const char kAlphabet[] = "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
+
+// 58^5, the base of one limb of digits
+static constexpr uint64_t kDigitLimb = 656356768;
+
+// Digit value of each character, or -1
+static const int8_t* digitValues() {
+  static const auto table = [] {
+    static int8_t values[256];
+    std::memset(values, -1, sizeof(values));
+    for (int i = 0; i < 58; i++) {
+      values[static_cast<uint8_t>(kAlphabet[i])] = static_cast<int8_t>(i);
+    }
+    return values;
+  }();
+  return table;
+}
+
+std::string base58Encode(const uint8_t* data, size_t size) {
+  size_t zeros = 0;
+  while (zeros < size && data[zeros] == 0) {
+    zeros++;
+  }
+
+  // Little-endian limbs of five digits each. Bytes go in four at a time:
+  // a limb below 2^30 times 2^32, plus the carry, stays below 2^64.
+  std::vector<uint32_t> limbs((size - zeros) * 138 / 500 + 2);
+  size_t used = 0;
+  size_t i = zeros;
+  size_t chunk = (size - zeros) % 4 == 0 ? 4 : (size - zeros) % 4;
+  while (i < size) {
+    uint64_t carry = 0;
+    for (size_t k = 0; k < chunk; k++) {
+      carry = (carry << 8) | data[i + k];
+    }
+    for (size_t j = 0; j < used; j++) {
+      uint64_t t = (static_cast<uint64_t>(limbs[j]) << (8 * chunk)) + carry;
+      limbs[j] = static_cast<uint32_t>(t % kDigitLimb);
+      carry = t / kDigitLimb;
+    }
+    while (carry != 0) {
+      limbs[used++] = static_cast<uint32_t>(carry % kDigitLimb);
+      carry /= kDigitLimb;
+    }
+    i += chunk;
+    chunk = 4;
+  }
+
+  std::string text(zeros, '1');
+  text.reserve(zeros + used * 5);
+  for (size_t j = used; j-- > 0;) {
+    char digits[5];
+    uint32_t limb = limbs[j];
+    for (int k = 4; k >= 0; k--) {
+      digits[k] = kAlphabet[limb % 58];
+      limb /= 58;
+    }
+    // The top limb is written without its leading zero digits
+    int skip = 0;
+    while (j + 1 == used && skip < 4 && digits[skip] == '1') {
+      skip++;
+    }
+    text.append(digits + skip, 5 - skip);
+  }
+  // Payloads can be private keys (xprv)
+  Botan::secure_scrub_memory(limbs.data(), limbs.size() * sizeof(uint32_t));
+  return text;
+}
+
+bool base58Decode(const char* text, size_t length, uint8_t* output, size_t size) {
+  const int8_t* values = digitValues();
+  size_t zeros = 0;
+  while (zeros < length && text[zeros] == '1') {
+    zeros++;
+  }
+  if (zeros > size) {
+    return false;
+  }
+
+  // Little-endian 32-bit limbs, fed five digits at a time. Anything that
+  // needs more limbs than `size` bytes can fill is rejected on the way.
+  size_t maxLimbs = (size - zeros + 3) / 4;
+  std::vector<uint32_t> limbs(maxLimbs + 1);
+  auto reject = [&] {
+    Botan::secure_scrub_memory(limbs.data(), limbs.size() * sizeof(uint32_t));
+    return false;
+  };
+  size_t used = 0;
+  size_t i = zeros;
+  size_t group = (length - zeros) % 5 == 0 ? 5 : (length - zeros) % 5;
+  while (i < length) {
+    uint64_t carry = 0;
+    uint64_t multiplier = 1;
+    for (size_t k = 0; k < group; k++) {
+      int8_t value = values[static_cast<uint8_t>(text[i + k])];
+      if (value < 0) {
+        return reject();
+      }
+      carry = carry * 58 + static_cast<uint64_t>(value);
+      multiplier *= 58;
+    }
+    for (size_t j = 0; j < used; j++) {
+      uint64_t t = limbs[j] * multiplier + carry;
+      limbs[j] = static_cast<uint32_t>(t);
+      carry = t >> 32;
+    }
+    if (carry != 0) {
+      if (used == maxLimbs) {
+        return reject();
+      }
+      limbs[used++] = static_cast<uint32_t>(carry);
+    }
+    i += group;
+    group = 5;
+  }
+
+  // Big-endian bytes without leading zeros must fill exactly the rest
+  size_t significant = used * 4;
+  while (significant > 0 && ((limbs[(significant - 1) / 4] >> (8 * ((significant - 1) % 4))) & 0xff) == 0) {
+    significant--;
+  }
+  if (zeros + significant != size) {
+    return reject();
+  }
+  std::memset(output, 0, zeros);
+  for (size_t k = 0; k < significant; k++) {
+    size_t byte = significant - 1 - k;
+    output[zeros + k] = static_cast<uint8_t>(limbs[byte / 4] >> (8 * (byte % 4)));
+  }
+  Botan::secure_scrub_memory(limbs.data(), limbs.size() * sizeof(uint32_t));
+  return true;
+}
+
+static void checksum(const uint8_t* data, size_t size, uint8_t* out) {
+  uint8_t hash[32];
+  hashInto(HashKind::Sha256, data, size, hash);
+  hashInto(HashKind::Sha256, hash, sizeof(hash), hash);
+  std::memcpy(out, hash, 4);
+}
+
+std::string base58CheckEncode(const uint8_t* data, size_t size) {
+  std::vector<uint8_t> buffer(size + 4);
+  std::memcpy(buffer.data(), data, size);
+  checksum(data, size, buffer.data() + size);
+  std::string text = base58Encode(buffer.data(), buffer.size());
+  Botan::secure_scrub_memory(buffer.data(), buffer.size());
+  return text;
+}
+
+bool base58CheckDecode(const char* text, size_t length, uint8_t* payload, size_t size) {
+  std::vector<uint8_t> buffer(size + 4);
+  bool valid = base58Decode(text, length, buffer.data(), buffer.size());
+  if (valid) {
+    uint8_t expected[4];
+    checksum(buffer.data(), size, expected);
+    valid = std::memcmp(expected, buffer.data() + size, 4) == 0;
+  }
+  if (valid) {
+    std::memcpy(payload, buffer.data(), size);
+  }
+  Botan::secure_scrub_memory(buffer.data(), buffer.size());
+  return valid;
+}
+
+} // namespace margelo::nitro::metamask_nativeutils
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace margelo::nitro::metamask_nativeutils {
+
+// Base58 with the Bitcoin alphabet. Conversion works on limbs of five base58
+// digits (58^5 < 2^32), so each input byte or digit group costs one 64-bit
+// multiply-add per limb rather than one per digit.
+
+/**
+ * Encode bytes as base58; each leading zero byte becomes a leading '1'.
+ * @param data Input bytes
+ * @param size Number of input bytes
+ * @return The base58 text
+ */
+std::string base58Encode(const uint8_t* data, size_t size);
+
+/**
+ * Decode base58 text of a known decoded size.
+ * @param text Base58 characters
+ * @param length Number of characters
+ * @param output Output buffer for exactly `size` bytes
+ * @param size Expected number of decoded bytes
+ * @return false if a character is outside the alphabet or the text does not
+ *   decode to exactly `size` bytes; `output` is then unspecified
+ */
+bool base58Decode(const char* text, size_t length, uint8_t* output, size_t size);
+
+/**
+ * Encode bytes followed by the first 4 bytes of their double SHA-256.
+ * @param data Payload bytes
+ * @param size Number of payload bytes
+ * @return The Base58Check text
+ */
+std::string base58CheckEncode(const uint8_t* data, size_t size);
+
+/**
+ * Decode Base58Check text with a payload of a known size.
+ * @param text Base58 characters
+ * @param length Number of characters
+ * @param payload Output buffer for exactly `size` bytes
+ * @param size Expected payload size, without the checksum
+ * @return false if the text is not valid base58, has the wrong size or the
+ *   checksum does not match; `payload` is then unspecified
+ */
+bool base58CheckDecode(const char* text, size_t length, uint8_t* payload, size_t size);
+
+} // namespace margelo::nitro::metamask_nativeutils
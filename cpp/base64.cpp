@@ -0,0 +1,83 @@
+#include "base64.hpp"
+#include <cstring>
+
+namespace margelo::nitro::metamask_nativeutils {
+
+static const char kAlphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+// Six-bit value of each character, or -1
+static const int8_t* sextetValues() {
+  static const auto table = [] {
+    static int8_t values[256];
+    std::memset(values, -1, sizeof(values));
+    for (int i = 0; i < 64; i++) {
+      values[static_cast<uint8_t>(kAlphabet[i])] = static_cast<int8_t>(i);
+    }
+    return values;
+  }();
+  return table;
+}
+
+std::string base64Encode(const uint8_t* data, size_t size) {
+  std::string text((size + 2) / 3 * 4, '=');
+  size_t out = 0;
+  size_t i = 0;
+  for (; i + 3 <= size; i += 3) {
+    uint32_t group = (static_cast<uint32_t>(data[i]) << 16) | (static_cast<uint32_t>(data[i + 1]) << 8) | data[i + 2];
+    text[out++] = kAlphabet[group >> 18];
+    text[out++] = kAlphabet[(group >> 12) & 63];
+    text[out++] = kAlphabet[(group >> 6) & 63];
+    text[out++] = kAlphabet[group & 63];
+  }
+  if (i < size) {
+    uint32_t group = static_cast<uint32_t>(data[i]) << 16;
+    if (i + 1 < size) {
+      group |= static_cast<uint32_t>(data[i + 1]) << 8;
+    }
+    text[out++] = kAlphabet[group >> 18];
+    text[out++] = kAlphabet[(group >> 12) & 63];
+    if (i + 1 < size) {
+      text[out] = kAlphabet[(group >> 6) & 63];
+    }
+  }
+  return text;
+}
+
+bool base64Decode(const char* text, size_t length, std::vector<uint8_t>& output) {
+  output.clear();
+  if (length % 4 != 0) {
+    return false;
+  }
+  size_t padding = 0;
+  if (length > 0 && text[length - 1] == '=') {
+    padding = text[length - 2] == '=' ? 2 : 1;
+  }
+  const int8_t* values = sextetValues();
+  output.resize(length / 4 * 3 - padding);
+  size_t out = 0;
+  for (size_t i = 0; i < length; i += 4) {
+    // The last group may end in padding, which counts as zero bits
+    bool last = i + 4 == length;
+    uint32_t group = 0;
+    for (size_t k = 0; k < 4; k++) {
+      int8_t value = last && k >= 4 - padding ? 0 : values[static_cast<uint8_t>(text[i + k])];
+      if (value < 0) {
+        output.clear();
+        return false;
+      }
+      group = (group << 6) | static_cast<uint32_t>(value);
+    }
+    size_t bytes = last ? 3 - padding : 3;
+    // Bits past the last byte must be zero
+    if (bytes < 3 && (group & ((1u << (8 * (3 - bytes))) - 1)) != 0) {
+      output.clear();
+      return false;
+    }
+    for (size_t k = 0; k < bytes; k++) {
+      output[out++] = static_cast<uint8_t>(group >> (16 - 8 * k));
+    }
+  }
+  return true;
+}
+
+} // namespace margelo::nitro::metamask_nativeutils
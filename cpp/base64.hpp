@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace margelo::nitro::metamask_nativeutils {
+
+/**
+ * Encode bytes as padded base64 with the standard alphabet (RFC 4648).
+ * @param data Input bytes
+ * @param size Number of input bytes
+ * @return The base64 text
+ */
+std::string base64Encode(const uint8_t* data, size_t size);
+
+/**
+ * Decode padded base64 with the standard alphabet. Whitespace, missing
+ * padding and non-zero bits after the last byte are rejected, so each byte
+ * string has exactly one accepted encoding.
+ * @param text Base64 characters
+ * @param length Number of characters
+ * @param output Receives the decoded bytes, replacing its contents
+ * @return false if the text is not canonical base64
+ */
+bool base64Decode(const char* text, size_t length, std::vector<uint8_t>& output);
+
+} // namespace margelo::nitro::metamask_nativeutils
@@ -0,0 +1,111 @@
+#include "bech32.hpp"
+#include <cstring>
+
+namespace margelo::nitro::metamask_nativeutils {
+
+static const char kCharset[] = "qpzry9x8gf2tvdw0s3jn54khce6mua7l";
+
+// Checksum constants: bech32 for witness version 0, bech32m after
+static constexpr uint32_t kBech32Const = 1;
+static constexpr uint32_t kBech32mConst = 0x2bc830a3;
+
+static uint32_t polymodStep(uint32_t chk, uint8_t value) {
+  static constexpr uint32_t kGenerator[] = {0x3b6a57b2, 0x26508e6d, 0x1ea119fa, 0x3d4233dd, 0x2a1462b3};
+  uint32_t top = chk >> 25;
+  chk = ((chk & 0x1ffffff) << 5) ^ value;
+  for (int i = 0; i < 5; i++) {
+    if ((top >> i) & 1) {
+      chk ^= kGenerator[i];
+    }
+  }
+  return chk;
+}
+
+bool decodeSegwitAddress(const std::string& address, SegwitProgram& output) {
+  // BIP173 caps addresses at 90 characters; this also bounds `data` below
+  if (address.size() < 8 || address.size() > 90) {
+    return false;
+  }
+  bool lower = false;
+  bool upper = false;
+  for (char c : address) {
+    if (c < 33 || c > 126) {
+      return false;
+    }
+    lower |= c >= 'a' && c <= 'z';
+    upper |= c >= 'A' && c <= 'Z';
+  }
+  if (lower && upper) {
+    return false;
+  }
+  size_t separator = address.rfind('1');
+  if (separator == std::string::npos || separator == 0 || address.size() - separator - 1 < 6) {
+    return false;
+  }
+
+  std::string hrp;
+  for (size_t i = 0; i < separator; i++) {
+    char c = address[i];
+    hrp.push_back(c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c);
+  }
+  if (hrp != "bc" && hrp != "tb" && hrp != "bcrt") {
+    return false;
+  }
+
+  uint32_t chk = 1;
+  for (char c : hrp) {
+    chk = polymodStep(chk, static_cast<uint8_t>(c >> 5));
+  }
+  chk = polymodStep(chk, 0);
+  for (char c : hrp) {
+    chk = polymodStep(chk, static_cast<uint8_t>(c & 31));
+  }
+  uint8_t data[90];
+  size_t dataSize = address.size() - separator - 1;
+  for (size_t i = 0; i < dataSize; i++) {
+    char c = address[separator + 1 + i];
+    if (c >= 'A' && c <= 'Z') {
+      c = static_cast<char>(c - 'A' + 'a');
+    }
+    const char* found = std::strchr(kCharset, c);
+    if (found == nullptr) {
+      return false;
+    }
+    data[i] = static_cast<uint8_t>(found - kCharset);
+    chk = polymodStep(chk, data[i]);
+  }
+
+  // The version comes first, then the program regrouped from 5 to 8 bits
+  size_t valueCount = dataSize - 6;
+  if (valueCount < 1 || data[0] > 16) {
+    return false;
+  }
+  output.version = data[0];
+  if (chk != (output.version == 0 ? kBech32Const : kBech32mConst)) {
+    return false;
+  }
+  uint32_t acc = 0;
+  int bits = 0;
+  output.size = 0;
+  for (size_t i = 1; i < valueCount; i++) {
+    acc = (acc << 5) | data[i];
+    bits += 5;
+    if (bits >= 8) {
+      bits -= 8;
+      if (output.size == sizeof(output.program)) {
+        return false;
+      }
+      output.program[output.size++] = static_cast<uint8_t>(acc >> bits);
+    }
+  }
+  // Padding is under a byte and all zero
+  if (bits >= 5 || (acc & ((1u << bits) - 1)) != 0) {
+    return false;
+  }
+  if (output.size < 2 || (output.version == 0 && output.size != 20 && output.size != 32)) {
+    return false;
+  }
+  return true;
+}
+
+} // namespace margelo::nitro::metamask_nativeutils
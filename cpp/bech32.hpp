@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace margelo::nitro::metamask_nativeutils {
+
+/** Witness version and program of a segwit address. */
+struct SegwitProgram {
+  uint8_t version;
+  uint8_t program[40];
+  size_t size;
+};
+
+/**
+ * Decode a Bitcoin segwit address (BIP173, and BIP350 for version 1 and
+ * up) on mainnet, testnet or regtest.
+ * @param address Address with the `bc`, `tb` or `bcrt` prefix
+ * @param output Receives the witness version and program
+ * @return false if the address is malformed, has a bad checksum or the
+ *   wrong checksum variant for its version, or a program of an invalid size
+ */
+bool decodeSegwitAddress(const std::string& address, SegwitProgram& output);
+
+} // namespace margelo::nitro::metamask_nativeutils
@@ -0,0 +1,75 @@
+#include "bip32.hpp"
+#include "hash_utils.hpp"
+#include "secp256k1_utils.hpp"
+#include <algorithm>
+
+namespace margelo::nitro::metamask_nativeutils {
+
+struct ExtendedKeyVersion {
+  uint32_t version;
+  bool isPrivate;
+};
+
+// SLIP-0132 versions for single-signature keys: BIP44 (x, t), BIP49 (y, u)
+// and BIP84 (z, v)
+static constexpr ExtendedKeyVersion kVersions[] = {
+    {0x0488b21e, false}, {0x0488ade4, true}, // xpub, xprv
+    {0x049d7cb2, false}, {0x049d7878, true}, // ypub, yprv
+    {0x04b24746, false}, {0x04b2430c, true}, // zpub, zprv
+    {0x043587cf, false}, {0x04358394, true}, // tpub, tprv
+    {0x044a5262, false}, {0x044a4e28, true}, // upub, uprv
+    {0x045f1cf6, false}, {0x045f18bc, true}, // vpub, vprv
+};
+
+static uint32_t load32BigEndian(const uint8_t* p) {
+  return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) |
+         (static_cast<uint32_t>(p[2]) << 8) | p[3];
+}
+
+const char* extendedKeyError(const uint8_t* key) {
+  uint32_t version = load32BigEndian(key);
+  const ExtendedKeyVersion* known = nullptr;
+  for (const auto& entry : kVersions) {
+    if (entry.version == version) {
+      known = &entry;
+    }
+  }
+  if (known == nullptr) {
+    return "unknown version";
+  }
+  if (key[4] == 0 && (load32BigEndian(key + 5) != 0 || load32BigEndian(key + 9) != 0)) {
+    return "master key with a parent fingerprint or child number";
+  }
+
+  const secp256k1_context* ctx = secp256k1Context();
+  const uint8_t* material = key + 45;
+  if (known->isPrivate) {
+    if (material[0] != 0 || !secp256k1_ec_seckey_verify(ctx, material + 1)) {
+      return "invalid private key";
+    }
+  } else {
+    // At 33 bytes only the 0x02 and 0x03 prefixes parse
+    secp256k1_pubkey pubkey;
+    if (!secp256k1_ec_pubkey_parse(ctx, &pubkey, material, 33)) {
+      return "invalid public key";
+    }
+  }
+  return nullptr;
+}
+
+void extendedKeyFingerprint(const uint8_t* key, uint8_t* fingerprint) {
+  const uint8_t* material = key + 45;
+  uint8_t publicKey[33];
+  if (material[0] == 0) {
+    derivePublicKeyInto(material + 1, publicKey, true);
+  } else {
+    std::copy(material, material + 33, publicKey);
+  }
+  uint8_t sha[32];
+  uint8_t hash160[20];
+  hashInto(HashKind::Sha256, publicKey, sizeof(publicKey), sha);
+  hashInto(HashKind::Ripemd160, sha, sizeof(sha), hash160);
+  std::copy(hash160, hash160 + 4, fingerprint);
+}
+
+} // namespace margelo::nitro::metamask_nativeutils
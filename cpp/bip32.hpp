@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace margelo::nitro::metamask_nativeutils {
+
+// BIP32 extended keys in their 78-byte serialization: version (4 bytes),
+// depth (1), parent fingerprint (4), child number (4), chain code (32), then
+// either a compressed public key or 0x00 and a private key (33), all
+// big-endian. Encoded as Base58Check they are the familiar xpub/xprv strings.
+static constexpr size_t kExtendedKeySize = 78;
+
+/**
+ * Validate an extended key: a known version (xpub/xprv, ypub/yprv,
+ * zpub/zprv and their testnet counterparts tpub, upub and vpub), a valid
+ * compressed point for public versions or a valid scalar behind 0x00 for
+ * private ones, and a zero parent fingerprint and child number at depth 0.
+ * @param key 78-byte serialization
+ * @return nullptr if valid, otherwise the reason it is not
+ */
+const char* extendedKeyError(const uint8_t* key);
+
+/**
+ * Fingerprint of an extended key, the value its children store as their
+ * parent fingerprint: the first 4 bytes of RIPEMD-160(SHA-256) of the
+ * compressed public key. Private keys are converted to theirs first.
+ * @param key A valid 78-byte serialization
+ * @param fingerprint Output buffer for 4 bytes
+ * @throws std::runtime_error if the key material is invalid
+ */
+void extendedKeyFingerprint(const uint8_t* key, uint8_t* fingerprint);
+
+} // namespace margelo::nitro::metamask_nativeutils
@@ -0,0 +1,340 @@
+#include "bip322.hpp"
+#include "base64.hpp"
+#include "bech32.hpp"
+#include "botan_conditional.h"
+#include "hash_utils.hpp"
+#include "secp256k1_utils.hpp"
+#include "secp256k1/include/secp256k1_extrakeys.h"
+#include "secp256k1/include/secp256k1_schnorrsig.h"
+#include <cstring>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace margelo::nitro::metamask_nativeutils {
+
+// Hash types: SIGHASH_DEFAULT exists for taproot only and is implied by a
+// 64-byte signature
+static constexpr uint8_t kSighashDefault = 0x00;
+static constexpr uint8_t kSighashAll = 0x01;
+
+// The one output of `to_sign`: zero value, script OP_RETURN
+static constexpr uint8_t kToSignOutputs[] = {0, 0, 0, 0, 0, 0, 0, 0, 0x01, 0x6a};
+
+using Bytes = std::vector<uint8_t>;
+
+static void append(Bytes& out, const uint8_t* data, size_t size) {
+  out.insert(out.end(), data, data + size);
+}
+
+static void appendLe32(Bytes& out, uint32_t value) {
+  for (int i = 0; i < 4; i++) {
+    out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+  }
+}
+
+static void sha256(const uint8_t* data, size_t size, uint8_t* out) {
+  hashInto(HashKind::Sha256, data, size, out);
+}
+
+static void doubleSha256(const uint8_t* data, size_t size, uint8_t* out) {
+  sha256(data, size, out);
+  sha256(out, 32, out);
+}
+
+// BIP340 tagged hash: SHA256(SHA256(tag) || SHA256(tag) || data)
+static void taggedHash(const char* tag, const uint8_t* data, size_t size, uint8_t* out) {
+  Bytes buffer(64);
+  sha256(reinterpret_cast<const uint8_t*>(tag), std::strlen(tag), buffer.data());
+  std::memcpy(buffer.data() + 32, buffer.data(), 32);
+  append(buffer, data, size);
+  sha256(buffer.data(), buffer.size(), out);
+}
+
+static void hash160(const uint8_t* data, size_t size, uint8_t* out) {
+  uint8_t sha[32];
+  sha256(data, size, sha);
+  hashInto(HashKind::Ripemd160, sha, sizeof(sha), out);
+}
+
+namespace {
+
+// A supported address: its scriptPubKey, and the key hash (P2WPKH) or
+// output key (P2TR) it commits to
+struct Challenge {
+  bool isTaproot;
+  uint8_t script[34];
+  size_t scriptSize;
+  const uint8_t* program;
+};
+
+} // namespace
+
+static bool parseChallenge(const std::string& address, SegwitProgram& decoded, Challenge& challenge) {
+  if (!decodeSegwitAddress(address, decoded)) {
+    return false;
+  }
+  if (decoded.version == 0 && decoded.size == 20) {
+    challenge.isTaproot = false;
+  } else if (decoded.version == 1 && decoded.size == 32) {
+    challenge.isTaproot = true;
+  } else {
+    return false;
+  }
+  // OP_0 or OP_1, then a push of the program
+  challenge.script[0] = challenge.isTaproot ? 0x51 : 0x00;
+  challenge.script[1] = static_cast<uint8_t>(decoded.size);
+  std::memcpy(challenge.script + 2, decoded.program, decoded.size);
+  challenge.scriptSize = decoded.size + 2;
+  challenge.program = decoded.program;
+  return true;
+}
+
+// txid of `to_spend`: version 0, one input spending the null outpoint with
+// scriptSig OP_0 PUSH32[message hash], one zero-value output to the address
+static void toSpendTxid(const Challenge& challenge, const uint8_t* message, size_t size, uint8_t* txid) {
+  uint8_t messageHash[32];
+  taggedHash("BIP0322-signed-message", message, size, messageHash);
+  Bytes tx;
+  tx.reserve(128);
+  appendLe32(tx, 0);
+  tx.push_back(0x01);
+  tx.insert(tx.end(), 32, 0);
+  appendLe32(tx, 0xffffffff);
+  tx.push_back(0x22);
+  tx.push_back(0x00);
+  tx.push_back(0x20);
+  append(tx, messageHash, 32);
+  appendLe32(tx, 0);
+  tx.push_back(0x01);
+  tx.insert(tx.end(), 8, 0);
+  tx.push_back(static_cast<uint8_t>(challenge.scriptSize));
+  append(tx, challenge.script, challenge.scriptSize);
+  appendLe32(tx, 0);
+  doubleSha256(tx.data(), tx.size(), txid);
+}
+
+// BIP143 sighash of `to_sign`'s input, with SIGHASH_ALL
+static void segwitV0Sighash(const uint8_t* txid, const uint8_t* keyHash, uint8_t* sighash) {
+  uint8_t outpoint[36] = {};
+  std::memcpy(outpoint, txid, 32);
+  const uint8_t sequence[4] = {};
+  Bytes preimage;
+  preimage.reserve(160);
+  appendLe32(preimage, 0);
+  uint8_t digest[32];
+  doubleSha256(outpoint, sizeof(outpoint), digest);
+  append(preimage, digest, 32);
+  doubleSha256(sequence, sizeof(sequence), digest);
+  append(preimage, digest, 32);
+  append(preimage, outpoint, sizeof(outpoint));
+  // scriptCode: the P2PKH script of the key hash
+  const uint8_t scriptCodeHead[] = {0x19, 0x76, 0xa9, 0x14};
+  append(preimage, scriptCodeHead, sizeof(scriptCodeHead));
+  append(preimage, keyHash, 20);
+  preimage.push_back(0x88);
+  preimage.push_back(0xac);
+  preimage.insert(preimage.end(), 8, 0); // amount
+  appendLe32(preimage, 0);               // nSequence
+  doubleSha256(kToSignOutputs, sizeof(kToSignOutputs), digest);
+  append(preimage, digest, 32);
+  appendLe32(preimage, 0); // nLockTime
+  appendLe32(preimage, kSighashAll);
+  doubleSha256(preimage.data(), preimage.size(), sighash);
+}
+
+// BIP341 key path sighash of `to_sign`'s input
+static void taprootSighash(const uint8_t* txid, const Challenge& challenge, uint8_t hashType, uint8_t* sighash) {
+  uint8_t outpoint[36] = {};
+  std::memcpy(outpoint, txid, 32);
+  const uint8_t zeros[8] = {};
+  Bytes message;
+  message.reserve(180);
+  message.push_back(0x00); // epoch
+  message.push_back(hashType);
+  appendLe32(message, 0); // nVersion
+  appendLe32(message, 0); // nLockTime
+  uint8_t digest[32];
+  sha256(outpoint, sizeof(outpoint), digest);
+  append(message, digest, 32);
+  sha256(zeros, 8, digest); // amounts
+  append(message, digest, 32);
+  uint8_t scripts[35];
+  scripts[0] = static_cast<uint8_t>(challenge.scriptSize);
+  std::memcpy(scripts + 1, challenge.script, challenge.scriptSize);
+  sha256(scripts, challenge.scriptSize + 1, digest);
+  append(message, digest, 32);
+  sha256(zeros, 4, digest); // sequences
+  append(message, digest, 32);
+  sha256(kToSignOutputs, sizeof(kToSignOutputs), digest);
+  append(message, digest, 32);
+  message.push_back(0x00); // key path, no annex
+  appendLe32(message, 0);  // input index
+  taggedHash("TapSighash", message.data(), message.size(), sighash);
+}
+
+static std::string encodeWitness(const std::vector<Bytes>& items) {
+  Bytes witness;
+  witness.push_back(static_cast<uint8_t>(items.size()));
+  for (const Bytes& item : items) {
+    witness.push_back(static_cast<uint8_t>(item.size()));
+    append(witness, item.data(), item.size());
+  }
+  return base64Encode(witness.data(), witness.size());
+}
+
+// Split a serialized witness stack into items; the lengths used here are
+// all below 0xfd, so larger CompactSize forms are rejected
+static bool decodeWitness(const Bytes& witness, std::vector<Bytes>& items) {
+  if (witness.empty() || witness[0] >= 0xfd) {
+    return false;
+  }
+  size_t count = witness[0];
+  size_t offset = 1;
+  items.clear();
+  for (size_t i = 0; i < count; i++) {
+    if (offset >= witness.size() || witness[offset] >= 0xfd) {
+      return false;
+    }
+    size_t length = witness[offset++];
+    if (witness.size() - offset < length) {
+      return false;
+    }
+    items.emplace_back(witness.begin() + offset, witness.begin() + offset + length);
+    offset += length;
+  }
+  return offset == witness.size();
+}
+
+std::string bip322Sign(const uint8_t* privateKey, const std::string& address, const uint8_t* message, size_t size) {
+  const secp256k1_context* ctx = secp256k1Context();
+  if (!secp256k1_ec_seckey_verify(ctx, privateKey)) {
+    throw std::runtime_error("Invalid private key");
+  }
+  SegwitProgram decoded;
+  Challenge challenge;
+  if (!parseChallenge(address, decoded, challenge)) {
+    throw std::runtime_error("Not a P2WPKH or P2TR address: " + address);
+  }
+  uint8_t txid[32];
+  toSpendTxid(challenge, message, size, txid);
+  uint8_t sighash[32];
+
+  if (!challenge.isTaproot) {
+    Bytes publicKey(33);
+    derivePublicKeyInto(privateKey, publicKey.data(), true);
+    uint8_t keyHash[20];
+    hash160(publicKey.data(), publicKey.size(), keyHash);
+    if (std::memcmp(keyHash, challenge.program, 20) != 0) {
+      throw std::runtime_error("Private key does not control address " + address);
+    }
+    segwitV0Sighash(txid, keyHash, sighash);
+    // Grind for a low r like Bitcoin Core, which saves a DER byte and makes
+    // signatures match Core's: retry RFC 6979 with a counter as extra data
+    secp256k1_ecdsa_signature signature;
+    uint8_t extraData[32] = {};
+    uint8_t compact[64];
+    for (uint32_t counter = 0;; counter++) {
+      for (int i = 0; i < 4; i++) {
+        extraData[i] = static_cast<uint8_t>(counter >> (8 * i));
+      }
+      if (!secp256k1_ecdsa_sign(ctx, &signature, sighash, privateKey, nullptr, counter == 0 ? nullptr : extraData)) {
+        throw std::runtime_error("Failed to sign message");
+      }
+      secp256k1_ecdsa_signature_serialize_compact(ctx, compact, &signature);
+      if (compact[0] < 0x80) {
+        break;
+      }
+    }
+    Bytes der(72);
+    size_t derSize = der.size();
+    secp256k1_ecdsa_signature_serialize_der(ctx, der.data(), &derSize, &signature);
+    der.resize(derSize);
+    der.push_back(kSighashAll);
+    return encodeWitness({der, publicKey});
+  }
+
+  // BIP86 output key: the internal key tweaked by its own TapTweak hash
+  secp256k1_keypair keypair;
+  secp256k1_xonly_pubkey xonly;
+  uint8_t internalKey[32];
+  uint8_t tweak[32];
+  uint8_t outputKey[32];
+  bool tweaked = secp256k1_keypair_create(ctx, &keypair, privateKey) &&
+                 secp256k1_keypair_xonly_pub(ctx, &xonly, nullptr, &keypair) &&
+                 secp256k1_xonly_pubkey_serialize(ctx, internalKey, &xonly);
+  if (tweaked) {
+    taggedHash("TapTweak", internalKey, 32, tweak);
+    tweaked = secp256k1_keypair_xonly_tweak_add(ctx, &keypair, tweak) &&
+              secp256k1_keypair_xonly_pub(ctx, &xonly, nullptr, &keypair) &&
+              secp256k1_xonly_pubkey_serialize(ctx, outputKey, &xonly);
+  }
+  if (!tweaked || std::memcmp(outputKey, challenge.program, 32) != 0) {
+    Botan::secure_scrub_memory(&keypair, sizeof(keypair));
+    throw std::runtime_error(tweaked ? "Private key does not control address " + address
+                                     : std::string("Failed to tweak private key"));
+  }
+  taprootSighash(txid, challenge, kSighashDefault, sighash);
+  uint8_t auxRandom[32];
+  std::random_device random;
+  for (size_t i = 0; i < sizeof(auxRandom); i += 4) {
+    uint32_t word = random();
+    std::memcpy(auxRandom + i, &word, 4);
+  }
+  Bytes signature(64);
+  bool signedOk = secp256k1_schnorrsig_sign32(ctx, signature.data(), sighash, &keypair, auxRandom);
+  Botan::secure_scrub_memory(&keypair, sizeof(keypair));
+  if (!signedOk) {
+    throw std::runtime_error("Failed to sign message");
+  }
+  return encodeWitness({signature});
+}
+
+bool bip322Verify(const std::string& address, const uint8_t* message, size_t size, const std::string& signature) {
+  SegwitProgram decoded;
+  Challenge challenge;
+  Bytes witness;
+  std::vector<Bytes> items;
+  if (!parseChallenge(address, decoded, challenge) ||
+      !base64Decode(signature.data(), signature.size(), witness) || !decodeWitness(witness, items)) {
+    return false;
+  }
+  const secp256k1_context* ctx = secp256k1Context();
+  uint8_t txid[32];
+  uint8_t sighash[32];
+
+  if (!challenge.isTaproot) {
+    // [DER signature || hash type, compressed public key]
+    if (items.size() != 2 || items[0].empty() || items[0].back() != kSighashAll || items[1].size() != 33) {
+      return false;
+    }
+    uint8_t keyHash[20];
+    hash160(items[1].data(), 33, keyHash);
+    secp256k1_ecdsa_signature parsed;
+    secp256k1_pubkey publicKey;
+    if (std::memcmp(keyHash, challenge.program, 20) != 0 ||
+        !secp256k1_ecdsa_signature_parse_der(ctx, &parsed, items[0].data(), items[0].size() - 1) ||
+        !secp256k1_ec_pubkey_parse(ctx, &publicKey, items[1].data(), 33)) {
+      return false;
+    }
+    toSpendTxid(challenge, message, size, txid);
+    segwitV0Sighash(txid, keyHash, sighash);
+    // High-s signatures fail here, as under Bitcoin's standardness rules
+    return secp256k1_ecdsa_verify(ctx, &parsed, sighash, &publicKey) == 1;
+  }
+
+  // [Schnorr signature], with an explicit hash type only if not the default
+  if (items.size() != 1 || (items[0].size() != 64 && (items[0].size() != 65 || items[0][64] != kSighashAll))) {
+    return false;
+  }
+  uint8_t hashType = items[0].size() == 65 ? kSighashAll : kSighashDefault;
+  secp256k1_xonly_pubkey outputKey;
+  if (!secp256k1_xonly_pubkey_parse(ctx, &outputKey, challenge.program)) {
+    return false;
+  }
+  toSpendTxid(challenge, message, size, txid);
+  taprootSighash(txid, challenge, hashType, sighash);
+  return secp256k1_schnorrsig_verify(ctx, items[0].data(), sighash, 32, &outputKey) == 1;
+}
+
+} // namespace margelo::nitro::metamask_nativeutils
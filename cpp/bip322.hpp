@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace margelo::nitro::metamask_nativeutils {
+
+// BIP322 generic message signing for single-key segwit addresses. A message
+// is signed by spending a virtual `to_spend` output locked to the address,
+// whose input commits to the tagged hash of the message, in a `to_sign`
+// transaction; the signature is that input's witness. Only the "simple"
+// format (the base64 witness stack) is produced and accepted, with
+// SIGHASH_ALL for P2WPKH and SIGHASH_DEFAULT or SIGHASH_ALL for P2TR key
+// path spends.
+
+/**
+ * Sign a message for a P2WPKH or P2TR address. P2WPKH signatures use
+ * RFC 6979 nonces ground for a low r as Bitcoin Core does, so they match
+ * Core's byte for byte; P2TR signatures use fresh auxiliary randomness and
+ * the BIP86 tweak of the key (no script tree).
+ * @param privateKey 32-byte private key controlling the address
+ * @param address bech32 P2WPKH or bech32m P2TR address
+ * @param message Message bytes
+ * @param size Number of message bytes
+ * @return The base64 "simple" signature
+ * @throws std::runtime_error if the key is invalid, the address is not a
+ *   P2WPKH or P2TR address, or the key does not control it
+ */
+std::string bip322Sign(const uint8_t* privateKey, const std::string& address, const uint8_t* message, size_t size);
+
+/**
+ * Verify a "simple" BIP322 signature. Malformed input is treated as an
+ * invalid signature rather than an error, so batches can be checked
+ * without exceptions.
+ * @param address bech32 P2WPKH or bech32m P2TR address
+ * @param message Message bytes
+ * @param size Number of message bytes
+ * @param signature Base64 witness stack
+ * @return true if the witness validly spends the address's `to_spend`
+ *   output for this message
+ */
+bool bip322Verify(const std::string& address, const uint8_t* message, size_t size, const std::string& signature);
+
+} // namespace margelo::nitro::metamask_nativeutils
@@ -0,0 +1,43 @@
+#include "bloom_utils.hpp"
+#include "keccak_utils.hpp"
+#include <algorithm>
+
+namespace margelo::nitro::metamask_nativeutils {
+
+BloomBits bloomBits(const uint8_t* item, size_t size) {
+  uint8_t hash[32];
+  keccak256(item, size, hash);
+
+  // Each of the first three 16-bit big-endian words of the hash selects a bit
+  // (mod 2048); bit 0 is the lowest bit of the last bloom byte
+  BloomBits bits;
+  for (size_t i = 0; i < 3; i++) {
+    uint32_t bit = ((static_cast<uint32_t>(hash[2 * i]) << 8) | hash[2 * i + 1]) & 2047;
+    bits.offsets[i] = static_cast<uint8_t>(kBloomSize - 1 - bit / 8);
+    bits.masks[i] = static_cast<uint8_t>(1u << (bit % 8));
+  }
+  return bits;
+}
+
+void bloomAddItems(uint8_t* bloom, const uint8_t* items, size_t count, size_t itemSize) {
+  for (size_t i = 0; i < count; i++) {
+    bloomAdd(bloom, bloomBits(items + i * itemSize, itemSize));
+  }
+}
+
+void bloomMatchAny(const uint8_t* blooms, size_t count, const std::vector<BloomBits>& queries, uint8_t* bitmap) {
+  if (queries.empty()) {
+    return;
+  }
+
+  for (size_t i = 0; i < count; i++) {
+    const uint8_t* bloom = blooms + i * kBloomSize;
+    bool matched = std::any_of(queries.begin(), queries.end(),
+                               [bloom](const BloomBits& bits) { return bloomMayContain(bloom, bits); });
+    if (matched) {
+      bitmap[i / 8] |= static_cast<uint8_t>(1u << (i % 8));
+    }
+  }
+}
+
+} // namespace margelo::nitro::metamask_nativeutils
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace margelo::nitro::metamask_nativeutils {
+
+// Size of an Ethereum logsBloom (2048 bits)
+constexpr size_t kBloomSize = 256;
+
+/**
+ * The three bloom bits an item sets, as byte offsets into the 256-byte bloom
+ * and masks within those bytes. Computing them costs one Keccak-256, so they
+ * are derived once per item and reused for every bloom tested.
+ */
+struct BloomBits {
+  uint8_t offsets[3];
+  uint8_t masks[3];
+};
+
+/**
+ * Derive the bloom bits of an item (an address or a topic).
+ * @param item Item bytes
+ * @param size Number of item bytes
+ */
+BloomBits bloomBits(const uint8_t* item, size_t size);
+
+/** Set an item's bits in a 256-byte bloom. */
+inline void bloomAdd(uint8_t* bloom, const BloomBits& bits) {
+  bloom[bits.offsets[0]] |= bits.masks[0];
+  bloom[bits.offsets[1]] |= bits.masks[1];
+  bloom[bits.offsets[2]] |= bits.masks[2];
+}
+
+/** Whether all of an item's bits are set in a 256-byte bloom. */
+inline bool bloomMayContain(const uint8_t* bloom, const BloomBits& bits) {
+  // Branch-free so the three loads issue together
+  return ((bloom[bits.offsets[0]] & bits.masks[0]) != 0) & ((bloom[bits.offsets[1]] & bits.masks[1]) != 0) &
+         ((bloom[bits.offsets[2]] & bits.masks[2]) != 0);
+}
+
+/**
+ * Add equally sized packed items to a bloom.
+ * @param bloom 256-byte bloom to update
+ * @param items Packed items
+ * @param count Number of items
+ * @param itemSize Size of each item
+ */
+void bloomAddItems(uint8_t* bloom, const uint8_t* items, size_t count, size_t itemSize);
+
+/**
+ * Test packed blooms against a set of queries.
+ * @param blooms `count` packed 256-byte blooms
+ * @param count Number of blooms
+ * @param queries Bits of the query items
+ * @param bitmap Zeroed output of (count + 7) / 8 bytes; bit i is set if
+ *   bloom i may contain at least one query
+ */
+void bloomMatchAny(const uint8_t* blooms, size_t count, const std::vector<BloomBits>& queries, uint8_t* bitmap);
+
+} // namespace margelo::nitro::metamask_nativeutils
@@ -0,0 +1,50 @@
+#include "chunk_stream.hpp"
+
+namespace margelo::nitro::metamask_nativeutils {
+
+bool ChunkStream::acquire() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  cv_.wait(lock, [this]() { return cancelled_ || inFlight_ < maxInFlight_; });
+  if (cancelled_) {
+    return false;
+  }
+  inFlight_++;
+  return true;
+}
+
+void ChunkStream::track(const std::shared_ptr<Promise<bool>>& ack) {
+  // Listeners keep the stream alive until the JS side has answered
+  auto self = shared_from_this();
+  ack->addOnResolvedListener([self](const bool& keepGoing) {
+    self->settle(keepGoing, nullptr);
+  });
+  ack->addOnRejectedListener([self](const std::exception_ptr& error) {
+    self->settle(false, error);
+  });
+}
+
+void ChunkStream::fail(std::exception_ptr error) {
+  settle(false, error);
+}
+
+void ChunkStream::drain() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  cv_.wait(lock, [this]() { return inFlight_ == 0; });
+  if (error_) {
+    std::rethrow_exception(error_);
+  }
+}
+
+void ChunkStream::settle(bool keepGoing, std::exception_ptr error) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  inFlight_--;
+  if (!keepGoing) {
+    cancelled_ = true;
+  }
+  if (error && !error_) {
+    error_ = error;
+  }
+  cv_.notify_all();
+}
+
+} // namespace margelo::nitro::metamask_nativeutils
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <NitroModules/Promise.hpp>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+
+namespace margelo::nitro::metamask_nativeutils {
+
+/**
+ * Flow control for streaming batch results to a JS callback.
+ *
+ * Every delivered chunk is tracked by the Promise Nitro returns for the JS
+ * callback invocation. The producing worker blocks once `maxInFlight` chunks
+ * are waiting on the JS thread, so a fast native producer can never queue
+ * more than a bounded number of callbacks. The callback returning `false`
+ * (or throwing) cancels the stream.
+ */
+class ChunkStream : public std::enable_shared_from_this<ChunkStream> {
+public:
+  explicit ChunkStream(size_t maxInFlight) : maxInFlight_(maxInFlight) {}
+
+  /**
+   * Block until another chunk may be delivered.
+   * @return false if the stream was cancelled by the consumer
+   */
+  bool acquire();
+
+  /**
+   * Track the acknowledgement of a delivered chunk.
+   * @param ack Promise returned by the JS callback invocation
+   */
+  void track(const std::shared_ptr<Promise<bool>>& ack);
+
+  /**
+   * Release a slot taken by acquire() whose chunk could not be delivered.
+   * @param error Error to surface from drain()
+   */
+  void fail(std::exception_ptr error);
+
+  /**
+   * Block until every delivered chunk has been acknowledged.
+   * @throws The error raised by the JS callback, if any
+   */
+  void drain();
+
+private:
+  void settle(bool keepGoing, std::exception_ptr error);
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  size_t maxInFlight_;
+  size_t inFlight_ = 0;
+  bool cancelled_ = false;
+  std::exception_ptr error_;
+};
+
+} // namespace margelo::nitro::metamask_nativeutils
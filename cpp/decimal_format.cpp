@@ -0,0 +1,59 @@
+#include "decimal_format.hpp"
+
+namespace margelo::nitro::metamask_nativeutils {
+
+// 10^9, the largest power of ten whose remainders fit a 32-bit limb
+static constexpr uint64_t kNineDigits = 1000000000;
+
+std::string formatDecimalAmount(const uint8_t* bytes, size_t size, unsigned decimals) {
+  // Big-endian 32-bit limbs of the value
+  uint32_t limbs[4] = {0, 0, 0, 0};
+  for (size_t i = 0; i < size && i < 16; i++) {
+    limbs[3 - i / 4] |= static_cast<uint32_t>(bytes[i]) << (8 * (i % 4));
+  }
+
+  // Peel off nine digits at a time, least significant group first
+  char digits[48];
+  size_t count = 0;
+  size_t top = 0;
+  while (top < 4 && limbs[top] == 0) {
+    top++;
+  }
+  while (top < 4) {
+    uint64_t remainder = 0;
+    for (size_t i = top; i < 4; i++) {
+      uint64_t current = (remainder << 32) | limbs[i];
+      limbs[i] = static_cast<uint32_t>(current / kNineDigits);
+      remainder = current % kNineDigits;
+    }
+    while (top < 4 && limbs[top] == 0) {
+      top++;
+    }
+    for (int k = 0; k < 9 && (top < 4 || remainder != 0); k++) {
+      digits[count++] = static_cast<char>('0' + remainder % 10);
+      remainder /= 10;
+    }
+  }
+
+  // Digits are least significant first; pad so there is a units digit
+  std::string text;
+  size_t width = count > decimals ? count : decimals + 1;
+  text.reserve(width + 1);
+  for (size_t i = width; i-- > 0;) {
+    text.push_back(i < count ? digits[i] : '0');
+    if (i == decimals && decimals > 0) {
+      text.push_back('.');
+    }
+  }
+  if (decimals > 0) {
+    while (text.back() == '0') {
+      text.pop_back();
+    }
+    if (text.back() == '.') {
+      text.pop_back();
+    }
+  }
+  return text;
+}
+
+} // namespace margelo::nitro::metamask_nativeutils
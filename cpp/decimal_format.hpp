@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace margelo::nitro::metamask_nativeutils {
+
+/**
+ * Format an unsigned integer of up to 128 bits as a decimal amount with
+ * `decimals` fractional digits, trimmed like Solana's `uiAmountString`:
+ * 1500000 with 6 decimals is "1.5", 2000000 is "2" and 5 is "0.000005".
+ * Conversion runs on 32-bit limbs, so it needs no 128-bit integer type.
+ * @param bytes Little-endian integer bytes
+ * @param size Number of bytes, at most 16
+ * @param decimals Number of digits after the decimal point
+ * @return The decimal string
+ */
+std::string formatDecimalAmount(const uint8_t* bytes, size_t size, unsigned decimals);
+
+} // namespace margelo::nitro::metamask_nativeutils
@@ -0,0 +1,622 @@
+#include "ed25519.hpp"
+#include "botan_conditional.h"
+
+#if defined(NATIVEUTILS_ED25519_TABLES)
+#include "hash_utils.hpp"
+#include "memory_trim.hpp"
+#include "simd_utils.hpp"
+#include <cstring>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+#endif
+
+namespace margelo::nitro::metamask_nativeutils {
+
+// The field arithmetic is shared by both backends: the table backend builds
+// on it, and point decoding uses it everywhere since Botan keeps its own
+// internal
+#if defined(__SIZEOF_INT128__)
+using u128 = unsigned __int128;
+#else
+// Just enough of a 128-bit integer for the field code on 32-bit targets:
+// sums of 64x64-bit products, right shifts below 64 and truncation
+struct u128 {
+  uint64_t lo, hi;
+
+  u128(uint64_t value = 0) : lo(value), hi(0) {}
+
+  explicit operator uint64_t() const {
+    return lo;
+  }
+
+  // Only ever called on values below 2^64
+  friend u128 operator*(u128 a, u128 b) {
+    uint64_t a0 = a.lo & 0xffffffff, a1 = a.lo >> 32;
+    uint64_t b0 = b.lo & 0xffffffff, b1 = b.lo >> 32;
+    uint64_t p00 = a0 * b0, p01 = a0 * b1, p10 = a1 * b0, p11 = a1 * b1;
+    uint64_t middle = (p00 >> 32) + (p01 & 0xffffffff) + (p10 & 0xffffffff);
+    u128 r;
+    r.lo = (p00 & 0xffffffff) | (middle << 32);
+    r.hi = p11 + (p01 >> 32) + (p10 >> 32) + (middle >> 32);
+    return r;
+  }
+
+  friend u128 operator+(u128 a, u128 b) {
+    u128 r;
+    r.lo = a.lo + b.lo;
+    r.hi = a.hi + b.hi + (r.lo < a.lo);
+    return r;
+  }
+
+  u128& operator+=(u128 b) {
+    return *this = *this + b;
+  }
+
+  friend u128 operator>>(u128 a, int n) {
+    u128 r;
+    r.lo = (a.lo >> n) | (a.hi << (64 - n));
+    r.hi = a.hi >> n;
+    return r;
+  }
+};
+#endif
+
+static constexpr uint64_t kMask51 = (uint64_t(1) << 51) - 1;
+
+// Field element mod p = 2^255 - 19: five 51-bit limbs, little-endian. Limbs
+// may grow past 51 bits between carries; mul and sq accept limbs below 2^54.
+struct Fe {
+  uint64_t v[5];
+};
+
+static constexpr Fe kZero = {{0, 0, 0, 0, 0}};
+static constexpr Fe kOne = {{1, 0, 0, 0, 0}};
+// d = -121665 / 121666, the curve constant
+static constexpr Fe kD = {{0x34dca135978a3, 0x1a8283b156ebd, 0x5e7a26001c029, 0x739c663a03cbb, 0x52036cee2b6ff}};
+// A square root of -1
+static constexpr Fe kSqrtM1 = {{0x61b274a0ea0b0, 0x0d5a5fc8f189d, 0x7ef5e9cbd0c60, 0x78595a6804c9e, 0x2b8324804fc1d}};
+
+static inline Fe feAdd(const Fe& f, const Fe& g) {
+  return {{f.v[0] + g.v[0], f.v[1] + g.v[1], f.v[2] + g.v[2], f.v[3] + g.v[3], f.v[4] + g.v[4]}};
+}
+
+// f - g + 4p, which stays positive for limbs of g below 2^53
+static inline Fe feSub(const Fe& f, const Fe& g) {
+  return {{f.v[0] + 0x1fffffffffffb4 - g.v[0], f.v[1] + 0x1ffffffffffffc - g.v[1], f.v[2] + 0x1ffffffffffffc - g.v[2],
+           f.v[3] + 0x1ffffffffffffc - g.v[3], f.v[4] + 0x1ffffffffffffc - g.v[4]}};
+}
+
+// Carry every limb down to 51 bits, plus a small excess in the lowest
+static inline Fe feCarry(Fe h) {
+  uint64_t c;
+  c = h.v[0] >> 51, h.v[0] &= kMask51, h.v[1] += c;
+  c = h.v[1] >> 51, h.v[1] &= kMask51, h.v[2] += c;
+  c = h.v[2] >> 51, h.v[2] &= kMask51, h.v[3] += c;
+  c = h.v[3] >> 51, h.v[3] &= kMask51, h.v[4] += c;
+  c = h.v[4] >> 51, h.v[4] &= kMask51, h.v[0] += c * 19;
+  return h;
+}
+
+// Reduce the five 128-bit column sums of a product
+static inline Fe feReduce(u128 t0, u128 t1, u128 t2, u128 t3, u128 t4) {
+  Fe h;
+  t1 += static_cast<uint64_t>(t0 >> 51), h.v[0] = static_cast<uint64_t>(t0) & kMask51;
+  t2 += static_cast<uint64_t>(t1 >> 51), h.v[1] = static_cast<uint64_t>(t1) & kMask51;
+  t3 += static_cast<uint64_t>(t2 >> 51), h.v[2] = static_cast<uint64_t>(t2) & kMask51;
+  t4 += static_cast<uint64_t>(t3 >> 51), h.v[3] = static_cast<uint64_t>(t3) & kMask51;
+  h.v[4] = static_cast<uint64_t>(t4) & kMask51;
+  h.v[0] += static_cast<uint64_t>(t4 >> 51) * 19;
+  h.v[1] += h.v[0] >> 51, h.v[0] &= kMask51;
+  return h;
+}
+
+static inline Fe feMul(const Fe& f, const Fe& g) {
+  const uint64_t* a = f.v;
+  const uint64_t* b = g.v;
+  uint64_t b1 = b[1] * 19, b2 = b[2] * 19, b3 = b[3] * 19, b4 = b[4] * 19;
+  u128 t0 = (u128)a[0] * b[0] + (u128)a[1] * b4 + (u128)a[2] * b3 + (u128)a[3] * b2 + (u128)a[4] * b1;
+  u128 t1 = (u128)a[0] * b[1] + (u128)a[1] * b[0] + (u128)a[2] * b4 + (u128)a[3] * b3 + (u128)a[4] * b2;
+  u128 t2 = (u128)a[0] * b[2] + (u128)a[1] * b[1] + (u128)a[2] * b[0] + (u128)a[3] * b4 + (u128)a[4] * b3;
+  u128 t3 = (u128)a[0] * b[3] + (u128)a[1] * b[2] + (u128)a[2] * b[1] + (u128)a[3] * b[0] + (u128)a[4] * b4;
+  u128 t4 = (u128)a[0] * b[4] + (u128)a[1] * b[3] + (u128)a[2] * b[2] + (u128)a[3] * b[1] + (u128)a[4] * b[0];
+  return feReduce(t0, t1, t2, t3, t4);
+}
+
+static inline Fe feSq(const Fe& f) {
+  const uint64_t* a = f.v;
+  uint64_t d0 = a[0] * 2, d1 = a[1] * 2, d3 = a[3] * 2;
+  uint64_t a3_19 = a[3] * 19, a4_19 = a[4] * 19;
+  u128 t0 = (u128)a[0] * a[0] + (u128)d1 * a4_19 + (u128)(a[2] * 2) * a3_19;
+  u128 t1 = (u128)d0 * a[1] + (u128)(a[2] * 2) * a4_19 + (u128)a[3] * a3_19;
+  u128 t2 = (u128)d0 * a[2] + (u128)a[1] * a[1] + (u128)d3 * a4_19;
+  u128 t3 = (u128)d0 * a[3] + (u128)d1 * a[2] + (u128)a[4] * a4_19;
+  u128 t4 = (u128)d0 * a[4] + (u128)d1 * a[3] + (u128)a[2] * a[2];
+  return feReduce(t0, t1, t2, t3, t4);
+}
+
+static inline Fe feSqN(Fe f, int n) {
+  for (int i = 0; i < n; i++) {
+    f = feSq(f);
+  }
+  return f;
+}
+
+// z^(2^250 - 1), the common part of ref10's inversion and square root
+// addition chains; z^11 is left in `z11` for the inversion
+static Fe fePow2_250_1(const Fe& z, Fe& z11) {
+  Fe z2 = feSq(z);
+  Fe z9 = feMul(feSqN(z2, 2), z);
+  z11 = feMul(z9, z2);
+  Fe z2_5_0 = feMul(feSq(z11), z9);
+  Fe z2_10_0 = feMul(feSqN(z2_5_0, 5), z2_5_0);
+  Fe z2_20_0 = feMul(feSqN(z2_10_0, 10), z2_10_0);
+  Fe z2_40_0 = feMul(feSqN(z2_20_0, 20), z2_20_0);
+  Fe z2_50_0 = feMul(feSqN(z2_40_0, 10), z2_10_0);
+  Fe z2_100_0 = feMul(feSqN(z2_50_0, 50), z2_50_0);
+  Fe z2_200_0 = feMul(feSqN(z2_100_0, 100), z2_100_0);
+  return feMul(feSqN(z2_200_0, 50), z2_50_0);
+}
+
+// z^((p - 5) / 8) = z^(2^252 - 3), for square roots
+static Fe fePow22523(const Fe& z) {
+  Fe z11;
+  return feMul(feSqN(fePow2_250_1(z, z11), 2), z);
+}
+
+// Canonical little-endian encoding
+static void feToBytes(const Fe& f, uint8_t* out) {
+  Fe h = feCarry(feCarry(f));
+  // h < 2p now, so h >= p exactly when h + 19 carries into bit 255
+  uint64_t q = (h.v[0] + 19) >> 51;
+  q = (h.v[1] + q) >> 51;
+  q = (h.v[2] + q) >> 51;
+  q = (h.v[3] + q) >> 51;
+  q = (h.v[4] + q) >> 51;
+  h.v[0] += 19 * q;
+  h.v[1] += h.v[0] >> 51, h.v[0] &= kMask51;
+  h.v[2] += h.v[1] >> 51, h.v[1] &= kMask51;
+  h.v[3] += h.v[2] >> 51, h.v[2] &= kMask51;
+  h.v[4] += h.v[3] >> 51, h.v[3] &= kMask51;
+  h.v[4] &= kMask51;
+
+  uint64_t words[4] = {h.v[0] | (h.v[1] << 51), (h.v[1] >> 13) | (h.v[2] << 38), (h.v[2] >> 26) | (h.v[3] << 25),
+                       (h.v[3] >> 39) | (h.v[4] << 12)};
+  for (int i = 0; i < 4; i++) {
+    for (int j = 0; j < 8; j++) {
+      out[i * 8 + j] = static_cast<uint8_t>(words[i] >> (8 * j));
+    }
+  }
+}
+
+// Little-endian decoding of the low 255 bits; values up to 2^255 - 1 are
+// accepted unreduced
+static Fe feFromBytes(const uint8_t* in) {
+  uint64_t w[4];
+  for (int i = 0; i < 4; i++) {
+    w[i] = 0;
+    for (int j = 0; j < 8; j++) {
+      w[i] |= static_cast<uint64_t>(in[i * 8 + j]) << (8 * j);
+    }
+  }
+  return {{w[0] & kMask51, ((w[0] >> 51) | (w[1] << 13)) & kMask51, ((w[1] >> 38) | (w[2] << 26)) & kMask51,
+           ((w[2] >> 25) | (w[3] << 39)) & kMask51, (w[3] >> 12) & kMask51}};
+}
+
+static bool feIsZero(const Fe& f) {
+  uint8_t bytes[32];
+  feToBytes(f, bytes);
+  uint8_t bits = 0;
+  for (uint8_t byte : bytes) {
+    bits |= byte;
+  }
+  return bits == 0;
+}
+
+#if defined(NATIVEUTILS_ED25519_TABLES)
+
+// 2 * d
+static constexpr Fe kD2 = {{0x69b9426b2f159, 0x35050762add7a, 0x3cf44c0038052, 0x6738cc7407977, 0x2406d9dc56dff}};
+static constexpr Fe kBaseX = {{0x62d608f25d51a, 0x412a4b4f6592a, 0x75b7171a4b31d, 0x1ff60527118fe, 0x216936d3cd6e5}};
+static constexpr Fe kBaseY = {{0x6666666666658, 0x4cccccccccccc, 0x1999999999999, 0x3333333333333, 0x6666666666666}};
+
+// z^(p - 2)
+static Fe feInvert(const Fe& z) {
+  Fe z11;
+  return feMul(feSqN(fePow2_250_1(z, z11), 5), z11);
+}
+
+// Extended coordinates: x = X/Z, y = Y/Z, x * y = T/Z
+struct PointP3 {
+  Fe X, Y, Z, T;
+};
+
+// Completed coordinates, the output of an addition before conversion
+struct PointP1P1 {
+  Fe X, Y, Z, T;
+};
+
+// Affine point prepared for mixed addition: (y + x, y - x, 2 * d * x * y).
+// One table entry; the pad keeps entries a whole number of vectors.
+struct Precomp {
+  Fe yPlusX, yMinusX, xy2d;
+  uint64_t pad;
+};
+static_assert(sizeof(Precomp) == 16 * sizeof(uint64_t));
+
+static constexpr size_t kPrecompWords = sizeof(Precomp) / sizeof(uint64_t);
+
+static inline PointP3 toP3(const PointP1P1& p) {
+  return {feMul(p.X, p.T), feMul(p.Y, p.Z), feMul(p.Z, p.T), feMul(p.X, p.Y)};
+}
+
+// p + q for an affine q: 7 multiplications in all with the conversion
+static inline PointP3 addMixed(const PointP3& p, const Precomp& q) {
+  Fe a = feMul(feAdd(p.Y, p.X), q.yPlusX);
+  Fe b = feMul(feSub(p.Y, p.X), q.yMinusX);
+  Fe c = feMul(q.xy2d, p.T);
+  Fe d = feAdd(p.Z, p.Z);
+  return toP3({feSub(a, b), feAdd(a, b), feAdd(d, c), feSub(d, c)});
+}
+
+// p + q for a general q, only used to build the table
+static PointP3 addFull(const PointP3& p, const PointP3& q) {
+  Fe a = feMul(feAdd(p.Y, p.X), feAdd(q.Y, q.X));
+  Fe b = feMul(feSub(p.Y, p.X), feSub(q.Y, q.X));
+  Fe c = feMul(feMul(p.T, kD2), q.T);
+  Fe zz = feMul(p.Z, q.Z);
+  Fe d = feAdd(zz, zz);
+  return toP3({feSub(a, b), feAdd(a, b), feAdd(d, c), feSub(d, c)});
+}
+
+static PointP3 doublePoint(const PointP3& p) {
+  Fe xx = feSq(p.X);
+  Fe yy = feSq(p.Y);
+  Fe zz = feSq(p.Z);
+  Fe b = feCarry(feAdd(zz, zz));
+  Fe a = feSq(feAdd(p.X, p.Y));
+  Fe y = feCarry(feAdd(yy, xx));
+  Fe z = feCarry(feSub(yy, xx));
+  return toP3({feSub(a, y), y, z, feSub(b, z)});
+}
+
+// Signed digits of 5 bits, each in [-16, 16) except the last, which takes
+// the final carry: 52 digits cover the 255-bit clamped scalar. Wider windows
+// mean fewer additions but longer constant-time scans; 5 bits measured best
+// of 4 to 7.
+static constexpr int kWindowBits = 5;
+static constexpr size_t kWindows = (256 + kWindowBits - 1) / kWindowBits;
+static constexpr size_t kEntriesPerWindow = size_t(1) << (kWindowBits - 1);
+
+static constexpr size_t kBaseTableBytes = kWindows * kEntriesPerWindow * sizeof(Precomp);
+
+// Entry k of window i is (k + 1) * 2^(5i) * B
+static std::vector<Precomp> buildBaseTable() {
+  std::vector<PointP3> points(kWindows * kEntriesPerWindow);
+  PointP3 base = {kBaseX, kBaseY, kOne, feMul(kBaseX, kBaseY)};
+  for (size_t i = 0; i < kWindows; i++) {
+    PointP3 multiple = base;
+    for (size_t k = 0; k < kEntriesPerWindow; k++) {
+      points[i * kEntriesPerWindow + k] = multiple;
+      multiple = addFull(multiple, base);
+    }
+    for (int bit = 0; bit < kWindowBits; bit++) {
+      base = doublePoint(base);
+    }
+  }
+
+  // One inversion for all Z with Montgomery's trick
+  std::vector<Fe> prefix(points.size());
+  Fe product = kOne;
+  for (size_t i = 0; i < points.size(); i++) {
+    prefix[i] = product;
+    product = feMul(product, points[i].Z);
+  }
+  Fe inverse = feInvert(product);
+  std::vector<Precomp> entries(points.size());
+  for (size_t i = points.size(); i-- > 0;) {
+    Fe zInverse = feMul(inverse, prefix[i]);
+    inverse = feMul(inverse, points[i].Z);
+    Fe x = feMul(points[i].X, zInverse);
+    Fe y = feMul(points[i].Y, zInverse);
+    entries[i] = {feCarry(feAdd(y, x)), feCarry(feSub(y, x)), feMul(feMul(x, y), kD2), 0};
+  }
+  return entries;
+}
+
+namespace {
+
+// The table is built on first use. A critical memory trim drops it and the
+// next caller rebuilds it; callers hold a reference, so a trim never frees a
+// table that is in use.
+struct BaseTableCache {
+  std::mutex mutex;
+  std::shared_ptr<const std::vector<Precomp>> table;
+};
+BaseTableCache baseTableCache;
+
+} // namespace
+
+static size_t baseTableUsage() {
+  std::lock_guard<std::mutex> lock(baseTableCache.mutex);
+  return baseTableCache.table ? kBaseTableBytes : 0;
+}
+
+// The table cannot shrink, so anything short of a full trim keeps it
+static size_t trimBaseTable(double keepFraction) {
+  std::lock_guard<std::mutex> lock(baseTableCache.mutex);
+  if (keepFraction > 0 || !baseTableCache.table) {
+    return 0;
+  }
+  baseTableCache.table.reset();
+  return kBaseTableBytes;
+}
+
+static std::shared_ptr<const std::vector<Precomp>> baseTable() {
+  static auto registration = MemoryTrimRegistry::shared().add("ed25519BaseTable",
+                                                              TrimPriority::ExpensiveCaches,
+                                                              kBaseTableBytes,
+                                                              baseTableUsage,
+                                                              trimBaseTable);
+  std::lock_guard<std::mutex> lock(baseTableCache.mutex);
+  if (!baseTableCache.table) {
+    baseTableCache.table = std::make_shared<const std::vector<Precomp>>(buildBaseTable());
+  }
+  return baseTableCache.table;
+}
+
+// Conditionally replace `f` with `g` when mask is all ones
+static inline void feSelect(Fe& f, const Fe& g, uint64_t mask) {
+  for (int i = 0; i < 5; i++) {
+    f.v[i] ^= (f.v[i] ^ g.v[i]) & mask;
+  }
+}
+
+// scalar * B for a scalar below 2^255: a clamped key or a reduced nonce
+static void scalarMultBase(const uint8_t* scalar, uint8_t* out) {
+  int8_t digits[kWindows];
+  int carry = 0;
+  for (size_t i = 0; i < kWindows; i++) {
+    size_t bit = i * kWindowBits;
+    // The window's bits, from a little-endian 16-bit read
+    unsigned word = scalar[bit / 8] | (bit / 8 + 1 < 32 ? scalar[bit / 8 + 1] << 8 : 0);
+    int value = static_cast<int>((word >> (bit % 8)) & ((1u << kWindowBits) - 1)) + carry;
+    carry = i + 1 < kWindows ? (value + static_cast<int>(kEntriesPerWindow)) >> kWindowBits : 0;
+    digits[i] = static_cast<int8_t>(value - (carry << kWindowBits));
+  }
+
+  auto tableReference = baseTable();
+  const Precomp* table = tableReference->data();
+  PointP3 result = {kZero, kOne, kOne, kZero};
+  Precomp entry;
+  for (size_t i = 0; i < kWindows; i++) {
+    int64_t digit = digits[i];
+    uint64_t negative = static_cast<uint64_t>(digit >> 63);
+    uint64_t magnitude = static_cast<uint64_t>((digit ^ static_cast<int64_t>(negative)) - static_cast<int64_t>(negative));
+
+    // Digit 0 selects nothing and leaves the identity, (1, 1, 0)
+    entry = {kOne, kOne, kZero, 0};
+    simd::selectEntry<kPrecompWords>(reinterpret_cast<uint64_t*>(&entry),
+                                     reinterpret_cast<const uint64_t*>(table + i * kEntriesPerWindow),
+                                     kEntriesPerWindow, magnitude - 1);
+
+    // -(x, y) = (-x, y): swap y + x with y - x and negate 2dxy
+    Fe yPlusX = entry.yPlusX;
+    feSelect(entry.yPlusX, entry.yMinusX, negative);
+    feSelect(entry.yMinusX, yPlusX, negative);
+    feSelect(entry.xy2d, feCarry(feSub(kZero, entry.xy2d)), negative);
+    result = addMixed(result, entry);
+  }
+  Botan::secure_scrub_memory(digits, sizeof(digits));
+
+  Fe zInverse = feInvert(result.Z);
+  Fe x = feMul(result.X, zInverse);
+  uint8_t xBytes[32];
+  feToBytes(x, xBytes);
+  feToBytes(feMul(result.Y, zInverse), out);
+  out[31] |= static_cast<uint8_t>((xBytes[0] & 1) << 7);
+}
+
+// Scalars mod L = 2^252 + 27742317777372353535851937790883648493, as
+// little-endian 64-bit words
+static constexpr uint64_t kL[4] = {0x5812631a5cf5d3ed, 0x14def9dea2f79cd6, 0, 0x1000000000000000};
+// floor(2^512 / L), for Barrett reduction
+static constexpr uint64_t kBarrettMu[5] = {0xed9ce5a30a2c131b, 0x2106215d086329a7, 0xffffffffffffffeb,
+                                           0xffffffffffffffff, 0xf};
+
+static void loadWords(const uint8_t* bytes, size_t count, uint64_t* words) {
+  for (size_t i = 0; i < count; i++) {
+    words[i] = 0;
+    for (int j = 7; j >= 0; j--) {
+      words[i] = (words[i] << 8) | bytes[i * 8 + j];
+    }
+  }
+}
+
+static void storeWords(const uint64_t* words, size_t count, uint8_t* bytes) {
+  for (size_t i = 0; i < count; i++) {
+    for (int j = 0; j < 8; j++) {
+      bytes[i * 8 + j] = static_cast<uint8_t>(words[i] >> (8 * j));
+    }
+  }
+}
+
+// out = a * b, with room for aCount + bCount words
+static void mulWords(const uint64_t* a, size_t aCount, const uint64_t* b, size_t bCount, uint64_t* out) {
+  std::memset(out, 0, (aCount + bCount) * sizeof(uint64_t));
+  for (size_t i = 0; i < aCount; i++) {
+    uint64_t carry = 0;
+    for (size_t j = 0; j < bCount; j++) {
+      u128 t = (u128)a[i] * b[j] + out[i + j] + carry;
+      out[i + j] = static_cast<uint64_t>(t);
+      carry = static_cast<uint64_t>(t >> 64);
+    }
+    out[i + bCount] = carry;
+  }
+}
+
+// x mod L for a 512-bit x (HAC 14.42 with b = 2^64, k = 4). The estimate
+// is at most 2L short, which two masked subtractions fix.
+static void scReduce(const uint64_t* x, uint64_t* out) {
+  uint64_t q[10];
+  mulWords(x + 3, 5, kBarrettMu, 5, q);
+  uint64_t qL[9];
+  mulWords(q + 5, 5, kL, 4, qL);
+
+  uint64_t r[5];
+  uint64_t borrow = 0;
+  for (int i = 0; i < 5; i++) {
+    u128 t = (u128)x[i] - qL[i] - borrow;
+    r[i] = static_cast<uint64_t>(t);
+    borrow = static_cast<uint64_t>(t >> 64) & 1;
+  }
+  for (int round = 0; round < 2; round++) {
+    uint64_t d[5];
+    borrow = 0;
+    for (int i = 0; i < 5; i++) {
+      u128 t = (u128)r[i] - (i < 4 ? kL[i] : 0) - borrow;
+      d[i] = static_cast<uint64_t>(t);
+      borrow = static_cast<uint64_t>(t >> 64) & 1;
+    }
+    // Keep r - L unless it went negative
+    uint64_t keep = borrow - 1;
+    for (int i = 0; i < 5; i++) {
+      r[i] = (d[i] & keep) | (r[i] & ~keep);
+    }
+  }
+  std::memcpy(out, r, 4 * sizeof(uint64_t));
+}
+
+static void hashParts(std::initializer_list<std::pair<const uint8_t*, size_t>> parts, uint8_t* output) {
+  thread_local std::unique_ptr<Botan::HashFunction> sha512 = createHashFunction(HashKind::Sha512);
+  for (const auto& [data, size] : parts) {
+    sha512->update(data, size);
+  }
+  sha512->final(output);
+}
+
+void ed25519ExpandKey(const uint8_t* seed, uint8_t* expanded) {
+  hashInto(HashKind::Sha512, seed, 32, expanded);
+  expanded[0] &= 248;
+  expanded[31] &= 127;
+  expanded[31] |= 64;
+  scalarMultBase(expanded, expanded + 64);
+}
+
+void ed25519PublicKey(const uint8_t* seed, uint8_t* publicKey) {
+  uint8_t expanded[kEd25519ExpandedKeySize];
+  ed25519ExpandKey(seed, expanded);
+  std::memcpy(publicKey, expanded + 64, 32);
+  Botan::secure_scrub_memory(expanded, sizeof(expanded));
+}
+
+void ed25519Sign(const uint8_t* expanded, const uint8_t* message, size_t size, uint8_t* signature) {
+  const uint8_t* prefix = expanded + 32;
+  const uint8_t* publicKey = expanded + 64;
+
+  // r = SHA-512(prefix || M) mod L, and R = r * B
+  uint8_t digest[64];
+  uint64_t wide[8], nonce[4];
+  hashParts({{prefix, 32}, {message, size}}, digest);
+  loadWords(digest, 8, wide);
+  scReduce(wide, nonce);
+  uint8_t nonceBytes[32];
+  storeWords(nonce, 4, nonceBytes);
+  scalarMultBase(nonceBytes, signature);
+
+  // k = SHA-512(R || A || M) mod L, and S = (r + k * s) mod L
+  hashParts({{signature, 32}, {publicKey, 32}, {message, size}}, digest);
+  loadWords(digest, 8, wide);
+  uint64_t challenge[4], scalar[4];
+  scReduce(wide, challenge);
+  loadWords(expanded, 4, scalar);
+  mulWords(challenge, 4, scalar, 4, wide);
+  uint64_t carry = 0;
+  for (int i = 0; i < 8; i++) {
+    u128 t = (u128)wide[i] + (i < 4 ? nonce[i] : 0) + carry;
+    wide[i] = static_cast<uint64_t>(t);
+    carry = static_cast<uint64_t>(t >> 64);
+  }
+  uint64_t s[4];
+  scReduce(wide, s);
+  storeWords(s, 4, signature + 32);
+
+  Botan::secure_scrub_memory(digest, sizeof(digest));
+  Botan::secure_scrub_memory(wide, sizeof(wide));
+  Botan::secure_scrub_memory(nonce, sizeof(nonce));
+  Botan::secure_scrub_memory(nonceBytes, sizeof(nonceBytes));
+  Botan::secure_scrub_memory(scalar, sizeof(scalar));
+}
+
+#else
+
+// Botan's 64-byte secret key (the seed, then the public key), followed by
+// the public key where the header promises it
+void ed25519ExpandKey(const uint8_t* seed, uint8_t* expanded) {
+  Botan::ed25519_gen_keypair(expanded + 64, expanded, seed);
+}
+
+void ed25519PublicKey(const uint8_t* seed, uint8_t* publicKey) {
+  uint8_t secretKey[64];
+  Botan::ed25519_gen_keypair(publicKey, secretKey, seed);
+  Botan::secure_scrub_memory(secretKey, sizeof(secretKey));
+}
+
+void ed25519Sign(const uint8_t* expanded, const uint8_t* message, size_t size, uint8_t* signature) {
+  Botan::ed25519_sign(signature, message, size, expanded, nullptr, 0);
+}
+
+#endif
+
+static void storeBigEndian(const Fe& f, uint8_t* out) {
+  uint8_t bytes[32];
+  feToBytes(f, bytes);
+  for (int i = 0; i < 32; i++) {
+    out[i] = bytes[31 - i];
+  }
+}
+
+bool ed25519DecodePoint(const uint8_t* encoded, uint8_t* x, uint8_t* y) {
+  Fe fy = feFromBytes(encoded);
+  bool xOdd = (encoded[31] >> 7) != 0;
+  // Non-canonical y: every limb at its maximum except a low limb of at
+  // least 2^51 - 19
+  if (fy.v[0] >= kMask51 - 18 && (fy.v[1] & fy.v[2] & fy.v[3] & fy.v[4]) == kMask51) {
+    return false;
+  }
+
+  // x^2 = u / v; the candidate root u * v^3 * (u * v^7)^((p - 5) / 8) needs
+  // no inversion, and is right up to a factor of sqrt(-1)
+  Fe yy = feSq(fy);
+  Fe u = feCarry(feSub(yy, kOne));
+  Fe v = feCarry(feAdd(feMul(yy, kD), kOne));
+  Fe v3 = feMul(feSq(v), v);
+  Fe fx = feMul(feMul(u, v3), fePow22523(feMul(feMul(feSq(v3), v), u)));
+  Fe vxx = feMul(v, feSq(fx));
+  if (!feIsZero(feSub(vxx, u))) {
+    if (!feIsZero(feAdd(vxx, u))) {
+      return false;
+    }
+    fx = feMul(fx, kSqrtM1);
+  }
+
+  uint8_t xBytes[32];
+  feToBytes(fx, xBytes);
+  if (feIsZero(fx) && xOdd) {
+    return false;
+  }
+  if (((xBytes[0] & 1) != 0) != xOdd) {
+    fx = feSub(kZero, fx);
+  }
+  if (x != nullptr) {
+    storeBigEndian(fx, x);
+  }
+  if (y != nullptr) {
+    storeBigEndian(fy, y);
+  }
+  return true;
+}
+
+} // namespace margelo::nitro::metamask_nativeutils
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Ed25519 key derivation and signing, tuned for deriving many keys during
+// account discovery and for signing repeatedly with one key. Field elements
+// use radix 2^51 with 64x64->128-bit products, and the base point multiple
+// comes from a table of signed multiples for every 5-bit window of the
+// scalar: 52 mixed additions and no doublings, against ref10's 64 additions
+// and 4 doublings over 10 limbs of 25.5 bits. Table entries are picked with
+// simd::selectEntry, which reads every entry of a window, so nothing branches
+// on or indexes by secret data.
+//
+// The table backend is opt-in: builds define NATIVEUTILS_ED25519_TABLES to
+// enable it (the ed25519Tables Gradle property, or NATIVEUTILS_ED25519_TABLES=1
+// in the environment of `pod install`). It needs unsigned __int128, which every
+// 64-bit target has. By default, and on other targets, Botan's ref10 code is
+// used. Both derive identical keys.
+#if defined(NATIVEUTILS_ED25519_TABLES) && !defined(__SIZEOF_INT128__)
+#undef NATIVEUTILS_ED25519_TABLES
+#endif
+
+namespace margelo::nitro::metamask_nativeutils {
+
+/**
+ * Derive the Ed25519 public key of a private key seed (RFC 8032 5.1.5).
+ * The expanded secret is wiped before returning. The first call on the table
+ * backend builds the 104 KiB table, which takes a few milliseconds.
+ * @param seed 32-byte private key
+ * @param publicKey Output buffer for the 32-byte public key
+ */
+void ed25519PublicKey(const uint8_t* seed, uint8_t* publicKey);
+
+/** Size of a key expanded by ed25519ExpandKey. */
+static constexpr size_t kEd25519ExpandedKeySize = 96;
+
+/**
+ * Prepare a seed for repeated signing. The last 32 bytes are the public key;
+ * the rest depends on the backend. The table backend stores the clamped
+ * scalar and nonce prefix from the seed's SHA-512, so signing skips that
+ * hash. The default Botan backend stores the seed, and every signature
+ * hashes it again, because Botan only signs from the seed. The result is
+ * secret and belongs in secure memory.
+ * @param seed 32-byte private key
+ * @param expanded Output buffer for kEd25519ExpandedKeySize bytes
+ */
+void ed25519ExpandKey(const uint8_t* seed, uint8_t* expanded);
+
+/**
+ * Sign a message with an expanded key (pure Ed25519, RFC 8032 5.1.6). Safe
+ * to call from several threads with the same key.
+ * @param expanded Key from ed25519ExpandKey
+ * @param message Message bytes
+ * @param size Number of message bytes
+ * @param signature Output buffer for the 64-byte signature
+ */
+void ed25519Sign(const uint8_t* expanded, const uint8_t* message, size_t size, uint8_t* signature);
+
+/**
+ * Decode a compressed point (RFC 8032 5.1.3): check that the encoding is
+ * canonical, the point is on the curve, and x = 0 does not come with a set
+ * sign bit, the same rules as noble's strict decoding. Both backends use the
+ * radix 2^51 field code here; on targets without __int128 its products go
+ * through a portable 128-bit type. Variable time, for public data only.
+ * @param encoded 32-byte encoding
+ * @param x Output for the 32-byte affine x, big-endian; may be null
+ * @param y Output for the 32-byte affine y, big-endian; may be null
+ * @return true if the encoding is a valid point; the outputs are only
+ *   written then
+ */
+bool ed25519DecodePoint(const uint8_t* encoded, uint8_t* x, uint8_t* y);
+
+} // namespace margelo::nitro::metamask_nativeutils
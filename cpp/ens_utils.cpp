@@ -0,0 +1,80 @@
+#include "ens_utils.hpp"
+#include "keccak_utils.hpp"
+#include <array>
+#include <cstring>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_map>
+
+namespace margelo::nitro::metamask_nativeutils {
+
+using Node = std::array<uint8_t, 32>;
+
+static void checkLabels(const std::string& name) {
+  if (name.front() == '.' || name.back() == '.' || name.find("..") != std::string::npos) {
+    throw std::runtime_error("Invalid ENS name '" + name + "': empty label");
+  }
+}
+
+// Extend a node with the labels of name[0, end), right to left
+static void hashLabels(const std::string& name, size_t end, uint8_t* node) {
+  uint8_t labelHash[32];
+  while (end > 0) {
+    size_t dot = name.rfind('.', end - 1);
+    size_t start = dot == std::string::npos ? 0 : dot + 1;
+    keccak256(reinterpret_cast<const uint8_t*>(name.data()) + start, end - start, labelHash);
+    keccak256Concat(node, 32, labelHash, 32, node);
+    end = dot == std::string::npos ? 0 : dot;
+  }
+}
+
+void ensNamehash(const std::string& name, uint8_t* output) {
+  std::memset(output, 0, 32);
+  if (!name.empty()) {
+    checkLabels(name);
+    hashLabels(name, name.size(), output);
+  }
+}
+
+void ensNamehashMany(const std::vector<std::string>& names, uint8_t* output) {
+  // Nodes of the proper suffixes ("eth", "base.eth", ...) seen so far in the
+  // batch; keys point into `names`, which outlives the map
+  std::unordered_map<std::string_view, Node> parents;
+  uint8_t labelHash[32];
+
+  for (size_t i = 0; i < names.size(); i++) {
+    const std::string& name = names[i];
+    uint8_t* node = output + i * 32;
+    std::memset(node, 0, 32);
+    if (name.empty()) {
+      continue;
+    }
+    checkLabels(name);
+
+    // Find the longest known parent, scanning suffixes from the left
+    size_t end = name.size();
+    for (size_t dot = name.find('.'); dot != std::string::npos; dot = name.find('.', dot + 1)) {
+      auto found = parents.find(std::string_view(name).substr(dot + 1));
+      if (found != parents.end()) {
+        std::memcpy(node, found->second.data(), 32);
+        end = dot;
+        break;
+      }
+    }
+
+    // Hash the remaining labels, remembering each new parent on the way
+    while (end > 0) {
+      size_t dot = name.rfind('.', end - 1);
+      size_t start = dot == std::string::npos ? 0 : dot + 1;
+      keccak256(reinterpret_cast<const uint8_t*>(name.data()) + start, end - start, labelHash);
+      keccak256Concat(node, 32, labelHash, 32, node);
+      if (dot == std::string::npos) {
+        break;
+      }
+      std::memcpy(parents[std::string_view(name).substr(start)].data(), node, 32);
+      end = dot;
+    }
+  }
+}
+
+} // namespace margelo::nitro::metamask_nativeutils
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace margelo::nitro::metamask_nativeutils {
+
+/**
+ * Compute the ENS namehash (EIP-137) of a name: starting from 32 zero bytes,
+ * node = keccak256(node ++ keccak256(label)) for each label from the right.
+ * The name is hashed as given, so it must already be normalized (ENSIP-15).
+ * @param name Dot-separated name, e.g. "vitalik.eth"; empty for the root
+ * @param output Output buffer for the 32-byte node
+ * @throws std::runtime_error if the name has an empty label
+ */
+void ensNamehash(const std::string& name, uint8_t* output);
+
+/**
+ * Compute the namehash of many names. Parent nodes shared between names
+ * (such as "eth") are hashed once per batch.
+ * @param names Names to hash
+ * @param output Output buffer for names.size() packed 32-byte nodes
+ * @throws std::runtime_error if a name has an empty label
+ */
+void ensNamehashMany(const std::vector<std::string>& names, uint8_t* output);
+
+} // namespace margelo::nitro::metamask_nativeutils
@@ -0,0 +1,68 @@
+#include "hash_utils.hpp"
+#include "botan_conditional.h"
+#include "parallel_for.hpp"
+#include <array>
+#include <stdexcept>
+#include <string>
+
+namespace margelo::nitro::metamask_nativeutils {
+
+// Inputs per parallel chunk in hashMany
+static constexpr size_t kParallelGrain = 256;
+
+struct HashInfo {
+  const char* botanName;
+  size_t outputSize;
+};
+
+// Indexed by HashKind
+static constexpr HashInfo kHashes[kHashKindCount] = {
+    {"SHA-256", 32},
+    {"SHA-512", 64},
+    {"SHA-3(256)", 32},
+    {"Keccak-1600(256)", 32},
+    {"RIPEMD-160", 20},
+    {"BLAKE2b(256)", 32},
+    {"BLAKE2b(512)", 64},
+};
+
+size_t hashOutputSize(HashKind kind) {
+  return kHashes[static_cast<size_t>(kind)].outputSize;
+}
+
+std::unique_ptr<Botan::HashFunction> createHashFunction(HashKind kind) {
+  const char* name = kHashes[static_cast<size_t>(kind)].botanName;
+  auto hasher = Botan::HashFunction::create(name);
+  if (!hasher) {
+    throw std::runtime_error(std::string("Failed to create ") + name + " hasher");
+  }
+  return hasher;
+}
+
+static Botan::HashFunction& threadHasher(HashKind kind) {
+  thread_local std::array<std::unique_ptr<Botan::HashFunction>, kHashKindCount> hashers;
+  auto& hasher = hashers[static_cast<size_t>(kind)];
+  if (!hasher) {
+    hasher = createHashFunction(kind);
+  }
+  return *hasher;
+}
+
+void hashInto(HashKind kind, const uint8_t* data, size_t size, uint8_t* output) {
+  auto& hasher = threadHasher(kind);
+  hasher.update(data, size);
+  hasher.final(output);
+}
+
+void hashMany(HashKind kind, const uint8_t* data, const size_t* offsets, size_t count, uint8_t* output) {
+  size_t outputSize = hashOutputSize(kind);
+  parallelFor(count, kParallelGrain, [=](size_t begin, size_t end) {
+    auto& hasher = threadHasher(kind);
+    for (size_t i = begin; i < end; i++) {
+      hasher.update(data + offsets[i], offsets[i + 1] - offsets[i]);
+      hasher.final(output + i * outputSize);
+    }
+  });
+}
+
+} // namespace margelo::nitro::metamask_nativeutils
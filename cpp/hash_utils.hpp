@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace Botan {
+class HashFunction;
+}
+
+namespace margelo::nitro::metamask_nativeutils {
+
+/** Hash functions available through the registry, used as a table index. */
+enum class HashKind {
+  Sha256,
+  Sha512,
+  Sha3_256,
+  Keccak256,
+  Ripemd160,
+  Blake2b256,
+  Blake2b512,
+};
+
+static constexpr size_t kHashKindCount = 7;
+
+/** Digest size of a hash function in bytes. */
+size_t hashOutputSize(HashKind kind);
+
+/**
+ * Hash one input into a caller-provided buffer. Each thread keeps one
+ * pre-instantiated Botan object per hash function, so calls never look up
+ * names or allocate.
+ * @param kind Hash function
+ * @param data Input bytes
+ * @param size Number of input bytes
+ * @param output Output buffer for hashOutputSize(kind) bytes
+ */
+void hashInto(HashKind kind, const uint8_t* data, size_t size, uint8_t* output);
+
+/**
+ * Hash many variable-length inputs, in parallel for large batches.
+ * @param kind Hash function
+ * @param data Packed inputs
+ * @param offsets count + 1 offsets into `data`; input i is [offsets[i], offsets[i + 1])
+ * @param count Number of inputs
+ * @param output Output buffer for `count` packed digests
+ */
+void hashMany(HashKind kind, const uint8_t* data, const size_t* offsets, size_t count, uint8_t* output);
+
+/**
+ * Create a standalone hash object for incremental hashing.
+ * @param kind Hash function
+ * @return A new Botan hash object
+ * @throws std::runtime_error if the hash function is not in this Botan build
+ */
+std::unique_ptr<Botan::HashFunction> createHashFunction(HashKind kind);
+
+} // namespace margelo::nitro::metamask_nativeutils
@@ -38,4 +38,18 @@ void hexToBytes(const std::string& hex, uint8_t* bytes, size_t expectedLen) {
     }
 }
 
+void hexToBytes(const char* hex, uint8_t* bytes, size_t byteLen) {
+    for (size_t i = 0; i < byteLen; i++) {
+        bytes[i] = (hexCharToByte(hex[i * 2]) << 4) | hexCharToByte(hex[i * 2 + 1]);
+    }
+}
+
+void bytesToHex(const uint8_t* bytes, size_t byteLen, char* hex) {
+    static const char kHexDigits[] = "0123456789abcdef";
+    for (size_t i = 0; i < byteLen; i++) {
+        hex[i * 2] = kHexDigits[bytes[i] >> 4];
+        hex[i * 2 + 1] = kHexDigits[bytes[i] & 0x0f];
+    }
+}
+
 } // namespace margelo::nitro::metamask_nativeutils
@@ -36,4 +36,21 @@ uint8_t hexCharToByte(char c);
  */
 void hexToBytes(const std::string& hex, uint8_t* bytes, size_t expectedLen);
 
+/**
+ * Convert raw hex characters (no prefix) to bytes with validation
+ * @param hex Hex characters to convert
+ * @param bytes Output buffer of `byteLen` bytes
+ * @param byteLen Number of bytes to decode (reads 2 * byteLen characters)
+ * @throws std::runtime_error if a character is not valid hex
+ */
+void hexToBytes(const char* hex, uint8_t* bytes, size_t byteLen);
+
+/**
+ * Convert bytes to lowercase hex characters (no prefix, no terminator)
+ * @param bytes Bytes to convert
+ * @param byteLen Number of bytes
+ * @param hex Output buffer of 2 * byteLen characters
+ */
+void bytesToHex(const uint8_t* bytes, size_t byteLen, char* hex);
+
 } // namespace margelo::nitro::metamask_nativeutils
@@ -0,0 +1,29 @@
+#include "keccak_utils.hpp"
+#include "botan_conditional.h"
+#include <memory>
+#include <stdexcept>
+
+namespace margelo::nitro::metamask_nativeutils {
+
+static Botan::HashFunction& threadKeccak256() {
+  thread_local std::unique_ptr<Botan::HashFunction> hasher = Botan::HashFunction::create("Keccak-1600(256)");
+  if (!hasher) {
+    throw std::runtime_error("Failed to create Keccak-256 hasher");
+  }
+  return *hasher;
+}
+
+void keccak256(const uint8_t* data, size_t dataLen, uint8_t* output) {
+  auto& hasher = threadKeccak256();
+  hasher.update(data, dataLen);
+  hasher.final(output);
+}
+
+void keccak256Concat(const uint8_t* first, size_t firstLen, const uint8_t* second, size_t secondLen, uint8_t* output) {
+  auto& hasher = threadKeccak256();
+  hasher.update(first, firstLen);
+  hasher.update(second, secondLen);
+  hasher.final(output);
+}
+
+} // namespace margelo::nitro::metamask_nativeutils
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace margelo::nitro::metamask_nativeutils {
+
+/**
+ * Compute Keccak-256 into a caller-provided buffer.
+ * Uses a per-thread, pre-instantiated Botan hasher so hot loops do not pay
+ * for looking up and allocating a hash object on every call.
+ * @param data Input bytes
+ * @param dataLen Number of input bytes
+ * @param output Output buffer for the 32-byte hash
+ */
+void keccak256(const uint8_t* data, size_t dataLen, uint8_t* output);
+
+/**
+ * Compute Keccak-256 of the concatenation of two inputs without copying them.
+ * @param first First input
+ * @param firstLen Length of the first input
+ * @param second Second input
+ * @param secondLen Length of the second input
+ * @param output Output buffer for the 32-byte hash
+ */
+void keccak256Concat(const uint8_t* first, size_t firstLen, const uint8_t* second, size_t secondLen, uint8_t* output);
+
+} // namespace margelo::nitro::metamask_nativeutils
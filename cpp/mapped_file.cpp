@@ -0,0 +1,98 @@
+#include "mapped_file.hpp"
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace margelo::nitro::metamask_nativeutils {
+
+static std::runtime_error fileError(const std::string& action, const std::string& path) {
+  return std::runtime_error("Failed to " + action + " '" + path + "': " + std::strerror(errno));
+}
+
+std::shared_ptr<MappedFile> MappedFile::open(const std::string& path) {
+  int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    throw fileError("open", path);
+  }
+
+  struct stat info;
+  if (fstat(fd, &info) != 0) {
+    auto error = fileError("stat", path);
+    close(fd);
+    throw error;
+  }
+  size_t size = static_cast<size_t>(info.st_size);
+  if (size == 0) {
+    close(fd);
+    throw std::runtime_error("Failed to map '" + path + "': file is empty");
+  }
+
+  void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  int mapErrno = errno;
+  // The mapping stays valid after the descriptor is closed
+  close(fd);
+  if (mapping == MAP_FAILED) {
+    errno = mapErrno;
+    throw fileError("map", path);
+  }
+
+  return std::shared_ptr<MappedFile>(new MappedFile(static_cast<const uint8_t*>(mapping), size));
+}
+
+MappedFile::~MappedFile() {
+  munmap(const_cast<uint8_t*>(data_), size_);
+}
+
+void writeFileAtomically(const std::string& path, const uint8_t* data, size_t size) {
+  // A unique name per call, so concurrent writers of the same path each
+  // rename a complete file of their own over it
+  std::string temporaryPath = path + ".tmp-XXXXXX";
+  int fd = mkstemp(temporaryPath.data());
+  if (fd < 0) {
+    throw fileError("create", temporaryPath);
+  }
+  // mkstemp creates the file as 0600
+  fcntl(fd, F_SETFD, FD_CLOEXEC);
+  if (fchmod(fd, 0644) != 0) {
+    auto error = fileError("create", temporaryPath);
+    close(fd);
+    unlink(temporaryPath.c_str());
+    throw error;
+  }
+
+  size_t written = 0;
+  while (written < size) {
+    ssize_t result = write(fd, data + written, size - written);
+    if (result < 0 && errno == EINTR) {
+      continue;
+    }
+    if (result <= 0) {
+      auto error = fileError("write", temporaryPath);
+      close(fd);
+      unlink(temporaryPath.c_str());
+      throw error;
+    }
+    written += static_cast<size_t>(result);
+  }
+
+  if (fsync(fd) != 0) {
+    auto error = fileError("sync", temporaryPath);
+    close(fd);
+    unlink(temporaryPath.c_str());
+    throw error;
+  }
+  close(fd);
+
+  if (rename(temporaryPath.c_str(), path.c_str()) != 0) {
+    auto error = fileError("replace", path);
+    unlink(temporaryPath.c_str());
+    throw error;
+  }
+}
+
+} // namespace margelo::nitro::metamask_nativeutils
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace margelo::nitro::metamask_nativeutils {
+
+/**
+ * Read-only memory mapping of a whole file. Pages are loaded on first access
+ * and can be dropped by the OS under memory pressure, so opening is constant
+ * time and large indexes cost no heap.
+ */
+class MappedFile {
+public:
+  /**
+   * Map a file read-only.
+   * @param path Absolute file path
+   * @throws std::runtime_error if the file cannot be opened or mapped
+   */
+  static std::shared_ptr<MappedFile> open(const std::string& path);
+
+  ~MappedFile();
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  const uint8_t* data() const { return data_; }
+  size_t size() const { return size_; }
+
+private:
+  MappedFile(const uint8_t* data, size_t size) : data_(data), size_(size) {}
+
+  const uint8_t* data_;
+  size_t size_;
+};
+
+/**
+ * Replace a file atomically: write to a uniquely named temporary file next to
+ * it, flush it to disk and rename it over `path`. Readers that mapped the old
+ * file keep a consistent view until they unmap it, and of concurrent writers
+ * the last to finish wins.
+ * @param path Absolute file path
+ * @param data Bytes to write
+ * @param size Number of bytes
+ * @throws std::runtime_error if the file cannot be written
+ */
+void writeFileAtomically(const std::string& path, const uint8_t* data, size_t size);
+
+/**
+ * Per-app directory for temporary and rebuildable files, as the platform
+ * reports it: NSTemporaryDirectory() on iOS and Context.getCacheDir() on
+ * Android, which accounts for secondary users and work profiles. Defined in
+ * ios/TemporaryDirectory.mm and android/src/main/cpp/TemporaryDirectory.cpp.
+ * @return Absolute path without a trailing slash
+ * @throws std::runtime_error if the platform cannot provide one yet
+ */
+std::string temporaryDirectory();
+
+} // namespace margelo::nitro::metamask_nativeutils
@@ -0,0 +1,111 @@
+#include "memory_trim.hpp"
+#include "secure_arena.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace margelo::nitro::metamask_nativeutils {
+
+// Share of its budget an entry keeps at a given level, or a negative value to skip it
+static double keepFraction(TrimLevel level, TrimPriority priority) {
+  switch (level) {
+    case TrimLevel::Moderate:
+      switch (priority) {
+        case TrimPriority::PooledBuffers: return 0.0;
+        case TrimPriority::DerivedCaches: return 0.5;
+        case TrimPriority::ExpensiveCaches: return -1.0;
+      }
+      break;
+    case TrimLevel::Low:
+      switch (priority) {
+        case TrimPriority::PooledBuffers: return 0.0;
+        case TrimPriority::DerivedCaches: return 0.0;
+        case TrimPriority::ExpensiveCaches: return 0.5;
+      }
+      break;
+    case TrimLevel::Critical:
+      return 0.0;
+  }
+  return -1.0;
+}
+
+MemoryTrimRegistry::Registration::~Registration() {
+  MemoryTrimRegistry::shared().remove(id_);
+}
+
+MemoryTrimRegistry& MemoryTrimRegistry::shared() {
+  static MemoryTrimRegistry registry;
+  // The secure arena's idle chunks and spare mappings are the first pool to go
+  static auto arenaRegistration = registry.add("secureArena",
+                                               TrimPriority::PooledBuffers,
+                                               SecureArena::shared().idleBudget(),
+                                               []() { return SecureArena::shared().stats().idleBytes; },
+                                               [](double keep) { return SecureArena::shared().trim(keep); },
+                                               [](size_t budget) { return SecureArena::shared().setIdleBudget(budget); });
+  return registry;
+}
+
+std::unique_ptr<MemoryTrimRegistry::Registration> MemoryTrimRegistry::add(std::string name,
+                                                                          TrimPriority priority,
+                                                                          size_t budgetBytes,
+                                                                          UsageFunction usage,
+                                                                          TrimFunction trim,
+                                                                          BudgetFunction setBudget) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  size_t id = nextId_++;
+  entries_.push_back(
+      {id, std::move(name), priority, budgetBytes, std::move(usage), std::move(trim), std::move(setBudget)});
+  return std::make_unique<Registration>(id);
+}
+
+size_t MemoryTrimRegistry::setBudget(const std::string& name, size_t budgetBytes) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto entry = std::find_if(entries_.begin(), entries_.end(), [&name](const Entry& e) { return e.name == name; });
+  if (entry == entries_.end()) {
+    throw std::runtime_error("No cache named '" + name + "'");
+  }
+  if (!entry->setBudget) {
+    throw std::runtime_error("The budget of cache '" + name + "' cannot be changed");
+  }
+  entry->budgetBytes = entry->setBudget(budgetBytes);
+  return entry->budgetBytes;
+}
+
+void MemoryTrimRegistry::remove(size_t id) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  entries_.erase(std::remove_if(entries_.begin(), entries_.end(), [id](const Entry& entry) { return entry.id == id; }),
+                 entries_.end());
+}
+
+size_t MemoryTrimRegistry::trim(TrimLevel level) {
+  // Holding the lock keeps entries from being unregistered (and destroyed) mid-trim
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  std::vector<const Entry*> ordered;
+  for (const auto& entry : entries_) {
+    ordered.push_back(&entry);
+  }
+  std::stable_sort(ordered.begin(), ordered.end(), [](const Entry* a, const Entry* b) {
+    return a->priority < b->priority;
+  });
+
+  size_t released = 0;
+  for (const Entry* entry : ordered) {
+    double keep = keepFraction(level, entry->priority);
+    if (keep >= 0) {
+      released += entry->trim(keep);
+    }
+  }
+  return released;
+}
+
+std::vector<CacheUsageSnapshot> MemoryTrimRegistry::usage() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::vector<CacheUsageSnapshot> result;
+  result.reserve(entries_.size());
+  for (const auto& entry : entries_) {
+    result.push_back({entry.name, entry.usage(), entry.budgetBytes});
+  }
+  return result;
+}
+
+} // namespace margelo::nitro::metamask_nativeutils
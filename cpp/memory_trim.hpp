@@ -0,0 +1,120 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace margelo::nitro::metamask_nativeutils {
+
+/** How hard to trim, from the platform's memory pressure signal. */
+enum class TrimLevel {
+  Moderate, // drop pooled buffers, halve caches
+  Low,      // drop pooled buffers and cheap caches
+  Critical, // drop everything that can be rebuilt
+};
+
+/** Order in which registered memory is given back; cheapest to rebuild first. */
+enum class TrimPriority {
+  PooledBuffers,   // free memory kept for reuse
+  DerivedCaches,   // results that are cheap to recompute
+  ExpensiveCaches, // precomputed tables and indexes
+};
+
+struct CacheUsageSnapshot {
+  std::string name;
+  size_t bytes;
+  size_t budgetBytes;
+};
+
+/**
+ * Process-wide list of caches and pools that can shrink under memory pressure.
+ *
+ * Each entry reports its current size and byte budget and knows how to trim
+ * itself to a fraction of that budget. trim() walks entries in priority
+ * order and returns the bytes they released.
+ *
+ * Registered today: the secure key arena and, in table builds, the Ed25519
+ * base-point table. Keyring accounts and AddressSet entries are caller data
+ * released by their own clear()/remove(), not caches, and the per-thread
+ * hashers are a few hundred bytes each that only their own thread can free.
+ */
+class MemoryTrimRegistry {
+public:
+  using UsageFunction = std::function<size_t()>;
+  // Shrink to `keepFraction` (0..1) of the budget; returns bytes released
+  using TrimFunction = std::function<size_t(double keepFraction)>;
+  // Apply a new budget, shrinking to it if needed; returns the budget in effect
+  using BudgetFunction = std::function<size_t(size_t budgetBytes)>;
+
+  /** Keeps an entry registered for as long as it is alive. */
+  class Registration {
+  public:
+    explicit Registration(size_t id) : id_(id) {}
+    ~Registration();
+    Registration(const Registration&) = delete;
+    Registration& operator=(const Registration&) = delete;
+
+  private:
+    size_t id_;
+  };
+
+  static MemoryTrimRegistry& shared();
+
+  /**
+   * Register a cache or pool.
+   * @param name Name reported by usage()
+   * @param priority When the entry is trimmed relative to others
+   * @param budgetBytes Configured upper bound of the entry's size
+   * @param usage Returns the current size in bytes
+   * @param trim Shrinks the entry; must not call back into the registry
+   * @param setBudget Applies a new budget, or nullptr if it is fixed; must
+   *   not call back into the registry
+   * @return Handle that unregisters the entry when destroyed
+   */
+  std::unique_ptr<Registration> add(std::string name,
+                                    TrimPriority priority,
+                                    size_t budgetBytes,
+                                    UsageFunction usage,
+                                    TrimFunction trim,
+                                    BudgetFunction setBudget = nullptr);
+
+  /**
+   * Change the byte budget of a registered entry.
+   * @param name Name the entry was registered with
+   * @param budgetBytes Requested budget
+   * @return The budget in effect, which the entry may have clamped
+   * @throws std::runtime_error if no entry has that name or its budget is fixed
+   */
+  size_t setBudget(const std::string& name, size_t budgetBytes);
+
+  /**
+   * Trim registered entries in priority order.
+   * @return Total bytes released
+   */
+  size_t trim(TrimLevel level);
+
+  std::vector<CacheUsageSnapshot> usage();
+
+private:
+  MemoryTrimRegistry() = default;
+  void remove(size_t id);
+
+  struct Entry {
+    size_t id;
+    std::string name;
+    TrimPriority priority;
+    size_t budgetBytes;
+    UsageFunction usage;
+    TrimFunction trim;
+    BudgetFunction setBudget;
+  };
+
+  std::mutex mutex_;
+  std::vector<Entry> entries_;
+  size_t nextId_ = 1;
+};
+
+} // namespace margelo::nitro::metamask_nativeutils
@@ -0,0 +1,68 @@
+#include "merkle_utils.hpp"
+#include "keccak_utils.hpp"
+#include "parallel_for.hpp"
+#include "simd_utils.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace margelo::nitro::metamask_nativeutils {
+
+// Hashes per parallel chunk; enough to amortize handing a chunk to a worker
+static constexpr size_t kParallelGrain = 512;
+
+void merkleHashPair(const uint8_t* a, const uint8_t* b, uint8_t* output) {
+  if (std::memcmp(a, b, 32) > 0) {
+    std::swap(a, b);
+  }
+  keccak256Concat(a, 32, b, 32, output);
+}
+
+void merkleHashLeaves(const uint8_t* leaves, size_t count, size_t leafSize, int rounds, uint8_t* output) {
+  parallelFor(count, kParallelGrain, [=](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) {
+      uint8_t* hash = output + i * 32;
+      keccak256(leaves + i * leafSize, leafSize, hash);
+      for (int round = 1; round < rounds; round++) {
+        keccak256(hash, 32, hash);
+      }
+    }
+  });
+}
+
+void merkleBuildTree(uint8_t* nodes, size_t leafCount) {
+  if (leafCount < 2) {
+    return;
+  }
+
+  // Inner nodes are [0, leafCount - 1). Level d holds nodes [2^d - 1, 2^(d+1) - 1),
+  // so start from the level of the last inner node and walk up to the root
+  size_t last = leafCount - 2;
+  size_t levelStart = 0;
+  while (2 * levelStart + 1 <= last) {
+    levelStart = 2 * levelStart + 1;
+  }
+
+  for (;;) {
+    size_t levelEnd = std::min(2 * levelStart + 1, last + 1);
+    parallelFor(levelEnd - levelStart, kParallelGrain, [=](size_t begin, size_t end) {
+      for (size_t i = levelStart + begin; i < levelStart + end; i++) {
+        merkleHashPair(nodes + (2 * i + 1) * 32, nodes + (2 * i + 2) * 32, nodes + i * 32);
+      }
+    });
+    if (levelStart == 0) {
+      return;
+    }
+    levelStart = (levelStart - 1) / 2;
+  }
+}
+
+bool merkleVerify(const uint8_t* root, const uint8_t* leaf, const uint8_t* proof, size_t proofLength) {
+  uint8_t hash[32];
+  std::memcpy(hash, leaf, 32);
+  for (size_t i = 0; i < proofLength; i++) {
+    merkleHashPair(hash, proof + i * 32, hash);
+  }
+  return simd::equal32(hash, root);
+}
+
+} // namespace margelo::nitro::metamask_nativeutils
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace margelo::nitro::metamask_nativeutils {
+
+// Merkle trees as built by OpenZeppelin's @openzeppelin/merkle-tree and
+// verified by its MerkleProof.sol: Keccak-256 over sorted pairs, stored as a
+// flat array of 32-byte nodes. Node 0 is the root, the children of node i
+// are 2i + 1 and 2i + 2, and the n leaves occupy the last n nodes in reverse
+// order. Each tree level is a contiguous range of that array.
+
+/** Number of nodes in a tree of `leafCount` leaves. */
+inline size_t merkleNodeCount(size_t leafCount) {
+  return 2 * leafCount - 1;
+}
+
+/** Hash two nodes in ascending byte order into `output`, which may alias either. */
+void merkleHashPair(const uint8_t* a, const uint8_t* b, uint8_t* output);
+
+/**
+ * Hash equally sized leaves with Keccak-256, in parallel for large batches.
+ * @param leaves Packed leaf data
+ * @param count Number of leaves
+ * @param leafSize Bytes per leaf
+ * @param rounds Keccak-256 applications: 1, or 2 for OpenZeppelin's
+ *   StandardMerkleTree, which hashes leaves twice against second-preimage attacks
+ * @param output Output buffer for `count` packed 32-byte hashes
+ */
+void merkleHashLeaves(const uint8_t* leaves, size_t count, size_t leafSize, int rounds, uint8_t* output);
+
+/**
+ * Fill the inner nodes of a flat tree whose leaves are already in place.
+ * Levels are hashed bottom-up; the nodes of a large level are hashed in
+ * parallel since they only depend on the level below.
+ * @param nodes merkleNodeCount(leafCount) packed 32-byte nodes
+ * @param leafCount Number of leaves, at least 1
+ */
+void merkleBuildTree(uint8_t* nodes, size_t leafCount);
+
+/**
+ * Fold a proof into a leaf hash and compare the result with a root.
+ * @param root Expected 32-byte root
+ * @param leaf 32-byte leaf hash
+ * @param proof `proofLength` packed 32-byte sibling hashes, leaf to root
+ * @param proofLength Number of proof nodes
+ * @return true if the proof leads to the root
+ */
+bool merkleVerify(const uint8_t* root, const uint8_t* leaf, const uint8_t* proof, size_t proofLength);
+
+} // namespace margelo::nitro::metamask_nativeutils
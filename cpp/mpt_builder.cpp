@@ -0,0 +1,276 @@
+#include "mpt_builder.hpp"
+#include "keccak_utils.hpp"
+#include "mpt_proof.hpp"
+#include "parallel_for.hpp"
+#include "rlp.hpp"
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+
+namespace margelo::nitro::metamask_nativeutils {
+
+// Nodes per parallel chunk when hashing a level
+static constexpr size_t kParallelGrain = 64;
+static constexpr uint32_t kNone = UINT32_MAX;
+
+namespace {
+
+// rlp(i) for the ordered trie keys; at most 9 bytes
+struct TrieKey {
+  uint8_t bytes[9];
+  uint8_t size;
+
+  uint8_t nibble(size_t index) const { return index % 2 == 0 ? bytes[index / 2] >> 4 : bytes[index / 2] & 0x0f; }
+  size_t nibbles() const { return size * 2u; }
+};
+
+struct TrieNode {
+  enum class Kind : uint8_t { Leaf, Extension, Branch };
+
+  Kind kind;
+  // Reference used by the parent: the node's encoding if shorter than 32
+  // bytes, otherwise its Keccak-256
+  uint8_t refSize = 0;
+  uint8_t ref[32];
+  uint32_t height = 0;
+  // Leaf and extension path: nibbles [pathStart, pathEnd) of keys[pathKey]
+  uint32_t pathKey = 0;
+  uint16_t pathStart = 0;
+  uint16_t pathEnd = 0;
+  // Leaf or branch value: an item index
+  uint32_t value = kNone;
+  // Extension child, or branch children by nibble
+  uint32_t children[16];
+};
+
+class OrderedTrieBuilder {
+public:
+  OrderedTrieBuilder(const uint8_t* items, const std::vector<size_t>& offsets, size_t count)
+      : items_(items), offsets_(offsets), keys_(count), order_(count) {
+    for (size_t i = 0; i < count; i++) {
+      uint8_t value[8];
+      size_t size = 0;
+      for (size_t v = i; v > 0; v >>= 8) {
+        size++;
+      }
+      for (size_t b = 0; b < size; b++) {
+        value[size - 1 - b] = static_cast<uint8_t>(i >> (8 * b));
+      }
+      keys_[i].size = static_cast<uint8_t>(rlpWriteString(keys_[i].bytes, value, size));
+    }
+
+    // Keys in byte order; RLP is prefix-free, so no key prefixes another
+    std::iota(order_.begin(), order_.end(), 0);
+    std::sort(order_.begin(), order_.end(), [this](uint32_t a, uint32_t b) {
+      const TrieKey& x = keys_[a];
+      const TrieKey& y = keys_[b];
+      int compared = std::memcmp(x.bytes, y.bytes, std::min(x.size, y.size));
+      return compared != 0 ? compared < 0 : x.size < y.size;
+    });
+
+    // n leaves, at most n - 1 branches, and at most one extension per branch
+    nodes_.reserve(3 * count);
+    build(0, count, 0);
+  }
+
+  void computeRoot(uint8_t* root) {
+    // Bucket nodes by height; a node only references lower nodes
+    uint32_t maxHeight = nodes_[0].height;
+    std::vector<uint32_t> levelStart(maxHeight + 2, 0);
+    for (const TrieNode& node : nodes_) {
+      levelStart[node.height + 1]++;
+    }
+    std::partial_sum(levelStart.begin(), levelStart.end(), levelStart.begin());
+    std::vector<uint32_t> byLevel(nodes_.size());
+    std::vector<uint32_t> cursor(levelStart.begin(), levelStart.end() - 1);
+    for (uint32_t i = 0; i < nodes_.size(); i++) {
+      byLevel[cursor[nodes_[i].height]++] = i;
+    }
+
+    for (uint32_t height = 0; height <= maxHeight; height++) {
+      const uint32_t* level = byLevel.data() + levelStart[height];
+      parallelFor(levelStart[height + 1] - levelStart[height], kParallelGrain, [&](size_t begin, size_t end) {
+        std::vector<uint8_t> scratch;
+        for (size_t i = begin; i < end; i++) {
+          seal(nodes_[level[i]], scratch);
+        }
+      });
+    }
+
+    // The root is always referenced by hash
+    TrieNode& top = nodes_[0];
+    if (top.refSize == 32) {
+      std::memcpy(root, top.ref, 32);
+    } else {
+      keccak256(top.ref, top.refSize, root);
+    }
+  }
+
+private:
+  // Build the node for sorted keys [begin, end) below `depth` nibbles; returns its index
+  uint32_t build(size_t begin, size_t end, size_t depth) {
+    uint32_t index = static_cast<uint32_t>(nodes_.size());
+    nodes_.emplace_back();
+    const TrieKey& first = keys_[order_[begin]];
+
+    if (end - begin == 1) {
+      TrieNode& leaf = nodes_[index];
+      leaf.kind = TrieNode::Kind::Leaf;
+      setPath(leaf, order_[begin], depth, first.nibbles());
+      leaf.value = order_[begin];
+      return index;
+    }
+
+    // Sorted keys share the prefix common to the first and last
+    const TrieKey& last = keys_[order_[end - 1]];
+    size_t shared = depth;
+    while (shared < first.nibbles() && shared < last.nibbles() && first.nibble(shared) == last.nibble(shared)) {
+      shared++;
+    }
+    if (shared > depth) {
+      uint32_t child = build(begin, end, shared);
+      TrieNode& extension = nodes_[index];
+      extension.kind = TrieNode::Kind::Extension;
+      setPath(extension, order_[begin], depth, shared);
+      extension.children[0] = child;
+      extension.height = nodes_[child].height + 1;
+      return index;
+    }
+
+    uint32_t children[16];
+    std::fill(children, children + 16, kNone);
+    uint32_t value = kNone;
+    uint32_t height = 0;
+    size_t i = begin;
+    if (first.nibbles() == depth) {
+      value = order_[i++];
+    }
+    while (i < end) {
+      uint8_t nibble = keys_[order_[i]].nibble(depth);
+      size_t groupEnd = i + 1;
+      while (groupEnd < end && keys_[order_[groupEnd]].nibble(depth) == nibble) {
+        groupEnd++;
+      }
+      children[nibble] = build(i, groupEnd, depth + 1);
+      height = std::max(height, nodes_[children[nibble]].height + 1);
+      i = groupEnd;
+    }
+
+    TrieNode& branch = nodes_[index];
+    branch.kind = TrieNode::Kind::Branch;
+    std::copy(children, children + 16, branch.children);
+    branch.value = value;
+    branch.height = height;
+    return index;
+  }
+
+  static void setPath(TrieNode& node, uint32_t key, size_t start, size_t end) {
+    node.pathKey = key;
+    node.pathStart = static_cast<uint16_t>(start);
+    node.pathEnd = static_cast<uint16_t>(end);
+  }
+
+  // Hex-prefix encoding of a node's path, with the leaf flag
+  size_t writePath(const TrieNode& node, uint8_t* output) const {
+    const TrieKey& key = keys_[node.pathKey];
+    size_t length = node.pathEnd - node.pathStart;
+    uint8_t flag = node.kind == TrieNode::Kind::Leaf ? 2 : 0;
+    size_t nibble = node.pathStart;
+    size_t size = 0;
+    if (length % 2 == 1) {
+      output[size++] = static_cast<uint8_t>(((flag + 1) << 4) | key.nibble(nibble++));
+    } else {
+      output[size++] = static_cast<uint8_t>(flag << 4);
+    }
+    for (; nibble < node.pathEnd; nibble += 2) {
+      output[size++] = static_cast<uint8_t>((key.nibble(nibble) << 4) | key.nibble(nibble + 1));
+    }
+    return size;
+  }
+
+  size_t valueSize(uint32_t item) const {
+    return rlpStringSize(items_ + offsets_[item], offsets_[item + 1] - offsets_[item]);
+  }
+
+  size_t writeValue(uint32_t item, uint8_t* output) const {
+    return rlpWriteString(output, items_ + offsets_[item], offsets_[item + 1] - offsets_[item]);
+  }
+
+  // A child reference is embedded as is if short, otherwise as a 32-byte string
+  size_t childSize(uint32_t child) const {
+    return child == kNone ? 1 : nodes_[child].refSize == 32 ? 33 : nodes_[child].refSize;
+  }
+
+  size_t writeChild(uint32_t child, uint8_t* output) const {
+    if (child == kNone) {
+      output[0] = 0x80;
+      return 1;
+    }
+    const TrieNode& node = nodes_[child];
+    if (node.refSize == 32) {
+      output[0] = 0xa0;
+      std::memcpy(output + 1, node.ref, 32);
+      return 33;
+    }
+    std::memcpy(output, node.ref, node.refSize);
+    return node.refSize;
+  }
+
+  // Encode a node whose children are sealed and store its reference
+  void seal(TrieNode& node, std::vector<uint8_t>& scratch) const {
+    uint8_t path[34];
+    size_t pathSize = 0;
+    size_t payloadSize = 0;
+    if (node.kind == TrieNode::Kind::Branch) {
+      for (uint32_t child : node.children) {
+        payloadSize += childSize(child);
+      }
+      payloadSize += node.value == kNone ? 1 : valueSize(node.value);
+    } else {
+      pathSize = writePath(node, path);
+      payloadSize = rlpStringSize(path, pathSize) +
+                    (node.kind == TrieNode::Kind::Leaf ? valueSize(node.value) : childSize(node.children[0]));
+    }
+
+    scratch.resize(rlpHeaderSize(payloadSize) + payloadSize);
+    uint8_t* output = scratch.data();
+    size_t size = rlpWriteHeader(output, payloadSize, true);
+    if (node.kind == TrieNode::Kind::Branch) {
+      for (uint32_t child : node.children) {
+        size += writeChild(child, output + size);
+      }
+      size += node.value == kNone ? rlpWriteString(output + size, nullptr, 0) : writeValue(node.value, output + size);
+    } else {
+      size += rlpWriteString(output + size, path, pathSize);
+      size += node.kind == TrieNode::Kind::Leaf ? writeValue(node.value, output + size)
+                                                : writeChild(node.children[0], output + size);
+    }
+
+    if (size < 32) {
+      std::memcpy(node.ref, output, size);
+      node.refSize = static_cast<uint8_t>(size);
+    } else {
+      keccak256(output, size, node.ref);
+      node.refSize = 32;
+    }
+  }
+
+  const uint8_t* items_;
+  const std::vector<size_t>& offsets_;
+  std::vector<TrieKey> keys_;
+  std::vector<uint32_t> order_;
+  std::vector<TrieNode> nodes_;
+};
+
+} // namespace
+
+void mptOrderedTrieRoot(const uint8_t* items, const std::vector<size_t>& offsets, size_t count, uint8_t* root) {
+  if (count == 0) {
+    std::memcpy(root, kEmptyTrieRoot, 32);
+    return;
+  }
+  OrderedTrieBuilder builder(items, offsets, count);
+  builder.computeRoot(root);
+}
+
+} // namespace margelo::nitro::metamask_nativeutils
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace margelo::nitro::metamask_nativeutils {
+
+/**
+ * Compute the root of the trie mapping rlp(i) to item i, as used for a
+ * block's transactionsRoot, receiptsRoot and withdrawalsRoot.
+ *
+ * The trie is built in memory with all nodes in one arena, then hashed
+ * bottom-up one level at a time: nodes of the same height only reference
+ * lower nodes, so each level is encoded and hashed as one batch, in
+ * parallel when it is large.
+ * @param items Encoded items back to back (transactions in their network
+ *   encoding, receipts in their consensus encoding)
+ * @param offsets count + 1 offsets; item i is [offsets[i], offsets[i + 1])
+ * @param count Number of items
+ * @param root Output buffer for the 32-byte root
+ */
+void mptOrderedTrieRoot(const uint8_t* items, const std::vector<size_t>& offsets, size_t count, uint8_t* root);
+
+} // namespace margelo::nitro::metamask_nativeutils
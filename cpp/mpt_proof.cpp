@@ -0,0 +1,101 @@
+#include "mpt_proof.hpp"
+#include "keccak_utils.hpp"
+#include "simd_utils.hpp"
+#include <stdexcept>
+#include <string>
+
+namespace margelo::nitro::metamask_nativeutils {
+
+const uint8_t kEmptyTrieRoot[32] = {0x56, 0xe8, 0x1f, 0x17, 0x1b, 0xcc, 0x55, 0xa6, 0xff, 0x83, 0x45,
+                                    0xe6, 0x92, 0xc0, 0xf8, 0x6e, 0x5b, 0x48, 0xe0, 0x1b, 0x99, 0x6c,
+                                    0xad, 0xc0, 0x01, 0x62, 0x2f, 0xb5, 0xe3, 0x63, 0xb4, 0x21};
+
+static constexpr size_t kPathNibbles = 64;
+
+static uint8_t nibbleAt(const uint8_t* bytes, size_t index) {
+  return index % 2 == 0 ? bytes[index / 2] >> 4 : bytes[index / 2] & 0x0f;
+}
+
+std::optional<RlpItem> mptVerifyProof(const uint8_t* root, const uint8_t* path, const std::vector<MptProofNode>& nodes) {
+  size_t next = 0;
+  size_t depth = 0; // nibbles of the path consumed
+  RlpItem reference{root, 32, false};
+
+  // A proof ends at the node holding the value or showing it is absent
+  auto requireAllUsed = [&]() {
+    if (next != nodes.size()) {
+      throw std::runtime_error("Proof has " + std::to_string(nodes.size() - next) + " unused nodes");
+    }
+  };
+
+  for (;;) {
+    RlpItem node;
+    if (reference.isList) {
+      node = reference;
+    } else if (reference.size == 32) {
+      if (next == nodes.size()) {
+        if (next == 0 && simd::equal32(reference.data, kEmptyTrieRoot)) {
+          return std::nullopt;
+        }
+        throw std::runtime_error("Proof ends before reaching the path");
+      }
+      const MptProofNode& encoded = nodes[next++];
+      uint8_t hash[32];
+      keccak256(encoded.data, encoded.size, hash);
+      if (!simd::equal32(hash, reference.data)) {
+        throw std::runtime_error("Proof node " + std::to_string(next - 1) + " does not match its parent hash");
+      }
+      node = rlpDecode(encoded.data, encoded.size);
+    } else if (reference.size == 0) {
+      requireAllUsed();
+      return std::nullopt;
+    } else {
+      throw std::runtime_error("Invalid trie node reference");
+    }
+
+    std::vector<RlpItem> items = rlpListItems(node);
+    if (items.size() == 17) {
+      // Branch: one child per nibble, plus a value for paths ending here
+      if (depth == kPathNibbles) {
+        requireAllUsed();
+        return items[16].size == 0 ? std::nullopt : std::optional<RlpItem>(items[16]);
+      }
+      reference = items[nibbleAt(path, depth++)];
+      continue;
+    }
+    if (items.size() != 2 || items[0].isList || items[0].size == 0) {
+      throw std::runtime_error("Invalid trie node with " + std::to_string(items.size()) + " items");
+    }
+
+    // Leaf or extension: hex-prefix encoded partial path
+    const uint8_t* partial = items[0].data;
+    uint8_t flags = partial[0] >> 4;
+    if (flags > 3 || (flags % 2 == 0 && (partial[0] & 0x0f) != 0)) {
+      throw std::runtime_error("Invalid hex-prefix path in trie node");
+    }
+    bool isLeaf = flags >= 2;
+    size_t start = flags % 2 == 1 ? 1 : 2; // nibble offset of the path in `partial`
+    size_t length = items[0].size * 2 - start;
+
+    bool matches = depth + length <= kPathNibbles;
+    for (size_t i = 0; matches && i < length; i++) {
+      matches = nibbleAt(partial, start + i) == nibbleAt(path, depth + i);
+    }
+    if (!matches || (isLeaf && depth + length != kPathNibbles)) {
+      requireAllUsed();
+      return std::nullopt;
+    }
+    depth += length;
+
+    if (isLeaf) {
+      requireAllUsed();
+      return items[1];
+    }
+    if (length == 0) {
+      throw std::runtime_error("Invalid empty extension in trie node");
+    }
+    reference = items[1];
+  }
+}
+
+} // namespace margelo::nitro::metamask_nativeutils
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "rlp.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace margelo::nitro::metamask_nativeutils {
+
+/** One RLP-encoded trie node of a proof, as returned by eth_getProof. */
+struct MptProofNode {
+  const uint8_t* data;
+  size_t size;
+};
+
+/** Root of an empty trie: keccak256(rlp("")) */
+extern const uint8_t kEmptyTrieRoot[32];
+
+/**
+ * Verify a Merkle-Patricia trie proof for a 32-byte trie path, walking the
+ * nodes from the root and checking each one's Keccak-256 against the
+ * reference in its parent. Nodes shorter than 32 bytes are embedded in their
+ * parent rather than listed in the proof.
+ * @param root 32-byte trie root
+ * @param path 32-byte path (for the state and storage tries, the Keccak-256
+ *   of the address or slot)
+ * @param nodes Proof nodes from the root down
+ * @return The RLP value stored at the path, aliasing the proof nodes; or
+ *   std::nullopt if the proof shows the path is absent
+ * @throws std::runtime_error if the proof is malformed or does not match the root
+ */
+std::optional<RlpItem> mptVerifyProof(const uint8_t* root, const uint8_t* path, const std::vector<MptProofNode>& nodes);
+
+} // namespace margelo::nitro::metamask_nativeutils
@@ -0,0 +1,31 @@
+#include "packed_items.hpp"
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+namespace margelo::nitro::metamask_nativeutils {
+
+std::vector<size_t> packedOffsets(const std::vector<double>& lengths, size_t totalSize, const char* what) {
+  std::vector<size_t> offsets(lengths.size() + 1, 0);
+  for (size_t i = 0; i < lengths.size(); i++) {
+    double length = lengths[i];
+    // NaN fails every comparison, so test for the valid range rather than
+    // against it; casting is only defined once the value is in range
+    if (!(length >= 0 && std::floor(length) == length)) {
+      throw std::runtime_error(std::string("Invalid ") + what + " length at index " + std::to_string(i));
+    }
+    size_t remaining = totalSize - offsets[i];
+    if (length > static_cast<double>(remaining)) {
+      throw std::runtime_error(std::string("Invalid ") + what + " length at index " + std::to_string(i) +
+                               ": exceeds the batch size of " + std::to_string(totalSize));
+    }
+    offsets[i + 1] = offsets[i] + static_cast<size_t>(length);
+  }
+  if (offsets.back() != totalSize) {
+    throw std::runtime_error(std::string("The ") + what + " lengths add up to " + std::to_string(offsets.back()) +
+                             ", expected " + std::to_string(totalSize));
+  }
+  return offsets;
+}
+
+} // namespace margelo::nitro::metamask_nativeutils
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace margelo::nitro::metamask_nativeutils {
+
+/**
+ * Turn the JS lengths of a packed batch into offsets. Lengths are checked
+ * against what is left of `totalSize` before they are added, so the offsets
+ * cannot wrap around and every item lies inside the batch.
+ * @param lengths Length of each item, as passed from JS
+ * @param totalSize Size of the packed batch, in the same unit as `lengths`
+ * @param what Item name for error messages, e.g. "message"
+ * @return `lengths.size() + 1` offsets, from 0 to `totalSize`
+ * @throws If a length is not a non-negative integer, or the lengths do not
+ *   add up to exactly `totalSize`
+ */
+std::vector<size_t> packedOffsets(const std::vector<double>& lengths, size_t totalSize, const char* what);
+
+} // namespace margelo::nitro::metamask_nativeutils
@@ -0,0 +1,97 @@
+#include "parallel_for.hpp"
+#include <NitroModules/ThreadPool.hpp>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace margelo::nitro::metamask_nativeutils {
+
+// Mobile SoCs have 2-4 fast cores; more helpers mostly land on slow ones
+static constexpr size_t kMaxHelpers = 3;
+
+namespace {
+
+// Outlives parallelFor() when a helper starts after all chunks are taken
+struct ParallelState {
+  const std::function<void(size_t, size_t)>* body = nullptr;
+  size_t count = 0;
+  size_t grain = 0;
+  size_t chunks = 0;
+  std::atomic<size_t> next{0};
+
+  std::mutex mutex;
+  std::condition_variable cv;
+  size_t done = 0;
+  std::exception_ptr error;
+
+  void work() {
+    for (size_t chunk = next.fetch_add(1); chunk < chunks; chunk = next.fetch_add(1)) {
+      std::exception_ptr failure;
+      try {
+        size_t begin = chunk * grain;
+        (*body)(begin, std::min(count, begin + grain));
+      } catch (...) {
+        failure = std::current_exception();
+      }
+
+      std::lock_guard<std::mutex> lock(mutex);
+      if (failure && !error) {
+        error = failure;
+      }
+      if (++done == chunks) {
+        cv.notify_one();
+      }
+    }
+  }
+};
+
+} // namespace
+
+void parallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)>& body) {
+  grain = std::max<size_t>(grain, 1);
+  size_t chunks = (count + grain - 1) / grain;
+  size_t helpers = std::min({chunks > 0 ? chunks - 1 : 0, kMaxHelpers,
+                             static_cast<size_t>(std::max(1u, std::thread::hardware_concurrency()) - 1)});
+  if (helpers == 0) {
+    if (count > 0) {
+      body(0, count);
+    }
+    return;
+  }
+
+  auto state = std::make_shared<ParallelState>();
+  state->body = &body;
+  state->count = count;
+  state->grain = grain;
+  state->chunks = chunks;
+  for (size_t i = 0; i < helpers; i++) {
+    ThreadPool::shared().run([state]() { state->work(); });
+  }
+  state->work();
+
+  std::unique_lock<std::mutex> lock(state->mutex);
+  state->cv.wait(lock, [&state]() { return state->done == state->chunks; });
+  if (state->error) {
+    std::rethrow_exception(state->error);
+  }
+}
+
+void parallelBitmap(size_t count, size_t grain, uint8_t* bitmap, const std::function<bool(size_t)>& predicate) {
+  parallelFor((count + 7) / 8, grain / 8, [&](size_t begin, size_t end) {
+    for (size_t byte = begin; byte < end; byte++) {
+      uint8_t bits = 0;
+      for (size_t i = byte * 8; i < std::min(count, byte * 8 + 8); i++) {
+        if (predicate(i)) {
+          bits |= static_cast<uint8_t>(1u << (i % 8));
+        }
+      }
+      bitmap[byte] = bits;
+    }
+  });
+}
+
+} // namespace margelo::nitro::metamask_nativeutils
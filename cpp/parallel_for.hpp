@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace margelo::nitro::metamask_nativeutils {
+
+/**
+ * Run `body` over [0, count) split into chunks of `grain` items, on the
+ * calling thread and up to a few shared thread pool workers. Chunks are
+ * claimed from an atomic cursor, so the calling thread finishes the work on
+ * its own if no worker is free, and never waits on a worker that has not
+ * started. Returns once every chunk has run.
+ * @param count Number of items
+ * @param grain Items per chunk; small ranges run inline
+ * @param body Called with [begin, end) for each chunk, possibly concurrently
+ * @throws The first exception thrown by `body`
+ */
+void parallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)>& body);
+
+/**
+ * Evaluate `predicate` for every item in [0, count) with parallelFor and
+ * write the results as an LSB-first bitmap. Chunks cover whole bitmap bytes,
+ * so no two workers write the same byte.
+ * @param count Number of items
+ * @param grain Items per chunk, rounded down to a multiple of 8
+ * @param bitmap Output of (count + 7) / 8 bytes
+ * @param predicate Called once per item index, possibly concurrently
+ * @throws The first exception thrown by `predicate`
+ */
+void parallelBitmap(size_t count, size_t grain, uint8_t* bitmap, const std::function<bool(size_t)>& predicate);
+
+} // namespace margelo::nitro::metamask_nativeutils
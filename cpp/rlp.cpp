@@ -0,0 +1,117 @@
+#include "rlp.hpp"
+#include <cstring>
+#include <stdexcept>
+
+namespace margelo::nitro::metamask_nativeutils {
+
+// Decode the item at the start of input; returns its encoded size
+static size_t decodeNext(const uint8_t* input, size_t size, RlpItem& item) {
+  if (size == 0) {
+    throw std::runtime_error("RLP input is empty");
+  }
+
+  uint8_t prefix = input[0];
+  size_t headerSize = 1;
+  size_t payloadSize = 0;
+  item.isList = prefix >= 0xc0;
+
+  if (prefix < 0x80) {
+    item.data = input;
+    item.size = 1;
+    return 1;
+  }
+
+  uint8_t shortBase = item.isList ? 0xc0 : 0x80;
+  if (prefix <= shortBase + 55) {
+    payloadSize = prefix - shortBase;
+  } else {
+    size_t lengthSize = prefix - shortBase - 55;
+    if (lengthSize > sizeof(size_t) || size < 1 + lengthSize) {
+      throw std::runtime_error("RLP length is truncated or too large");
+    }
+    if (input[1] == 0) {
+      throw std::runtime_error("RLP length has leading zeros");
+    }
+    for (size_t i = 0; i < lengthSize; i++) {
+      payloadSize = (payloadSize << 8) | input[1 + i];
+    }
+    if (payloadSize < 56) {
+      throw std::runtime_error("RLP long form used for a short payload");
+    }
+    headerSize += lengthSize;
+  }
+
+  if (payloadSize > size - headerSize) {
+    throw std::runtime_error("RLP payload is truncated");
+  }
+  if (!item.isList && payloadSize == 1 && input[headerSize] < 0x80) {
+    throw std::runtime_error("RLP single byte is not encoded as itself");
+  }
+  item.data = input + headerSize;
+  item.size = payloadSize;
+  return headerSize + payloadSize;
+}
+
+RlpItem rlpDecode(const uint8_t* input, size_t size) {
+  RlpItem item;
+  if (decodeNext(input, size, item) != size) {
+    throw std::runtime_error("RLP input has trailing bytes");
+  }
+  return item;
+}
+
+std::vector<RlpItem> rlpListItems(const RlpItem& list) {
+  if (!list.isList) {
+    throw std::runtime_error("RLP item is not a list");
+  }
+  std::vector<RlpItem> items;
+  size_t offset = 0;
+  while (offset < list.size) {
+    RlpItem item;
+    offset += decodeNext(list.data + offset, list.size - offset, item);
+    items.push_back(item);
+  }
+  return items;
+}
+
+size_t rlpHeaderSize(size_t payloadSize) {
+  size_t size = 1;
+  if (payloadSize > 55) {
+    for (size_t length = payloadSize; length > 0; length >>= 8) {
+      size++;
+    }
+  }
+  return size;
+}
+
+size_t rlpWriteHeader(uint8_t* output, size_t payloadSize, bool isList) {
+  uint8_t base = isList ? 0xc0 : 0x80;
+  if (payloadSize <= 55) {
+    output[0] = static_cast<uint8_t>(base + payloadSize);
+    return 1;
+  }
+  size_t lengthSize = rlpHeaderSize(payloadSize) - 1;
+  output[0] = static_cast<uint8_t>(base + 55 + lengthSize);
+  for (size_t i = 0; i < lengthSize; i++) {
+    output[lengthSize - i] = static_cast<uint8_t>(payloadSize >> (8 * i));
+  }
+  return 1 + lengthSize;
+}
+
+size_t rlpStringSize(const uint8_t* data, size_t size) {
+  return size == 1 && data[0] < 0x80 ? 1 : rlpHeaderSize(size) + size;
+}
+
+size_t rlpWriteString(uint8_t* output, const uint8_t* data, size_t size) {
+  if (size == 1 && data[0] < 0x80) {
+    output[0] = data[0];
+    return 1;
+  }
+  size_t headerSize = rlpWriteHeader(output, size, false);
+  if (size > 0) {
+    std::memcpy(output + headerSize, data, size);
+  }
+  return headerSize + size;
+}
+
+} // namespace margelo::nitro::metamask_nativeutils
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace margelo::nitro::metamask_nativeutils {
+
+/** A decoded RLP item. The payload points into the decoded input. */
+struct RlpItem {
+  const uint8_t* data = nullptr; // payload: string bytes, or the encoded list items
+  size_t size = 0;
+  bool isList = false;
+};
+
+/**
+ * Decode one RLP item spanning the whole input. Only canonical encodings are
+ * accepted (minimal lengths, single bytes below 0x80 unwrapped), as
+ * consensus data must use them.
+ * @param input Encoded item
+ * @param size Number of input bytes
+ * @return The item; its payload aliases `input`
+ * @throws std::runtime_error if the input is not exactly one canonical item
+ */
+RlpItem rlpDecode(const uint8_t* input, size_t size);
+
+/**
+ * Decode the items of an RLP list.
+ * @param list A list item
+ * @return The list's items, in order
+ * @throws std::runtime_error if `list` is not a list or an item is malformed
+ */
+std::vector<RlpItem> rlpListItems(const RlpItem& list);
+
+/** Encoded size of a string or list header for a payload of `payloadSize` bytes. */
+size_t rlpHeaderSize(size_t payloadSize);
+
+/**
+ * Write a string or list header.
+ * @param output Buffer of at least rlpHeaderSize(payloadSize) bytes
+ * @param payloadSize Size of the payload that follows
+ * @param isList Whether the payload is a list
+ * @return Number of bytes written
+ */
+size_t rlpWriteHeader(uint8_t* output, size_t payloadSize, bool isList);
+
+/** Encoded size of a byte string. */
+size_t rlpStringSize(const uint8_t* data, size_t size);
+
+/**
+ * Encode a byte string.
+ * @param output Buffer of at least rlpStringSize(data, size) bytes
+ * @return Number of bytes written
+ */
+size_t rlpWriteString(uint8_t* output, const uint8_t* data, size_t size);
+
+} // namespace margelo::nitro::metamask_nativeutils
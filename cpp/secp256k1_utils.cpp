@@ -0,0 +1,62 @@
+#include "secp256k1_utils.hpp"
+#include <mutex>
+#include <stdexcept>
+
+namespace margelo::nitro::metamask_nativeutils {
+
+// Static global context for maximum performance.
+// Made const and initialized with a call-once guard for thread safety.
+static std::once_flag g_ctx_once;
+static const secp256k1_context* g_ctx = nullptr;
+
+const secp256k1_context* secp256k1Context() {
+    std::call_once(g_ctx_once, []() {
+        g_ctx = secp256k1_context_create(SECP256K1_CONTEXT_NONE);
+    });
+
+    if (!g_ctx) {
+        throw std::runtime_error("Failed to initialize secp256k1 context");
+    }
+    return g_ctx;
+}
+
+// libsecp256k1 treats the length parameter as an in/out value: on input it is the buffer
+// capacity, on output it is the actual number of bytes written. We defensively verify that
+// the actual length matches the format we requested (33 or 65 bytes) so that future changes
+// in libsecp256k1 cannot cause us to read uninitialized or truncated public key data.
+void serializeSecp256k1PubkeyChecked(
+    const secp256k1_pubkey* pubkey,
+    uint8_t* output,
+    size_t expectedLen,
+    unsigned int flags) {
+  size_t outputLen = expectedLen;
+  if (!secp256k1_ec_pubkey_serialize(secp256k1Context(), output, &outputLen, pubkey, flags)) {
+    throw std::runtime_error("Failed to serialize public key");
+  }
+  if (outputLen != expectedLen) {
+    throw std::runtime_error("Unexpected public key length from secp256k1");
+  }
+}
+
+void derivePublicKeyInto(const uint8_t* privateKeyBytes, uint8_t* output, bool isCompressed) {
+  const secp256k1_context* ctx = secp256k1Context();
+
+  // Use secp256k1's built-in validation (checks if key is not 0 and < curve order)
+  if (!secp256k1_ec_seckey_verify(ctx, privateKeyBytes)) {
+      throw std::runtime_error("Private key is invalid");
+  }
+  
+  // Create public key from private key
+  secp256k1_pubkey pubkey;
+  if (!secp256k1_ec_pubkey_create(ctx, &pubkey, privateKeyBytes)) {
+      throw std::runtime_error("Failed to create public key from private key");
+  }
+  
+  // Serialize the public key
+  size_t keySize = isCompressed ? 33 : 65;
+  unsigned int flags = isCompressed ? SECP256K1_EC_COMPRESSED : SECP256K1_EC_UNCOMPRESSED;
+
+  serializeSecp256k1PubkeyChecked(&pubkey, output, keySize, flags);
+}
+
+} // namespace margelo::nitro::metamask_nativeutils
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "secp256k1/include/secp256k1.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace margelo::nitro::metamask_nativeutils {
+
+/**
+ * Get the shared secp256k1 context, creating it on first use.
+ * @return Context usable from any thread
+ * @throws std::runtime_error if the context cannot be created
+ */
+const secp256k1_context* secp256k1Context();
+
+/**
+ * Serialize a public key and verify that libsecp256k1 wrote exactly the expected length.
+ * @param pubkey Parsed public key
+ * @param output Output buffer of `expectedLen` bytes
+ * @param expectedLen 33 for compressed or 65 for uncompressed keys
+ * @param flags SECP256K1_EC_COMPRESSED or SECP256K1_EC_UNCOMPRESSED
+ * @throws std::runtime_error if serialization fails
+ */
+void serializeSecp256k1PubkeyChecked(const secp256k1_pubkey* pubkey, uint8_t* output, size_t expectedLen, unsigned int flags);
+
+/**
+ * Derive a serialized public key from a 32-byte private key.
+ * @param privateKeyBytes 32-byte private key
+ * @param output Output buffer of 33 (compressed) or 65 (uncompressed) bytes
+ * @param isCompressed Whether to write the compressed encoding
+ * @throws std::runtime_error if the private key is invalid
+ */
+void derivePublicKeyInto(const uint8_t* privateKeyBytes, uint8_t* output, bool isCompressed);
+
+} // namespace margelo::nitro::metamask_nativeutils
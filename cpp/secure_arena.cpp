@@ -0,0 +1,353 @@
+#include "secure_arena.hpp"
+#include "botan_conditional.h"
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace margelo::nitro::metamask_nativeutils {
+
+static constexpr size_t kChunkSize = 64 * 1024;
+// 1 MiB of pooled blocks; anything beyond gets dedicated mappings
+static constexpr size_t kMaxChunks = 16;
+static constexpr size_t kMinBlockSize = 32;
+static constexpr size_t kAlignment = 16;
+// Released dedicated mappings kept for reuse, in bytes
+static constexpr size_t kSpareBudgetBytes = 256 * 1024;
+// Free blocks hold the free list link in their first bytes
+static constexpr size_t kLinkSize = sizeof(uint8_t*);
+
+static size_t roundUp(size_t value, size_t multiple) {
+  return (value + multiple - 1) / multiple * multiple;
+}
+
+// Smallest power-of-two block that fits `size`; returns kClassCount if none does
+static size_t classFor(size_t size, size_t& blockSize) {
+  size_t sizeClass = 0;
+  blockSize = kMinBlockSize;
+  while (sizeClass < SecureArena::kClassCount && blockSize < size) {
+    sizeClass++;
+    blockSize <<= 1;
+  }
+  return sizeClass;
+}
+
+SecureArena& SecureArena::shared() {
+  static SecureArena arena;
+  return arena;
+}
+
+SecureArena::SecureArena() : idleBudget_(maxIdleBytes()) {
+  long pageSize = sysconf(_SC_PAGESIZE);
+  pageSize_ = pageSize > 0 ? static_cast<size_t>(pageSize) : 4096;
+}
+
+uint8_t* SecureArena::allocate(size_t size) {
+  size = size == 0 ? 1 : size;
+
+  size_t blockSize = 0;
+  size_t sizeClass = classFor(size, blockSize);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  uint8_t* block = sizeClass < kClassCount ? allocateFromChunks(blockSize, sizeClass) : nullptr;
+  if (block != nullptr) {
+    inUseBytes_ += blockSize;
+  } else {
+    block = allocateDedicated(size);
+    inUseBytes_ += roundUp(size, kAlignment);
+  }
+  liveAllocations_++;
+  return block;
+}
+
+void SecureArena::deallocate(uint8_t* ptr, size_t size) {
+  if (ptr == nullptr) {
+    return;
+  }
+  size = size == 0 ? 1 : size;
+
+  size_t blockSize = 0;
+  size_t sizeClass = classFor(size, blockSize);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  liveAllocations_--;
+  size_t chunk = sizeClass < kClassCount ? chunkIndexOf(ptr) : chunks_.size();
+  if (chunk < chunks_.size()) {
+    Botan::secure_scrub_memory(ptr, blockSize);
+    std::memcpy(ptr, &freeLists_[sizeClass], kLinkSize);
+    freeLists_[sizeClass] = ptr;
+    inUseBytes_ -= blockSize;
+    chunkInUseBytes_ -= blockSize;
+    chunks_[chunk].inUseBytes -= blockSize;
+  } else {
+    deallocateDedicated(ptr, size);
+    inUseBytes_ -= roundUp(size, kAlignment);
+  }
+  if (idleBytesLocked() > idleBudget_) {
+    enforceIdleBudget();
+  }
+}
+
+SecureArenaStats SecureArena::stats() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return {reservedBytes_, lockedBytes_, inUseBytes_, idleBytesLocked(), liveAllocations_};
+}
+
+size_t SecureArena::maxIdleBytes() {
+  return kMaxChunks * kChunkSize + kSpareBudgetBytes;
+}
+
+size_t SecureArena::idleBudget() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return idleBudget_;
+}
+
+size_t SecureArena::setIdleBudget(size_t bytes) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  // Below one chunk, a single small allocation would map and unmap a chunk
+  idleBudget_ = std::clamp(bytes, kChunkSize, maxIdleBytes());
+  enforceIdleBudget();
+  return idleBudget_;
+}
+
+size_t SecureArena::idleBytesLocked() const {
+  return spareBytes_ + chunks_.size() * kChunkSize - chunkInUseBytes_;
+}
+
+size_t SecureArena::trim(double keepFraction) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  size_t reservedBefore = reservedBytes_;
+
+  size_t keepSpareBytes = static_cast<size_t>(static_cast<double>(kSpareBudgetBytes) * keepFraction);
+  while (spareBytes_ > keepSpareBytes) {
+    releaseOldestSpare();
+  }
+
+  if (keepFraction <= 0) {
+    releaseIdleChunks(0);
+  }
+  return reservedBefore - reservedBytes_;
+}
+
+void SecureArena::releaseOldestSpare() {
+  Mapping mapping = spareMappings_.front();
+  spareMappings_.erase(spareMappings_.begin());
+  spareBytes_ -= mapping.usableSize;
+  unmapGuarded(mapping);
+}
+
+// Spare mappings are the cheapest idle memory to give up, so they go first
+void SecureArena::enforceIdleBudget() {
+  while (!spareMappings_.empty() && idleBytesLocked() > idleBudget_) {
+    releaseOldestSpare();
+  }
+  if (idleBytesLocked() > idleBudget_) {
+    releaseIdleChunks(idleBudget_);
+  }
+}
+
+void SecureArena::releaseIdleChunks(size_t keepIdleBytes) {
+  // A chunk is idle when every block carved from it is back on a free list
+  if (std::none_of(chunks_.begin(), chunks_.end(), [](const Chunk& chunk) { return chunk.inUseBytes == 0; })) {
+    return;
+  }
+  std::vector<Chunk> idle;
+  std::vector<Chunk> busy;
+  size_t idleBytes = idleBytesLocked();
+  for (const auto& chunk : chunks_) {
+    if (chunk.inUseBytes == 0 && idleBytes > keepIdleBytes) {
+      idle.push_back(chunk);
+      idleBytes -= kChunkSize;
+    } else {
+      busy.push_back(chunk);
+    }
+  }
+  if (idle.empty()) {
+    return;
+  }
+
+  // Unlink blocks of idle chunks from the free lists before unmapping them
+  auto inIdleChunk = [&idle](const uint8_t* block) {
+    return std::any_of(idle.begin(), idle.end(), [block](const Chunk& chunk) {
+      return block >= chunk.begin && block < chunk.end;
+    });
+  };
+  for (auto& head : freeLists_) {
+    uint8_t** link = &head;
+    while (*link != nullptr) {
+      uint8_t* block = *link;
+      uint8_t* next;
+      std::memcpy(&next, block, kLinkSize);
+      if (inIdleChunk(block)) {
+        *link = next;
+      } else {
+        link = reinterpret_cast<uint8_t**>(block);
+      }
+    }
+  }
+
+  for (const auto& chunk : idle) {
+    unmapGuarded({chunk.begin, kChunkSize, chunk.locked});
+  }
+  chunks_ = std::move(busy);
+}
+
+uint8_t* SecureArena::allocateFromChunks(size_t blockSize, size_t sizeClass) {
+  if (uint8_t* block = freeLists_[sizeClass]) {
+    std::memcpy(&freeLists_[sizeClass], block, kLinkSize);
+    std::memset(block, 0, kLinkSize);
+    chunks_[chunkIndexOf(block)].inUseBytes += blockSize;
+    chunkInUseBytes_ += blockSize;
+    return block;
+  }
+
+  if (chunks_.empty() || chunks_.back().cursor + blockSize > chunks_.back().end) {
+    if (chunks_.size() >= kMaxChunks || !addChunk()) {
+      return nullptr;
+    }
+  }
+
+  // Chunks are page aligned and block sizes are powers of two, so bumping keeps blocks aligned
+  auto& chunk = chunks_.back();
+  uint8_t* block = chunk.cursor;
+  chunk.cursor += blockSize;
+  chunk.inUseBytes += blockSize;
+  chunkInUseBytes_ += blockSize;
+  return block;
+}
+
+bool SecureArena::addChunk() {
+  try {
+    Mapping mapping = mapGuarded(kChunkSize);
+    chunks_.push_back({mapping.begin, mapping.begin, mapping.begin + kChunkSize, 0, mapping.locked});
+    return true;
+  } catch (const std::bad_alloc&) {
+    return false;
+  }
+}
+
+uint8_t* SecureArena::allocateDedicated(size_t size) {
+  size_t rounded = roundUp(size, kAlignment);
+  size_t usable = roundUp(rounded, pageSize_);
+
+  Mapping mapping{};
+  auto spare = std::find_if(spareMappings_.begin(), spareMappings_.end(), [usable](const Mapping& candidate) {
+    return candidate.usableSize == usable;
+  });
+  if (spare != spareMappings_.end()) {
+    mapping = *spare;
+    spareMappings_.erase(spare);
+    spareBytes_ -= mapping.usableSize;
+  } else {
+    mapping = mapGuarded(usable);
+  }
+  dedicated_[mapping.begin] = mapping;
+
+  // Place the block against the trailing guard page so overruns fault immediately
+  return mapping.begin + usable - rounded;
+}
+
+void SecureArena::deallocateDedicated(uint8_t* ptr, size_t size) {
+  size_t rounded = roundUp(size, kAlignment);
+  Botan::secure_scrub_memory(ptr, rounded);
+
+  // The block starts inside the first usable page
+  auto* begin = reinterpret_cast<uint8_t*>(reinterpret_cast<uintptr_t>(ptr) & ~static_cast<uintptr_t>(pageSize_ - 1));
+  auto it = dedicated_.find(begin);
+  if (it == dedicated_.end()) {
+    return;
+  }
+  Mapping mapping = it->second;
+  dedicated_.erase(it);
+
+  if (mapping.usableSize > kSpareBudgetBytes) {
+    unmapGuarded(mapping);
+    return;
+  }
+  // Keep the most recently released sizes; they are the likeliest to repeat
+  while (spareBytes_ + mapping.usableSize > kSpareBudgetBytes) {
+    releaseOldestSpare();
+  }
+  spareMappings_.push_back(mapping);
+  spareBytes_ += mapping.usableSize;
+}
+
+SecureArena::Mapping SecureArena::mapGuarded(size_t usableSize) {
+  size_t totalSize = usableSize + 2 * pageSize_;
+  void* region = mmap(nullptr, totalSize, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (region == MAP_FAILED) {
+    throw std::bad_alloc();
+  }
+
+  uint8_t* begin = static_cast<uint8_t*>(region) + pageSize_;
+  if (mprotect(begin, usableSize, PROT_READ | PROT_WRITE) != 0) {
+    munmap(region, totalSize);
+    throw std::bad_alloc();
+  }
+#ifdef MADV_DONTDUMP
+  madvise(begin, usableSize, MADV_DONTDUMP);
+#endif
+
+  bool locked = mlock(begin, usableSize) == 0;
+  if (locked) {
+    lockedBytes_ += usableSize;
+  }
+  reservedBytes_ += usableSize;
+  return {begin, usableSize, locked};
+}
+
+void SecureArena::unmapGuarded(const Mapping& mapping) {
+  if (mapping.locked) {
+    munlock(mapping.begin, mapping.usableSize);
+    lockedBytes_ -= mapping.usableSize;
+  }
+  munmap(mapping.begin - pageSize_, mapping.usableSize + 2 * pageSize_);
+  reservedBytes_ -= mapping.usableSize;
+}
+
+// Index of the chunk holding `ptr`, or chunks_.size() if none does
+size_t SecureArena::chunkIndexOf(const uint8_t* ptr) const {
+  for (size_t i = 0; i < chunks_.size(); i++) {
+    if (ptr >= chunks_[i].begin && ptr < chunks_[i].end) {
+      return i;
+    }
+  }
+  return chunks_.size();
+}
+
+SecureBuffer::SecureBuffer(size_t size) : data_(SecureArena::shared().allocate(size)), size_(size) {}
+
+SecureBuffer::SecureBuffer(const uint8_t* data, size_t size) : SecureBuffer(size) {
+  if (size > 0) {
+    std::memcpy(data_, data, size);
+  }
+}
+
+SecureBuffer::~SecureBuffer() {
+  release();
+}
+
+SecureBuffer::SecureBuffer(SecureBuffer&& other) noexcept : data_(other.data_), size_(other.size_) {
+  other.data_ = nullptr;
+  other.size_ = 0;
+}
+
+SecureBuffer& SecureBuffer::operator=(SecureBuffer&& other) noexcept {
+  if (this != &other) {
+    release();
+    data_ = other.data_;
+    size_ = other.size_;
+    other.data_ = nullptr;
+    other.size_ = 0;
+  }
+  return *this;
+}
+
+void SecureBuffer::release() {
+  SecureArena::shared().deallocate(data_, size_);
+  data_ = nullptr;
+  size_ = 0;
+}
+
+} // namespace margelo::nitro::metamask_nativeutils
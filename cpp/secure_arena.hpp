@@ -0,0 +1,155 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace margelo::nitro::metamask_nativeutils {
+
+struct SecureArenaStats {
+  size_t reservedBytes;  // usable bytes mapped by the arena
+  size_t lockedBytes;    // of which successfully mlock()ed
+  size_t inUseBytes;     // handed out and not yet released
+  size_t idleBytes;      // mapped but free: spare mappings and unused chunk space
+  size_t liveAllocations;
+};
+
+/**
+ * Allocator for private keys and other secret material.
+ *
+ * Small blocks come from 64 KiB chunks that are mapped once with a guard page
+ * on each side, locked into RAM (best effort; the RLIMIT_MEMLOCK budget can be
+ * small) and excluded from core dumps. Allocation is a free-list pop or a bump
+ * of the chunk cursor, so hot paths never pay for mmap/mlock. Blocks larger
+ * than the biggest size class, or requested once the chunks are exhausted, get
+ * a dedicated guarded mapping that ends right at its trailing guard page;
+ * released mappings are kept for reuse, within a byte budget, since mapping
+ * and locking costs tens of microseconds. Every block is zeroed on release.
+ *
+ * Idle memory is held to a configurable budget: when a release takes it
+ * over, spare mappings go first, then chunks with no live blocks. Chunks
+ * that still hold a live block cannot be released, so the budget can only
+ * be exceeded by free space in those.
+ */
+class SecureArena {
+public:
+  static SecureArena& shared();
+
+  /**
+   * Allocate zero-filled secure memory, 16-byte aligned.
+   * @param size Number of bytes (0 is treated as 1)
+   * @throws std::bad_alloc if no memory can be mapped
+   */
+  uint8_t* allocate(size_t size);
+
+  /**
+   * Wipe and release memory returned by allocate().
+   * @param ptr Block to release (nullptr is ignored)
+   * @param size The size passed to allocate()
+   */
+  void deallocate(uint8_t* ptr, size_t size);
+
+  SecureArenaStats stats();
+
+  /**
+   * Release idle memory under memory pressure.
+   * @param keepFraction Share of the spare mapping budget to keep (0..1);
+   *   at 0, chunks with no live blocks are unmapped as well
+   * @return Number of bytes unmapped
+   */
+  size_t trim(double keepFraction);
+
+  /** Most idle memory the arena can hold: every chunk and the spare budget. */
+  static size_t maxIdleBytes();
+
+  /** Budget for SecureArenaStats::idleBytes; maxIdleBytes() unless set. */
+  size_t idleBudget();
+
+  /**
+   * Set the idle memory budget and release what is over it.
+   * @param bytes New budget, clamped to one chunk .. maxIdleBytes()
+   * @return The budget in effect
+   */
+  size_t setIdleBudget(size_t bytes);
+
+  SecureArena(const SecureArena&) = delete;
+  SecureArena& operator=(const SecureArena&) = delete;
+
+  static constexpr size_t kClassCount = 7; // 32 B .. 2 KiB
+
+private:
+  SecureArena();
+
+  struct Chunk {
+    uint8_t* begin;
+    uint8_t* cursor;
+    uint8_t* end;
+    size_t inUseBytes;
+    bool locked;
+  };
+
+  struct Mapping {
+    uint8_t* begin;
+    size_t usableSize;
+    bool locked;
+  };
+
+  uint8_t* allocateFromChunks(size_t blockSize, size_t sizeClass);
+  uint8_t* allocateDedicated(size_t size);
+  void deallocateDedicated(uint8_t* ptr, size_t size);
+  bool addChunk();
+  Mapping mapGuarded(size_t usableSize);
+  void unmapGuarded(const Mapping& mapping);
+  size_t chunkIndexOf(const uint8_t* ptr) const;
+  size_t idleBytesLocked() const;
+  void enforceIdleBudget();
+  void releaseOldestSpare();
+  void releaseIdleChunks(size_t keepIdleBytes);
+
+  std::mutex mutex_;
+  size_t pageSize_;
+  std::vector<Chunk> chunks_;
+  uint8_t* freeLists_[kClassCount] = {};
+  // Dedicated mappings in use, by usable start
+  std::unordered_map<uint8_t*, Mapping> dedicated_;
+  // Released dedicated mappings kept (wiped) for reuse by same-sized requests
+  std::vector<Mapping> spareMappings_;
+  size_t spareBytes_ = 0;
+  size_t idleBudget_;
+  size_t chunkInUseBytes_ = 0;
+  size_t reservedBytes_ = 0;
+  size_t lockedBytes_ = 0;
+  size_t inUseBytes_ = 0;
+  size_t liveAllocations_ = 0;
+};
+
+/**
+ * Owning, move-only buffer allocated from SecureArena::shared().
+ * The memory is wiped when the buffer is destroyed.
+ */
+class SecureBuffer {
+public:
+  SecureBuffer() = default;
+  explicit SecureBuffer(size_t size);
+  SecureBuffer(const uint8_t* data, size_t size);
+  ~SecureBuffer();
+
+  SecureBuffer(SecureBuffer&& other) noexcept;
+  SecureBuffer& operator=(SecureBuffer&& other) noexcept;
+  SecureBuffer(const SecureBuffer&) = delete;
+  SecureBuffer& operator=(const SecureBuffer&) = delete;
+
+  uint8_t* data() { return data_; }
+  const uint8_t* data() const { return data_; }
+  size_t size() const { return size_; }
+
+private:
+  void release();
+
+  uint8_t* data_ = nullptr;
+  size_t size_ = 0;
+};
+
+} // namespace margelo::nitro::metamask_nativeutils
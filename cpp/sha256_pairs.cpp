@@ -0,0 +1,288 @@
+#include "sha256_pairs.hpp"
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define NATIVEUTILS_SHA256_X86 1
+#include <cpuid.h>
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#define NATIVEUTILS_SHA256_ARMV8 1
+#include <arm_neon.h>
+#if defined(__linux__)
+#include <asm/hwcap.h>
+#include <sys/auxv.h>
+#endif
+#endif
+
+namespace margelo::nitro::metamask_nativeutils {
+
+alignas(16) static const uint32_t kRoundConstants[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+// Message schedule plus round constant for the second block of every 64-byte
+// message: 0x80, zeros, and the bit length 512
+alignas(16) static const uint32_t kPaddingSchedule[64] = {
+    0xc28a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf374,
+    0x649b69c1, 0xf0fe4786, 0x0fe1edc6, 0x240cf254, 0x4fe9346f, 0x6cc984be, 0x61b9411e, 0x16f988fa,
+    0xf2c65152, 0xa88e5a6d, 0xb019fc65, 0xb9d99ec7, 0x9a1231c3, 0xe70eeaa0, 0xfdb1232b, 0xc7353eb0,
+    0x3069bad5, 0xcb976d5f, 0x5a0f118f, 0xdc1eeefd, 0x0a35b689, 0xde0b7a04, 0x58f4ca9d, 0xe15d5b16,
+    0x007f3e86, 0x37088980, 0xa507ea32, 0x6fab9537, 0x17406110, 0x0d8cd6f1, 0xcdaa3b6d, 0xc0bbbe37,
+    0x83613bda, 0xdb48a363, 0x0b02e931, 0x6fd15ca7, 0x521afaca, 0x31338431, 0x6ed41a95, 0x6d437890,
+    0xc39c91f2, 0x9eccabbd, 0xb5c9a0e6, 0x532fb63c, 0xd2c741c6, 0x07237ea3, 0xa4954b68, 0x4c191d76,
+};
+
+alignas(16) static const uint32_t kInitialState[8] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19,
+};
+
+// Portable kernel: four messages per pass, one per vector lane. The compiler
+// lowers the vector extension to SSE2 or NEON, or to scalar code elsewhere.
+
+typedef uint32_t Lanes __attribute__((vector_size(16)));
+
+static inline Lanes rotr(Lanes x, int bits) {
+  return (x >> bits) | (x << (32 - bits));
+}
+
+static inline uint32_t loadBigEndian32(const uint8_t* p) {
+  return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) |
+         (static_cast<uint32_t>(p[2]) << 8) | static_cast<uint32_t>(p[3]);
+}
+
+static inline void storeBigEndian32(uint8_t* p, uint32_t value) {
+  p[0] = static_cast<uint8_t>(value >> 24);
+  p[1] = static_cast<uint8_t>(value >> 16);
+  p[2] = static_cast<uint8_t>(value >> 8);
+  p[3] = static_cast<uint8_t>(value);
+}
+
+static inline void round(Lanes s[8], Lanes wk) {
+  Lanes t1 = s[7] + (rotr(s[4], 6) ^ rotr(s[4], 11) ^ rotr(s[4], 25)) + ((s[4] & s[5]) ^ (~s[4] & s[6])) + wk;
+  Lanes t2 = (rotr(s[0], 2) ^ rotr(s[0], 13) ^ rotr(s[0], 22)) + ((s[0] & s[1]) ^ (s[0] & s[2]) ^ (s[1] & s[2]));
+  s[7] = s[6];
+  s[6] = s[5];
+  s[5] = s[4];
+  s[4] = s[3] + t1;
+  s[3] = s[2];
+  s[2] = s[1];
+  s[1] = s[0];
+  s[0] = t1 + t2;
+}
+
+// Hash 4 packed messages into 4 packed digests; all input is read first
+static void hashLanes(const uint8_t* messages, uint8_t* digests) {
+  Lanes w[16];
+  for (int t = 0; t < 16; t++) {
+    for (int lane = 0; lane < 4; lane++) {
+      w[t][lane] = loadBigEndian32(messages + lane * 64 + t * 4);
+    }
+  }
+
+  Lanes initial[8], s[8];
+  for (int i = 0; i < 8; i++) {
+    initial[i] = s[i] = Lanes{} + kInitialState[i];
+  }
+  for (int t = 0; t < 64; t++) {
+    if (t >= 16) {
+      Lanes w15 = w[(t + 1) & 15], w2 = w[(t + 14) & 15];
+      w[t & 15] += (rotr(w15, 7) ^ rotr(w15, 18) ^ (w15 >> 3)) + w[(t + 9) & 15] +
+                   (rotr(w2, 17) ^ rotr(w2, 19) ^ (w2 >> 10));
+    }
+    round(s, w[t & 15] + kRoundConstants[t]);
+  }
+  for (int i = 0; i < 8; i++) {
+    s[i] += initial[i];
+    initial[i] = s[i];
+  }
+
+  for (int t = 0; t < 64; t++) {
+    round(s, Lanes{} + kPaddingSchedule[t]);
+  }
+  for (int i = 0; i < 8; i++) {
+    s[i] += initial[i];
+    for (int lane = 0; lane < 4; lane++) {
+      storeBigEndian32(digests + lane * 32 + i * 4, s[i][lane]);
+    }
+  }
+}
+
+static void hashPairsVector(const uint8_t* input, size_t count, uint8_t* output) {
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    hashLanes(input + i * 64, output + i * 32);
+  }
+  if (i < count) {
+    uint8_t messages[4 * 64] = {};
+    uint8_t digests[4 * 32];
+    std::memcpy(messages, input + i * 64, (count - i) * 64);
+    hashLanes(messages, digests);
+    std::memcpy(output + i * 32, digests, (count - i) * 32);
+  }
+}
+
+#if defined(NATIVEUTILS_SHA256_X86)
+
+// SHA-NI keeps the state as ABEF and CDGH and runs two rounds per
+// sha256rnds2, taking the message words plus constants in the low half of
+// its third operand
+
+__attribute__((target("sha,sse4.1"))) static void hashPairsShaNi(const uint8_t* input, size_t count, uint8_t* output) {
+  const __m128i byteSwap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+  __m128i dcba = _mm_loadu_si128(reinterpret_cast<const __m128i*>(kInitialState));
+  __m128i hgfe = _mm_loadu_si128(reinterpret_cast<const __m128i*>(kInitialState + 4));
+  __m128i cdab = _mm_shuffle_epi32(dcba, 0xb1);
+  __m128i efgh = _mm_shuffle_epi32(hgfe, 0x1b);
+  const __m128i initialAbef = _mm_alignr_epi8(cdab, efgh, 8);
+  const __m128i initialCdgh = _mm_blend_epi16(efgh, cdab, 0xf0);
+
+  for (size_t i = 0; i < count; i++) {
+    const uint8_t* message = input + i * 64;
+    __m128i abef = initialAbef;
+    __m128i cdgh = initialCdgh;
+
+    __m128i w[4];
+    for (int j = 0; j < 4; j++) {
+      w[j] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(message + j * 16)), byteSwap);
+    }
+    // Rounds 4j..4j+3 use w[j % 4]; words 16 onwards are expanded a group
+    // ahead of their rounds
+    for (int j = 0; j < 16; j++) {
+      __m128i current = w[j & 3];
+      __m128i wk = _mm_add_epi32(current, _mm_load_si128(reinterpret_cast<const __m128i*>(kRoundConstants + j * 4)));
+      cdgh = _mm_sha256rnds2_epu32(cdgh, abef, wk);
+      if (j >= 3 && j <= 14) {
+        __m128i& next = w[(j + 1) & 3];
+        next = _mm_add_epi32(next, _mm_alignr_epi8(current, w[(j + 3) & 3], 4));
+        next = _mm_sha256msg2_epu32(next, current);
+      }
+      abef = _mm_sha256rnds2_epu32(abef, cdgh, _mm_shuffle_epi32(wk, 0x0e));
+      if (j >= 1 && j <= 12) {
+        w[(j + 3) & 3] = _mm_sha256msg1_epu32(w[(j + 3) & 3], current);
+      }
+    }
+    abef = _mm_add_epi32(abef, initialAbef);
+    cdgh = _mm_add_epi32(cdgh, initialCdgh);
+
+    __m128i middleAbef = abef;
+    __m128i middleCdgh = cdgh;
+    for (int j = 0; j < 16; j++) {
+      __m128i wk = _mm_load_si128(reinterpret_cast<const __m128i*>(kPaddingSchedule + j * 4));
+      cdgh = _mm_sha256rnds2_epu32(cdgh, abef, wk);
+      abef = _mm_sha256rnds2_epu32(abef, cdgh, _mm_shuffle_epi32(wk, 0x0e));
+    }
+    abef = _mm_add_epi32(abef, middleAbef);
+    cdgh = _mm_add_epi32(cdgh, middleCdgh);
+
+    // Back to ABCD and EFGH, big-endian
+    __m128i feba = _mm_shuffle_epi32(abef, 0x1b);
+    __m128i dchg = _mm_shuffle_epi32(cdgh, 0xb1);
+    __m128i abcd = _mm_blend_epi16(feba, dchg, 0xf0);
+    __m128i efghOut = _mm_alignr_epi8(dchg, feba, 8);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i * 32), _mm_shuffle_epi8(abcd, byteSwap));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i * 32 + 16), _mm_shuffle_epi8(efghOut, byteSwap));
+  }
+}
+
+static bool cpuHasShaExtensions() {
+  unsigned int eax, ebx, ecx, edx;
+  if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx) || !(ecx & bit_SSSE3) || !(ecx & bit_SSE4_1)) {
+    return false;
+  }
+  if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) {
+    return false;
+  }
+  return (ebx & (1u << 29)) != 0; // SHA
+}
+
+#elif defined(NATIVEUTILS_SHA256_ARMV8)
+
+#if defined(__clang__)
+#define NATIVEUTILS_TARGET_SHA2 __attribute__((target("crypto")))
+#else
+#define NATIVEUTILS_TARGET_SHA2 __attribute__((target("+crypto")))
+#endif
+
+NATIVEUTILS_TARGET_SHA2 static void hashPairsArmv8(const uint8_t* input, size_t count, uint8_t* output) {
+  const uint32x4_t initialAbcd = vld1q_u32(kInitialState);
+  const uint32x4_t initialEfgh = vld1q_u32(kInitialState + 4);
+
+  for (size_t i = 0; i < count; i++) {
+    const uint8_t* message = input + i * 64;
+    uint32x4_t abcd = initialAbcd;
+    uint32x4_t efgh = initialEfgh;
+
+    uint32x4_t w[4];
+    for (int j = 0; j < 4; j++) {
+      w[j] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(message + j * 16)));
+    }
+    for (int j = 0; j < 16; j++) {
+      uint32x4_t wk = vaddq_u32(w[j & 3], vld1q_u32(kRoundConstants + j * 4));
+      if (j < 12) {
+        w[j & 3] = vsha256su1q_u32(vsha256su0q_u32(w[j & 3], w[(j + 1) & 3]), w[(j + 2) & 3], w[(j + 3) & 3]);
+      }
+      uint32x4_t previous = abcd;
+      abcd = vsha256hq_u32(abcd, efgh, wk);
+      efgh = vsha256h2q_u32(efgh, previous, wk);
+    }
+    abcd = vaddq_u32(abcd, initialAbcd);
+    efgh = vaddq_u32(efgh, initialEfgh);
+
+    uint32x4_t middleAbcd = abcd;
+    uint32x4_t middleEfgh = efgh;
+    for (int j = 0; j < 16; j++) {
+      uint32x4_t wk = vld1q_u32(kPaddingSchedule + j * 4);
+      uint32x4_t previous = abcd;
+      abcd = vsha256hq_u32(abcd, efgh, wk);
+      efgh = vsha256h2q_u32(efgh, previous, wk);
+    }
+    abcd = vaddq_u32(abcd, middleAbcd);
+    efgh = vaddq_u32(efgh, middleEfgh);
+
+    vst1q_u8(output + i * 32, vrev32q_u8(vreinterpretq_u8_u32(abcd)));
+    vst1q_u8(output + i * 32 + 16, vrev32q_u8(vreinterpretq_u8_u32(efgh)));
+  }
+}
+
+static bool cpuHasShaExtensions() {
+#if defined(__APPLE__)
+  return true; // every arm64 Apple CPU has the ARMv8 crypto extensions
+#elif defined(__linux__)
+  return (getauxval(AT_HWCAP) & HWCAP_SHA2) != 0;
+#else
+  return false;
+#endif
+}
+
+#endif
+
+using PairKernel = void (*)(const uint8_t*, size_t, uint8_t*);
+
+static PairKernel selectKernel() {
+#if defined(NATIVEUTILS_SHA256_X86)
+  if (cpuHasShaExtensions()) {
+    return hashPairsShaNi;
+  }
+#elif defined(NATIVEUTILS_SHA256_ARMV8)
+  if (cpuHasShaExtensions()) {
+    return hashPairsArmv8;
+  }
+#endif
+  return hashPairsVector;
+}
+
+void sha256Pairs(const uint8_t* input, size_t count, uint8_t* output) {
+  static const PairKernel kernel = selectKernel();
+  kernel(input, count, output);
+}
+
+} // namespace margelo::nitro::metamask_nativeutils
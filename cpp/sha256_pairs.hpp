@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace margelo::nitro::metamask_nativeutils {
+
+/**
+ * SHA-256 of `count` independent 64-byte messages, the pair hash SSZ
+ * merkleization is made of. A 64-byte message always has the same padding
+ * block, so its message schedule is precomputed and only the first block is
+ * expanded per message. Uses the SHA extensions of x86 (SHA-NI) or ARMv8 when
+ * the CPU has them, and otherwise hashes four messages at a time with vector
+ * arithmetic.
+ * @param input `count` packed 64-byte messages
+ * @param count Number of messages
+ * @param output `count` packed 32-byte digests. May be the same buffer as
+ *   `input`, since digest i is written after message i has been read; any
+ *   other overlap is not allowed
+ */
+void sha256Pairs(const uint8_t* input, size_t count, uint8_t* output);
+
+} // namespace margelo::nitro::metamask_nativeutils
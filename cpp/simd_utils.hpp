@@ -0,0 +1,185 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+// NEON across-vector reductions (vaddv, vminv) are AArch64-only, so 32-bit
+// ARM builds use the scalar code
+#if defined(__SSE2__)
+#define NATIVEUTILS_SIMD_SSE2 1
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#define NATIVEUTILS_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace margelo::nitro::metamask_nativeutils::simd {
+
+// Small vector helpers with SSE2 (x86-64 simulators/emulators), NEON (arm64
+// devices) and scalar implementations. Everything is inline so each call site
+// compiles to a handful of instructions.
+
+#if defined(NATIVEUTILS_SIMD_NEON)
+// NEON has no movemask; AND the 0x00/0xff lanes with per-lane bit weights and
+// add across each half
+inline uint32_t movemask(uint8x16_t lanes) {
+  static const uint8_t kWeights[16] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+  uint8x16_t weighted = vandq_u8(lanes, vld1q_u8(kWeights));
+  uint32_t low = vaddv_u8(vget_low_u8(weighted));
+  uint32_t high = vaddv_u8(vget_high_u8(weighted));
+  return low | (high << 8);
+}
+#endif
+
+/**
+ * Compare 16 bytes against one value.
+ * @param group 16 bytes, any alignment
+ * @param value Byte to look for
+ * @return Bitmask with bit i set where group[i] == value
+ */
+inline uint32_t matchByte16(const uint8_t* group, uint8_t value) {
+#if defined(NATIVEUTILS_SIMD_SSE2)
+  __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+  __m128i matches = _mm_cmpeq_epi8(bytes, _mm_set1_epi8(static_cast<char>(value)));
+  return static_cast<uint32_t>(_mm_movemask_epi8(matches));
+#elif defined(NATIVEUTILS_SIMD_NEON)
+  return movemask(vceqq_u8(vld1q_u8(group), vdupq_n_u8(value)));
+#else
+  uint32_t mask = 0;
+  for (int i = 0; i < 16; i++) {
+    mask |= static_cast<uint32_t>(group[i] == value) << i;
+  }
+  return mask;
+#endif
+}
+
+/**
+ * Collect the top bit of 16 bytes.
+ * @param group 16 bytes, any alignment
+ * @return Bitmask with bit i set where group[i] >= 0x80
+ */
+inline uint32_t highBits16(const uint8_t* group) {
+#if defined(NATIVEUTILS_SIMD_SSE2)
+  return static_cast<uint32_t>(_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(group))));
+#elif defined(NATIVEUTILS_SIMD_NEON)
+  return movemask(vtstq_u8(vld1q_u8(group), vdupq_n_u8(0x80)));
+#else
+  uint32_t mask = 0;
+  for (int i = 0; i < 16; i++) {
+    mask |= static_cast<uint32_t>(group[i] >> 7) << i;
+  }
+  return mask;
+#endif
+}
+
+/**
+ * Compare two 32-byte values (hashes, topics, words).
+ * @return true if all 32 bytes are equal
+ */
+inline bool equal32(const uint8_t* a, const uint8_t* b) {
+#if defined(NATIVEUTILS_SIMD_SSE2)
+  __m128i lo = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a)),
+                              _mm_loadu_si128(reinterpret_cast<const __m128i*>(b)));
+  __m128i hi = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + 16)),
+                              _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + 16)));
+  return _mm_movemask_epi8(_mm_and_si128(lo, hi)) == 0xffff;
+#elif defined(NATIVEUTILS_SIMD_NEON)
+  uint8x16_t lo = vceqq_u8(vld1q_u8(a), vld1q_u8(b));
+  uint8x16_t hi = vceqq_u8(vld1q_u8(a + 16), vld1q_u8(b + 16));
+  return vminvq_u8(vandq_u8(lo, hi)) == 0xff;
+#else
+  return std::memcmp(a, b, 32) == 0;
+#endif
+}
+
+/**
+ * Compare two 20-byte values (addresses) with two overlapping 16-byte loads.
+ * @return true if all 20 bytes are equal
+ */
+inline bool equal20(const uint8_t* a, const uint8_t* b) {
+#if defined(NATIVEUTILS_SIMD_SSE2)
+  __m128i head = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a)),
+                                _mm_loadu_si128(reinterpret_cast<const __m128i*>(b)));
+  __m128i tail = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + 4)),
+                                _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + 4)));
+  return _mm_movemask_epi8(_mm_and_si128(head, tail)) == 0xffff;
+#elif defined(NATIVEUTILS_SIMD_NEON)
+  uint8x16_t head = vceqq_u8(vld1q_u8(a), vld1q_u8(b));
+  uint8x16_t tail = vceqq_u8(vld1q_u8(a + 4), vld1q_u8(b + 4));
+  return vminvq_u8(vandq_u8(head, tail)) == 0xff;
+#else
+  return std::memcmp(a, b, 20) == 0;
+#endif
+}
+
+/**
+ * Constant-time table lookup for secret indexes. Every entry is read and
+ * blended into an accumulator under a mask, so neither the timing nor the
+ * memory access pattern depends on `index`. The entry is held in registers
+ * while the table is scanned, hence the compile-time size.
+ * @tparam Words Words per entry; must be even
+ * @param out `Words` words; replaced by the matching entry, and left as is
+ *   if no entry matches
+ * @param table `count` entries of `Words` words each
+ * @param count Number of entries
+ * @param index Entry to select
+ */
+template <size_t Words>
+inline void selectEntry(uint64_t* out, const uint64_t* table, size_t count, uint64_t index) {
+  static_assert(Words % 2 == 0, "entries must be a whole number of 16-byte vectors");
+#if defined(NATIVEUTILS_SIMD_SSE2)
+  __m128i acc[Words / 2];
+  for (size_t w = 0; w < Words / 2; w++) {
+    acc[w] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(out) + w);
+  }
+#elif defined(NATIVEUTILS_SIMD_NEON)
+  uint64x2_t acc[Words / 2];
+  for (size_t w = 0; w < Words / 2; w++) {
+    acc[w] = vld1q_u64(out + 2 * w);
+  }
+#else
+  uint64_t acc[Words];
+  std::memcpy(acc, out, sizeof(acc));
+#endif
+  for (size_t i = 0; i < count; i++) {
+    // All ones when i == index, without a comparison the compiler could
+    // turn into a branch
+    uint64_t diff = i ^ index;
+    uint64_t mask = ((diff | (0 - diff)) >> 63) - 1;
+    const uint64_t* entry = table + i * Words;
+#if defined(NATIVEUTILS_SIMD_SSE2)
+    __m128i lanes = _mm_set1_epi64x(static_cast<long long>(mask));
+    for (size_t w = 0; w < Words / 2; w++) {
+      __m128i candidate = _mm_loadu_si128(reinterpret_cast<const __m128i*>(entry) + w);
+      acc[w] = _mm_or_si128(_mm_andnot_si128(lanes, acc[w]), _mm_and_si128(lanes, candidate));
+    }
+#elif defined(NATIVEUTILS_SIMD_NEON)
+    uint64x2_t lanes = vdupq_n_u64(mask);
+    for (size_t w = 0; w < Words / 2; w++) {
+      acc[w] = vbslq_u64(lanes, vld1q_u64(entry + 2 * w), acc[w]);
+    }
+#else
+    for (size_t w = 0; w < Words; w++) {
+      acc[w] ^= (acc[w] ^ entry[w]) & mask;
+    }
+#endif
+  }
+#if defined(NATIVEUTILS_SIMD_SSE2)
+  for (size_t w = 0; w < Words / 2; w++) {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out) + w, acc[w]);
+  }
+#elif defined(NATIVEUTILS_SIMD_NEON)
+  for (size_t w = 0; w < Words / 2; w++) {
+    vst1q_u64(out + 2 * w, acc[w]);
+  }
+#else
+  std::memcpy(out, acc, sizeof(acc));
+#endif
+}
+
+/** Index of the lowest set bit of a non-zero mask. */
+inline int lowestBit(uint32_t mask) {
+  return __builtin_ctz(mask);
+}
+
+} // namespace margelo::nitro::metamask_nativeutils::simd
@@ -0,0 +1,256 @@
+#include "solana_message.hpp"
+#include "base58.hpp"
+#include <array>
+#include <cstring>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace margelo::nitro::metamask_nativeutils {
+
+static constexpr uint8_t kLegacyVersion = 0xff;
+static constexpr uint8_t kSignerFlag = 1;
+static constexpr uint8_t kWritableFlag = 2;
+// Instructions and lookups name accounts by a u8 index
+static constexpr size_t kMaxAccounts = 256;
+
+namespace {
+
+using Key = std::array<uint8_t, 32>;
+
+// Keys are hashes or curve points, except for a few well-known program ids
+// with long zero runs; folding all four words covers both
+struct KeyHash {
+  size_t operator()(const Key& key) const noexcept {
+    uint64_t words[4];
+    std::memcpy(words, key.data(), sizeof(words));
+    return static_cast<size_t>(words[0] ^ words[1] ^ words[2] ^ words[3]);
+  }
+};
+
+struct KeyMeta {
+  Key key;
+  bool isSigner = false;
+  bool isWritable = false;
+  bool isInvoked = false;
+  bool isLoaded = false;
+  // Position in the compiled account list
+  size_t index = 0;
+};
+
+struct Instruction {
+  size_t program;
+  std::vector<size_t> accounts;
+  const uint8_t* data;
+  size_t dataSize;
+};
+
+struct Lookup {
+  const Key* table;
+  std::vector<uint8_t> writableIndexes;
+  std::vector<uint8_t> readonlyIndexes;
+};
+
+class Reader {
+public:
+  Reader(const uint8_t* data, size_t size) : data_(data), size_(size) {}
+
+  const uint8_t* take(size_t count) {
+    if (size_ - offset_ < count) {
+      throw std::runtime_error("Solana message is truncated");
+    }
+    const uint8_t* p = data_ + offset_;
+    offset_ += count;
+    return p;
+  }
+  uint8_t u8() { return *take(1); }
+  uint16_t u16() {
+    const uint8_t* p = take(2);
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+  }
+  bool done() const { return offset_ == size_; }
+
+private:
+  const uint8_t* data_;
+  size_t size_;
+  size_t offset_ = 0;
+};
+
+} // namespace
+
+static void appendCompactU16(std::vector<uint8_t>& out, size_t value) {
+  if (value > 0xffff) {
+    throw std::runtime_error("Solana message length " + std::to_string(value) + " exceeds a compact-u16");
+  }
+  while (value >= 0x80) {
+    out.push_back(static_cast<uint8_t>(value | 0x80));
+    value >>= 7;
+  }
+  out.push_back(static_cast<uint8_t>(value));
+}
+
+std::vector<uint8_t> compileSolanaMessage(const std::vector<std::string>& addresses, const uint8_t* message,
+                                          size_t size) {
+  std::vector<Key> keys(addresses.size());
+  for (size_t i = 0; i < addresses.size(); i++) {
+    const std::string& address = addresses[i];
+    if (!base58Decode(address.data(), address.size(), keys[i].data(), 32)) {
+      throw std::runtime_error("Address at index " + std::to_string(i) + " is not a 32-byte base58 key: " + address);
+    }
+  }
+
+  Reader reader(message, size);
+  auto key = [&](uint16_t index) -> const Key& {
+    if (index >= keys.size()) {
+      throw std::runtime_error("Address index " + std::to_string(index) + " is out of range");
+    }
+    return keys[index];
+  };
+
+  // Account metas in order of first use, merged by key
+  std::vector<KeyMeta> metas;
+  std::unordered_map<Key, size_t, KeyHash> metaIndex;
+  auto metaFor = [&](const Key& k) -> size_t {
+    auto [it, inserted] = metaIndex.emplace(k, metas.size());
+    if (inserted) {
+      metas.push_back(KeyMeta{k});
+    }
+    return it->second;
+  };
+
+  uint8_t version = reader.u8();
+  if (version != kLegacyVersion && version != 0) {
+    throw std::runtime_error("Unsupported Solana message version " + std::to_string(version));
+  }
+  size_t payer = metaFor(key(reader.u16()));
+  metas[payer].isSigner = true;
+  metas[payer].isWritable = true;
+  const Key& blockhash = key(reader.u16());
+
+  std::vector<Instruction> instructions(reader.u16());
+  for (Instruction& instruction : instructions) {
+    instruction.program = metaFor(key(reader.u16()));
+    metas[instruction.program].isInvoked = true;
+    instruction.accounts.resize(reader.u16());
+    for (size_t& account : instruction.accounts) {
+      account = metaFor(key(reader.u16()));
+      uint8_t flags = reader.u8();
+      metas[account].isSigner |= (flags & kSignerFlag) != 0;
+      metas[account].isWritable |= (flags & kWritableFlag) != 0;
+    }
+    instruction.dataSize = reader.u16();
+    instruction.data = reader.take(instruction.dataSize);
+  }
+
+  // Move eligible accounts into the lookups of the first table holding them:
+  // writable ones, then readonly ones, each in order of first use
+  std::vector<Lookup> lookups;
+  std::vector<size_t> loadedWritable;
+  std::vector<size_t> loadedReadonly;
+  size_t tableCount = reader.u16();
+  if (version == kLegacyVersion && tableCount > 0) {
+    throw std::runtime_error("Legacy Solana messages cannot use address lookup tables");
+  }
+  for (size_t t = 0; t < tableCount; t++) {
+    Lookup lookup;
+    lookup.table = &key(reader.u16());
+    std::unordered_map<Key, size_t, KeyHash> entries;
+    size_t entryCount = reader.u16();
+    if (entryCount > kMaxAccounts) {
+      throw std::runtime_error("Lookup table " + std::to_string(t) + " has more than 256 addresses");
+    }
+    for (size_t e = 0; e < entryCount; e++) {
+      entries.emplace(key(reader.u16()), e);
+    }
+    for (bool writable : {true, false}) {
+      for (size_t m = 0; m < metas.size(); m++) {
+        KeyMeta& meta = metas[m];
+        if (meta.isLoaded || meta.isSigner || meta.isInvoked || meta.isWritable != writable) {
+          continue;
+        }
+        auto it = entries.find(meta.key);
+        if (it == entries.end()) {
+          continue;
+        }
+        meta.isLoaded = true;
+        (writable ? lookup.writableIndexes : lookup.readonlyIndexes).push_back(static_cast<uint8_t>(it->second));
+        (writable ? loadedWritable : loadedReadonly).push_back(m);
+      }
+    }
+    if (!lookup.writableIndexes.empty() || !lookup.readonlyIndexes.empty()) {
+      lookups.push_back(std::move(lookup));
+    }
+  }
+  if (!reader.done()) {
+    throw std::runtime_error("Solana message has trailing bytes");
+  }
+
+  // Static keys by signer and writable category, then loaded keys
+  std::vector<size_t> order;
+  order.reserve(metas.size());
+  size_t header[3] = {0, 0, 0};
+  for (int category = 0; category < 4; category++) {
+    bool signer = category < 2;
+    bool writable = category % 2 == 0;
+    for (size_t m = 0; m < metas.size(); m++) {
+      const KeyMeta& meta = metas[m];
+      if (!meta.isLoaded && meta.isSigner == signer && meta.isWritable == writable) {
+        order.push_back(m);
+        header[0] += signer;
+        header[1] += signer && !writable;
+        header[2] += !signer && !writable;
+      }
+    }
+  }
+  size_t staticCount = order.size();
+  order.insert(order.end(), loadedWritable.begin(), loadedWritable.end());
+  order.insert(order.end(), loadedReadonly.begin(), loadedReadonly.end());
+  // The header counts are single bytes; only the signer count can reach 256
+  if (header[0] >= kMaxAccounts) {
+    throw std::runtime_error("Solana message has more than 255 signers");
+  }
+  if (order.size() > kMaxAccounts) {
+    throw std::runtime_error("Solana message uses " + std::to_string(order.size()) + " accounts, more than " +
+                             std::to_string(kMaxAccounts));
+  }
+  for (size_t i = 0; i < order.size(); i++) {
+    metas[order[i]].index = i;
+  }
+
+  std::vector<uint8_t> out;
+  out.reserve(size + staticCount * 32);
+  if (version == 0) {
+    out.push_back(0x80);
+  }
+  for (size_t count : header) {
+    out.push_back(static_cast<uint8_t>(count));
+  }
+  appendCompactU16(out, staticCount);
+  for (size_t i = 0; i < staticCount; i++) {
+    const Key& k = metas[order[i]].key;
+    out.insert(out.end(), k.begin(), k.end());
+  }
+  out.insert(out.end(), blockhash.begin(), blockhash.end());
+  appendCompactU16(out, instructions.size());
+  for (const Instruction& instruction : instructions) {
+    out.push_back(static_cast<uint8_t>(metas[instruction.program].index));
+    appendCompactU16(out, instruction.accounts.size());
+    for (size_t account : instruction.accounts) {
+      out.push_back(static_cast<uint8_t>(metas[account].index));
+    }
+    appendCompactU16(out, instruction.dataSize);
+    out.insert(out.end(), instruction.data, instruction.data + instruction.dataSize);
+  }
+  if (version == 0) {
+    appendCompactU16(out, lookups.size());
+    for (const Lookup& lookup : lookups) {
+      out.insert(out.end(), lookup.table->begin(), lookup.table->end());
+      appendCompactU16(out, lookup.writableIndexes.size());
+      out.insert(out.end(), lookup.writableIndexes.begin(), lookup.writableIndexes.end());
+      appendCompactU16(out, lookup.readonlyIndexes.size());
+      out.insert(out.end(), lookup.readonlyIndexes.begin(), lookup.readonlyIndexes.end());
+    }
+  }
+  return out;
+}
+
+} // namespace margelo::nitro::metamask_nativeutils
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace margelo::nitro::metamask_nativeutils {
+
+// Solana transaction message compilation. The input names every address by
+// its index in a list of base58 strings, so callers never dedupe or decode
+// keys themselves. All integers are little-endian:
+//
+//   u8  version           0xff for a legacy message, 0 for v0
+//   u16 feePayer          address index
+//   u16 recentBlockhash   address index (a blockhash is base58 like a key)
+//   u16 instructionCount
+//     u16 programId       address index
+//     u16 accountCount
+//       u16 address       address index
+//       u8  flags         bit 0: signer, bit 1: writable
+//     u16 dataLength
+//     u8  data[dataLength]
+//   u16 lookupTableCount  0 for legacy messages
+//     u16 table           address index of the lookup table account
+//     u16 addressCount
+//       u16 address       address index of each entry, in table order
+//
+// Keys are ordered as in @solana/web3.js `MessageV0.compile`: the fee payer,
+// then writable signers, readonly signers, writable and readonly
+// non-signers, each in order of first use. In v0 messages, non-signer
+// accounts that are not invoked as programs are loaded from the first table
+// that holds them instead of being listed statically.
+
+/**
+ * Compile and serialize a Solana message; the result is the exact bytes
+ * that each required signer signs with Ed25519.
+ * @param addresses Base58 addresses and blockhashes the message refers to
+ * @param message Packed message in the layout above
+ * @param size Number of message bytes
+ * @return The serialized legacy or v0 message
+ * @throws std::runtime_error if an address is not 32 bytes of base58, the
+ *   layout is truncated or has trailing bytes, an index is out of range, or
+ *   the message needs more than 256 accounts or 255 signers
+ */
+std::vector<uint8_t> compileSolanaMessage(const std::vector<std::string>& addresses, const uint8_t* message,
+                                          size_t size);
+
+} // namespace margelo::nitro::metamask_nativeutils
@@ -0,0 +1,233 @@
+#include "ssz.hpp"
+#include "parallel_for.hpp"
+#include "sha256_pairs.hpp"
+#include <array>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace margelo::nitro::metamask_nativeutils {
+
+// Pairs per parallel chunk when hashing one level of a large tree
+static constexpr size_t kLevelGrain = 1024;
+// Containers per parallel chunk
+static constexpr size_t kContainerGrain = 256;
+
+const uint8_t* sszZeroHash(size_t depth) {
+  static const auto zeroHashes = [] {
+    std::array<std::array<uint8_t, 32>, kSszMaxDepth + 1> hashes{};
+    for (size_t i = 1; i <= kSszMaxDepth; i++) {
+      uint8_t block[64];
+      std::memcpy(block, hashes[i - 1].data(), 32);
+      std::memcpy(block + 32, hashes[i - 1].data(), 32);
+      sha256Pairs(block, 1, hashes[i].data());
+    }
+    return hashes;
+  }();
+  return zeroHashes[depth].data();
+}
+
+// Levels above the chunks for `limit` chunks: ceil(log2(limit))
+static size_t treeDepth(uint64_t limit) {
+  size_t depth = 0;
+  while (depth < kSszMaxDepth && (uint64_t(1) << depth) < limit) {
+    depth++;
+  }
+  return depth;
+}
+
+// Hash one level of `count` nodes into the next, pairing an odd last node
+// with the zero hash of its depth. Returns the number of nodes written.
+static size_t hashLevel(const uint8_t* nodes, size_t count, size_t depth, uint8_t* output) {
+  size_t pairs = count / 2;
+  parallelFor(pairs, kLevelGrain, [=](size_t begin, size_t end) {
+    sha256Pairs(nodes + begin * 64, end - begin, output + begin * 32);
+  });
+  if (count % 2 != 0) {
+    uint8_t block[64];
+    std::memcpy(block, nodes + pairs * 64, 32);
+    std::memcpy(block + 32, sszZeroHash(depth), 32);
+    sha256Pairs(block, 1, output + pairs * 32);
+  }
+  return pairs + count % 2;
+}
+
+void sszMerkleize(const uint8_t* data, size_t size, uint64_t limit, uint8_t* root) {
+  size_t count = (size + 31) / 32;
+  if (count > limit) {
+    throw std::runtime_error("SSZ data has " + std::to_string(count) + " chunks, more than the limit of " +
+                             std::to_string(limit));
+  }
+  size_t depth = treeDepth(limit);
+  if (count == 0) {
+    std::memcpy(root, sszZeroHash(depth), 32);
+    return;
+  }
+
+  std::vector<uint8_t> padded;
+  if (size % 32 != 0) {
+    padded.assign(count * 32, 0);
+    std::memcpy(padded.data(), data, size);
+    data = padded.data();
+  }
+  if (depth == 0) {
+    std::memcpy(root, data, 32);
+    return;
+  }
+
+  // Levels alternate between two buffers, since a level hashed in parallel
+  // cannot overwrite the one it reads. Once a level is down to one node, the
+  // rest of the tree is zero subtrees.
+  std::vector<uint8_t> current((count + 1) / 2 * 32);
+  std::vector<uint8_t> next((count + 3) / 4 * 32);
+  count = hashLevel(data, count, 0, current.data());
+  for (size_t level = 1; level < depth; level++) {
+    count = hashLevel(current.data(), count, level, next.data());
+    current.swap(next);
+  }
+  std::memcpy(root, current.data(), 32);
+}
+
+void sszMixInLength(const uint8_t* root, uint64_t length, uint8_t* output) {
+  uint8_t block[64] = {};
+  std::memcpy(block, root, 32);
+  for (int i = 0; i < 8; i++) {
+    block[32 + i] = static_cast<uint8_t>(length >> (8 * i));
+  }
+  sha256Pairs(block, 1, output);
+}
+
+// Field types of the supported containers and how each becomes one leaf
+enum class FieldKind {
+  Bytes32, // the leaf itself
+  Bytes48, // BLSPubkey: two chunks hashed into the leaf
+  Bytes96, // BLSSignature: three chunks merkleized into the leaf
+  Uint64,  // little-endian, zero-padded
+  Boolean, // 0 or 1, zero-padded
+};
+
+struct ContainerLayout {
+  const FieldKind* fields;
+  size_t fieldCount;
+  size_t size;
+  size_t leafDepth; // leaves are the fields padded to a power of two
+};
+
+static constexpr FieldKind kValidatorFields[] = {
+    FieldKind::Bytes48, FieldKind::Bytes32, FieldKind::Uint64, FieldKind::Boolean,
+    FieldKind::Uint64,  FieldKind::Uint64,  FieldKind::Uint64, FieldKind::Uint64,
+};
+static constexpr FieldKind kDepositMessageFields[] = {FieldKind::Bytes48, FieldKind::Bytes32, FieldKind::Uint64};
+static constexpr FieldKind kDepositDataFields[] = {FieldKind::Bytes48, FieldKind::Bytes32, FieldKind::Uint64,
+                                                   FieldKind::Bytes96};
+
+static size_t fieldSize(FieldKind kind) {
+  switch (kind) {
+    case FieldKind::Bytes32: return 32;
+    case FieldKind::Bytes48: return 48;
+    case FieldKind::Bytes96: return 96;
+    case FieldKind::Uint64: return 8;
+    case FieldKind::Boolean: return 1;
+  }
+  return 0;
+}
+
+static ContainerLayout containerLayout(SszContainerType type) {
+  switch (type) {
+    case SszContainerType::Validator: return {kValidatorFields, 8, 121, 3};
+    case SszContainerType::DepositMessage: return {kDepositMessageFields, 3, 88, 2};
+    case SszContainerType::DepositData: return {kDepositDataFields, 4, 184, 2};
+  }
+  throw std::runtime_error("Unknown SSZ container type");
+}
+
+size_t sszContainerSize(SszContainerType type) {
+  return containerLayout(type).size;
+}
+
+// Roots of `count` containers: fill the leaves of every item, hashing the
+// multi-chunk fields of the whole batch together, then reduce all the item
+// trees level by level. Item trees are adjacent and equally sized, so the
+// pairs of a level never cross from one item into the next.
+static void hashContainers(const ContainerLayout& layout, const uint8_t* items, size_t count, size_t firstIndex,
+                           uint8_t* roots) {
+  size_t leafCount = size_t(1) << layout.leafDepth;
+  std::vector<uint8_t> leaves(count * leafCount * 32, 0);
+  std::vector<uint8_t> scratch;
+
+  size_t offset = 0;
+  for (size_t f = 0; f < layout.fieldCount; f++) {
+    FieldKind kind = layout.fields[f];
+    size_t size = fieldSize(kind);
+    auto leaf = [&](size_t item) { return leaves.data() + (item * leafCount + f) * 32; };
+    auto field = [&](size_t item) { return items + item * layout.size + offset; };
+
+    switch (kind) {
+      case FieldKind::Bytes32:
+      case FieldKind::Uint64:
+        for (size_t i = 0; i < count; i++) {
+          std::memcpy(leaf(i), field(i), size);
+        }
+        break;
+      case FieldKind::Boolean:
+        for (size_t i = 0; i < count; i++) {
+          if (*field(i) > 1) {
+            throw std::runtime_error("Invalid boolean in SSZ container at index " + std::to_string(firstIndex + i));
+          }
+          *leaf(i) = *field(i);
+        }
+        break;
+      case FieldKind::Bytes48:
+        scratch.assign(count * 64, 0);
+        for (size_t i = 0; i < count; i++) {
+          std::memcpy(scratch.data() + i * 64, field(i), 48);
+        }
+        sha256Pairs(scratch.data(), count, scratch.data());
+        for (size_t i = 0; i < count; i++) {
+          std::memcpy(leaf(i), scratch.data() + i * 32, 32);
+        }
+        break;
+      case FieldKind::Bytes96:
+        // Chunks c0, c1, c2 and a zero chunk: hash (c0, c1) and (c2, 0), then the pair
+        scratch.assign(count * 128, 0);
+        for (size_t i = 0; i < count; i++) {
+          std::memcpy(scratch.data() + i * 128, field(i), 96);
+        }
+        sha256Pairs(scratch.data(), count * 2, scratch.data());
+        sha256Pairs(scratch.data(), count, scratch.data());
+        for (size_t i = 0; i < count; i++) {
+          std::memcpy(leaf(i), scratch.data() + i * 32, 32);
+        }
+        break;
+    }
+    offset += size;
+  }
+
+  size_t nodes = count * leafCount;
+  for (size_t level = 0; level < layout.leafDepth; level++) {
+    nodes /= 2;
+    sha256Pairs(leaves.data(), nodes, leaves.data());
+  }
+  std::memcpy(roots, leaves.data(), count * 32);
+}
+
+void sszContainerRoots(SszContainerType type, const uint8_t* items, size_t count, uint8_t* roots) {
+  ContainerLayout layout = containerLayout(type);
+  parallelFor(count, kContainerGrain, [&](size_t begin, size_t end) {
+    hashContainers(layout, items + begin * layout.size, end - begin, begin, roots + begin * 32);
+  });
+}
+
+void sszContainerListRoot(SszContainerType type, const uint8_t* items, size_t count, uint64_t limit, uint8_t* root) {
+  if (count > limit) {
+    throw std::runtime_error("SSZ list has " + std::to_string(count) + " items, more than the limit of " +
+                             std::to_string(limit));
+  }
+  std::vector<uint8_t> roots(count * 32);
+  sszContainerRoots(type, items, count, roots.data());
+  sszMerkleize(roots.data(), roots.size(), limit, root);
+  sszMixInLength(root, count, root);
+}
+
+} // namespace margelo::nitro::metamask_nativeutils
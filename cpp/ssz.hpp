@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace margelo::nitro::metamask_nativeutils {
+
+// SSZ hash_tree_root as defined by the consensus specs: values are split
+// into 32-byte chunks, padded with zero chunks up to a power of two and
+// hashed in pairs with SHA-256 down to one root. Lists mix their length into
+// the root of their chunks.
+
+/** Deepest tree sszMerkleize supports, for a limit of up to 2^64 chunks. */
+static constexpr size_t kSszMaxDepth = 64;
+
+/**
+ * Root of a tree of zero chunks, computed once for every depth.
+ * @param depth Levels above the chunks, at most kSszMaxDepth
+ * @return 32-byte root; depth 0 is the zero chunk itself
+ */
+const uint8_t* sszZeroHash(size_t depth);
+
+/**
+ * `merkleize(pack(data), limit)`: hash packed chunks into the root of a tree
+ * with room for `limit` chunks. Missing chunks are zero, and whole subtrees
+ * of them are taken from the zero hash cache rather than hashed. Levels with
+ * many nodes are hashed in parallel.
+ * @param data Packed chunk data; a partial last chunk is padded with zeros,
+ *   as when packing basic values
+ * @param size Bytes of data
+ * @param limit Maximum number of chunks, which sets the depth of the tree
+ * @param root Output buffer for the 32-byte root
+ * @throws std::runtime_error if the data has more than `limit` chunks
+ */
+void sszMerkleize(const uint8_t* data, size_t size, uint64_t limit, uint8_t* root);
+
+/**
+ * `mix_in_length(root, length)`, the last step of hashing a list.
+ * @param root 32-byte root of the list's chunks
+ * @param length Number of elements in the list
+ * @param output Output buffer for the 32-byte root; may alias `root`
+ */
+void sszMixInLength(const uint8_t* root, uint64_t length, uint8_t* output);
+
+/** Fixed-size beacon chain containers with a batched hash_tree_root. */
+enum class SszContainerType {
+  Validator,      // 121 bytes: pubkey, withdrawal credentials, balance, slashed, 4 epochs
+  DepositMessage, // 88 bytes: pubkey, withdrawal credentials, amount
+  DepositData,    // 184 bytes: DepositMessage fields and signature
+};
+
+/** Serialized size of a container. */
+size_t sszContainerSize(SszContainerType type);
+
+/**
+ * hash_tree_root of many serialized containers of one type. The fields of
+ * every item are laid out as leaves side by side, so each tree level of the
+ * whole batch is one sha256Pairs call; large batches are split across threads.
+ * @param type Container type
+ * @param items `count` packed serialized containers
+ * @param count Number of containers
+ * @param roots Output buffer for `count` packed 32-byte roots
+ * @throws std::runtime_error if a boolean field is neither 0 nor 1
+ */
+void sszContainerRoots(SszContainerType type, const uint8_t* items, size_t count, uint8_t* roots);
+
+/**
+ * hash_tree_root of a `List[type, limit]`, such as the validator registry
+ * (`List[Validator, 2**40]`).
+ * @param type Container type
+ * @param items `count` packed serialized containers
+ * @param count Number of containers
+ * @param limit List limit
+ * @param root Output buffer for the 32-byte root
+ * @throws std::runtime_error if there are more than `limit` items or a
+ *   boolean field is neither 0 nor 1
+ */
+void sszContainerListRoot(SszContainerType type, const uint8_t* items, size_t count, uint64_t limit, uint8_t* root);
+
+} // namespace margelo::nitro::metamask_nativeutils
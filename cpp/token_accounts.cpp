@@ -0,0 +1,22 @@
+#include "token_accounts.hpp"
+#include <cstring>
+
+namespace margelo::nitro::metamask_nativeutils {
+
+bool decodeTokenAccount(const AccountLayout& layout, const uint8_t* data, size_t size, uint8_t* mint, uint8_t* owner,
+                        uint8_t* amount) {
+  if (size < layout.minSize) {
+    return false;
+  }
+  if (!layout.discriminator.empty() &&
+      std::memcmp(data, layout.discriminator.data(), layout.discriminator.size()) != 0) {
+    return false;
+  }
+  std::memcpy(mint, data + layout.mintOffset, 32);
+  std::memcpy(owner, data + layout.ownerOffset, 32);
+  std::memcpy(amount, data + layout.amountOffset, layout.amountSize);
+  std::memset(amount + layout.amountSize, 0, 16 - layout.amountSize);
+  return true;
+}
+
+} // namespace margelo::nitro::metamask_nativeutils
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace margelo::nitro::metamask_nativeutils {
+
+/**
+ * Where the fields of a token account sit in its data. SPL Token and
+ * Token-2022 accounts hold the mint at 0, the owner at 32 and a u64 amount
+ * at 64 in at least 165 bytes; Borsh-encoded program accounts with a fixed
+ * prefix are described the same way, usually behind an 8-byte Anchor
+ * discriminator.
+ */
+struct AccountLayout {
+  size_t mintOffset;
+  size_t ownerOffset;
+  size_t amountOffset;
+  // 8 for a u64 amount, 16 for a u128
+  size_t amountSize;
+  // At least the end of every field and of the discriminator
+  size_t minSize;
+  std::vector<uint8_t> discriminator;
+};
+
+/**
+ * Extract the mint, owner and amount of one account.
+ * @param layout Field positions
+ * @param data Account data
+ * @param size Number of data bytes
+ * @param mint Output buffer for the 32-byte mint
+ * @param owner Output buffer for the 32-byte owner
+ * @param amount Output buffer for the amount as 16 little-endian bytes
+ * @return false, leaving the outputs untouched, if the data is shorter than
+ *   `layout.minSize` or does not start with the discriminator
+ */
+bool decodeTokenAccount(const AccountLayout& layout, const uint8_t* data, size_t size, uint8_t* mint, uint8_t* owner,
+                        uint8_t* amount);
+
+} // namespace margelo::nitro::metamask_nativeutils
@@ -39,6 +39,28 @@ import {
 } from './benchmarks/hmacSha512Benchmark';
 import { runAllPubToAddressTests } from './tests/pubToAddressTests';
 import { runAllKeccak256Tests } from './tests/keccak256Tests';
+import { runAllDispatchTests } from './tests/dispatchTests';
+import { runAllStreamingTests } from './tests/streamingTests';
+import { runAllPipelineTests } from './tests/pipelineTests';
+import { runAllMemoryTrimTests } from './tests/memoryTrimTests';
+import { runAllAddressSetTests } from './tests/addressSetTests';
+import { runAllBloomTests } from './tests/bloomTests';
+import { runAllLogFilterTests } from './tests/logFilterTests';
+import { runAllSelectorIndexTests } from './tests/selectorIndexTests';
+import { runAllEnsTests } from './tests/ensTests';
+import { runAllMerkleTests } from './tests/merkleTests';
+import { runAllMptProofTests } from './tests/mptProofTests';
+import { runAllTrieRootTests } from './tests/trieRootTests';
+import { runAllSszTests } from './tests/sszTests';
+import { runAllDomainIndexTests } from './tests/domainIndexTests';
+import { runAllHashTests } from './tests/hashTests';
+import { runAllEd25519KeyHandleTests } from './tests/ed25519KeyHandleTests';
+import { runAllEd25519PointTests } from './tests/ed25519PointTests';
+import { runAllKeyringTests } from './tests/keyringTests';
+import { runAllExtendedKeyTests } from './tests/extendedKeyTests';
+import { runAllBip322Tests } from './tests/bip322Tests';
+import { runAllSolanaMessageTests } from './tests/solanaMessageTests';
+import { runAllTokenAccountTests } from './tests/tokenAccountTests';
 import type { TestResult } from './testUtils';
 import {
   runAllPubToAddressBenchmarks,
@@ -52,6 +74,18 @@ import {
   runAllEd25519Benchmarks,
   type BenchmarkResult as Ed25519BenchmarkResult,
 } from './benchmarks/ed25519Benchmark';
+import {
+  runAllSubmissionRingBenchmarks,
+  type ThroughputResult,
+} from './benchmarks/submissionRingBenchmark';
+import {
+  runAllBloomBenchmarks,
+  type BloomBenchmarkResult,
+} from './benchmarks/bloomBenchmark';
+import {
+  runAllSszBenchmarks,
+  type SszBenchmarkResult,
+} from './benchmarks/sszBenchmark';
 import {
   testEd25519BasicFunctionality,
   testEd25519PublicKeyFormat,
@@ -72,6 +106,7 @@ interface TestSuite {
   name: string;
   runner: () =>
     | TestResult[]
+    | Promise<TestResult[]>
     | ValidationResult[]
     | VerificationResult[]
     | Ed25519VerificationResult[];
@@ -88,6 +123,28 @@ export default function App() {
     verification: VerificationResult[];
     pubToAddress: TestResult[];
     keccak256: TestResult[];
+    dispatch: TestResult[];
+    streaming: TestResult[];
+    pipeline: TestResult[];
+    memoryTrim: TestResult[];
+    addressSet: TestResult[];
+    bloom: TestResult[];
+    logFilter: TestResult[];
+    selectorIndex: TestResult[];
+    ens: TestResult[];
+    merkle: TestResult[];
+    mptProof: TestResult[];
+    trieRoot: TestResult[];
+    ssz: TestResult[];
+    domainIndex: TestResult[];
+    hash: TestResult[];
+    ed25519KeyHandle: TestResult[];
+    ed25519Point: TestResult[];
+    keyring: TestResult[];
+    extendedKey: TestResult[];
+    bip322: TestResult[];
+    solanaMessage: TestResult[];
+    tokenAccount: TestResult[];
     ed25519: TestResult[];
     ed25519Noble: TestResult[];
     ed25519Verification: Ed25519VerificationResult[];
@@ -100,6 +157,28 @@ export default function App() {
     verification: [],
     pubToAddress: [],
     keccak256: [],
+    dispatch: [],
+    streaming: [],
+    pipeline: [],
+    memoryTrim: [],
+    addressSet: [],
+    bloom: [],
+    logFilter: [],
+    selectorIndex: [],
+    ens: [],
+    merkle: [],
+    mptProof: [],
+    trieRoot: [],
+    ssz: [],
+    domainIndex: [],
+    hash: [],
+    ed25519KeyHandle: [],
+    ed25519Point: [],
+    keyring: [],
+    extendedKey: [],
+    bip322: [],
+    solanaMessage: [],
+    tokenAccount: [],
     ed25519: [],
     ed25519Noble: [],
     ed25519Verification: [],
@@ -111,12 +190,18 @@ export default function App() {
     pubToAddressSuite: PubToAddressBenchmarkResult[] | null;
     keccak256Suite: Keccak256BenchmarkResult[] | null;
     ed25519Suite: Ed25519BenchmarkResult[] | null;
+    ringSuite: ThroughputResult[] | null;
+    bloomSuite: BloomBenchmarkResult[] | null;
+    sszSuite: SszBenchmarkResult[] | null;
   }>({
     suite: null,
     hmacSuite: null,
     pubToAddressSuite: null,
     keccak256Suite: null,
     ed25519Suite: null,
+    ringSuite: null,
+    bloomSuite: null,
+    sszSuite: null,
   });
 
   const [isRunning, setIsRunning] = useState(false);
@@ -178,6 +263,116 @@ export default function App() {
       key: 'keccak256',
       runner: () => runAllKeccak256Tests(),
     },
+    {
+      name: 'Adaptive Dispatch',
+      key: 'dispatch',
+      runner: () => runAllDispatchTests(),
+    },
+    {
+      name: 'Streaming Derivation',
+      key: 'streaming',
+      runner: () => runAllStreamingTests(),
+    },
+    {
+      name: 'Native Pipelines',
+      key: 'pipeline',
+      runner: () => runAllPipelineTests(),
+    },
+    {
+      name: 'Memory Trimming',
+      key: 'memoryTrim',
+      runner: () => runAllMemoryTrimTests(),
+    },
+    {
+      name: 'Address Sets',
+      key: 'addressSet',
+      runner: () => runAllAddressSetTests(),
+    },
+    {
+      name: 'logsBloom Filters',
+      key: 'bloom',
+      runner: () => runAllBloomTests(),
+    },
+    {
+      name: 'Event Log Filters',
+      key: 'logFilter',
+      runner: () => runAllLogFilterTests(),
+    },
+    {
+      name: 'Selector Index',
+      key: 'selectorIndex',
+      runner: () => runAllSelectorIndexTests(),
+    },
+    {
+      name: 'ENS Namehash',
+      key: 'ens',
+      runner: () => runAllEnsTests(),
+    },
+    {
+      name: 'Merkle Trees',
+      key: 'merkle',
+      runner: () => runAllMerkleTests(),
+    },
+    {
+      name: 'Merkle-Patricia Proofs',
+      key: 'mptProof',
+      runner: () => runAllMptProofTests(),
+    },
+    {
+      name: 'Trie Roots',
+      key: 'trieRoot',
+      runner: () => runAllTrieRootTests(),
+    },
+    {
+      name: 'SSZ hash_tree_root',
+      key: 'ssz',
+      runner: () => runAllSszTests(),
+    },
+    {
+      name: 'Domain Index',
+      key: 'domainIndex',
+      runner: () => runAllDomainIndexTests(),
+    },
+    {
+      name: 'Hash Registry',
+      key: 'hash',
+      runner: () => runAllHashTests(),
+    },
+    {
+      name: 'Ed25519 Key Handle',
+      key: 'ed25519KeyHandle',
+      runner: () => runAllEd25519KeyHandleTests(),
+    },
+    {
+      name: 'Ed25519 Points',
+      key: 'ed25519Point',
+      runner: () => runAllEd25519PointTests(),
+    },
+    {
+      name: 'Keyring',
+      key: 'keyring',
+      runner: () => runAllKeyringTests(),
+    },
+    {
+      name: 'Extended Keys',
+      key: 'extendedKey',
+      runner: () => runAllExtendedKeyTests(),
+    },
+    {
+      name: 'BIP322',
+      key: 'bip322',
+      runner: () => runAllBip322Tests(),
+    },
+    {
+      name: 'Solana Messages',
+      key: 'solanaMessage',
+      runner: () => runAllSolanaMessageTests(),
+    },
+    {
+      name: 'Token Accounts',
+      key: 'tokenAccount',
+      runner: () => runAllTokenAccountTests(),
+    },
     {
       name: 'getPublicKeyEd25519',
       key: 'ed25519',
@@ -214,6 +409,28 @@ export default function App() {
       verification: [],
       pubToAddress: [],
       keccak256: [],
+      dispatch: [],
+      streaming: [],
+      pipeline: [],
+      memoryTrim: [],
+      addressSet: [],
+      bloom: [],
+      logFilter: [],
+      selectorIndex: [],
+      ens: [],
+      merkle: [],
+      mptProof: [],
+      trieRoot: [],
+      ssz: [],
+      domainIndex: [],
+      hash: [],
+      ed25519KeyHandle: [],
+      ed25519Point: [],
+      keyring: [],
+      extendedKey: [],
+      bip322: [],
+      solanaMessage: [],
+      tokenAccount: [],
       ed25519: [],
       ed25519Noble: [],
       ed25519Verification: [],
@@ -224,6 +441,9 @@ export default function App() {
       pubToAddressSuite: null,
       keccak256Suite: null,
       ed25519Suite: null,
+      ringSuite: null,
+      bloomSuite: null,
+      sszSuite: null,
     });
   };
 
@@ -242,7 +462,7 @@ export default function App() {
       // Run all test suites with small delays between them
       for (const suite of testSuites) {
         try {
-          const results = suite.runner();
+          const results = await suite.runner();
           (newResults as any)[suite.key] = results;
         } catch (error) {
           // If a test suite throws an error, create a single failed test result
@@ -337,6 +557,28 @@ export default function App() {
       ...testResults.verification.map((r) => ({ success: r.matches })),
       ...testResults.pubToAddress.map((r) => ({ success: r.success })),
       ...testResults.keccak256.map((r) => ({ success: r.success })),
+      ...testResults.dispatch.map((r) => ({ success: r.success })),
+      ...testResults.streaming.map((r) => ({ success: r.success })),
+      ...testResults.pipeline.map((r) => ({ success: r.success })),
+      ...testResults.memoryTrim.map((r) => ({ success: r.success })),
+      ...testResults.addressSet.map((r) => ({ success: r.success })),
+      ...testResults.bloom.map((r) => ({ success: r.success })),
+      ...testResults.logFilter.map((r) => ({ success: r.success })),
+      ...testResults.selectorIndex.map((r) => ({ success: r.success })),
+      ...testResults.ens.map((r) => ({ success: r.success })),
+      ...testResults.merkle.map((r) => ({ success: r.success })),
+      ...testResults.mptProof.map((r) => ({ success: r.success })),
+      ...testResults.trieRoot.map((r) => ({ success: r.success })),
+      ...testResults.ssz.map((r) => ({ success: r.success })),
+      ...testResults.domainIndex.map((r) => ({ success: r.success })),
+      ...testResults.hash.map((r) => ({ success: r.success })),
+      ...testResults.ed25519KeyHandle.map((r) => ({ success: r.success })),
+      ...testResults.ed25519Point.map((r) => ({ success: r.success })),
+      ...testResults.keyring.map((r) => ({ success: r.success })),
+      ...testResults.extendedKey.map((r) => ({ success: r.success })),
+      ...testResults.bip322.map((r) => ({ success: r.success })),
+      ...testResults.solanaMessage.map((r) => ({ success: r.success })),
+      ...testResults.tokenAccount.map((r) => ({ success: r.success })),
       ...testResults.ed25519.map((r) => ({ success: r.success })),
       ...testResults.ed25519Noble.map((r) => ({ success: r.success })),
       ...testResults.ed25519Verification.map((r) => ({ success: r.matches })),
@@ -466,6 +708,41 @@ export default function App() {
               />
             </View>
           </View>
+          <View style={styles.buttonRow}>
+            <View style={styles.buttonContainer}>
+              <Button
+                title={
+                  isRunning ? '⏳ Running...' : '🔁 Submission Ring Throughput'
+                }
+                onPress={() =>
+                  runBenchmark('ringSuite', runAllSubmissionRingBenchmarks)
+                }
+                disabled={isRunning}
+              />
+            </View>
+          </View>
+          <View style={styles.buttonRow}>
+            <View style={styles.buttonContainer}>
+              <Button
+                title={isRunning ? '⏳ Running...' : '🌸 logsBloom Scanning'}
+                onPress={() =>
+                  runBenchmark('bloomSuite', runAllBloomBenchmarks)
+                }
+                disabled={isRunning}
+              />
+            </View>
+          </View>
+          <View style={styles.buttonRow}>
+            <View style={styles.buttonContainer}>
+              <Button
+                title={isRunning ? '⏳ Running...' : '🧱 SSZ hash_tree_root'}
+                onPress={() =>
+                  runBenchmark('sszSuite', runAllSszBenchmarks)
+                }
+                disabled={isRunning}
+              />
+            </View>
+          </View>
           {benchmarkProgress && (
             <Text style={styles.progressText}>
               🔄 Running: {benchmarkProgress.testName} (
@@ -1053,6 +1330,104 @@ export default function App() {
             })}
           </View>
         )}
+
+        {benchmarkResults.ringSuite && (
+          <View style={styles.section}>
+            <Text style={styles.sectionTitle}>
+              🔁 Submission Ring vs Batch Calls
+            </Text>
+            {benchmarkResults.ringSuite.map((result, index) => (
+              <View key={index} style={styles.benchmarkResult}>
+                <Text style={styles.benchmarkTitle}>{result.testName}</Text>
+                <View style={styles.benchmarkMetrics}>
+                  <Text style={styles.benchmarkDetails}>
+                    🔁 Ring: {result.ring.averageTime.toFixed(1)}ms •{' '}
+                    {result.ring.requestsPerSecond.toFixed(0)} req/sec
+                  </Text>
+                  <Text style={styles.benchmarkDetails}>
+                    📦 Batch calls: {result.batch.averageTime.toFixed(1)}ms •{' '}
+                    {result.batch.requestsPerSecond.toFixed(0)} req/sec
+                  </Text>
+                  <Text
+                    style={[
+                      styles.benchmarkComparison,
+                      result.speedupFactor >= 1
+                        ? styles.success
+                        : styles.failure,
+                    ]}
+                  >
+                    ⚡ {result.speedupFactor.toFixed(2)}x{' '}
+                    {result.speedupFactor >= 1 ? 'faster' : 'slower'}
+                  </Text>
+                </View>
+              </View>
+            ))}
+          </View>
+        )}
+
+        {benchmarkResults.bloomSuite && (
+          <View style={styles.section}>
+            <Text style={styles.sectionTitle}>🌸 logsBloom Scanning</Text>
+            {benchmarkResults.bloomSuite.map((result, index) => (
+              <View key={index} style={styles.benchmarkResult}>
+                <Text style={styles.benchmarkTitle}>{result.testName}</Text>
+                <View style={styles.benchmarkMetrics}>
+                  <Text style={styles.benchmarkDetails}>
+                    🚀 Native: {result.native.averageTime.toFixed(1)}ms •{' '}
+                    {result.native.itemsPerSecond.toFixed(0)} /sec
+                  </Text>
+                  <Text style={styles.benchmarkDetails}>
+                    📜 JS: {result.javascript.averageTime.toFixed(1)}ms •{' '}
+                    {result.javascript.itemsPerSecond.toFixed(0)} /sec
+                  </Text>
+                  <Text
+                    style={[
+                      styles.benchmarkComparison,
+                      result.speedupFactor >= 1
+                        ? styles.success
+                        : styles.failure,
+                    ]}
+                  >
+                    ⚡ {result.speedupFactor.toFixed(2)}x{' '}
+                    {result.speedupFactor >= 1 ? 'faster' : 'slower'}
+                  </Text>
+                </View>
+              </View>
+            ))}
+          </View>
+        )}
+
+        {benchmarkResults.sszSuite && (
+          <View style={styles.section}>
+            <Text style={styles.sectionTitle}>🧱 SSZ hash_tree_root</Text>
+            {benchmarkResults.sszSuite.map((result, index) => (
+              <View key={index} style={styles.benchmarkResult}>
+                <Text style={styles.benchmarkTitle}>{result.testName}</Text>
+                <View style={styles.benchmarkMetrics}>
+                  <Text style={styles.benchmarkDetails}>
+                    🚀 Native: {result.native.averageTime.toFixed(1)}ms •{' '}
+                    {result.native.itemsPerSecond.toFixed(0)} /sec
+                  </Text>
+                  <Text style={styles.benchmarkDetails}>
+                    📜 JS: {result.javascript.averageTime.toFixed(1)}ms •{' '}
+                    {result.javascript.itemsPerSecond.toFixed(0)} /sec
+                  </Text>
+                  <Text
+                    style={[
+                      styles.benchmarkComparison,
+                      result.speedupFactor >= 1
+                        ? styles.success
+                        : styles.failure,
+                    ]}
+                  >
+                    ⚡ {result.speedupFactor.toFixed(2)}x{' '}
+                    {result.speedupFactor >= 1 ? 'faster' : 'slower'}
+                  </Text>
+                </View>
+              </View>
+            ))}
+          </View>
+        )}
       </View>
     </ScrollView>
   );
@@ -0,0 +1,182 @@
+import { bloomBuild, bloomMatches } from '@metamask/native-utils';
+import { keccak_256 } from '@noble/hashes/sha3';
+import { calculateStats } from '../testUtils';
+
+export type BloomBenchmarkResult = {
+  testName: string;
+  items: number;
+  native: { averageTime: number; itemsPerSecond: number };
+  javascript: { averageTime: number; itemsPerSecond: number };
+  speedupFactor: number;
+};
+
+const BLOOM_COUNT = 100_000;
+const ROUNDS = 5;
+
+function makeItems(count: number, size: number, seed: number): Uint8Array[] {
+  let state = seed;
+  return Array.from({ length: count }, () => {
+    const item = new Uint8Array(size);
+    for (let j = 0; j < size; j++) {
+      state = (state * 1103515245 + 12345) >>> 0;
+      item[j] = state >>> 24;
+    }
+    return item;
+  });
+}
+
+// Packed blooms with roughly a quarter of the bits set, like busy blocks
+function makeBlooms(count: number): Uint8Array {
+  const blooms = new Uint8Array(count * 256);
+  let state = 42;
+  for (let i = 0; i < blooms.length; i++) {
+    state = (state * 1103515245 + 12345) >>> 0;
+    blooms[i] = (state >>> 24) & (state >>> 16);
+  }
+  return blooms;
+}
+
+// The approach JS code takes today: bit positions computed once per query
+// with noble, then every bloom checked in a JS loop
+function jsBloomBits(item: Uint8Array): number[] {
+  const hash = keccak_256(item);
+  const bits: number[] = [];
+  for (let i = 0; i < 6; i += 2) {
+    const bit = ((hash[i]! << 8) | hash[i + 1]!) & 2047;
+    bits.push(255 - (bit >> 3), 1 << (bit & 7));
+  }
+  return bits;
+}
+
+function jsBloomMatches(
+  blooms: Uint8Array,
+  queries: Uint8Array[],
+): Uint8Array {
+  const queryBits = queries.map(jsBloomBits);
+  const count = blooms.length / 256;
+  const bitmap = new Uint8Array(Math.ceil(count / 8));
+  for (let i = 0; i < count; i++) {
+    const base = i * 256;
+    for (const bits of queryBits) {
+      if (
+        (blooms[base + bits[0]!]! & bits[1]!) !== 0 &&
+        (blooms[base + bits[2]!]! & bits[3]!) !== 0 &&
+        (blooms[base + bits[4]!]! & bits[5]!) !== 0
+      ) {
+        bitmap[i >> 3] = bitmap[i >> 3]! | (1 << (i & 7));
+        break;
+      }
+    }
+  }
+  return bitmap;
+}
+
+function jsBloomBuild(items: Uint8Array[]): Uint8Array {
+  const bloom = new Uint8Array(256);
+  for (const item of items) {
+    const bits = jsBloomBits(item);
+    for (let k = 0; k < 6; k += 2) {
+      bloom[bits[k]!] = bloom[bits[k]!]! | bits[k + 1]!;
+    }
+  }
+  return bloom;
+}
+
+async function measure(
+  testName: string,
+  items: number,
+  nativeImpl: () => unknown,
+  jsImpl: () => unknown,
+): Promise<BloomBenchmarkResult> {
+  nativeImpl();
+  jsImpl();
+
+  const nativeTimes: number[] = [];
+  const jsTimes: number[] = [];
+  for (let round = 0; round < ROUNDS; round++) {
+    let start = performance.now();
+    nativeImpl();
+    nativeTimes.push(performance.now() - start);
+
+    start = performance.now();
+    jsImpl();
+    jsTimes.push(performance.now() - start);
+
+    // Yield so the UI stays responsive between rounds
+    await new Promise((resolve) => setTimeout(resolve, 0));
+  }
+
+  const nativeStats = calculateStats(nativeTimes);
+  const jsStats = calculateStats(jsTimes);
+
+  return {
+    testName,
+    items,
+    native: {
+      averageTime: nativeStats.averageTime,
+      itemsPerSecond: (items * 1000) / nativeStats.averageTime,
+    },
+    javascript: {
+      averageTime: jsStats.averageTime,
+      itemsPerSecond: (items * 1000) / jsStats.averageTime,
+    },
+    speedupFactor: jsStats.averageTime / nativeStats.averageTime,
+  };
+}
+
+// History sync for a single account
+export async function benchmarkScanSingleAddress(
+  blooms: Uint8Array,
+): Promise<BloomBenchmarkResult> {
+  const queries = makeItems(1, 20, 1);
+  return measure(
+    `Scan ${BLOOM_COUNT / 1000}k blooms, 1 address`,
+    BLOOM_COUNT,
+    () => bloomMatches(blooms, queries),
+    () => jsBloomMatches(blooms, queries),
+  );
+}
+
+// History sync for a wallet with several accounts and watched event topics
+export async function benchmarkScanWallet(
+  blooms: Uint8Array,
+): Promise<BloomBenchmarkResult> {
+  const queries = [...makeItems(20, 20, 2), ...makeItems(5, 32, 3)];
+  return measure(
+    `Scan ${BLOOM_COUNT / 1000}k blooms, 20 addresses + 5 topics`,
+    BLOOM_COUNT,
+    () => bloomMatches(blooms, queries),
+    () => jsBloomMatches(blooms, queries),
+  );
+}
+
+// Receipt blooms for 10k logs of one address and three topics each
+export async function benchmarkBuildLogBlooms(): Promise<BloomBenchmarkResult> {
+  const logs = Array.from({ length: 10_000 }, (_, i) => [
+    ...makeItems(1, 20, i * 2 + 1),
+    ...makeItems(3, 32, i * 2 + 2),
+  ]);
+  return measure(
+    'Build 10k log blooms',
+    logs.length,
+    () => logs.forEach((log) => bloomBuild(log)),
+    () => logs.forEach((log) => jsBloomBuild(log)),
+  );
+}
+
+// Run all bloom benchmarks
+export async function runAllBloomBenchmarks(): Promise<
+  BloomBenchmarkResult[]
+> {
+  console.log('🚀 Starting bloom filter benchmarks...');
+
+  const blooms = makeBlooms(BLOOM_COUNT);
+  const results = [
+    await benchmarkScanSingleAddress(blooms),
+    await benchmarkScanWallet(blooms),
+    await benchmarkBuildLogBlooms(),
+  ];
+
+  console.log('✅ All bloom filter benchmarks completed!');
+  return results;
+}
@@ -0,0 +1,187 @@
+import {
+  sszContainerListRoot,
+  sszContainerRoots,
+} from '@metamask/native-utils';
+import { sha256 } from '@noble/hashes/sha2';
+import { calculateStats } from '../testUtils';
+
+export type SszBenchmarkResult = {
+  testName: string;
+  items: number;
+  native: { averageTime: number; itemsPerSecond: number };
+  javascript: { averageTime: number; itemsPerSecond: number };
+  speedupFactor: number;
+};
+
+// A validator registry of this size takes a few seconds per round in JS
+const VALIDATOR_COUNT = 100_000;
+const VALIDATOR_REGISTRY_LIMIT = 2 ** 40;
+const ROUNDS = 3;
+
+// Serialized validators with random keys and credentials and realistic
+// balances and epochs
+function makeValidators(count: number): Uint8Array[] {
+  let state = 7;
+  return Array.from({ length: count }, (_, i) => {
+    const validator = new Uint8Array(121);
+    for (let j = 0; j < 80; j++) {
+      state = (state * 1103515245 + 12345) >>> 0;
+      validator[j] = state >>> 24;
+    }
+    const view = new DataView(validator.buffer);
+    view.setBigUint64(80, 32_000_000_000n, true);
+    view.setBigUint64(89, BigInt(i >> 4), true);
+    view.setBigUint64(97, BigInt((i >> 4) + 5), true);
+    view.setBigUint64(105, 0xffffffffffffffffn, true);
+    view.setBigUint64(113, 0xffffffffffffffffn, true);
+    return validator;
+  });
+}
+
+// The approach JS code takes today: a straightforward merkleization with
+// noble's SHA-256, zero hashes cached
+const ZERO_HASHES: Uint8Array[] = [new Uint8Array(32)];
+for (let depth = 1; depth <= 64; depth++) {
+  const below = ZERO_HASHES[depth - 1]!;
+  ZERO_HASHES.push(jsHashPair(below, below));
+}
+
+function jsHashPair(a: Uint8Array, b: Uint8Array): Uint8Array {
+  const block = new Uint8Array(64);
+  block.set(a);
+  block.set(b, 32);
+  return sha256(block);
+}
+
+function jsMerkleize(chunks: Uint8Array[], limit: number): Uint8Array {
+  let depth = 0;
+  while (2 ** depth < limit) {
+    depth++;
+  }
+  if (chunks.length === 0) {
+    return ZERO_HASHES[depth]!;
+  }
+  let level = chunks;
+  for (let d = 0; d < depth; d++) {
+    const next: Uint8Array[] = [];
+    for (let i = 0; i < level.length; i += 2) {
+      next.push(jsHashPair(level[i]!, level[i + 1] ?? ZERO_HASHES[d]!));
+    }
+    level = next;
+  }
+  return level[0]!;
+}
+
+function jsChunk(bytes: Uint8Array): Uint8Array {
+  const chunk = new Uint8Array(32);
+  chunk.set(bytes);
+  return chunk;
+}
+
+function jsValidatorRoot(validator: Uint8Array): Uint8Array {
+  const leaves = [
+    jsHashPair(
+      validator.subarray(0, 32),
+      jsChunk(validator.subarray(32, 48)),
+    ),
+    validator.subarray(48, 80),
+    jsChunk(validator.subarray(80, 88)),
+    jsChunk(validator.subarray(88, 89)),
+    jsChunk(validator.subarray(89, 97)),
+    jsChunk(validator.subarray(97, 105)),
+    jsChunk(validator.subarray(105, 113)),
+    jsChunk(validator.subarray(113, 121)),
+  ];
+  return jsMerkleize(leaves, 8);
+}
+
+function jsValidatorListRoot(validators: Uint8Array[]): Uint8Array {
+  const root = jsMerkleize(
+    validators.map(jsValidatorRoot),
+    VALIDATOR_REGISTRY_LIMIT,
+  );
+  const length = new Uint8Array(32);
+  new DataView(length.buffer).setUint32(0, validators.length, true);
+  return jsHashPair(root, length);
+}
+
+async function measure(
+  testName: string,
+  items: number,
+  nativeImpl: () => unknown,
+  jsImpl: () => unknown,
+): Promise<SszBenchmarkResult> {
+  await nativeImpl();
+  jsImpl();
+
+  const nativeTimes: number[] = [];
+  const jsTimes: number[] = [];
+  for (let round = 0; round < ROUNDS; round++) {
+    let start = performance.now();
+    await nativeImpl();
+    nativeTimes.push(performance.now() - start);
+
+    start = performance.now();
+    jsImpl();
+    jsTimes.push(performance.now() - start);
+
+    // Yield so the UI stays responsive between rounds
+    await new Promise((resolve) => setTimeout(resolve, 0));
+  }
+
+  const nativeStats = calculateStats(nativeTimes);
+  const jsStats = calculateStats(jsTimes);
+
+  return {
+    testName,
+    items,
+    native: {
+      averageTime: nativeStats.averageTime,
+      itemsPerSecond: (items * 1000) / nativeStats.averageTime,
+    },
+    javascript: {
+      averageTime: jsStats.averageTime,
+      itemsPerSecond: (items * 1000) / jsStats.averageTime,
+    },
+    speedupFactor: jsStats.averageTime / nativeStats.averageTime,
+  };
+}
+
+// hash_tree_root of each validator, e.g. to diff two registry snapshots
+export async function benchmarkValidatorRoots(
+  validators: Uint8Array[],
+): Promise<SszBenchmarkResult> {
+  return measure(
+    `${validators.length / 1000}k validator roots`,
+    validators.length,
+    () => sszContainerRoots('validator', validators),
+    () => validators.map(jsValidatorRoot),
+  );
+}
+
+// hash_tree_root(state.validators) with the registry limit of 2^40
+export async function benchmarkValidatorListRoot(
+  validators: Uint8Array[],
+): Promise<SszBenchmarkResult> {
+  return measure(
+    `Validator registry root, ${validators.length / 1000}k validators`,
+    validators.length,
+    () =>
+      sszContainerListRoot('validator', validators, VALIDATOR_REGISTRY_LIMIT),
+    () => jsValidatorListRoot(validators),
+  );
+}
+
+// Run all SSZ benchmarks
+export async function runAllSszBenchmarks(): Promise<SszBenchmarkResult[]> {
+  console.log('🚀 Starting SSZ benchmarks...');
+
+  const validators = makeValidators(VALIDATOR_COUNT);
+  const results = [
+    await benchmarkValidatorRoots(validators),
+    await benchmarkValidatorListRoot(validators),
+  ];
+
+  console.log('✅ All SSZ benchmarks completed!');
+  return results;
+}
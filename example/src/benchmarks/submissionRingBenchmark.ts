@@ -0,0 +1,140 @@
+import {
+  SubmissionQueue,
+  createPipeline,
+  getPublicKeysAsync,
+  type RingOp,
+} from '@metamask/native-utils';
+import { calculateStats } from '../testUtils';
+
+export type ThroughputResult = {
+  testName: string;
+  requests: number;
+  ring: { averageTime: number; requestsPerSecond: number };
+  batch: { averageTime: number; requestsPerSecond: number };
+  speedupFactor: number;
+};
+
+const BATCH_SIZE = 256;
+const ROUNDS = 5;
+
+// Deterministic valid secp256k1 / ed25519 private keys
+function makeInputs(count: number, size: number): Uint8Array[] {
+  return Array.from({ length: count }, (_, i) => {
+    const item = new Uint8Array(size);
+    for (let j = 0; j < size; j++) {
+      item[j] = (i * 31 + j * 7 + 1) & 0xff;
+    }
+    item[0] = 0x01;
+    return item;
+  });
+}
+
+// Stream every input through one queue, draining whenever it fills up
+async function runThroughRing(
+  queue: SubmissionQueue,
+  op: RingOp,
+  inputs: Uint8Array[],
+): Promise<number> {
+  let completed = 0;
+  for (const input of inputs) {
+    if (!queue.enqueue(op, input)) {
+      completed += (await queue.drain()).length;
+      queue.enqueue(op, input);
+    }
+  }
+  completed += (await queue.drain()).length;
+  return completed;
+}
+
+async function measure(
+  testName: string,
+  requests: number,
+  ringImpl: () => Promise<unknown>,
+  batchImpl: () => Promise<unknown>,
+): Promise<ThroughputResult> {
+  // Warm up both paths
+  await ringImpl();
+  await batchImpl();
+
+  const ringTimes: number[] = [];
+  const batchTimes: number[] = [];
+  for (let round = 0; round < ROUNDS; round++) {
+    let start = performance.now();
+    await ringImpl();
+    ringTimes.push(performance.now() - start);
+
+    start = performance.now();
+    await batchImpl();
+    batchTimes.push(performance.now() - start);
+  }
+
+  const ringStats = calculateStats(ringTimes);
+  const batchStats = calculateStats(batchTimes);
+
+  return {
+    testName,
+    requests,
+    ring: {
+      averageTime: ringStats.averageTime,
+      requestsPerSecond: (requests * 1000) / ringStats.averageTime,
+    },
+    batch: {
+      averageTime: batchStats.averageTime,
+      requestsPerSecond: (requests * 1000) / batchStats.averageTime,
+    },
+    speedupFactor: batchStats.averageTime / ringStats.averageTime,
+  };
+}
+
+// secp256k1 key derivation: ring vs repeated getPublicKeysAsync batches
+export async function benchmarkRingPublicKeys(): Promise<ThroughputResult> {
+  const keys = makeInputs(4096, 32);
+  const queue = new SubmissionQueue(BATCH_SIZE, BATCH_SIZE * (32 + 33));
+
+  return measure(
+    `secp256k1 public keys (${keys.length})`,
+    keys.length,
+    () => runThroughRing(queue, 'secp256k1PublicKeyCompressed', keys),
+    async () => {
+      for (let i = 0; i < keys.length; i += BATCH_SIZE) {
+        await getPublicKeysAsync(keys.slice(i, i + BATCH_SIZE), true);
+      }
+    },
+  );
+}
+
+// Small-message hashing: ring vs repeated packed pipeline batches
+export async function benchmarkRingKeccak(): Promise<ThroughputResult> {
+  const messages = makeInputs(16384, 64);
+  const queue = new SubmissionQueue(BATCH_SIZE, BATCH_SIZE * (64 + 32));
+  const pipeline = createPipeline(['keccak256'], 64);
+
+  return measure(
+    `keccak256 64-byte messages (${messages.length})`,
+    messages.length,
+    () => runThroughRing(queue, 'keccak256', messages),
+    async () => {
+      for (let i = 0; i < messages.length; i += BATCH_SIZE) {
+        const batch = messages.slice(i, i + BATCH_SIZE);
+        const packed = new Uint8Array(batch.length * 64);
+        batch.forEach((message, j) => packed.set(message, j * 64));
+        await pipeline.runAsync(packed.buffer);
+      }
+    },
+  );
+}
+
+// Run all submission ring benchmarks
+export async function runAllSubmissionRingBenchmarks(): Promise<
+  ThroughputResult[]
+> {
+  console.log('🚀 Starting submission ring benchmarks...');
+
+  const results = [
+    await benchmarkRingPublicKeys(),
+    await benchmarkRingKeccak(),
+  ];
+
+  console.log('✅ All submission ring benchmarks completed!');
+  return results;
+}
@@ -50,6 +50,13 @@ export function utf8ToBytes(str: string): Uint8Array {
   return new TextEncoder().encode(str);
 }
 
+/**
+ * Random bytes for test inputs (not cryptographically secure)
+ */
+export function randomBytes(length: number): Uint8Array {
+  return new Uint8Array(length).map(() => Math.floor(Math.random() * 256));
+}
+
 /**
  * Concatenate multiple Uint8Arrays
  */
@@ -0,0 +1,173 @@
+import { createAddressSet, packAddresses } from '@metamask/native-utils';
+import type { TestResult } from '../testUtils';
+
+// Deterministic pseudo-random addresses; a small alphabet forces shared prefixes
+function makeAddresses(count: number, seed: number, alphabet = 256) {
+  const addresses: Uint8Array[] = [];
+  let state = seed;
+  for (let i = 0; i < count; i++) {
+    const address = new Uint8Array(20);
+    for (let j = 0; j < 20; j++) {
+      state = (state * 1103515245 + 12345) >>> 0;
+      address[j] = (state >>> 16) % alphabet;
+    }
+    addresses.push(address);
+  }
+  return addresses;
+}
+
+function toKey(address: Uint8Array): string {
+  return Array.from(address, (byte) =>
+    byte.toString(16).padStart(2, '0'),
+  ).join('');
+}
+
+function bitAt(bitmap: Uint8Array, index: number): boolean {
+  return (bitmap[index >> 3]! & (1 << (index & 7))) !== 0;
+}
+
+// Hex strings with and without prefix match the same raw address
+function testHexAndBytes(): TestResult {
+  const name = 'Hex and byte addresses are interchangeable';
+  try {
+    const address = '0x52908400098527886E0F7030069857D2E4169EE7';
+    const set = createAddressSet([address]);
+    const bitmap = new Uint8Array(
+      set.contains(
+        packAddresses([
+          address.toLowerCase(),
+          address.slice(2),
+          new Uint8Array(20),
+        ]),
+      ),
+    );
+    const success =
+      set.size === 1 &&
+      bitAt(bitmap, 0) &&
+      bitAt(bitmap, 1) &&
+      !bitAt(bitmap, 2);
+    return {
+      name,
+      success,
+      message: success
+        ? '✓ Prefixed, unprefixed and mixed-case hex match'
+        : `✗ Unexpected bitmap ${bitmap[0]} for size ${set.size}`,
+    };
+  } catch (error) {
+    return { name, success: false, message: `✗ Unexpected error: ${error}` };
+  }
+}
+
+// Insert/remove churn with duplicates agrees with a JS Set at every step
+function testMatchesJsSet(): TestResult {
+  const name = 'Insert, remove and contains match a JS Set';
+  try {
+    const set = createAddressSet();
+    const reference = new Set<string>();
+    for (let round = 0; round < 50; round++) {
+      const inserted = makeAddresses(300, round * 3 + 1, 4);
+      const removed = makeAddresses(200, round * 3 + 2, 4);
+      const queries = makeAddresses(150, round * 3 + 3, 4);
+
+      const sizeBefore = reference.size;
+      inserted.forEach((address) => reference.add(toKey(address)));
+      const expectedInserted = reference.size - sizeBefore;
+      const expectedRemoved = removed.filter((address) =>
+        reference.delete(toKey(address)),
+      ).length;
+
+      const actualInserted = set.insert(packAddresses(inserted));
+      const actualRemoved = set.remove(packAddresses(removed));
+      const bitmap = new Uint8Array(set.contains(packAddresses(queries)));
+      const mismatch = queries.findIndex(
+        (address, i) => bitAt(bitmap, i) !== reference.has(toKey(address)),
+      );
+
+      if (
+        actualInserted !== expectedInserted ||
+        actualRemoved !== expectedRemoved ||
+        set.size !== reference.size ||
+        mismatch !== -1
+      ) {
+        return {
+          name,
+          success: false,
+          message: `✗ Round ${round}: inserted ${actualInserted}/${expectedInserted}, removed ${actualRemoved}/${expectedRemoved}, size ${set.size}/${reference.size}, mismatch at ${mismatch}`,
+        };
+      }
+    }
+    return { name, success: true, message: `✓ ${reference.size} addresses` };
+  } catch (error) {
+    return { name, success: false, message: `✗ Unexpected error: ${error}` };
+  }
+}
+
+// Large batches stay exact after the table grows
+function testLargeBatch(): TestResult {
+  const name = 'Exact membership for 20k addresses';
+  try {
+    const members = makeAddresses(20000, 7);
+    const others = makeAddresses(20000, 8);
+    const set = createAddressSet(members, 16);
+    const start = Date.now();
+    const bitmap = new Uint8Array(
+      set.contains(packAddresses([...members, ...others])),
+    );
+    const duration = Date.now() - start;
+
+    let hits = 0;
+    for (let i = 0; i < 40000; i++) {
+      hits += bitAt(bitmap, i) ? 1 : 0;
+    }
+    const success =
+      set.size === 20000 && hits === 20000 && bitmap.length === 5000;
+    return {
+      name,
+      success,
+      message: success
+        ? `✓ 40000 lookups in ${duration}ms`
+        : `✗ ${hits} hits for ${set.size} members`,
+      duration,
+    };
+  } catch (error) {
+    return { name, success: false, message: `✗ Unexpected error: ${error}` };
+  }
+}
+
+// Malformed input is rejected
+function testRejectsInvalidInput(): TestResult {
+  const name = 'Rejects malformed addresses';
+  const set = createAddressSet();
+  const attempts: [string, () => unknown][] = [
+    ['short hex', () => packAddresses(['0x1234'])],
+    ['invalid hex', () => packAddresses(['zz'.repeat(20)])],
+    ['21 bytes', () => packAddresses([new Uint8Array(21)])],
+    ['unaligned buffer', () => set.contains(new ArrayBuffer(30))],
+  ];
+  const accepted = attempts.filter(([, attempt]) => {
+    try {
+      attempt();
+      return true;
+    } catch {
+      return false;
+    }
+  });
+  return {
+    name,
+    success: accepted.length === 0,
+    message:
+      accepted.length === 0
+        ? '✓ All malformed inputs rejected'
+        : `✗ Accepted: ${accepted.map(([label]) => label).join(', ')}`,
+  };
+}
+
+// Run all address set tests
+export function runAllAddressSetTests(): TestResult[] {
+  return [
+    testHexAndBytes(),
+    testMatchesJsSet(),
+    testLargeBatch(),
+    testRejectsInvalidInput(),
+  ];
+}
@@ -0,0 +1,156 @@
+import {
+  bip322Sign,
+  bip322Verify,
+  bip322VerifyBatch,
+  type Bip322Proof,
+} from '@metamask/native-utils';
+import { type TestResult } from '../testUtils';
+
+// BIP322 test vectors: the key of WIF
+// L3VFeEujGtevx9w18HD1fhRbCH67Az2dpCymeRE1SoPK6XQtaN2k and its addresses
+const PRIVATE_KEY =
+  'bb051cd0dda0246f33c5a9e133ebd8e7bc02a92af6c41adc131ccd7826c5b004';
+const P2WPKH = 'bc1q9vza2e8x573nczrlzms0wvx3gsqjx7vavgkx0l';
+const P2TR = 'bc1ppv609nr0vr25u07u95waq5lucwfm6tde4nydujnu8npg4q75mr5sxq8lt3';
+
+const VECTORS: Bip322Proof[] = [
+  {
+    address: P2WPKH,
+    message: '',
+    signature:
+      'AkcwRAIgM2gBAQqvZX15ZiysmKmQpDrG83avLIT492QBzLnQIxYCIBaTpOaD20qRlEylyxFSeEA2ba9YOixpX8z46TSDtS40ASECx/EgAxlkQpQ9hYjgGu6EBCPMVPwVIVJqO4XCsMvViHI=',
+  },
+  {
+    address: P2WPKH,
+    message: 'Hello World',
+    signature:
+      'AkcwRAIgZRfIY3p7/DoVTty6YZbWS71bc5Vct9p9Fia83eRmw2QCICK/ENGfwLtptFluMGs2KsqoNSk89pO7F29zJLUx9a/sASECx/EgAxlkQpQ9hYjgGu6EBCPMVPwVIVJqO4XCsMvViHI=',
+  },
+  {
+    address: P2TR,
+    message: 'Hello World',
+    signature:
+      'AUHd69PrJQEv+oKTfZ8l+WROBHuy9HKrbFCJu7U1iK2iiEy1vMU5EfMtjc+VSHM7aU0SDbak5IUZRVno2P5mjSafAQ==',
+  },
+];
+
+// The vectors verify, and P2WPKH signing reproduces them exactly
+function testVectors(): TestResult {
+  const name = 'BIP322 test vectors';
+  try {
+    const failures: string[] = [];
+    VECTORS.forEach((vector, i) => {
+      if (!bip322Verify(vector.address, vector.message, vector.signature)) {
+        failures.push(`verify ${i}`);
+      }
+      if (
+        vector.address === P2WPKH &&
+        bip322Sign(PRIVATE_KEY, vector.address, vector.message) !==
+          vector.signature
+      ) {
+        failures.push(`sign ${i}`);
+      }
+    });
+    const success = failures.length === 0;
+    return {
+      name,
+      success,
+      message: success
+        ? `✓ ${VECTORS.length} vectors match`
+        : `✗ Mismatch: ${failures.join(', ')}`,
+    };
+  } catch (error) {
+    return { name, success: false, message: `✗ Unexpected error: ${error}` };
+  }
+}
+
+// Fresh taproot signatures verify, and only for their own message
+function testTaprootRoundTrip(): TestResult {
+  const name = 'P2TR sign and verify';
+  try {
+    const message = `Login at ${Date.now()}`;
+    const signature = bip322Sign(PRIVATE_KEY, P2TR, message);
+    const valid = bip322Verify(P2TR, message, signature);
+    const forged = bip322Verify(P2TR, `${message}!`, signature);
+    const success = valid && !forged;
+    return {
+      name,
+      success,
+      message: success
+        ? '✓ Signature verifies for its message only'
+        : `✗ Valid ${valid}, other message ${forged}`,
+    };
+  } catch (error) {
+    return { name, success: false, message: `✗ Unexpected error: ${error}` };
+  }
+}
+
+// A batch flags exactly the tampered proofs
+function testBatch(): TestResult {
+  const name = 'Batch verify';
+  try {
+    const proofs: Bip322Proof[] = [];
+    const expected: boolean[] = [];
+    for (let i = 0; i < 40; i++) {
+      const vector = VECTORS[i % VECTORS.length]!;
+      const tampered = i % 5 === 0;
+      proofs.push(
+        tampered ? { ...vector, message: `${vector.message}?` } : vector,
+      );
+      expected.push(!tampered);
+    }
+    // Malformed entries are invalid, not errors
+    proofs.push({ ...VECTORS[0]!, signature: 'not base64' });
+    proofs.push({ ...VECTORS[0]!, address: 'bc1qnotanaddress' });
+    expected.push(false, false);
+    const valid = bip322VerifyBatch(proofs);
+    const success = valid.join() === expected.join();
+    return {
+      name,
+      success,
+      message: success
+        ? `✓ ${proofs.length} proofs checked`
+        : `✗ Got ${valid.filter(Boolean).length} valid, expected ${
+            expected.filter(Boolean).length
+          }`,
+    };
+  } catch (error) {
+    return { name, success: false, message: `✗ Unexpected error: ${error}` };
+  }
+}
+
+// Signing throws for a key that does not control the address
+function testSignErrors(): TestResult {
+  const name = 'Sign rejects wrong keys and addresses';
+  const errors: string[] = [];
+  const expectThrow = (label: string, fn: () => unknown) => {
+    try {
+      fn();
+      errors.push(`${label} did not throw`);
+    } catch {
+      // Expected
+    }
+  };
+  const otherKey = PRIVATE_KEY.replace(/^bb/, 'cc');
+  expectThrow('other key', () => bip322Sign(otherKey, P2WPKH, 'x'));
+  expectThrow('legacy address', () =>
+    bip322Sign(PRIVATE_KEY, '1BvBMSEYstWetqTFn5Au4m4GFg7xJaNVN2', 'x'),
+  );
+  expectThrow('zero key', () => bip322Sign(new Uint8Array(32), P2TR, 'x'));
+  const success = errors.length === 0;
+  return {
+    name,
+    success,
+    message: success ? '✓ All rejected' : `✗ ${errors.join(', ')}`,
+  };
+}
+
+// Run all BIP322 tests
+export function runAllBip322Tests(): TestResult[] {
+  return [
+    testVectors(),
+    testTaprootRoundTrip(),
+    testBatch(),
+    testSignErrors(),
+  ];
+}
@@ -0,0 +1,148 @@
+import {
+  bloomAdd,
+  bloomBuild,
+  bloomMatches,
+  keccak256,
+} from '@metamask/native-utils';
+import { keccak_256 } from '@noble/hashes/sha3';
+import { uint8ArrayToHex, utf8ToBytes, type TestResult } from '../testUtils';
+
+// Reference logsBloom insertion (Yellow Paper M3:2048)
+function jsBloomAdd(bloom: Uint8Array, item: Uint8Array): void {
+  const hash = keccak_256(item);
+  for (let i = 0; i < 6; i += 2) {
+    const bit = ((hash[i]! << 8) | hash[i + 1]!) & 2047;
+    const index = 255 - (bit >> 3);
+    bloom[index] = bloom[index]! | (1 << (bit & 7));
+  }
+}
+
+function makeItems(count: number, size: number, seed: number): Uint8Array[] {
+  let state = seed;
+  return Array.from({ length: count }, () => {
+    const item = new Uint8Array(size);
+    for (let j = 0; j < size; j++) {
+      state = (state * 1103515245 + 12345) >>> 0;
+      item[j] = state >>> 24;
+    }
+    return item;
+  });
+}
+
+function bitAt(bitmap: Uint8Array, index: number): boolean {
+  return (bitmap[index >> 3]! & (1 << (index & 7))) !== 0;
+}
+
+// go-ethereum TestBloomExtensively: 100 items, then hash the bloom
+function testGethVector(): TestResult {
+  const name = 'Matches go-ethereum bloom vector';
+  try {
+    const bloom = new Uint8Array(256);
+    for (let i = 0; i < 100; i++) {
+      bloomAdd(bloom, [utf8ToBytes(`xxxxxxxxxx data ${i} yyyyyyyyyyyyyy`)]);
+    }
+    const expected =
+      'c8d3ca65cdb4874300a9e39475508f23ed6da09fdbc487f89a2dcf50b09eb263';
+    const actual = uint8ArrayToHex(keccak256(bloom), false);
+    return {
+      name,
+      success: actual === expected,
+      message:
+        actual === expected ? '✓ Bloom hash matches' : `✗ Got ${actual}`,
+    };
+  } catch (error) {
+    return { name, success: false, message: `✗ Unexpected error: ${error}` };
+  }
+}
+
+// Mixed addresses and topics build the same bloom as the JS reference
+function testBuildMatchesReference(): TestResult {
+  const name = 'bloomBuild matches JS reference';
+  try {
+    const items = [...makeItems(5, 20, 1), ...makeItems(12, 32, 2)];
+    const expected = new Uint8Array(256);
+    items.forEach((item) => jsBloomAdd(expected, item));
+    const actual = bloomBuild([uint8ArrayToHex(items[0]!), ...items.slice(1)]);
+    const success = uint8ArrayToHex(actual) === uint8ArrayToHex(expected);
+    return {
+      name,
+      success,
+      message: success ? '✓ 17 items agree' : '✗ Blooms differ',
+    };
+  } catch (error) {
+    return { name, success: false, message: `✗ Unexpected error: ${error}` };
+  }
+}
+
+// Batch matching has no false negatives and agrees with per-bloom checks
+function testMatchesReference(): TestResult {
+  const name = 'bloomMatches agrees with per-bloom checks';
+  try {
+    const addresses = makeItems(300, 20, 3);
+    const blooms = addresses.map((address) => bloomBuild([address]));
+    const queries = [addresses[7]!, addresses[250]!, ...makeItems(4, 32, 4)];
+
+    const expected = blooms.map((bloom) =>
+      queries.some((query) => {
+        const bits = new Uint8Array(256);
+        jsBloomAdd(bits, query);
+        return bits.every((byte, i) => (bloom[i]! & byte) === byte);
+      }),
+    );
+    const packed = new Uint8Array(blooms.length * 256);
+    blooms.forEach((bloom, i) => packed.set(bloom, i * 256));
+
+    const fromArray = bloomMatches(blooms, queries);
+    const fromPacked = bloomMatches(packed, queries);
+    const mismatch = expected.findIndex(
+      (match, i) =>
+        bitAt(fromArray, i) !== match || bitAt(fromPacked, i) !== match,
+    );
+    const success = mismatch === -1 && expected[7]! && expected[250]!;
+    return {
+      name,
+      success,
+      message: success
+        ? `✓ ${expected.filter(Boolean).length} of 300 blooms match`
+        : `✗ Mismatch at bloom ${mismatch}`,
+    };
+  } catch (error) {
+    return { name, success: false, message: `✗ Unexpected error: ${error}` };
+  }
+}
+
+// Malformed blooms are rejected
+function testRejectsInvalidInput(): TestResult {
+  const name = 'Rejects malformed blooms';
+  const attempts: [string, () => unknown][] = [
+    ['short bloom', () => bloomAdd(new Uint8Array(255), [new Uint8Array(20)])],
+    ['unaligned blooms', () => bloomMatches(new Uint8Array(300), ['0x00'])],
+    ['empty item', () => bloomBuild([new Uint8Array(0)])],
+  ];
+  const accepted = attempts.filter(([, attempt]) => {
+    try {
+      attempt();
+      return true;
+    } catch {
+      return false;
+    }
+  });
+  return {
+    name,
+    success: accepted.length === 0,
+    message:
+      accepted.length === 0
+        ? '✓ All malformed inputs rejected'
+        : `✗ Accepted: ${accepted.map(([label]) => label).join(', ')}`,
+  };
+}
+
+// Run all bloom filter tests
+export function runAllBloomTests(): TestResult[] {
+  return [
+    testGethVector(),
+    testBuildMatchesReference(),
+    testMatchesReference(),
+    testRejectsInvalidInput(),
+  ];
+}
@@ -0,0 +1,222 @@
+import {
+  getDispatchThresholds,
+  getPublicKey,
+  getPublicKeyEd25519,
+  getPublicKeysAsync,
+  getPublicKeysEd25519Async,
+  hmacSha512,
+  hmacSha512Async,
+  keccak256,
+  keccak256Async,
+} from '@metamask/native-utils';
+import type { DispatchThreshold } from '@metamask/native-utils';
+import type { TestResult } from '../testUtils';
+import { uint8ArrayToHex } from '../testUtils';
+
+const OPS = [
+  'keccak256',
+  'hmacSha512',
+  'secp256k1PublicKey',
+  'ed25519PublicKey',
+];
+
+function makeBytes(length: number): Uint8Array {
+  const bytes = new Uint8Array(length);
+  for (let i = 0; i < length; i++) {
+    bytes[i] = (i * 31 + 7) & 0xff;
+  }
+  return bytes;
+}
+
+// Distinct keys that are valid secp256k1 scalars and ed25519 seeds
+function makeKeys(count: number): Uint8Array[] {
+  const keys: Uint8Array[] = [];
+  for (let i = 0; i < count; i++) {
+    const key = new Uint8Array(32).fill(0x5a);
+    key[0] = 0x01;
+    new DataView(key.buffer).setUint32(1, i);
+    keys.push(key);
+  }
+  return keys;
+}
+
+function findThreshold(op: string): DispatchThreshold {
+  const threshold = getDispatchThresholds().find((entry) => entry.op === op);
+  if (!threshold) {
+    throw new Error(`No threshold for ${op}`);
+  }
+  return threshold;
+}
+
+// Sizes just below and just above the inline limit, capped for slow models
+function sizesAround(op: string, cap: number): number[] {
+  const limit = findThreshold(op).inlineMaxUnits;
+  const below = Math.max(1, Math.min(cap, Math.floor(limit)));
+  const above = Number.isFinite(limit)
+    ? Math.min(cap, Math.ceil(limit) + 1)
+    : cap;
+  return [1, below, above];
+}
+
+// Calibration runs on the thread pool when the module loads
+async function waitForCalibration(): Promise<boolean> {
+  for (let attempt = 0; attempt < 250; attempt++) {
+    const thresholds = getDispatchThresholds();
+    if (
+      thresholds.every((entry) => entry.samples > 0 && entry.offloadCostNs > 0)
+    ) {
+      return true;
+    }
+    await new Promise((resolve) => setTimeout(resolve, 20));
+  }
+  return false;
+}
+
+// Every modelled operation reports a calibrated cost model
+async function testThresholdsReported(): Promise<TestResult> {
+  const name = 'Dispatch thresholds are reported after calibration';
+  try {
+    if (!(await waitForCalibration())) {
+      return {
+        name,
+        success: false,
+        message: `✗ Not calibrated: ${JSON.stringify(
+          getDispatchThresholds(),
+        )}`,
+      };
+    }
+    const thresholds = getDispatchThresholds();
+    const ops = thresholds.map((entry) => entry.op);
+    const valid =
+      ops.join() === OPS.join() &&
+      thresholds.every(
+        (entry) =>
+          entry.fixedCostNs >= 0 &&
+          entry.perUnitCostNs >= 0 &&
+          entry.offloadCostNs > 0 &&
+          entry.inlineMaxUnits >= 0 &&
+          entry.samples >= 2,
+      );
+    return {
+      name,
+      success: valid,
+      message: valid
+        ? `✓ ${thresholds
+            .map(
+              (entry) => `${entry.op} ≤ ${Math.floor(entry.inlineMaxUnits)}`,
+            )
+            .join(', ')}`
+        : `✗ Unexpected thresholds: ${JSON.stringify(thresholds)}`,
+    };
+  } catch (error) {
+    return { name, success: false, message: `✗ Unexpected error: ${error}` };
+  }
+}
+
+// A single hash always runs inline and a huge key batch never does
+function testThresholdBounds(): TestResult {
+  const name = 'Thresholds keep tiny work inline and huge batches offloaded';
+  try {
+    const keccak = findThreshold('keccak256').inlineMaxUnits;
+    const secp256k1 = findThreshold('secp256k1PublicKey').inlineMaxUnits;
+    const ed25519 = findThreshold('ed25519PublicKey').inlineMaxUnits;
+    const success = keccak >= 32 && secp256k1 < 100_000 && ed25519 < 100_000;
+    return {
+      name,
+      success,
+      message: success
+        ? `✓ keccak256 ${Math.floor(keccak)} bytes, secp256k1 ${Math.floor(secp256k1)} keys, ed25519 ${Math.floor(ed25519)} keys`
+        : `✗ keccak256 ${keccak}, secp256k1 ${secp256k1}, ed25519 ${ed25519}`,
+    };
+  } catch (error) {
+    return { name, success: false, message: `✗ Unexpected error: ${error}` };
+  }
+}
+
+// Completed requests are fed back into the model
+async function testSnapshotRefines(): Promise<TestResult> {
+  const name = 'Completed requests refine the model';
+  try {
+    const before = findThreshold('keccak256').samples;
+    await keccak256Async(makeBytes(32));
+    await keccak256Async(makeBytes(64 * 1024));
+    const after = findThreshold('keccak256').samples;
+    return {
+      name,
+      success: after >= before + 2,
+      message:
+        after >= before + 2
+          ? `✓ Samples ${before} → ${after}`
+          : `✗ Samples ${before} → ${after}`,
+    };
+  } catch (error) {
+    return { name, success: false, message: `✗ Unexpected error: ${error}` };
+  }
+}
+
+// Results are the same on both sides of each threshold
+async function testResultsAcrossThresholds(): Promise<TestResult> {
+  const name = 'Inline and offloaded requests match the sync API';
+  try {
+    for (const size of sizesAround('keccak256', 1 << 20)) {
+      const data = makeBytes(size);
+      const actual = uint8ArrayToHex(await keccak256Async(data));
+      if (actual !== uint8ArrayToHex(keccak256(data))) {
+        return { name, success: false, message: `✗ keccak256 ${size} bytes` };
+      }
+    }
+
+    const key = makeBytes(64);
+    for (const size of sizesAround('hmacSha512', 1 << 20)) {
+      const data = makeBytes(size);
+      const actual = uint8ArrayToHex(await hmacSha512Async(key, data));
+      if (actual !== uint8ArrayToHex(hmacSha512(key, data))) {
+        return {
+          name,
+          success: false,
+          message: `✗ hmacSha512 ${size} bytes`,
+        };
+      }
+    }
+
+    for (const count of sizesAround('secp256k1PublicKey', 256)) {
+      const keys = makeKeys(count);
+      const actual = await getPublicKeysAsync(keys);
+      const mismatch = keys.findIndex(
+        (privateKey, i) =>
+          uint8ArrayToHex(actual[i]!) !==
+          uint8ArrayToHex(getPublicKey(privateKey)),
+      );
+      if (actual.length !== count || mismatch !== -1) {
+        return { name, success: false, message: `✗ secp256k1 ${count} keys` };
+      }
+    }
+
+    for (const count of sizesAround('ed25519PublicKey', 256)) {
+      const keys = makeKeys(count);
+      const actual = await getPublicKeysEd25519Async(keys);
+      const mismatch = keys.findIndex(
+        (privateKey, i) =>
+          uint8ArrayToHex(actual[i]!) !==
+          uint8ArrayToHex(getPublicKeyEd25519(privateKey)),
+      );
+      if (actual.length !== count || mismatch !== -1) {
+        return { name, success: false, message: `✗ ed25519 ${count} keys` };
+      }
+    }
+
+    return { name, success: true, message: '✓ All sizes match' };
+  } catch (error) {
+    return { name, success: false, message: `✗ Unexpected error: ${error}` };
+  }
+}
+
+// Run all adaptive dispatch tests
+export async function runAllDispatchTests(): Promise<TestResult[]> {
+  return [
+    await testThresholdsReported(),
+    testThresholdBounds(),
+    await testSnapshotRefines(),
+    await testResultsAcrossThresholds(),
+  ];
+}
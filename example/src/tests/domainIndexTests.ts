@@ -0,0 +1,155 @@
+import {
+  buildDomainIndex,
+  getTemporaryDirectory,
+  matchDomains,
+  openDomainIndex,
+} from '@metamask/native-utils';
+import type { TestResult } from '../testUtils';
+
+const BLOCKED = [
+  'evil-wallet.com',
+  'Phishing.IO.',
+  'drainer.example.org',
+  // Duplicate after normalization
+  'EVIL-wallet.com',
+  // Invalid, skipped
+  'bad..domain',
+];
+
+function indexPath(name: string): string {
+  return `${getTemporaryDirectory()}/${name}`;
+}
+
+// Listed domains match themselves and their subdomains, but not their
+// parents or look-alikes
+async function testSuffixMatch(): Promise<TestResult> {
+  const name = 'Matches listed domains and subdomains';
+  try {
+    const path = indexPath('domain-test.idx');
+    const indexed = await buildDomainIndex(BLOCKED, path);
+    const index = openDomainIndex(path);
+    const hosts = [
+      'evil-wallet.com',
+      'app.EVIL-WALLET.com',
+      'phishing.io',
+      'a.b.phishing.io.',
+      'drainer.example.org',
+      'example.org',
+      'not-evil-wallet.com',
+      'evil-wallet.com.au',
+      'com',
+    ];
+    const expected = [true, true, true, true, true, false, false, false, false];
+    const matched = matchDomains(index, hosts);
+
+    const success =
+      indexed === 3 &&
+      index.size === 3 &&
+      matched.every((match, i) => match === expected[i]);
+    return {
+      name,
+      success,
+      message: success
+        ? `✓ ${hosts.length} hostnames classified`
+        : `✗ Got ${indexed}: ${JSON.stringify(matched)}`,
+    };
+  } catch (error) {
+    return { name, success: false, message: `✗ Unexpected error: ${error}` };
+  }
+}
+
+// An updated list is swapped in by reload, and open indexes stay
+// consistent until then
+async function testReload(): Promise<TestResult> {
+  const name = 'Swaps in a rebuilt list on reload';
+  try {
+    const path = indexPath('domain-reload.idx');
+    await buildDomainIndex(['old-scam.com'], path);
+    const index = openDomainIndex(path);
+    await buildDomainIndex(['new-scam.com'], path);
+    const [oldBefore, newBefore] = matchDomains(index, [
+      'old-scam.com',
+      'new-scam.com',
+    ]);
+    index.reload();
+    const [oldAfter, newAfter] = matchDomains(index, [
+      'old-scam.com',
+      'new-scam.com',
+    ]);
+
+    const success =
+      oldBefore === true &&
+      newBefore === false &&
+      oldAfter === false &&
+      newAfter === true;
+    return {
+      name,
+      success,
+      message: success
+        ? '✓ Old list until reload, new list after'
+        : `✗ Got ${[oldBefore, newBefore, oldAfter, newAfter]}`,
+    };
+  } catch (error) {
+    return { name, success: false, message: `✗ Unexpected error: ${error}` };
+  }
+}
+
+// A block list the size of the public phishing lists
+async function testLargeList(): Promise<TestResult> {
+  const name = 'Opens a 200k-domain list instantly';
+  try {
+    const path = indexPath('domain-large.idx');
+    const domains = Array.from(
+      { length: 200_000 },
+      (_, i) => `scam-${i}.example${i % 50}.com`,
+    );
+    await buildDomainIndex(domains, path);
+
+    let start = Date.now();
+    const index = openDomainIndex(path);
+    const openTime = Date.now() - start;
+
+    start = Date.now();
+    const matched = matchDomains(
+      index,
+      Array.from({ length: 10_000 }, (_, i) =>
+        i % 2 === 0 ? `www.scam-${i}.example${i % 50}.com` : `site-${i}.org`,
+      ),
+    );
+    const lookupTime = Date.now() - start;
+
+    const success =
+      index.size === 200_000 && matched.every((match, i) => match === !(i % 2));
+    return {
+      name,
+      success,
+      message: success
+        ? `✓ Opened in ${openTime}ms, 10k lookups in ${lookupTime}ms`
+        : `✗ Size ${index.size}`,
+      duration: openTime + lookupTime,
+    };
+  } catch (error) {
+    return { name, success: false, message: `✗ Unexpected error: ${error}` };
+  }
+}
+
+// Missing files are rejected
+function testRejectsInvalidFiles(): TestResult {
+  const name = 'Rejects missing index files';
+  try {
+    openDomainIndex(indexPath('does-not-exist.idx'));
+    return { name, success: false, message: '✗ Opened a missing file' };
+  } catch (error) {
+    return { name, success: true, message: `✓ ${error}` };
+  }
+}
+
+// Run all domain index tests
+export async function runAllDomainIndexTests(): Promise<TestResult[]> {
+  return [
+    await testSuffixMatch(),
+    await testReload(),
+    await testLargeList(),
+    testRejectsInvalidFiles(),
+  ];
+}
@@ -0,0 +1,90 @@
+import {
+  createEd25519KeyHandle,
+  getPublicKeyEd25519,
+  signEd25519Batch,
+} from '@metamask/native-utils';
+import { ed25519 } from '@noble/curves/ed25519';
+import rfc8032Vectors from '../vectors/rfc8032-ed25519.json';
+import {
+  hexToUint8Array,
+  uint8ArrayToHex,
+  type TestResult,
+} from '../testUtils';
+
+// Signatures and public keys from the RFC 8032 test vectors
+function testRfc8032(): TestResult {
+  const name = 'Matches RFC 8032 signatures';
+  try {
+    const failed = rfc8032Vectors.filter(({ priv, pub, msg, sig }) => {
+      const key = createEd25519KeyHandle(priv);
+      const message = hexToUint8Array(msg);
+      const signature = new Uint8Array(key.sign(message.slice().buffer));
+      return (
+        uint8ArrayToHex(new Uint8Array(key.publicKey()), false) !== pub ||
+        uint8ArrayToHex(signature, false) !== sig
+      );
+    });
+    const success = failed.length === 0;
+    return {
+      name,
+      success,
+      message: success
+        ? `✓ ${rfc8032Vectors.length} vectors match`
+        : `✗ Mismatch for ${failed.map(({ pub }) => pub).join(', ')}`,
+    };
+  } catch (error) {
+    return { name, success: false, message: `✗ Unexpected error: ${error}` };
+  }
+}
+
+// A batch large enough to be signed in parallel, with empty and long
+// messages, checked against noble
+function testSignBatch(): TestResult {
+  const name = 'signBatch matches noble';
+  try {
+    const seed = new Uint8Array(32).map((_, i) => i * 13 + 7);
+    const key = createEd25519KeyHandle(seed);
+    const messages = Array.from({ length: 300 }, (_, i) =>
+      new Uint8Array((i * 37) % 1000).fill(i & 0xff),
+    );
+    const signatures = signEd25519Batch(key, messages);
+    const mismatches = messages.filter(
+      (message, i) =>
+        uint8ArrayToHex(signatures[i]!) !==
+        uint8ArrayToHex(ed25519.sign(message, seed)),
+    );
+    const publicKeyMatches =
+      uint8ArrayToHex(new Uint8Array(key.publicKey())) ===
+      uint8ArrayToHex(getPublicKeyEd25519(seed));
+    const success =
+      mismatches.length === 0 &&
+      publicKeyMatches &&
+      signEd25519Batch(key, []).length === 0;
+    const publicKeyStatus = publicKeyMatches ? 'matches' : 'differs';
+    return {
+      name,
+      success,
+      message: success
+        ? `✓ ${messages.length} signatures match`
+        : `✗ ${mismatches.length} signatures differ, public key ${publicKeyStatus}`,
+    };
+  } catch (error) {
+    return { name, success: false, message: `✗ Unexpected error: ${error}` };
+  }
+}
+
+// Keys of the wrong size are rejected
+function testRejectsInvalidKeys(): TestResult {
+  const name = 'Rejects keys that are not 32 bytes';
+  try {
+    createEd25519KeyHandle(new Uint8Array(31));
+    return { name, success: false, message: '✗ Accepted a 31-byte key' };
+  } catch (error) {
+    return { name, success: true, message: `✓ ${error}` };
+  }
+}
+
+// Run all Ed25519 key handle tests
+export function runAllEd25519KeyHandleTests(): TestResult[] {
+  return [testRfc8032(), testSignBatch(), testRejectsInvalidKeys()];
+}
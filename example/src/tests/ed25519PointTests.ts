@@ -0,0 +1,108 @@
+import {
+  ed25519DecompressPoints,
+  ed25519IsOnCurve,
+  getPublicKeyEd25519,
+} from '@metamask/native-utils';
+import { ed25519 } from '@noble/curves/ed25519';
+import {
+  randomBytes,
+  uint8ArrayToHex,
+  type TestResult,
+} from '../testUtils';
+
+// Reference decoding; fromHex throws for anything that is not a point
+function nobleDecode(point: Uint8Array): { x: bigint; y: bigint } | null {
+  try {
+    return ed25519.ExtendedPoint.fromHex(point).toAffine();
+  } catch {
+    return null;
+  }
+}
+
+// Random values (about half decode) and public keys (all decode), plus the
+// encodings where strict decoding differs from a lenient one
+function samplePoints(): Uint8Array[] {
+  const yIsP = new Uint8Array(32).fill(0xff);
+  yIsP[0] = 0xed;
+  yIsP[31] = 0x7f;
+  const identity = new Uint8Array(32);
+  identity[0] = 1;
+  const identityWithSign = identity.slice();
+  identityWithSign[31] = 0x80;
+  return [
+    ...Array.from({ length: 400 }, () => randomBytes(32)),
+    ...Array.from({ length: 100 }, () => getPublicKeyEd25519(randomBytes(32))),
+    yIsP,
+    identity,
+    identityWithSign,
+    new Uint8Array(32),
+  ];
+}
+
+function testIsOnCurve(points: Uint8Array[]): TestResult {
+  const name = 'ed25519IsOnCurve matches noble';
+  try {
+    const bitmap = ed25519IsOnCurve(points);
+    const mismatches = points.filter(
+      (point, i) =>
+        ((bitmap[i >> 3]! & (1 << (i & 7))) !== 0) !==
+        (nobleDecode(point) !== null),
+    );
+    const valid = points.filter((point) => nobleDecode(point) !== null);
+    const success =
+      mismatches.length === 0 && ed25519IsOnCurve([]).length === 0;
+    return {
+      name,
+      success,
+      message: success
+        ? `✓ ${points.length} encodings, ${valid.length} on the curve`
+        : `✗ Differs for ${mismatches.map((point) => uint8ArrayToHex(point)).join(', ')}`,
+    };
+  } catch (error) {
+    return { name, success: false, message: `✗ Unexpected error: ${error}` };
+  }
+}
+
+function testDecompress(points: Uint8Array[]): TestResult {
+  const name = 'ed25519DecompressPoints matches noble';
+  try {
+    const decoded = ed25519DecompressPoints(points);
+    const mismatches = points.filter((point, i) => {
+      const expected = nobleDecode(point);
+      const actual = decoded[i];
+      return expected === null || !actual
+        ? expected !== null || actual !== null
+        : expected.x !== actual.x || expected.y !== actual.y;
+    });
+    const success = mismatches.length === 0;
+    return {
+      name,
+      success,
+      message: success
+        ? `✓ ${points.length} encodings decoded`
+        : `✗ Differs for ${mismatches.map((point) => uint8ArrayToHex(point)).join(', ')}`,
+    };
+  } catch (error) {
+    return { name, success: false, message: `✗ Unexpected error: ${error}` };
+  }
+}
+
+function testRejectsInvalidLength(): TestResult {
+  const name = 'Rejects encodings that are not 32 bytes';
+  try {
+    ed25519IsOnCurve([new Uint8Array(31)]);
+    return { name, success: false, message: '✗ Accepted a 31-byte encoding' };
+  } catch (error) {
+    return { name, success: true, message: `✓ ${error}` };
+  }
+}
+
+// Run all Ed25519 point tests
+export function runAllEd25519PointTests(): TestResult[] {
+  const points = samplePoints();
+  return [
+    testIsOnCurve(points),
+    testDecompress(points),
+    testRejectsInvalidLength(),
+  ];
+}
@@ -309,6 +309,38 @@ export const testEd25519NobleComparison = (): TestResult[] => {
     }
   }
 
+  // Pseudo-random keys exercise every digit of the scalar recoding and every
+  // table entry of the native fixed-base multiplication
+  try {
+    let state = 1;
+    const keys = Array.from({ length: 500 }, () =>
+      Uint8Array.from({ length: 32 }, () => {
+        state = (state * 1103515245 + 12345) >>> 0;
+        return state >>> 24;
+      }),
+    );
+    keys.push(new Uint8Array(32), new Uint8Array(32).fill(0xff));
+    const mismatches = keys.filter(
+      (key) =>
+        uint8ArrayToHex(getPublicKeyEd25519(key)) !==
+        uint8ArrayToHex(ed25519.getPublicKey(key)),
+    );
+    results.push({
+      name: 'Ed25519 Native vs Noble - random keys',
+      success: mismatches.length === 0,
+      message:
+        mismatches.length === 0
+          ? `✓ ${keys.length} keys match`
+          : `${mismatches.length} of ${keys.length} keys differ, first ${uint8ArrayToHex(mismatches[0]!, false)}`,
+    });
+  } catch (error) {
+    results.push({
+      name: 'Ed25519 Native vs Noble - random keys',
+      success: false,
+      message: `Error: ${error}`,
+    });
+  }
+
   return results;
 };
 
@@ -0,0 +1,148 @@
+import { namehash, namehashMany } from '@metamask/native-utils';
+import { keccak_256 } from '@noble/hashes/sha3';
+import { uint8ArrayToHex, utf8ToBytes, type TestResult } from '../testUtils';
+
+// Reference EIP-137 namehash
+function jsNamehash(name: string): string {
+  let node = new Uint8Array(32);
+  if (name) {
+    for (const label of name.split('.').reverse()) {
+      const input = new Uint8Array(64);
+      input.set(node);
+      input.set(keccak_256(utf8ToBytes(label)), 32);
+      node = keccak_256(input);
+    }
+  }
+  return uint8ArrayToHex(node);
+}
+
+// Vectors from EIP-137
+function testKnownVectors(): TestResult {
+  const name = 'Matches EIP-137 vectors';
+  try {
+    const vectors: [string, string][] = [
+      ['', `0x${'00'.repeat(32)}`],
+      [
+        'eth',
+        '0x93cdeb708b7545dc668eb9280176169d1c33cfd8ed6f04690a0bcc88a93fc4ae',
+      ],
+      [
+        'foo.eth',
+        '0xde9b09fd7c5f901e23a3f19fecc54828e9c848539801e86591bd9801b019f84f',
+      ],
+    ];
+    const failed = vectors.filter(([input, node]) => namehash(input) !== node);
+    const success = failed.length === 0;
+    return {
+      name,
+      success,
+      message: success
+        ? `✓ ${vectors.length} vectors match`
+        : `✗ Mismatch for ${failed.map(([input]) => `'${input}'`).join()}`,
+    };
+  } catch (error) {
+    return { name, success: false, message: `✗ Unexpected error: ${error}` };
+  }
+}
+
+// Batches share parent nodes; results must not depend on order or sharing
+function testBatchMatchesSingle(): TestResult {
+  const name = 'Batch matches single-name hashing';
+  try {
+    const names = [
+      'vitalik.eth',
+      'eth',
+      'sub.vitalik.eth',
+      'vitalik.eth',
+      '',
+      'a.b.c.base.eth',
+      'c.base.eth',
+      'wallet.metamask.xyz',
+      '🦊.eth',
+    ];
+    const batch = namehashMany(names);
+    const mismatch = names.findIndex(
+      (input, i) =>
+        batch[i] !== namehash(input) || batch[i] !== jsNamehash(input),
+    );
+    const success = batch.length === names.length && mismatch === -1;
+    return {
+      name,
+      success,
+      message: success
+        ? `✓ ${names.length} names match`
+        : `✗ Mismatch for '${names[mismatch]}'`,
+    };
+  } catch (error) {
+    return { name, success: false, message: `✗ Unexpected error: ${error}` };
+  }
+}
+
+// Empty labels are rejected
+function testRejectsEmptyLabels(): TestResult {
+  const name = 'Rejects empty labels';
+  const invalid = ['.eth', 'eth.', 'foo..eth', '.'];
+  const accepted = invalid.filter((input) => {
+    try {
+      namehash(input);
+      return true;
+    } catch {
+      return false;
+    }
+  });
+  let batchRejected = false;
+  try {
+    namehashMany(['foo.eth', '.foo.eth']);
+  } catch {
+    batchRejected = true;
+  }
+  const success = accepted.length === 0 && batchRejected;
+  return {
+    name,
+    success,
+    message: success
+      ? `✓ ${invalid.length} names rejected`
+      : `✗ Accepted ${accepted.join(', ') || 'batch'}`,
+  };
+}
+
+// An address book's worth of names, native batch vs JS
+function testAddressBookPerformance(): TestResult {
+  const name = 'Hashes 1000 names faster than JS';
+  try {
+    const names = Array.from(
+      { length: 1000 },
+      (_, i) => `account${i}.${i % 2 ? 'eth' : 'wallet.eth'}`,
+    );
+
+    let start = Date.now();
+    const batch = namehashMany(names);
+    const nativeTime = Date.now() - start;
+
+    start = Date.now();
+    const expected = names.map(jsNamehash);
+    const jsTime = Date.now() - start;
+
+    const success = batch.every((node, i) => node === expected[i]);
+    return {
+      name,
+      success,
+      message: success
+        ? `✓ Native ${nativeTime}ms, JS ${jsTime}ms`
+        : '✗ Batch differs from JS reference',
+      duration: nativeTime,
+    };
+  } catch (error) {
+    return { name, success: false, message: `✗ Unexpected error: ${error}` };
+  }
+}
+
+// Run all ENS tests
+export function runAllEnsTests(): TestResult[] {
+  return [
+    testKnownVectors(),
+    testBatchMatchesSingle(),
+    testRejectsEmptyLabels(),
+    testAddressBookPerformance(),
+  ];
+}
@@ -0,0 +1,144 @@
+import {
+  parseExtendedKeys,
+  serializeExtendedKeys,
+} from '@metamask/native-utils';
+import { type TestResult } from '../testUtils';
+
+// BIP32 test vector 1: m, then m/0H
+const VECTOR_1 = [
+  {
+    encoded:
+      'xpub661MyMwAqRbcFtXgS5sYJABqqG9YLmC4Q1Rdap9gSE8NqtwybGhePY2gZ29ESFjqJoCu1Rupje8YtGqsefD265TMg7usUDFdp6W1EGMcet8',
+    fingerprint: 0x3442193e,
+  },
+  {
+    encoded:
+      'xprv9s21ZrQH143K3QTDL4LXw2F7HEK3wJUD2nW2nRk4stbPy6cq3jPPqjiChkVvvNKmPGJxWUtg6LnF5kejMRNNU3TGtRBeJgk33yuGBxrMPHi',
+    fingerprint: 0x3442193e,
+  },
+  {
+    encoded:
+      'xpub68Gmy5EdvgibQVfPdqkBBCHxA5htiqg55crXYuXoQRKfDBFA1WEjWgP6LHhwBZeNK1VTsfTFUHCdrfp1bgwQ9xv5ski8PX9rL2dZXvgGDnw',
+    fingerprint: 0x5c1bd648,
+  },
+  {
+    encoded:
+      'xprv9uHRZZhk6KAJC1avXpDAp4MDc3sQKNxDiPvvkX8Br5ngLNv1TxvUxt4cV1rGL5hj6KCesnDYUhd7oWgT11eZG7XnxHrnYeSvkzY7d2bhkJ7',
+    fingerprint: 0x5c1bd648,
+  },
+];
+
+// BIP32 test vector 5, plus a broken checksum
+const INVALID = [
+  // Public key with a 0x04 prefix
+  'xpub661MyMwAqRbcEYS8w7XLSVeEsBXy79zSzH1J8vCdxAZningWLdN3zgtU6Txnt3siSujt9RCVYsx4qHZGc62TG4McvMGcAUjeuwZdduYEvFn',
+  // Private key with a 0x04 prefix
+  'xprv9s21ZrQH143K24Mfq5zL5MhWK9hUhhGbd45hLXo2Pq2oqzMMo63oStZzFGpWnsj83BHtEy5Zt8CcDr1UiRXuWCmTQLxEK9vbz5gPstX92JQ',
+  // Depth 0 with a parent fingerprint
+  'xprv9s2SPatNQ9Vc6GTbVMFPFo7jsaZySyzk7L8n2uqKXJen3KUmvQNTuLh3fhZMBoG3G4ZW1N2kZuHEPY53qmbZzCHshoQnNf4GvELZfqTUrcv',
+  // Depth 0 with a child number
+  'xpub661MyMwAuDcm6CRQ5N4qiHKrJ39Xe1R1NyfouMKTTWcguwVcfrZJaNvhpebzGerh7gucBvzEQWRugZDuDXjNDRmXzSZe4c7mnTK97pTvGS8',
+  // Unknown version
+  'DMwo58pR1QLEFihHiXPVykYB6fJmsTeHvyTp7hRThAtCX8CvYzgPcn8XnmdfHGMQzT7ayAmfo4z3gY5KfbrZWZ6St24UVf2Qgo6oujFktLHdHY4',
+  // Private key equal to the group order
+  'xprv9s21ZrQH143K24Mfq5zL5MhWK9hUhhGbd45hLXo2Pq2oqzMMo63oStZzFAzHGBP2UuGCqWLTAPLcMtD5SDKr24z3aiUvKr9bJpdrcLg1y3G',
+  // Public key off the curve
+  'xpub661MyMwAqRbcEYS8w7XLSVeEsBXy79zSzH1J8vCdxAZningWLdN3zgtU6Q5JXayek4PRsn35jii4veMimro1xefsM58PgBMrvdYre8QyULY',
+  // Bad checksum
+  'xprv9s21ZrQH143K3QTDL4LXw2F7HEK3wJUD2nW2nRk4stbPy6cq3jPPqjiChkVvvNKmPGJxWUtg6LnF5kejMRNNU3TGtRBeJgk33yuGBxrMPHL',
+  // Not base58
+  'xpub0OIl',
+];
+
+// Test vector keys parse with the right fingerprints and serialize back
+function testVectors(): TestResult {
+  const name = 'BIP32 vector 1 round trip';
+  try {
+    const parsed = parseExtendedKeys(VECTOR_1.map((v) => v.encoded));
+    const failures: string[] = [];
+    parsed.forEach((key, i) => {
+      if (!key || key.fingerprint !== VECTOR_1[i]!.fingerprint) {
+        failures.push(`fingerprint ${i}`);
+      }
+    });
+    // The child's parent fingerprint is the master's fingerprint
+    if (parsed[2]?.parentFingerprint !== parsed[0]?.fingerprint) {
+      failures.push('parent fingerprint');
+    }
+    if (parsed.every(Boolean)) {
+      const encoded = serializeExtendedKeys(parsed.map((key) => key!));
+      encoded.forEach((text, i) => {
+        if (text !== VECTOR_1[i]!.encoded) {
+          failures.push(`encoding ${i}`);
+        }
+      });
+    }
+    const success = failures.length === 0;
+    return {
+      name,
+      success,
+      message: success
+        ? `✓ ${VECTOR_1.length} keys match`
+        : `✗ Mismatch: ${failures.join(', ')}`,
+    };
+  } catch (error) {
+    return { name, success: false, message: `✗ Unexpected error: ${error}` };
+  }
+}
+
+// Invalid keys parse to null without failing the rest of the batch
+function testInvalid(): TestResult {
+  const name = 'Rejects invalid extended keys';
+  try {
+    const parsed = parseExtendedKeys([...INVALID, VECTOR_1[0]!.encoded]);
+    const accepted = INVALID.filter((_, i) => parsed[i] !== null);
+    const success = accepted.length === 0 && parsed[INVALID.length] !== null;
+    return {
+      name,
+      success,
+      message: success
+        ? `✓ ${INVALID.length} invalid keys rejected`
+        : `✗ Accepted ${accepted.join(', ')}`,
+    };
+  } catch (error) {
+    return { name, success: false, message: `✗ Unexpected error: ${error}` };
+  }
+}
+
+// Serializing a key that would not parse throws
+function testSerializeErrors(): TestResult {
+  const name = 'Serialize rejects invalid keys';
+  const [master] = parseExtendedKeys([VECTOR_1[1]!.encoded]);
+  const errors: string[] = [];
+  const expectThrow = (label: string, fn: () => unknown) => {
+    try {
+      fn();
+      errors.push(`${label} did not throw`);
+    } catch {
+      // Expected
+    }
+  };
+  if (!master) {
+    return { name, success: false, message: '✗ Master key did not parse' };
+  }
+  expectThrow('zero private key', () =>
+    serializeExtendedKeys([{ ...master, key: new Uint8Array(32) }]),
+  );
+  expectThrow('public version with a private key', () =>
+    serializeExtendedKeys([{ ...master, version: 'xpub' }]),
+  );
+  expectThrow('master with a child number', () =>
+    serializeExtendedKeys([{ ...master, childNumber: 1 }]),
+  );
+  const success = errors.length === 0;
+  return {
+    name,
+    success,
+    message: success ? '✓ All rejected' : `✗ ${errors.join(', ')}`,
+  };
+}
+
+// Run all extended key tests
+export function runAllExtendedKeyTests(): TestResult[] {
+  return [testVectors(), testInvalid(), testSerializeErrors()];
+}
@@ -0,0 +1,117 @@
+import {
+  createHasher,
+  hash,
+  hashMany,
+  type HashAlgorithm,
+} from '@metamask/native-utils';
+import hashVectors from '../vectors/hashes.json';
+import {
+  hexToUint8Array,
+  uint8ArrayToHex,
+  type TestResult,
+} from '../testUtils';
+
+const ALGORITHMS: HashAlgorithm[] = [
+  'sha256',
+  'sha512',
+  'sha3_256',
+  'keccak256',
+  'ripemd160',
+  'blake2b256',
+  'blake2b512',
+];
+
+const MESSAGES = hashVectors.vectors.map(({ data }) => hexToUint8Array(data));
+
+// One-shot digests of every algorithm
+function testVectors(): TestResult {
+  const name = 'Matches vectors for every algorithm';
+  try {
+    const failed = ALGORITHMS.filter((algorithm) =>
+      hashVectors.vectors.some(
+        (vector, i) =>
+          uint8ArrayToHex(hash(algorithm, MESSAGES[i]!)) !== vector[algorithm],
+      ),
+    );
+    const success = failed.length === 0;
+    return {
+      name,
+      success,
+      message: success
+        ? `✓ ${ALGORITHMS.length} algorithms match`
+        : `✗ Mismatch for ${failed.join(', ')}`,
+    };
+  } catch (error) {
+    return { name, success: false, message: `✗ Unexpected error: ${error}` };
+  }
+}
+
+// A batch large enough to be hashed in parallel, with messages of varying
+// length including empty ones
+function testHashMany(): TestResult {
+  const name = 'hashMany matches hash';
+  try {
+    const items = Array.from({ length: 2000 }, (_, i) =>
+      new Uint8Array(i % 200).fill(i & 0xff),
+    );
+    const failed = ALGORITHMS.filter((algorithm) => {
+      const digests = hashMany(algorithm, items);
+      return items.some(
+        (item, i) =>
+          uint8ArrayToHex(digests[i]!) !==
+          uint8ArrayToHex(hash(algorithm, item)),
+      );
+    });
+    const success = failed.length === 0 && hashMany('sha256', []).length === 0;
+    return {
+      name,
+      success,
+      message: success
+        ? `✓ ${items.length} items for ${ALGORITHMS.length} algorithms`
+        : `✗ Mismatch for ${failed.join(', ')}`,
+    };
+  } catch (error) {
+    return { name, success: false, message: `✗ Unexpected error: ${error}` };
+  }
+}
+
+// Data fed in uneven parts, and a hasher reused after digest() and reset()
+function testIncremental(): TestResult {
+  const name = 'Incremental hashing matches one-shot';
+  try {
+    const message = MESSAGES[2]!;
+    const failed = ALGORITHMS.filter((algorithm) => {
+      const hasher = createHasher(algorithm);
+      hasher.update(new Uint8Array([1, 2, 3]).buffer);
+      hasher.reset();
+      for (let offset = 0; offset < message.length; offset += 77) {
+        hasher.update(message.slice(offset, offset + 77).buffer);
+      }
+      const first = uint8ArrayToHex(new Uint8Array(hasher.digest()));
+      hasher.update(message.slice().buffer);
+      const second = uint8ArrayToHex(new Uint8Array(hasher.digest()));
+      const expected = uint8ArrayToHex(hash(algorithm, message));
+      return (
+        first !== expected ||
+        second !== expected ||
+        hasher.algorithm !== algorithm ||
+        hasher.outputSize !== (expected.length - 2) / 2
+      );
+    });
+    const success = failed.length === 0;
+    return {
+      name,
+      success,
+      message: success
+        ? `✓ ${ALGORITHMS.length} algorithms match`
+        : `✗ Mismatch for ${failed.join(', ')}`,
+    };
+  } catch (error) {
+    return { name, success: false, message: `✗ Unexpected error: ${error}` };
+  }
+}
+
+// Run all hash registry tests
+export function runAllHashTests(): TestResult[] {
+  return [testVectors(), testHashMany(), testIncremental()];
+}
@@ -0,0 +1,137 @@
+import {
+  addKeyringKeys,
+  createKeyring,
+  getKeyringAddresses,
+  publicKeyByAddress,
+  signByAddress,
+} from '@metamask/native-utils';
+import { secp256k1 } from '@noble/curves/secp256k1';
+import { keccak_256 } from '@noble/hashes/sha3';
+import {
+  hexToUint8Array,
+  randomBytes,
+  uint8ArrayToHex,
+  type TestResult,
+} from '../testUtils';
+
+function nobleAddress(privateKey: Uint8Array): string {
+  const publicKey = secp256k1.getPublicKey(privateKey, false);
+  return uint8ArrayToHex(keccak_256(publicKey.subarray(1)).subarray(12));
+}
+
+// Addresses, public keys and signatures of random keys, against noble
+function testMatchesNoble(): TestResult {
+  const name = 'Keyring matches noble';
+  try {
+    const keys = Array.from({ length: 50 }, () =>
+      secp256k1.utils.randomPrivateKey(),
+    );
+    const expected = keys.map(nobleAddress);
+    const keyring = createKeyring(keys.map((key) => key.slice()));
+    const addresses = getKeyringAddresses(keyring);
+    const failures: string[] = [];
+    if (addresses.join() !== expected.join()) {
+      failures.push('addresses');
+    }
+    keys.forEach((key, i) => {
+      const address = expected[i]!;
+      const hash = randomBytes(32);
+      const signature = secp256k1.sign(hash, key);
+      const nobleSignature = new Uint8Array([
+        ...signature.toCompactRawBytes(),
+        signature.recovery,
+      ]);
+      if (
+        uint8ArrayToHex(signByAddress(keyring, address, hash)) !==
+        uint8ArrayToHex(nobleSignature)
+      ) {
+        failures.push(`signature ${i}`);
+      }
+      if (
+        uint8ArrayToHex(publicKeyByAddress(keyring, address)) !==
+          uint8ArrayToHex(secp256k1.getPublicKey(key, true)) ||
+        uint8ArrayToHex(publicKeyByAddress(keyring, address, false)) !==
+          uint8ArrayToHex(secp256k1.getPublicKey(key, false))
+      ) {
+        failures.push(`public key ${i}`);
+      }
+    });
+    const success = failures.length === 0 && keyring.size === keys.length;
+    return {
+      name,
+      success,
+      message: success
+        ? `✓ ${keys.length} accounts match`
+        : `✗ Mismatch: ${failures.join(', ')}`,
+    };
+  } catch (error) {
+    return { name, success: false, message: `✗ Unexpected error: ${error}` };
+  }
+}
+
+// Duplicate keys are kept once, and removal keeps the order of the rest
+function testAddAndRemove(): TestResult {
+  const name = 'Adds once and removes in place';
+  try {
+    const keys = Array.from({ length: 4 }, () =>
+      secp256k1.utils.randomPrivateKey(),
+    );
+    const keyring = createKeyring(keys.slice(0, 3).map((key) => key.slice()));
+    const added = addKeyringKeys(keyring, [keys[1]!.slice(), keys[3]!.slice()]);
+    const addresses = keys.map(nobleAddress);
+    // The same address twice counts once
+    const removed = keyring.removeAccounts(
+      hexToUint8Array(addresses[1]! + addresses[1]!.slice(2)).buffer,
+    );
+    const remaining = getKeyringAddresses(keyring).join();
+    const success =
+      added.join() === [addresses[1], addresses[3]].join() &&
+      removed === 1 &&
+      remaining === [addresses[0], addresses[2], addresses[3]].join();
+    return {
+      name,
+      success,
+      message: success
+        ? '✓ Duplicate kept once, removal kept order'
+        : `✗ Added ${added.length}, removed ${removed}, left ${remaining}`,
+    };
+  } catch (error) {
+    return { name, success: false, message: `✗ Unexpected error: ${error}` };
+  }
+}
+
+// Bad keys add nothing, unknown addresses throw
+function testErrors(): TestResult {
+  const name = 'Rejects invalid keys and unknown addresses';
+  const keyring = createKeyring();
+  const errors: string[] = [];
+  const expectThrow = (label: string, fn: () => unknown) => {
+    try {
+      fn();
+      errors.push(`${label} did not throw`);
+    } catch {
+      // Expected
+    }
+  };
+  expectThrow('zero key', () =>
+    addKeyringKeys(keyring, [randomBytes(32), new Uint8Array(32)]),
+  );
+  expectThrow('short key', () => addKeyringKeys(keyring, [randomBytes(31)]));
+  expectThrow('unknown address', () =>
+    signByAddress(keyring, randomBytes(20), randomBytes(32)),
+  );
+  if (keyring.size !== 0) {
+    errors.push(`${keyring.size} accounts added`);
+  }
+  const success = errors.length === 0;
+  return {
+    name,
+    success,
+    message: success ? '✓ All rejected' : `✗ ${errors.join(', ')}`,
+  };
+}
+
+// Run all keyring tests
+export function runAllKeyringTests(): TestResult[] {
+  return [testMatchesNoble(), testAddAndRemove(), testErrors()];
+}
@@ -0,0 +1,285 @@
+import {
+  createLogFilter,
+  filterLogs,
+  packLogs,
+  type RpcLog,
+} from '@metamask/native-utils';
+import { uint8ArrayToHex, type TestResult } from '../testUtils';
+
+const TRANSFER_TOPIC =
+  '0xddf252ad1be2c89b69c2b068fc378daa952ba7f163c4a11628f55a4df523b3ef';
+const APPROVAL_TOPIC =
+  '0x8c5be1e5ebec7d5bd14f71427d1e84f3dd0314c0f7b2291e5b200ac8c7c3b925';
+const TOKEN = '0xa0b86991c6218b36c1d19d4a2e9eb0ce3606eb48';
+const ALICE = '0x1111111111111111111111111111111111111111';
+const BOB = '0x2222222222222222222222222222222222222222';
+
+function addressTopic(address: string): string {
+  return `0x${'0'.repeat(24)}${address.slice(2)}`;
+}
+
+function word(value: bigint): string {
+  const twos = value < 0n ? (1n << 256n) + value : value;
+  return `0x${twos.toString(16).padStart(64, '0')}`;
+}
+
+const ERC20_TRANSFER: RpcLog = {
+  address: TOKEN,
+  topics: [TRANSFER_TOPIC, addressTopic(ALICE), addressTopic(BOB)],
+  data: word(1_500_000n),
+};
+
+const ERC721_TRANSFER: RpcLog = {
+  address: TOKEN,
+  topics: [
+    TRANSFER_TOPIC,
+    addressTopic(BOB),
+    addressTopic(ALICE),
+    word(42n),
+  ],
+  data: '0x',
+};
+
+const APPROVAL: RpcLog = {
+  address: TOKEN,
+  topics: [APPROVAL_TOPIC, addressTopic(ALICE), addressTopic(BOB)],
+  data: word(2n ** 256n - 1n),
+};
+
+const UNRELATED: RpcLog = {
+  address: TOKEN,
+  topics: [word(7n)],
+  data: word(1n),
+};
+
+// Signatures hash to the well-known topic0 values
+function testTopicHashes(): TestResult {
+  const name = 'Event signatures hash to topic0';
+  try {
+    const filter = createLogFilter([
+      'event Transfer(address indexed from, address indexed to, uint256 value)',
+      'Approval(address indexed,address indexed,uint)',
+    ]);
+    const topics = filter.events.map((event) =>
+      uint8ArrayToHex(new Uint8Array(event.topic)),
+    );
+    const success =
+      topics[0] === TRANSFER_TOPIC &&
+      topics[1] === APPROVAL_TOPIC &&
+      filter.events[1]!.signature === 'Approval(address,address,uint256)';
+    return {
+      name,
+      success,
+      message: success ? '✓ Transfer and Approval match' : `✗ Got ${topics}`,
+    };
+  } catch (error) {
+    return { name, success: false, message: `✗ Unexpected error: ${error}` };
+  }
+}
+
+// ERC-20 and ERC-721 Transfer share topic0 but differ in indexed layout
+function testDecodesByLayout(): TestResult {
+  const name = 'Decodes ERC-20 and ERC-721 transfers';
+  try {
+    const filter = createLogFilter([
+      'event Transfer(address indexed from, address indexed to, uint256 value)',
+      'event Transfer(address indexed from, address indexed to, uint256 indexed tokenId)',
+      'event Approval(address indexed owner, address indexed spender, uint256 value)',
+    ]);
+    const decoded = filterLogs(filter, [
+      UNRELATED,
+      ERC20_TRANSFER,
+      ERC721_TRANSFER,
+      APPROVAL,
+    ]);
+
+    const [erc20, erc721, approval] = decoded;
+    const success =
+      decoded.length === 3 &&
+      erc20?.logIndex === 1 &&
+      erc20.args.from === ALICE &&
+      erc20.args.to === BOB &&
+      erc20.args.value === 1_500_000n &&
+      erc721?.logIndex === 2 &&
+      erc721.args.tokenId === 42n &&
+      erc721.args.from === BOB &&
+      approval?.event === 'Approval' &&
+      approval.args.value === 2n ** 256n - 1n;
+    return {
+      name,
+      success,
+      message: success
+        ? '✓ 3 of 4 logs matched and decoded'
+        : `✗ Got ${JSON.stringify(decoded, (_, v) =>
+            typeof v === 'bigint' ? v.toString() : v,
+          )}`,
+    };
+  } catch (error) {
+    return { name, success: false, message: `✗ Unexpected error: ${error}` };
+  }
+}
+
+// Signed, boolean and fixed-bytes parameters; dynamic parameters are skipped
+function testValueTypes(): TestResult {
+  const name = 'Decodes int, bool and bytesN parameters';
+  try {
+    const filter = createLogFilter([
+      'event Sample(int24 indexed tick, string note, bool flag, bytes4 tag)',
+    ]);
+    const topic = uint8ArrayToHex(new Uint8Array(filter.events[0]!.topic));
+    const data =
+      word(96n) + // offset of `note`
+      word(1n).slice(2) +
+      `deadbeef${'0'.repeat(56)}` +
+      word(0n).slice(2);
+    const [log] = filterLogs(filter, [
+      { address: TOKEN, topics: [topic, word(-5n)], data },
+    ]);
+    const success =
+      log?.args.tick === -5n &&
+      log.args.flag === true &&
+      log.args.tag === '0xdeadbeef' &&
+      !('note' in log.args);
+    return {
+      name,
+      success,
+      message: success ? '✓ Parameters decoded' : '✗ Unexpected arguments',
+    };
+  } catch (error) {
+    return { name, success: false, message: `✗ Unexpected error: ${error}` };
+  }
+}
+
+// Anonymous events have no topic0; indexed parameters start at topic 0
+function testAnonymousEvents(): TestResult {
+  const name = 'Matches anonymous events by layout';
+  try {
+    const filter = createLogFilter([
+      'event Transfer(address indexed from, address indexed to, uint256 value)',
+      'event Deposit(address indexed account, address indexed token, uint256 amount) anonymous',
+    ]);
+    const deposit: RpcLog = {
+      address: TOKEN,
+      topics: [addressTopic(BOB), addressTopic(TOKEN)],
+      data: word(7n),
+    };
+    const decoded = filterLogs(filter, [
+      UNRELATED,
+      ERC20_TRANSFER,
+      deposit,
+      APPROVAL,
+    ]);
+    const [transfer, anonymous] = decoded;
+    const success =
+      filter.events[1]!.topic.byteLength === 0 &&
+      decoded.length === 2 &&
+      transfer?.event === 'Transfer' &&
+      anonymous?.logIndex === 2 &&
+      anonymous.event === 'Deposit' &&
+      anonymous.args.account === BOB &&
+      anonymous.args.token === TOKEN &&
+      anonymous.args.amount === 7n;
+    return {
+      name,
+      success,
+      message: success
+        ? '✓ Named and anonymous events told apart'
+        : `✗ Got ${JSON.stringify(decoded, (_, v) =>
+            typeof v === 'bigint' ? v.toString() : v,
+          )}`,
+    };
+  } catch (error) {
+    return { name, success: false, message: `✗ Unexpected error: ${error}` };
+  }
+}
+
+// Throughput over a large packed batch
+function testLargeBatch(): TestResult {
+  const name = 'Filters 20k packed logs';
+  try {
+    const filter = createLogFilter([
+      'event Transfer(address indexed from, address indexed to, uint256 value)',
+    ]);
+    const logs = Array.from({ length: 20000 }, (_, i) =>
+      i % 4 === 0 ? ERC20_TRANSFER : i % 4 === 1 ? APPROVAL : UNRELATED,
+    );
+    const packed = packLogs(logs);
+    const start = Date.now();
+    const decoded = filterLogs(filter, packed);
+    const duration = Date.now() - start;
+    const success =
+      decoded.length === 5000 && decoded.every((log) => log.logIndex % 4 === 0);
+    return {
+      name,
+      success,
+      message: success
+        ? `✓ ${decoded.length} matches in ${duration}ms`
+        : `✗ ${decoded.length} matches`,
+      duration,
+    };
+  } catch (error) {
+    return { name, success: false, message: `✗ Unexpected error: ${error}` };
+  }
+}
+
+// Malformed signatures and logs are rejected
+function testRejectsInvalidInput(): TestResult {
+  const name = 'Rejects malformed signatures and logs';
+  const attempts: [string, () => unknown][] = [
+    ['unknown type', () => createLogFilter(['Foo(uint7 x)'])],
+    ['unbalanced', () => createLogFilter(['Foo(address'])],
+    ['trailing text', () => createLogFilter(['Foo(address) garbage'])],
+    [
+      'anonymous function',
+      () => createLogFilter(['function foo(uint) anonymous']),
+    ],
+    [
+      'four indexed',
+      () =>
+        createLogFilter([
+          'Foo(uint indexed,uint indexed,uint indexed,uint indexed)',
+        ]),
+    ],
+    [
+      'oversized array',
+      () => createLogFilter(['Foo(uint256[999999][999999])']),
+    ],
+    [
+      'oversized head',
+      () =>
+        createLogFilter(['Foo(uint256[999999][100],uint256[999999][100])']),
+    ],
+    [
+      'short topic',
+      () => packLogs([{ address: TOKEN, topics: ['0x01'], data: '0x' }]),
+    ],
+  ];
+  const accepted = attempts.filter(([, attempt]) => {
+    try {
+      attempt();
+      return true;
+    } catch {
+      return false;
+    }
+  });
+  return {
+    name,
+    success: accepted.length === 0,
+    message:
+      accepted.length === 0
+        ? '✓ All malformed inputs rejected'
+        : `✗ Accepted: ${accepted.map(([label]) => label).join(', ')}`,
+  };
+}
+
+// Run all log filter tests
+export function runAllLogFilterTests(): TestResult[] {
+  return [
+    testTopicHashes(),
+    testDecodesByLayout(),
+    testValueTypes(),
+    testAnonymousEvents(),
+    testLargeBatch(),
+    testRejectsInvalidInput(),
+  ];
+}
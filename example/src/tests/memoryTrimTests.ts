@@ -0,0 +1,153 @@
+import {
+  createKeyring,
+  createPipeline,
+  getCacheUsage,
+  getPublicKeyEd25519,
+  setCacheBudget,
+  trimMemory,
+} from '@metamask/native-utils';
+import type { TestResult } from '../testUtils';
+
+function makeKeys(count: number): ArrayBuffer {
+  const keys = new Uint8Array(count * 32);
+  for (let i = 0; i < keys.length; i++) {
+    keys[i] = (i * 13 + 1) & 0xff;
+  }
+  for (let i = 0; i < count; i++) {
+    keys[i * 32] = 0x01;
+  }
+  return keys.buffer;
+}
+
+// Distinct valid keys, so a keyring keeps one account per key
+function makeDistinctKeys(count: number): ArrayBuffer {
+  const keys = new Uint8Array(count * 32).fill(0x5a);
+  for (let i = 0; i < count; i++) {
+    keys[i * 32] = 0x01;
+    new DataView(keys.buffer).setUint32(i * 32 + 1, i);
+  }
+  return keys.buffer;
+}
+
+function findOverBudget(): string | null {
+  const over = getCacheUsage().find((cache) => cache.bytes > cache.budgetBytes);
+  return over ? `${over.name}: ${over.bytes} > ${over.budgetBytes}` : null;
+}
+
+// Every cache reports a byte budget
+function testUsageReported(): TestResult {
+  const name = 'Caches report usage and budgets';
+  try {
+    const usage = getCacheUsage();
+    const valid =
+      usage.length > 0 &&
+      usage.every((cache) => cache.bytes >= 0 && cache.budgetBytes > 0);
+    return {
+      name,
+      success: valid,
+      message: valid
+        ? `✓ ${usage.map((cache) => cache.name).join(', ')}`
+        : `✗ Unexpected usage: ${JSON.stringify(usage)}`,
+    };
+  } catch (error) {
+    return { name, success: false, message: `✗ Unexpected error: ${error}` };
+  }
+}
+
+// Caches stay within a configured budget while batches of varying size churn
+// secure memory. The budget is well below what the secure arena can hold
+// (1 MiB of chunks and 256 KiB of spare mappings): a cleared 2500-account
+// keyring alone leaves two idle chunks, 128 KiB, so without enforcement the
+// load goes over it.
+function testBudgetsUnderLoad(): TestResult {
+  const name = 'Caches stay within budget under load';
+  const arena = getCacheUsage().find((cache) => cache.name === 'secureArena');
+  if (!arena) {
+    return { name, success: false, message: '✗ No secureArena cache' };
+  }
+  try {
+    const budget = setCacheBudget('secureArena', 96 * 1024);
+    if (budget !== 96 * 1024) {
+      return { name, success: false, message: `✗ Budget set to ${budget}` };
+    }
+    const pipeline = createPipeline(
+      ['secp256k1PublicKeyCompressed', 'keccak256'],
+      32,
+    );
+    for (let round = 0; round < 40; round++) {
+      pipeline.run(makeKeys(1 + ((round * 37) % 700)));
+      getPublicKeyEd25519('01'.repeat(32));
+      if (round % 8 === 0) {
+        const keyring = createKeyring();
+        keyring.addKeys(makeDistinctKeys(2500));
+        keyring.clear();
+      }
+
+      const over = findOverBudget();
+      if (over) {
+        return { name, success: false, message: `✗ Round ${round}: ${over}` };
+      }
+    }
+    return { name, success: true, message: '✓ All caches within budget' };
+  } catch (error) {
+    return { name, success: false, message: `✗ Unexpected error: ${error}` };
+  } finally {
+    setCacheBudget('secureArena', arena.budgetBytes);
+  }
+}
+
+// Critical trimming releases idle memory and never grows a cache
+function testCriticalTrim(): TestResult {
+  const name = 'Critical trim releases memory';
+  try {
+    createPipeline(['hexEncode'], 4096).run(new ArrayBuffer(4096 * 8));
+    const before = getCacheUsage();
+    const released = trimMemory('critical');
+    const after = getCacheUsage();
+
+    const grown = after.find((cache) => {
+      const previous = before.find((entry) => entry.name === cache.name);
+      return previous !== undefined && cache.bytes > previous.bytes;
+    });
+    const success = released >= 0 && grown === undefined;
+    return {
+      name,
+      success,
+      message: success
+        ? `✓ Released ${released} bytes`
+        : `✗ Released ${released}, grown: ${grown?.name}`,
+    };
+  } catch (error) {
+    return { name, success: false, message: `✗ Unexpected error: ${error}` };
+  }
+}
+
+// Raw Android onTrimMemory levels are accepted
+function testAndroidLevels(): TestResult {
+  const name = 'Accepts Android onTrimMemory levels';
+  try {
+    const results = [5, 10, 15, 20, 40, 60, 80].map((level) =>
+      trimMemory(level),
+    );
+    const success = results.every((bytes) => bytes >= 0);
+    return {
+      name,
+      success,
+      message: success
+        ? `✓ Released ${results.join(', ')} bytes`
+        : `✗ Unexpected results: ${results.join(', ')}`,
+    };
+  } catch (error) {
+    return { name, success: false, message: `✗ Unexpected error: ${error}` };
+  }
+}
+
+// Run all memory trim tests
+export function runAllMemoryTrimTests(): TestResult[] {
+  return [
+    testUsageReported(),
+    testBudgetsUnderLoad(),
+    testCriticalTrim(),
+    testAndroidLevels(),
+  ];
+}
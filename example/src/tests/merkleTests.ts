@@ -0,0 +1,202 @@
+import {
+  buildMerkleTree,
+  getMerkleProof,
+  verifyMerkleProofs,
+  type MerkleLeafHash,
+} from '@metamask/native-utils';
+import { keccak_256 } from '@noble/hashes/sha3';
+import type { TestResult } from '../testUtils';
+
+function compareBytes(a: Uint8Array, b: Uint8Array): number {
+  for (let i = 0; i < a.length; i++) {
+    if (a[i] !== b[i]) {
+      return a[i]! - b[i]!;
+    }
+  }
+  return 0;
+}
+
+function hashPair(a: Uint8Array, b: Uint8Array): Uint8Array {
+  const input = new Uint8Array(64);
+  const [low, high] = compareBytes(a, b) <= 0 ? [a, b] : [b, a];
+  input.set(low);
+  input.set(high, 32);
+  return keccak_256(input);
+}
+
+// Reference of @openzeppelin/merkle-tree's makeMerkleTree
+function jsMerkleTree(
+  leaves: Uint8Array[],
+  leafHash: MerkleLeafHash,
+): Uint8Array[] {
+  const hashes = leaves.map((leaf) =>
+    leafHash === 'none'
+      ? leaf
+      : leafHash === 'keccak256'
+        ? keccak_256(leaf)
+        : keccak_256(keccak_256(leaf)),
+  );
+  hashes.sort(compareBytes);
+  const tree = new Array<Uint8Array>(2 * hashes.length - 1);
+  hashes.forEach((hash, i) => {
+    tree[tree.length - 1 - i] = hash;
+  });
+  for (let i = tree.length - 1 - hashes.length; i >= 0; i--) {
+    tree[i] = hashPair(tree[2 * i + 1]!, tree[2 * i + 2]!);
+  }
+  return tree;
+}
+
+// abi.encode(address, uint256)-sized leaves
+function makeLeaves(count: number): Uint8Array[] {
+  return Array.from({ length: count }, (_, i) => {
+    const leaf = new Uint8Array(64);
+    leaf.fill(i & 0xff, 12, 32);
+    new DataView(leaf.buffer).setUint32(60, i * 1000 + 1);
+    return leaf;
+  });
+}
+
+function bitAt(bitmap: Uint8Array, index: number): boolean {
+  return (bitmap[index >> 3]! & (1 << (index & 7))) !== 0;
+}
+
+// Roots and node layout match OpenZeppelin for every leaf hashing mode
+async function testMatchesOpenZeppelinLayout(): Promise<TestResult> {
+  const name = 'Matches OpenZeppelin tree layout';
+  try {
+    const cases: [number, MerkleLeafHash][] = [
+      [1, 'doubleKeccak256'],
+      [2, 'doubleKeccak256'],
+      [5, 'keccak256'],
+      [8, 'none'],
+      [13, 'doubleKeccak256'],
+      [100, 'keccak256'],
+    ];
+    for (const [count, leafHash] of cases) {
+      const leaves = makeLeaves(count);
+      const input =
+        leafHash === 'none' ? leaves.map((leaf) => keccak_256(leaf)) : leaves;
+      const tree = await buildMerkleTree(input, { leafHash });
+      const nodes = new Uint8Array(tree.getNodes());
+      const expected = jsMerkleTree(input, leafHash);
+      const mismatch = expected.findIndex(
+        (node, i) =>
+          compareBytes(node, nodes.subarray(i * 32, i * 32 + 32)) !== 0,
+      );
+      if (mismatch !== -1 || nodes.length !== expected.length * 32) {
+        return {
+          name,
+          success: false,
+          message: `✗ ${count} leaves (${leafHash}): node ${mismatch} differs`,
+        };
+      }
+    }
+    return { name, success: true, message: `✓ ${cases.length} trees match` };
+  } catch (error) {
+    return { name, success: false, message: `✗ Unexpected error: ${error}` };
+  }
+}
+
+// Proofs from the tree verify in one batch; altered ones do not
+async function testBatchVerify(): Promise<TestResult> {
+  const name = 'Verifies proofs in batch';
+  try {
+    const leaves = makeLeaves(37);
+    const tree = await buildMerkleTree(leaves);
+    const items = leaves.map((leaf, i) => ({
+      leaf,
+      proof: getMerkleProof(tree, i),
+    }));
+    // Wrong leaf for its proof, and a proof with a flipped node
+    items[3] = { leaf: leaves[4]!, proof: items[3]!.proof };
+    const tampered = items[10]!.proof.slice();
+    tampered[0] = `0x${'11'.repeat(32)}`;
+    items[10] = { leaf: leaves[10]!, proof: tampered };
+
+    const bitmap = verifyMerkleProofs(new Uint8Array(tree.root), items);
+    const failed = items.map((_, i) => i).filter((i) => !bitAt(bitmap, i));
+    const success = failed.join() === '3,10';
+    return {
+      name,
+      success,
+      message: success
+        ? '✓ 35 valid, 2 rejected'
+        : `✗ Rejected ${failed.join()}`,
+    };
+  } catch (error) {
+    return { name, success: false, message: `✗ Unexpected error: ${error}` };
+  }
+}
+
+// Input validation
+async function testRejectsInvalidInput(): Promise<TestResult> {
+  const name = 'Rejects invalid leaves';
+  const attempts = [
+    () => buildMerkleTree([]),
+    () => buildMerkleTree([new Uint8Array(64), new Uint8Array(32)]),
+    () => buildMerkleTree([new Uint8Array(64)], { leafHash: 'none' }),
+  ];
+  let rejected = 0;
+  for (const attempt of attempts) {
+    try {
+      await attempt();
+    } catch {
+      rejected++;
+    }
+  }
+  const success = rejected === attempts.length;
+  return {
+    name,
+    success,
+    message: success
+      ? `✓ ${rejected} invalid inputs rejected`
+      : `✗ Only ${rejected} of ${attempts.length} rejected`,
+  };
+}
+
+// Airdrop-sized tree: build, proofs and batch verification
+async function testAirdropPerformance(): Promise<TestResult> {
+  const name = 'Builds and verifies a 20k-leaf airdrop';
+  try {
+    const leaves = makeLeaves(20_000);
+
+    let start = Date.now();
+    const tree = await buildMerkleTree(leaves);
+    const buildTime = Date.now() - start;
+
+    start = Date.now();
+    jsMerkleTree(leaves, 'doubleKeccak256');
+    const jsBuildTime = Date.now() - start;
+
+    const items = leaves.map((leaf, i) => ({
+      leaf,
+      proof: getMerkleProof(tree, i),
+    }));
+    start = Date.now();
+    const bitmap = verifyMerkleProofs(new Uint8Array(tree.root), items);
+    const verifyTime = Date.now() - start;
+
+    const success = items.every((_, i) => bitAt(bitmap, i));
+    return {
+      name,
+      success,
+      message: success
+        ? `✓ Build ${buildTime}ms (JS ${jsBuildTime}ms), verify ${verifyTime}ms`
+        : '✗ Valid proof rejected',
+      duration: buildTime + verifyTime,
+    };
+  } catch (error) {
+    return { name, success: false, message: `✗ Unexpected error: ${error}` };
+  }
+}
+
+// Run all Merkle tree tests
+export async function runAllMerkleTests(): Promise<TestResult[]> {
+  return [
+    await testMatchesOpenZeppelinLayout(),
+    await testBatchVerify(),
+    await testRejectsInvalidInput(),
+    await testAirdropPerformance(),
+  ];
+}
@@ -0,0 +1,154 @@
+import {
+  verifyAccountProof,
+  type EthGetProofResponse,
+} from '@metamask/native-utils';
+import proofVectors from '../vectors/eth-get-proof.json';
+import type { TestResult } from '../testUtils';
+
+const { stateRoot, account, absentAccount } = proofVectors;
+
+// Flip one bit of a hex-encoded proof node
+function tamper(node: string): string {
+  const last = parseInt(node.slice(-2), 16) ^ 1;
+  return node.slice(0, -2) + last.toString(16).padStart(2, '0');
+}
+
+// Account fields and storage values come from the proofs
+function testProvesAccountAndStorage(): TestResult {
+  const name = 'Proves account and storage values';
+  try {
+    const proven = verifyAccountProof(stateRoot, account);
+    const expectedValues = account.storageProof.map(({ value }) =>
+      BigInt(value),
+    );
+    const success =
+      proven.exists &&
+      proven.nonce === BigInt(account.nonce) &&
+      proven.balance === BigInt(account.balance) &&
+      proven.storageHash === account.storageHash &&
+      proven.codeHash === account.codeHash &&
+      proven.storage.every(
+        (slot, i) => slot.valid && slot.value === expectedValues[i],
+      );
+    return {
+      name,
+      success,
+      message: success
+        ? `✓ Account and ${proven.storage.length} slots proven`
+        : `✗ Got ${JSON.stringify(proven, (_, v) =>
+            typeof v === 'bigint' ? v.toString() : v,
+          )}`,
+    };
+  } catch (error) {
+    return { name, success: false, message: `✗ Unexpected error: ${error}` };
+  }
+}
+
+// Exclusion proofs: an unset slot and an account that does not exist
+function testProvesAbsence(): TestResult {
+  const name = 'Proves absent accounts and slots';
+  try {
+    const proven = verifyAccountProof(stateRoot, absentAccount);
+    const unsetSlot = verifyAccountProof(stateRoot, account).storage[3];
+    const success =
+      !proven.exists &&
+      proven.balance === 0n &&
+      unsetSlot?.valid === true &&
+      unsetSlot.value === 0n;
+    return {
+      name,
+      success,
+      message: success
+        ? '✓ Absent account and unset slot proven'
+        : '✗ Exclusion proof not accepted',
+    };
+  } catch (error) {
+    return { name, success: false, message: `✗ Unexpected error: ${error}` };
+  }
+}
+
+// A bad storage proof only invalidates its own slot
+function testRejectsTamperedStorageProof(): TestResult {
+  const name = 'Flags tampered storage proofs';
+  try {
+    const response: EthGetProofResponse = {
+      ...account,
+      storageProof: account.storageProof.map((slot, i) =>
+        i === 1 ? { ...slot, proof: slot.proof.map(tamper) } : slot,
+      ),
+    };
+    const proven = verifyAccountProof(stateRoot, response);
+    const validity = proven.storage.map((slot) => slot.valid);
+    const success =
+      validity.join() === 'true,false,true,true' &&
+      proven.storage[1]?.value === 0n;
+    return {
+      name,
+      success,
+      message: success
+        ? '✓ Only the tampered slot is invalid'
+        : `✗ Validity ${validity.join()}`,
+    };
+  } catch (error) {
+    return { name, success: false, message: `✗ Unexpected error: ${error}` };
+  }
+}
+
+// A bad account proof or the wrong root fails the whole call
+function testRejectsTamperedAccountProof(): TestResult {
+  const name = 'Rejects tampered account proofs';
+  const attempts: [string, EthGetProofResponse][] = [
+    [
+      stateRoot,
+      { ...account, accountProof: account.accountProof.map(tamper) },
+    ],
+    [`0x${'00'.repeat(32)}`, account],
+  ];
+  const accepted = attempts.filter(([root, response]) => {
+    try {
+      verifyAccountProof(root, response);
+      return true;
+    } catch {
+      return false;
+    }
+  });
+  const success = accepted.length === 0;
+  return {
+    name,
+    success,
+    message: success
+      ? `✓ ${attempts.length} invalid proofs rejected`
+      : `✗ Accepted ${accepted.length} invalid proofs`,
+  };
+}
+
+// Many tokens: repeated verification of the same response
+function testVerificationSpeed(): TestResult {
+  const name = 'Verifies 1000 proof sets quickly';
+  try {
+    const start = Date.now();
+    for (let i = 0; i < 1000; i++) {
+      verifyAccountProof(stateRoot, account);
+    }
+    const duration = Date.now() - start;
+    return {
+      name,
+      success: true,
+      message: `✓ ${duration}ms for 1000 accounts with 4 slots each`,
+      duration,
+    };
+  } catch (error) {
+    return { name, success: false, message: `✗ Unexpected error: ${error}` };
+  }
+}
+
+// Run all Merkle-Patricia proof tests
+export function runAllMptProofTests(): TestResult[] {
+  return [
+    testProvesAccountAndStorage(),
+    testProvesAbsence(),
+    testRejectsTamperedStorageProof(),
+    testRejectsTamperedAccountProof(),
+    testVerificationSpeed(),
+  ];
+}
@@ -0,0 +1,170 @@
+import {
+  createPipeline,
+  getPublicKey,
+  keccak256,
+  pubToAddress,
+} from '@metamask/native-utils';
+import type { TestResult } from '../testUtils';
+import { hexToUint8Array, uint8ArrayToHex } from '../testUtils';
+
+const PRIVATE_KEYS = [
+  '0x4c0883a69102937d6231471b5dbb6204fe5129617082792ae468d01a3f362318',
+  '0x0000000000000000000000000000000000000000000000000000000000000001',
+  '0xfffffffffffffffffffffffffffffffebaaedce6af48a03bbfd25e8cd0364140',
+];
+
+function packHex(hexes: string[], itemSize: number): ArrayBuffer {
+  const buffer = new ArrayBuffer(hexes.length * itemSize);
+  const view = new Uint8Array(buffer);
+  hexes.forEach((hex, i) => view.set(hexToUint8Array(hex), i * itemSize));
+  return buffer;
+}
+
+function packAscii(strings: string[]): ArrayBuffer {
+  const itemSize = strings[0]!.length;
+  const view = new Uint8Array(strings.length * itemSize);
+  strings.forEach((str, i) => {
+    for (let j = 0; j < itemSize; j++) {
+      view[i * itemSize + j] = str.charCodeAt(j);
+    }
+  });
+  return view.buffer;
+}
+
+function unpackAscii(buffer: ArrayBuffer, itemSize: number): string[] {
+  const view = new Uint8Array(buffer);
+  const result: string[] = [];
+  for (let offset = 0; offset < view.length; offset += itemSize) {
+    result.push(
+      String.fromCharCode(...view.subarray(offset, offset + itemSize)),
+    );
+  }
+  return result;
+}
+
+// Private key -> address must match getPublicKey + pubToAddress
+function testAddressPipeline(): TestResult {
+  const name = 'Private keys to addresses matches pubToAddress';
+  try {
+    const pipeline = createPipeline(
+      ['secp256k1PublicKey', 'stripPrefix', 'keccak256', 'last20'],
+      32,
+    );
+    const output = new Uint8Array(pipeline.run(packHex(PRIVATE_KEYS, 32)));
+
+    for (let i = 0; i < PRIVATE_KEYS.length; i++) {
+      const expected = uint8ArrayToHex(
+        pubToAddress(getPublicKey(PRIVATE_KEYS[i]!, false), true),
+      );
+      const actual = uint8ArrayToHex(output.subarray(i * 20, (i + 1) * 20));
+      if (actual !== expected) {
+        return {
+          name,
+          success: false,
+          message: `✗ Index ${i}: expected ${expected}, got ${actual}`,
+        };
+      }
+    }
+
+    return {
+      name,
+      success: pipeline.outputSize === 20,
+      message: `✓ ${PRIVATE_KEYS.length} addresses match`,
+    };
+  } catch (error) {
+    return { name, success: false, message: `✗ Unexpected error: ${error}` };
+  }
+}
+
+// EIP-55 vectors from the specification
+function testChecksumPipeline(): TestResult {
+  const name = 'EIP-55 checksum vectors';
+  const expected = [
+    '5aAeb6053F3E94C9b9A09f33669435E7Ef1BeAed',
+    'fB6916095ca1df60bB79Ce92cE3Ea74c37c5d359',
+    'dbF03B407c01E7cD3CBea99509d93f8DDDC8C6FB',
+    'D1220A0cf47c7B9Be7A2E6BA89F429762e7b9aDb',
+  ];
+  try {
+    const pipeline = createPipeline(['hexDecode', 'checksumHex'], 40);
+    const output = pipeline.run(
+      packAscii(expected.map((address) => address.toLowerCase())),
+    );
+    const actual = unpackAscii(output, 40);
+    const mismatch = actual.findIndex((address, i) => address !== expected[i]);
+
+    return mismatch === -1
+      ? { name, success: true, message: `✓ ${actual.length} vectors match` }
+      : {
+          name,
+          success: false,
+          message: `✗ Expected ${expected[mismatch]}, got ${actual[mismatch]}`,
+        };
+  } catch (error) {
+    return { name, success: false, message: `✗ Unexpected error: ${error}` };
+  }
+}
+
+// Single-stage keccak256 must match the standalone function
+function testKeccakPipeline(): TestResult {
+  const name = 'keccak256 stage matches keccak256';
+  try {
+    const items = ['0x' + '00'.repeat(64), '0x' + 'ab'.repeat(64)];
+    const pipeline = createPipeline(['keccak256'], 64);
+    const output = new Uint8Array(pipeline.run(packHex(items, 64)));
+
+    for (let i = 0; i < items.length; i++) {
+      const expected = uint8ArrayToHex(keccak256(hexToUint8Array(items[i]!)));
+      const actual = uint8ArrayToHex(output.subarray(i * 32, (i + 1) * 32));
+      if (actual !== expected) {
+        return {
+          name,
+          success: false,
+          message: `✗ Index ${i}: expected ${expected}, got ${actual}`,
+        };
+      }
+    }
+    return { name, success: true, message: '✓ Hashes match' };
+  } catch (error) {
+    return { name, success: false, message: `✗ Unexpected error: ${error}` };
+  }
+}
+
+// Chains with mismatched sizes are rejected at compile time
+function testInvalidChain(): TestResult {
+  const name = 'Rejects incompatible stage chain';
+  try {
+    createPipeline(['keccak256', 'checksumHex'], 32);
+    return { name, success: false, message: '✗ Expected an error' };
+  } catch (error) {
+    return { name, success: true, message: `✓ Threw: ${error}` };
+  }
+}
+
+// Invalid private keys fail with the index of the offending item
+function testInvalidKeyIndex(): TestResult {
+  const name = 'Reports index of invalid private key';
+  try {
+    const pipeline = createPipeline(['seckeyVerify'], 32);
+    pipeline.run(packHex([PRIVATE_KEYS[0]!, '0x' + '00'.repeat(32)], 32));
+    return { name, success: false, message: '✗ Expected an error' };
+  } catch (error) {
+    const success = String(error).includes('index 1');
+    return {
+      name,
+      success,
+      message: success ? `✓ Threw: ${error}` : `✗ Wrong error: ${error}`,
+    };
+  }
+}
+
+// Run all pipeline tests
+export function runAllPipelineTests(): TestResult[] {
+  return [
+    testAddressPipeline(),
+    testChecksumPipeline(),
+    testKeccakPipeline(),
+    testInvalidChain(),
+    testInvalidKeyIndex(),
+  ];
+}
@@ -0,0 +1,141 @@
+import {
+  buildSelectorIndex,
+  getTemporaryDirectory,
+  lookupSelectors,
+  openSelectorIndex,
+} from '@metamask/native-utils';
+import type { TestResult } from '../testUtils';
+
+const SIGNATURES = [
+  'transfer(address,uint256)',
+  'function approve(address spender, uint amount)',
+  'transferFrom(address,address,uint256)',
+  // Both hash to 0x42966c68
+  'burn(uint256)',
+  'collate_propagate_storage(bytes16)',
+  // Duplicate after canonicalization
+  'transfer(address to, uint256 value)',
+  'not a signature',
+];
+
+function indexPath(name: string): string {
+  return `${getTemporaryDirectory()}/${name}`;
+}
+
+// Known selectors resolve, including collisions, whole calldata and 0X
+async function testLookup(): Promise<TestResult> {
+  const name = 'Builds and looks up selectors';
+  try {
+    const path = indexPath('selector-test.idx');
+    const indexed = await buildSelectorIndex(SIGNATURES, path);
+    const index = openSelectorIndex(path);
+    const [transfer, approve, burn, unknown] = lookupSelectors(index, [
+      '0xa9059cbb',
+      `0X095EA7B3${'00'.repeat(64)}`,
+      new Uint8Array([0x42, 0x96, 0x6c, 0x68]),
+      '0xdeadbeef',
+    ]);
+
+    const success =
+      indexed === 5 &&
+      index.size === 5 &&
+      transfer?.join() === 'transfer(address,uint256)' &&
+      approve?.join() === 'approve(address,uint256)' &&
+      burn?.join() === 'burn(uint256),collate_propagate_storage(bytes16)' &&
+      unknown?.length === 0;
+    return {
+      name,
+      success,
+      message: success
+        ? '✓ 5 signatures indexed, collisions kept'
+        : `✗ Got ${indexed}: ${JSON.stringify([transfer, approve, burn])}`,
+    };
+  } catch (error) {
+    return { name, success: false, message: `✗ Unexpected error: ${error}` };
+  }
+}
+
+// A rebuilt index replaces the file without disturbing open readers
+async function testAtomicRebuild(): Promise<TestResult> {
+  const name = 'Rebuild keeps open indexes valid';
+  try {
+    const path = indexPath('selector-rebuild.idx');
+    await buildSelectorIndex(['transfer(address,uint256)'], path);
+    const before = openSelectorIndex(path);
+    await buildSelectorIndex(['approve(address,uint256)'], path);
+    const after = openSelectorIndex(path);
+
+    const success =
+      lookupSelectors(before, ['0xa9059cbb'])[0]?.length === 1 &&
+      lookupSelectors(after, ['0xa9059cbb'])[0]?.length === 0 &&
+      lookupSelectors(after, ['0x095ea7b3'])[0]?.length === 1;
+    return {
+      name,
+      success,
+      message: success
+        ? '✓ Old and new index both consistent'
+        : '✗ Unexpected lookups',
+    };
+  } catch (error) {
+    return { name, success: false, message: `✗ Unexpected error: ${error}` };
+  }
+}
+
+// 100k generated signatures: open time and batch lookup time
+async function testLargeIndex(): Promise<TestResult> {
+  const name = 'Opens a 100k-signature index instantly';
+  try {
+    const path = indexPath('selector-large.idx');
+    const signatures = Array.from(
+      { length: 100_000 },
+      (_, i) => `fn${i}(uint256,address)`,
+    );
+    await buildSelectorIndex(signatures, path);
+
+    let start = Date.now();
+    const index = openSelectorIndex(path);
+    const openTime = Date.now() - start;
+
+    start = Date.now();
+    const results = lookupSelectors(
+      index,
+      Array.from({ length: 10_000 }, (_, i) =>
+        new Uint8Array([i & 0xff, (i >> 8) & 0xff, 0x12, 0x34]),
+      ),
+    );
+    const lookupTime = Date.now() - start;
+
+    const success = index.size === 100_000 && results.length === 10_000;
+    return {
+      name,
+      success,
+      message: success
+        ? `✓ Opened in ${openTime}ms, 10k lookups in ${lookupTime}ms`
+        : `✗ Size ${index.size}`,
+      duration: openTime + lookupTime,
+    };
+  } catch (error) {
+    return { name, success: false, message: `✗ Unexpected error: ${error}` };
+  }
+}
+
+// Missing and malformed files are rejected
+function testRejectsInvalidFiles(): TestResult {
+  const name = 'Rejects missing index files';
+  try {
+    openSelectorIndex(indexPath('does-not-exist.idx'));
+    return { name, success: false, message: '✗ Opened a missing file' };
+  } catch (error) {
+    return { name, success: true, message: `✓ ${error}` };
+  }
+}
+
+// Run all selector index tests
+export async function runAllSelectorIndexTests(): Promise<TestResult[]> {
+  return [
+    await testLookup(),
+    await testAtomicRebuild(),
+    await testLargeIndex(),
+    testRejectsInvalidFiles(),
+  ];
+}
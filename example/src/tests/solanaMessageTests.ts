@@ -0,0 +1,164 @@
+import { compileSolanaMessage } from '@metamask/native-utils';
+import { uint8ArrayToHex, type TestResult } from '../testUtils';
+
+const BASE58 = '123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz';
+const SYSTEM_PROGRAM = '11111111111111111111111111111111';
+
+// Address whose 32 bytes are zero except the last, which is n (1 to 57)
+function address(n: number): string {
+  return '1'.repeat(31) + BASE58[n];
+}
+
+function addressBytes(n: number): number[] {
+  return [...new Array(31).fill(0), n];
+}
+
+function compare(
+  name: string,
+  actual: Uint8Array,
+  expected: number[],
+): TestResult {
+  const success =
+    uint8ArrayToHex(actual) === uint8ArrayToHex(new Uint8Array(expected));
+  return {
+    name,
+    success,
+    message: success
+      ? `✓ ${actual.length} bytes match`
+      : `✗ Got ${uint8ArrayToHex(actual)}`,
+  };
+}
+
+// A legacy SOL transfer, laid out by hand
+function testLegacyTransfer(): TestResult {
+  const name = 'Legacy transfer message';
+  try {
+    // SystemProgram transfer of 1000 lamports
+    const data = [2, 0, 0, 0, 0xe8, 0x03, 0, 0, 0, 0, 0, 0];
+    const message = compileSolanaMessage({
+      version: 'legacy',
+      feePayer: address(1),
+      recentBlockhash: address(9),
+      instructions: [
+        {
+          programAddress: SYSTEM_PROGRAM,
+          accounts: [
+            { address: address(1), isSigner: true, isWritable: true },
+            { address: address(2), isSigner: false, isWritable: true },
+          ],
+          data: new Uint8Array(data),
+        },
+      ],
+    });
+    return compare(name, message, [
+      ...[1, 0, 1, 3],
+      ...addressBytes(1),
+      ...addressBytes(2),
+      ...new Array(32).fill(0),
+      ...addressBytes(9),
+      ...[1, 2, 2, 0, 1, data.length],
+      ...data,
+    ]);
+  } catch (error) {
+    return { name, success: false, message: `✗ Unexpected error: ${error}` };
+  }
+}
+
+// Non-signer accounts move into the lookup table that holds them
+function testV0Lookup(): TestResult {
+  const name = 'v0 message with a lookup table';
+  try {
+    const message = compileSolanaMessage({
+      version: 0,
+      feePayer: address(1),
+      recentBlockhash: address(9),
+      instructions: [
+        {
+          programAddress: address(4),
+          accounts: [
+            { address: address(2), isSigner: false, isWritable: true },
+            { address: address(3), isSigner: false, isWritable: false },
+            { address: address(1), isSigner: true, isWritable: true },
+          ],
+          data: new Uint8Array([7]),
+        },
+      ],
+      lookupTables: [
+        // Holds nothing used, so it is left out
+        { address: address(6), addresses: [address(7)] },
+        { address: address(5), addresses: [address(3), address(2)] },
+      ],
+    });
+    return compare(name, message, [
+      ...[0x80, 1, 0, 1, 2],
+      ...addressBytes(1),
+      ...addressBytes(4),
+      ...addressBytes(9),
+      // Loaded accounts follow the static ones: writable, then readonly
+      ...[1, 1, 3, 2, 3, 0, 1, 7],
+      ...[1, ...addressBytes(5), 1, 1, 1, 0],
+    ]);
+  } catch (error) {
+    return { name, success: false, message: `✗ Unexpected error: ${error}` };
+  }
+}
+
+// Invalid messages throw
+function testErrors(): TestResult {
+  const name = 'Rejects invalid messages';
+  const errors: string[] = [];
+  const expectThrow = (label: string, fn: () => unknown) => {
+    try {
+      fn();
+      errors.push(`${label} did not throw`);
+    } catch {
+      // Expected
+    }
+  };
+  const base = {
+    version: 0 as const,
+    feePayer: address(1),
+    recentBlockhash: address(9),
+    instructions: [],
+  };
+  expectThrow('bad address', () =>
+    compileSolanaMessage({ ...base, feePayer: '0OIl' }),
+  );
+  expectThrow('legacy with tables', () =>
+    compileSolanaMessage({
+      ...base,
+      version: 'legacy',
+      lookupTables: [{ address: address(5), addresses: [] }],
+    }),
+  );
+  expectThrow('too many accounts', () =>
+    compileSolanaMessage({
+      ...base,
+      instructions: [
+        {
+          programAddress: SYSTEM_PROGRAM,
+          accounts: Array.from({ length: 300 }, (_, i) => ({
+            // 30 zero bytes, then a distinct value of at least 256
+            address: `${'1'.repeat(30)}${BASE58[5 + Math.floor(i / 58)]}${
+              BASE58[i % 58]
+            }`,
+            isSigner: false,
+            isWritable: false,
+          })),
+          data: new Uint8Array(),
+        },
+      ],
+    }),
+  );
+  const success = errors.length === 0;
+  return {
+    name,
+    success,
+    message: success ? '✓ All rejected' : `✗ ${errors.join(', ')}`,
+  };
+}
+
+// Run all Solana message tests
+export function runAllSolanaMessageTests(): TestResult[] {
+  return [testLegacyTransfer(), testV0Lookup(), testErrors()];
+}
@@ -0,0 +1,167 @@
+import {
+  sszContainerListRoot,
+  sszContainerRoots,
+  sszMerkleize,
+  sszMixInLength,
+} from '@metamask/native-utils';
+import sszVectors from '../vectors/ssz.json';
+import type { TestResult } from '../testUtils';
+
+type ContainerType = keyof typeof sszVectors.containers;
+const CONTAINER_TYPES = Object.keys(sszVectors.containers) as ContainerType[];
+
+// hash_tree_root of an empty List[Validator, 2**40]
+const EMPTY_REGISTRY_ROOT =
+  '0xea569bcb4fbb2ed26d30e997d7337e7e12a43ac115793e9cbe25da401fcbb725';
+
+// Chunk packing, zero padding and limits deeper than the data
+function testMerkleize(): TestResult {
+  const name = 'Matches merkleize vectors';
+  try {
+    const failed = sszVectors.merkleize.filter(
+      ({ data, limit, root }) => sszMerkleize(data, limit) !== root,
+    );
+    const success = failed.length === 0;
+    return {
+      name,
+      success,
+      message: success
+        ? `✓ ${sszVectors.merkleize.length} roots match`
+        : `✗ Mismatch for limits ${failed.map(({ limit }) => limit).join()}`,
+    };
+  } catch (error) {
+    return { name, success: false, message: `✗ Unexpected error: ${error}` };
+  }
+}
+
+function testContainerRoots(): TestResult {
+  const name = 'Matches container root vectors';
+  try {
+    const failed = CONTAINER_TYPES.filter((type) => {
+      const { items, roots } = sszVectors.containers[type];
+      return sszContainerRoots(type, items).join() !== roots.join();
+    });
+    const success = failed.length === 0;
+    return {
+      name,
+      success,
+      message: success
+        ? `✓ ${CONTAINER_TYPES.join(', ')}`
+        : `✗ Mismatch for ${failed.join(', ')}`,
+    };
+  } catch (error) {
+    return { name, success: false, message: `✗ Unexpected error: ${error}` };
+  }
+}
+
+async function testListRoots(): Promise<TestResult> {
+  const name = 'Matches List[type, 2**40] vectors';
+  try {
+    const failed: string[] = [];
+    for (const type of CONTAINER_TYPES) {
+      const { items, listRoot } = sszVectors.containers[type];
+      if ((await sszContainerListRoot(type, items, 2 ** 40)) !== listRoot) {
+        failed.push(type);
+      }
+    }
+    const empty = await sszContainerListRoot('validator', [], 2 ** 40);
+    const success = failed.length === 0 && empty === EMPTY_REGISTRY_ROOT;
+    return {
+      name,
+      success,
+      message: success
+        ? '✓ List roots match'
+        : `✗ Mismatch for ${failed.join(', ') || 'empty list'}`,
+    };
+  } catch (error) {
+    return { name, success: false, message: `✗ Unexpected error: ${error}` };
+  }
+}
+
+// The list root is mix_in_length over the merkleized container roots
+function testListComposition(): TestResult {
+  const name = 'Composes merkleize and mix_in_length';
+  try {
+    const { items, listRoot } = sszVectors.containers.depositData;
+    const roots = sszContainerRoots('depositData', items).join('');
+    const chunks = `0x${roots.replace(/0x/g, '')}`;
+    const root = sszMixInLength(sszMerkleize(chunks, 2 ** 40), items.length);
+    const success = root === listRoot;
+    return {
+      name,
+      success,
+      message: success ? '✓ Same root' : `✗ Got ${root}`,
+    };
+  } catch (error) {
+    return { name, success: false, message: `✗ Unexpected error: ${error}` };
+  }
+}
+
+function testRejectsInvalid(): TestResult {
+  const name = 'Rejects invalid input';
+  const rejects = (fn: () => unknown) => {
+    try {
+      fn();
+      return false;
+    } catch {
+      return true;
+    }
+  };
+  const validator = sszVectors.containers.validator.items[0]!;
+  // Byte 88 is the slashed flag, which must be 0 or 1
+  const slashedAt = 2 + 88 * 2;
+  const badBoolean =
+    validator.slice(0, slashedAt) + '02' + validator.slice(slashedAt + 2);
+  const checks = [
+    rejects(() => sszMerkleize(new Uint8Array(96), 2)),
+    rejects(() => sszContainerRoots('validator', [validator.slice(0, -2)])),
+    rejects(() => sszContainerRoots('validator', [badBoolean])),
+    rejects(() => sszMixInLength(new Uint8Array(31), 1)),
+  ];
+  const success = checks.every(Boolean);
+  return {
+    name,
+    success,
+    message: success
+      ? '✓ All rejected'
+      : `✗ Accepted check ${checks.indexOf(false)}`,
+  };
+}
+
+// A large registry, sharing one buffer to keep memory down on devices
+async function testLargeRegistry(): Promise<TestResult> {
+  const name = 'Hashes a 250k validator registry';
+  try {
+    const packed = new Uint8Array(250_000 * 121);
+    const validators = Array.from({ length: 250_000 }, (_, i) => {
+      const validator = packed.subarray(i * 121, i * 121 + 121);
+      validator[0] = i & 0xff;
+      validator[1] = i >> 8;
+      return validator;
+    });
+    const start = Date.now();
+    const root = await sszContainerListRoot('validator', validators, 2 ** 40);
+    const duration = Date.now() - start;
+    const success = root.length === 66 && root !== EMPTY_REGISTRY_ROOT;
+    return {
+      name,
+      success,
+      message: success ? `✓ ${duration}ms` : `✗ Got ${root}`,
+      duration,
+    };
+  } catch (error) {
+    return { name, success: false, message: `✗ Unexpected error: ${error}` };
+  }
+}
+
+// Run all SSZ tests
+export async function runAllSszTests(): Promise<TestResult[]> {
+  return [
+    testMerkleize(),
+    testContainerRoots(),
+    await testListRoots(),
+    testListComposition(),
+    testRejectsInvalid(),
+    await testLargeRegistry(),
+  ];
+}
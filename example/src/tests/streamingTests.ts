@@ -0,0 +1,243 @@
+import {
+  getPublicKey,
+  getPublicKeyEd25519,
+  getPublicKeysEd25519Streaming,
+  getPublicKeysStreaming,
+} from '@metamask/native-utils';
+import type { TestResult } from '../testUtils';
+import { uint8ArrayToHex } from '../testUtils';
+
+// Chunks that may wait on the JS thread before the native worker pauses
+const MAX_CHUNKS_IN_FLIGHT = 2;
+
+// Distinct keys that are valid secp256k1 scalars and ed25519 seeds
+function makeKeys(count: number): Uint8Array[] {
+  const keys: Uint8Array[] = [];
+  for (let i = 0; i < count; i++) {
+    const key = new Uint8Array(32).fill(0x3c);
+    key[0] = 0x01;
+    new DataView(key.buffer).setUint32(1, i);
+    keys.push(key);
+  }
+  return keys;
+}
+
+type Chunk = { startIndex: number; results: Uint8Array[] };
+
+// Chunks arrive in order, are full except the last, and cover every key
+function checkChunks(
+  chunks: Chunk[],
+  count: number,
+  chunkSize: number,
+): string | null {
+  let expectedStart = 0;
+  for (const chunk of chunks) {
+    if (chunk.startIndex !== expectedStart) {
+      return `chunk at ${chunk.startIndex}, expected ${expectedStart}`;
+    }
+    const expectedSize = Math.min(chunkSize, count - expectedStart);
+    if (chunk.results.length !== expectedSize) {
+      return `chunk at ${chunk.startIndex} has ${chunk.results.length} results, expected ${expectedSize}`;
+    }
+    expectedStart += expectedSize;
+  }
+  return expectedStart === count
+    ? null
+    : `${expectedStart} results, expected ${count}`;
+}
+
+// secp256k1 chunks match getPublicKey in order, with a short last chunk
+async function testSecp256k1Chunks(): Promise<TestResult> {
+  const name = 'secp256k1 streaming delivers ordered chunks';
+  try {
+    const keys = makeKeys(10);
+    const chunks: Chunk[] = [];
+    const delivered = await getPublicKeysStreaming(
+      keys,
+      (startIndex, results) => {
+        chunks.push({ startIndex, results });
+      },
+      false,
+      { chunkSize: 3 },
+    );
+
+    const problem = checkChunks(chunks, keys.length, 3);
+    if (problem || delivered !== keys.length) {
+      return {
+        name,
+        success: false,
+        message: `✗ ${problem ?? `Delivered ${delivered}`}`,
+      };
+    }
+    const results = chunks.flatMap((chunk) => chunk.results);
+    const mismatch = keys.findIndex(
+      (key, i) =>
+        uint8ArrayToHex(results[i]!) !==
+        uint8ArrayToHex(getPublicKey(key, false)),
+    );
+    return {
+      name,
+      success: mismatch === -1,
+      message:
+        mismatch === -1
+          ? `✓ ${chunks.length} chunks, ${delivered} keys`
+          : `✗ Mismatch at index ${mismatch}`,
+    };
+  } catch (error) {
+    return { name, success: false, message: `✗ Unexpected error: ${error}` };
+  }
+}
+
+// ed25519 chunks match getPublicKeyEd25519 in order
+async function testEd25519Chunks(): Promise<TestResult> {
+  const name = 'ed25519 streaming delivers ordered chunks';
+  try {
+    const keys = makeKeys(9);
+    const chunks: Chunk[] = [];
+    const delivered = await getPublicKeysEd25519Streaming(
+      keys,
+      (startIndex, results) => {
+        chunks.push({ startIndex, results });
+      },
+      { chunkSize: 4 },
+    );
+
+    const problem = checkChunks(chunks, keys.length, 4);
+    if (problem || delivered !== keys.length) {
+      return {
+        name,
+        success: false,
+        message: `✗ ${problem ?? `Delivered ${delivered}`}`,
+      };
+    }
+    const results = chunks.flatMap((chunk) => chunk.results);
+    const mismatch = keys.findIndex(
+      (key, i) =>
+        uint8ArrayToHex(results[i]!) !==
+        uint8ArrayToHex(getPublicKeyEd25519(key)),
+    );
+    return {
+      name,
+      success: mismatch === -1,
+      message:
+        mismatch === -1
+          ? `✓ ${chunks.length} chunks, ${delivered} keys`
+          : `✗ Mismatch at index ${mismatch}`,
+    };
+  } catch (error) {
+    return { name, success: false, message: `✗ Unexpected error: ${error}` };
+  }
+}
+
+// A slow handler still receives every chunk, once each, in order
+async function testSlowConsumer(): Promise<TestResult> {
+  const name = 'Slow handler receives every chunk in order';
+  try {
+    const keys = makeKeys(64);
+    const chunks: Chunk[] = [];
+    const delivered = await getPublicKeysStreaming(
+      keys,
+      (startIndex, results) => {
+        chunks.push({ startIndex, results });
+        const until = Date.now() + 5;
+        while (Date.now() < until) {
+          // Hold the JS thread so the native worker fills the queue
+        }
+      },
+      true,
+      { chunkSize: 4 },
+    );
+
+    const problem = checkChunks(chunks, keys.length, 4);
+    const success = problem === null && delivered === keys.length;
+    return {
+      name,
+      success,
+      message: success
+        ? `✓ ${chunks.length} chunks`
+        : `✗ ${problem ?? `Delivered ${delivered}`}`,
+    };
+  } catch (error) {
+    return { name, success: false, message: `✗ Unexpected error: ${error}` };
+  }
+}
+
+// Cancelling on the first chunk stops the worker within the queue bound
+async function testQueueBound(): Promise<TestResult> {
+  const name = 'Cancelled stream stops within the queue bound';
+  try {
+    let calls = 0;
+    const delivered = await getPublicKeysStreaming(
+      makeKeys(256),
+      () => {
+        calls++;
+        return false;
+      },
+      true,
+      { chunkSize: 1 },
+    );
+
+    const success =
+      calls >= 1 && calls <= MAX_CHUNKS_IN_FLIGHT && delivered === calls;
+    return {
+      name,
+      success,
+      message: success
+        ? `✓ ${calls} of 256 chunks delivered`
+        : `✗ ${calls} handler calls, ${delivered} delivered`,
+    };
+  } catch (error) {
+    return { name, success: false, message: `✗ Unexpected error: ${error}` };
+  }
+}
+
+// A throwing handler rejects the stream
+async function testHandlerError(): Promise<TestResult> {
+  const name = 'Throwing handler rejects the stream';
+  try {
+    await getPublicKeysEd25519Streaming(
+      makeKeys(8),
+      () => {
+        throw new Error('handler failed');
+      },
+      { chunkSize: 2 },
+    );
+    return { name, success: false, message: '✗ Stream resolved' };
+  } catch (error) {
+    return { name, success: true, message: `✓ Rejected: ${error}` };
+  }
+}
+
+// Chunk sizes must be positive integers
+async function testInvalidChunkSize(): Promise<TestResult> {
+  const name = 'Rejects invalid chunk sizes';
+  const accepted: number[] = [];
+  for (const chunkSize of [0, -1, 1.5, NaN]) {
+    try {
+      await getPublicKeysStreaming(makeKeys(2), () => {}, true, { chunkSize });
+      accepted.push(chunkSize);
+    } catch {
+      // Expected
+    }
+  }
+  return {
+    name,
+    success: accepted.length === 0,
+    message:
+      accepted.length === 0
+        ? '✓ All rejected'
+        : `✗ Accepted ${accepted.join(', ')}`,
+  };
+}
+
+// Run all streaming tests
+export async function runAllStreamingTests(): Promise<TestResult[]> {
+  return [
+    await testSecp256k1Chunks(),
+    await testEd25519Chunks(),
+    await testSlowConsumer(),
+    await testQueueBound(),
+    await testHandlerError(),
+    await testInvalidChunkSize(),
+  ];
+}
@@ -0,0 +1,154 @@
+import {
+  SPL_TOKEN_ACCOUNT_LAYOUT,
+  decodeTokenAccounts,
+} from '@metamask/native-utils';
+import {
+  randomBytes,
+  uint8ArrayToHex,
+  type TestResult,
+} from '../testUtils';
+
+function toBase64(bytes: Uint8Array): string {
+  return btoa(String.fromCharCode(...bytes));
+}
+
+function writeAmount(data: Uint8Array, offset: number, amount: bigint) {
+  for (let i = 0; offset + i < data.length && amount > 0n; i++) {
+    data[offset + i] = Number(amount & 0xffn);
+    amount >>= 8n;
+  }
+}
+
+// A 165-byte SPL token account
+function splAccount(mint: Uint8Array, owner: Uint8Array, amount: bigint) {
+  const data = new Uint8Array(165);
+  data.set(mint, 0);
+  data.set(owner, 32);
+  writeAmount(data, 64, amount);
+  data[108] = 1; // initialized
+  return data;
+}
+
+// Raw and base64 accounts decode to the same fields
+function testSplAccounts(): TestResult {
+  const name = 'SPL token accounts';
+  try {
+    const expected = Array.from({ length: 300 }, (_, i) => ({
+      mint: randomBytes(32),
+      owner: randomBytes(32),
+      amount: i === 0 ? 0n : BigInt(Math.floor(Math.random() * 2 ** 53)) * 7n,
+    }));
+    const raw = expected.map((e) => splAccount(e.mint, e.owner, e.amount));
+    const failures: string[] = [];
+    for (const [label, decoded] of [
+      ['raw', decodeTokenAccounts(raw)],
+      ['base64', decodeTokenAccounts(raw.map(toBase64))],
+    ] as const) {
+      decoded.forEach((account, i) => {
+        const e = expected[i]!;
+        if (
+          !account ||
+          uint8ArrayToHex(account.mint) !== uint8ArrayToHex(e.mint) ||
+          uint8ArrayToHex(account.owner) !== uint8ArrayToHex(e.owner) ||
+          account.amount !== e.amount
+        ) {
+          failures.push(`${label} ${i}`);
+        }
+      });
+    }
+    const success = failures.length === 0;
+    return {
+      name,
+      success,
+      message: success
+        ? `✓ ${expected.length} accounts match`
+        : `✗ Mismatch: ${failures.slice(0, 5).join(', ')}`,
+    };
+  } catch (error) {
+    return { name, success: false, message: `✗ Unexpected error: ${error}` };
+  }
+}
+
+// Amounts are formatted with their own decimals and trimmed
+function testFormattedAmounts(): TestResult {
+  const name = 'Formatted amounts';
+  try {
+    const cases: [bigint, number, string][] = [
+      [1500000n, 6, '1.5'],
+      [2000000n, 6, '2'],
+      [5n, 6, '0.000005'],
+      [0n, 9, '0'],
+      [18446744073709551615n, 0, '18446744073709551615'],
+      [18446744073709551615n, 9, '18446744073.709551615'],
+    ];
+    const decoded = decodeTokenAccounts(
+      cases.map(([amount]) =>
+        splAccount(randomBytes(32), randomBytes(32), amount),
+      ),
+      { decimals: cases.map(([, decimals]) => decimals) },
+    );
+    const failures = cases.filter(
+      ([, , text], i) => decoded[i]?.formattedAmount !== text,
+    );
+    const success = failures.length === 0;
+    return {
+      name,
+      success,
+      message: success
+        ? `✓ ${cases.length} amounts formatted`
+        : `✗ Wrong: ${failures.map(([, , text]) => text).join(', ')}`,
+    };
+  } catch (error) {
+    return { name, success: false, message: `✗ Unexpected error: ${error}` };
+  }
+}
+
+// A custom layout with a discriminator and a u128 amount
+function testBorshLayout(): TestResult {
+  const name = 'Borsh layout with a discriminator';
+  try {
+    const discriminator = randomBytes(8);
+    const layout = {
+      mintOffset: 8,
+      ownerOffset: 40,
+      amountOffset: 72,
+      amountSize: 16 as const,
+      discriminator,
+    };
+    const amount = 2n ** 100n + 12345n;
+    const data = new Uint8Array(88);
+    data.set(discriminator, 0);
+    writeAmount(data, 72, amount);
+    const other = data.slice();
+    other[0] = other[0]! ^ 1;
+    const [matching, mismatched, short, spl] = decodeTokenAccounts(
+      [
+        data,
+        other,
+        data.subarray(0, 87),
+        splAccount(randomBytes(32), randomBytes(32), 1n),
+      ],
+      { layout },
+    );
+    const success =
+      matching?.amount === amount &&
+      mismatched === null &&
+      short === null &&
+      spl === null &&
+      SPL_TOKEN_ACCOUNT_LAYOUT.minSize === 165;
+    return {
+      name,
+      success,
+      message: success
+        ? '✓ Matching account decoded, others rejected'
+        : `✗ Got ${matching?.amount}, ${mismatched}, ${short}, ${spl}`,
+    };
+  } catch (error) {
+    return { name, success: false, message: `✗ Unexpected error: ${error}` };
+  }
+}
+
+// Run all token account tests
+export function runAllTokenAccountTests(): TestResult[] {
+  return [testSplAccounts(), testFormattedAmounts(), testBorshLayout()];
+}
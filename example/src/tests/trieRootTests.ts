@@ -0,0 +1,99 @@
+import { orderedTrieRoot } from '@metamask/native-utils';
+import trieVectors from '../vectors/ordered-trie.json';
+import type { TestResult } from '../testUtils';
+
+const EMPTY_TRIE_ROOT =
+  '0x56e81f171bcc55a6ff8345e692c0f86e5b48e01b996cadc001622fb5e363b421';
+
+// Roots of generated tries, including short embedded nodes
+function testVectors(): TestResult {
+  const name = 'Matches ordered trie vectors';
+  try {
+    const failed = trieVectors.cases.filter(
+      ({ items, root }) => orderedTrieRoot(items) !== root,
+    );
+    const sizes = failed.map(({ items }) => items.length);
+    const success = failed.length === 0;
+    return {
+      name,
+      success,
+      message: success
+        ? `✓ ${trieVectors.cases.length} roots match`
+        : `✗ Mismatch for ${sizes.join()} items`,
+    };
+  } catch (error) {
+    return { name, success: false, message: `✗ Unexpected error: ${error}` };
+  }
+}
+
+// A block without transactions has the empty trie root
+function testEmptyRoot(): TestResult {
+  const name = 'Empty list has the empty trie root';
+  try {
+    const root = orderedTrieRoot([]);
+    const success = root === EMPTY_TRIE_ROOT;
+    return {
+      name,
+      success,
+      message: success ? '✓ Empty trie root' : `✗ Got ${root}`,
+    };
+  } catch (error) {
+    return { name, success: false, message: `✗ Unexpected error: ${error}` };
+  }
+}
+
+// Changing or reordering one item changes the root
+function testDetectsChanges(): TestResult {
+  const name = 'Detects changed and reordered items';
+  try {
+    const items = trieVectors.cases[trieVectors.cases.length - 1]!.items;
+    const root = orderedTrieRoot(items);
+    const changed = items.slice();
+    changed[7] = `${changed[7]!}00`;
+    const swapped = items.slice();
+    [swapped[0], swapped[1]] = [swapped[1]!, swapped[0]!];
+    const success =
+      orderedTrieRoot(changed) !== root && orderedTrieRoot(swapped) !== root;
+    return {
+      name,
+      success,
+      message: success ? '✓ Roots differ' : '✗ Root unchanged',
+    };
+  } catch (error) {
+    return { name, success: false, message: `✗ Unexpected error: ${error}` };
+  }
+}
+
+// A large block: 1000 receipt-sized items
+function testLargeBlock(): TestResult {
+  const name = 'Computes a 1000-item root quickly';
+  try {
+    const items = Array.from({ length: 1000 }, (_, i) => {
+      const item = new Uint8Array(400);
+      item.fill(i & 0xff);
+      return item;
+    });
+    const start = Date.now();
+    const root = orderedTrieRoot(items);
+    const duration = Date.now() - start;
+    const success = root.length === 66 && root !== EMPTY_TRIE_ROOT;
+    return {
+      name,
+      success,
+      message: success ? `✓ ${duration}ms` : `✗ Got ${root}`,
+      duration,
+    };
+  } catch (error) {
+    return { name, success: false, message: `✗ Unexpected error: ${error}` };
+  }
+}
+
+// Run all trie root tests
+export function runAllTrieRootTests(): TestResult[] {
+  return [
+    testVectors(),
+    testEmptyRoot(),
+    testDetectsChanges(),
+    testLargeBlock(),
+  ];
+}
@@ -0,0 +1,19 @@
+#import <Foundation/Foundation.h>
+
+#include "mapped_file.hpp"
+#include <stdexcept>
+
+namespace margelo::nitro::metamask_nativeutils {
+
+std::string temporaryDirectory() {
+  @autoreleasepool {
+    // Standardizing drops the trailing slash NSTemporaryDirectory() adds
+    NSString* path = [NSTemporaryDirectory() stringByStandardizingPath];
+    if (path.length == 0) {
+      throw std::runtime_error("The app temporary directory is not available");
+    }
+    return std::string(path.UTF8String);
+  }
+}
+
+} // namespace margelo::nitro::metamask_nativeutils
@@ -0,0 +1,17 @@
+import type { HybridObject } from 'react-native-nitro-modules';
+
+/**
+ * Native hash set of raw 20-byte addresses. Batch arguments are addresses
+ * packed back to back (20 bytes each).
+ */
+export interface AddressSet
+  extends HybridObject<{ ios: 'c++'; android: 'c++' }> {
+  readonly size: number;
+  /** Add addresses; returns how many were not already present. */
+  insert(addresses: ArrayBuffer): number;
+  /** Remove addresses; returns how many were present. */
+  remove(addresses: ArrayBuffer): number;
+  /** Bitmap with bit `i % 8` of byte `i / 8` set if address `i` is present. */
+  contains(addresses: ArrayBuffer): ArrayBuffer;
+  clear(): void;
+}
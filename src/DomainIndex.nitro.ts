@@ -0,0 +1,22 @@
+import type { HybridObject } from 'react-native-nitro-modules';
+
+/**
+ * Memory-mapped set of domains, such as a phishing block list or allow
+ * list, built by `buildDomainIndex`. A listed domain also matches all of its
+ * subdomains.
+ */
+export interface DomainIndex
+  extends HybridObject<{ ios: 'c++'; android: 'c++' }> {
+  /** Number of domains in the index */
+  readonly size: number;
+  /**
+   * Check hostnames against the index. Returns a bitmap with bit `i % 8` of
+   * byte `i / 8` set if hostname i or one of its parent domains is listed.
+   */
+  matches(hostnames: string[]): ArrayBuffer;
+  /**
+   * Map the index file again after it was rebuilt. Lookups switch to the
+   * new list at once; if the file is invalid, the old list stays in use.
+   */
+  reload(): void;
+}
@@ -0,0 +1,20 @@
+import type { HybridObject } from 'react-native-nitro-modules';
+
+/**
+ * Ed25519 private key held in native secure memory, created by
+ * `createEd25519KeyHandle`. The key never returns to JS. Builds with the
+ * table-based Ed25519 backend also expand the seed once, so repeated signing
+ * skips the SHA-512 of the seed.
+ */
+export interface Ed25519KeyHandle
+  extends HybridObject<{ ios: 'c++'; android: 'c++' }> {
+  /** The 32-byte public key */
+  publicKey(): ArrayBuffer;
+  /** Sign a message (pure Ed25519, RFC 8032); returns 64 bytes */
+  sign(message: ArrayBuffer): ArrayBuffer;
+  /**
+   * Sign many messages, packed back to back with their lengths; returns the
+   * 64-byte signatures packed in the same order
+   */
+  signBatch(messages: ArrayBuffer, messageLengths: number[]): ArrayBuffer;
+}
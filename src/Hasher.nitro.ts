@@ -0,0 +1,36 @@
+import type { HybridObject } from 'react-native-nitro-modules';
+
+/**
+ * Hash functions available natively:
+ * - `sha256`, `sha512`: SHA-2 (Bitcoin, Solana, Cosmos)
+ * - `sha3_256`: FIPS 202 SHA3-256, which differs from Ethereum's Keccak-256
+ *   in its padding
+ * - `keccak256`: Keccak-256 as used by Ethereum
+ * - `ripemd160`: RIPEMD-160, as in Bitcoin's HASH160
+ * - `blake2b256`, `blake2b512`: BLAKE2b with a 32- or 64-byte digest
+ *   (Polkadot, Cardano, Zcash)
+ */
+export type HashAlgorithm =
+  | 'sha256'
+  | 'sha512'
+  | 'sha3_256'
+  | 'keccak256'
+  | 'ripemd160'
+  | 'blake2b256'
+  | 'blake2b512';
+
+/**
+ * Incremental hash of data that arrives in parts, created by
+ * `createHasher`.
+ */
+export interface Hasher
+  extends HybridObject<{ ios: 'c++'; android: 'c++' }> {
+  readonly algorithm: HashAlgorithm;
+  /** Digest size in bytes */
+  readonly outputSize: number;
+  update(data: ArrayBuffer): void;
+  /** Finish the hash and reset the hasher for the next message */
+  digest(): ArrayBuffer;
+  /** Discard the data hashed so far */
+  reset(): void;
+}
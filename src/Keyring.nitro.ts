@@ -0,0 +1,30 @@
+import type { HybridObject } from 'react-native-nitro-modules';
+
+/**
+ * secp256k1 account keys held in native secure memory, created by
+ * `createKeyring`. Each account's public key and address are derived once
+ * when it is added, and accounts are found by their raw 20-byte address, so
+ * lookups and signing never move key bytes to or from JS.
+ */
+export interface Keyring extends HybridObject<{ ios: 'c++'; android: 'c++' }> {
+  /** Number of accounts */
+  readonly size: number;
+  /**
+   * Add 32-byte private keys packed back to back; returns their 20-byte
+   * addresses packed in the same order. Keys already present are kept once.
+   */
+  addKeys(privateKeys: ArrayBuffer): ArrayBuffer;
+  /** Remove accounts by packed 20-byte address; returns how many were held */
+  removeAccounts(addresses: ArrayBuffer): number;
+  /** Every address, 20 bytes each, in the order the accounts were added */
+  getAddresses(): ArrayBuffer;
+  /** The 33-byte compressed or 65-byte uncompressed public key of an account */
+  publicKeyByAddress(address: ArrayBuffer, isCompressed: boolean): ArrayBuffer;
+  /**
+   * Sign a 32-byte hash with an account's key (ECDSA with RFC 6979 nonces,
+   * low s); returns 65 bytes, r || s || recovery id (0 or 1)
+   */
+  signByAddress(address: ArrayBuffer, hash: ArrayBuffer): ArrayBuffer;
+  /** Remove every account, wiping its key */
+  clear(): void;
+}
@@ -0,0 +1,42 @@
+import type { HybridObject } from 'react-native-nitro-modules';
+
+/** An event matched by a {@link LogFilter} and the parameters it decodes. */
+export interface LogFilterEvent {
+  name: string;
+  /** Canonical signature, e.g. `Transfer(address,address,uint256)` */
+  signature: string;
+  /** Keccak-256 of the canonical signature (topic0); empty if anonymous */
+  topic: ArrayBuffer;
+  /**
+   * Decoded parameters in output order; arrays, tuples and dynamic types are
+   * skipped
+   */
+  fieldNames: string[];
+  fieldTypes: string[];
+}
+
+/**
+ * Matched logs, in log order. `logIndices` and `eventIndices` hold one u32
+ * (little-endian) per match. Decoded fields follow the event's `fieldTypes`:
+ * address fields take 20 bytes of `addresses`, every other field 32 bytes of
+ * `values`.
+ */
+export interface LogFilterMatches {
+  logIndices: ArrayBuffer;
+  eventIndices: ArrayBuffer;
+  addresses: ArrayBuffer;
+  values: ArrayBuffer;
+}
+
+/**
+ * Event signatures hashed once and matched natively against packed logs.
+ *
+ * `logs` holds one 160-byte record per log: address (20 bytes), topic count
+ * (u8), 3 bytes padding, data offset and data length (u32 little-endian, into
+ * `data`), then four 32-byte topic slots.
+ */
+export interface LogFilter
+  extends HybridObject<{ ios: 'c++'; android: 'c++' }> {
+  readonly events: LogFilterEvent[];
+  filter(logs: ArrayBuffer, data: ArrayBuffer): LogFilterMatches;
+}
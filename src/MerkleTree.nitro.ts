@@ -0,0 +1,30 @@
+import type { HybridObject } from 'react-native-nitro-modules';
+
+/**
+ * How leaves are hashed before they enter the tree:
+ * - `none`: leaves are already 32-byte hashes (SimpleMerkleTree)
+ * - `keccak256`: one Keccak-256, e.g. of `abi.encodePacked(...)`
+ * - `doubleKeccak256`: Keccak-256 twice, as OpenZeppelin's
+ *   StandardMerkleTree does with `abi.encode(...)`
+ */
+export type MerkleLeafHash = 'none' | 'keccak256' | 'doubleKeccak256';
+
+/**
+ * Keccak-256 sorted-pair Merkle tree in OpenZeppelin's flat layout, built by
+ * `buildMerkleTree`. Leaf indices refer to the order leaves were given in.
+ */
+export interface MerkleTree
+  extends HybridObject<{ ios: 'c++'; android: 'c++' }> {
+  /** The 32-byte root */
+  readonly root: ArrayBuffer;
+  /** Number of leaves */
+  readonly leafCount: number;
+  /** All nodes, 32 bytes each: root first, leaves last in reverse tree order */
+  getNodes(): ArrayBuffer;
+  /** Leaf hashes in input order, 32 bytes each */
+  getLeafHashes(): ArrayBuffer;
+  /** Proof of one leaf: sibling hashes from the leaf up, 32 bytes each */
+  getProof(index: number): ArrayBuffer;
+  /** Proofs of many leaves */
+  getProofs(indices: number[]): ArrayBuffer[];
+}
@@ -1,4 +1,129 @@
 import type { HybridObject } from 'react-native-nitro-modules';
+import type { AddressSet } from './AddressSet.nitro';
+import type { DomainIndex } from './DomainIndex.nitro';
+import type { Ed25519KeyHandle } from './Ed25519KeyHandle.nitro';
+import type { HashAlgorithm, Hasher } from './Hasher.nitro';
+import type { Keyring } from './Keyring.nitro';
+import type { LogFilter } from './LogFilter.nitro';
+import type { MerkleLeafHash, MerkleTree } from './MerkleTree.nitro';
+import type { SelectorIndex } from './SelectorIndex.nitro';
+import type { Pipeline, PipelineStage } from './Pipeline.nitro';
+import type { SubmissionRing } from './SubmissionRing.nitro';
+
+/**
+ * Cost model the adaptive dispatcher uses for one operation.
+ * Units are bytes for hashing operations and keys for key derivation.
+ */
+export interface DispatchThreshold {
+  op: string;
+  fixedCostNs: number;
+  perUnitCostNs: number;
+  offloadCostNs: number;
+  inlineMaxUnits: number;
+  samples: number;
+}
+
+/**
+ * How aggressively to release native memory:
+ * - `moderate`: pooled buffers, and caches down to half their budget
+ * - `low`: pooled buffers and cheap caches, expensive caches down to half
+ * - `critical`: everything that can be rebuilt, including the Ed25519 table
+ */
+export type MemoryTrimLevel = 'moderate' | 'low' | 'critical';
+
+/** Current size and configured byte budget of a native cache or pool. */
+export interface CacheUsage {
+  name: string;
+  bytes: number;
+  budgetBytes: number;
+}
+
+/**
+ * Account state and storage values proven against a state root by
+ * `verifyStorageProofs`. Integers are big-endian without leading zeros.
+ */
+export interface VerifiedAccount {
+  /**
+   * Whether the account is in the state trie. Absent accounts have a zero
+   * nonce and balance, the empty storage root and the empty code hash.
+   */
+  exists: boolean;
+  nonce: ArrayBuffer;
+  balance: ArrayBuffer;
+  storageRoot: ArrayBuffer;
+  codeHash: ArrayBuffer;
+  /** 32 bytes per slot, zero for absent slots */
+  storageValues: ArrayBuffer;
+  /** Bitmap, bit i set if the proof of slot i is valid */
+  storageValid: ArrayBuffer;
+}
+
+/**
+ * Points decoded by `ed25519DecompressPoints`. Coordinates are big-endian.
+ */
+export interface Ed25519Points {
+  /** 64 bytes per point, x then y; zero for invalid encodings */
+  coordinates: ArrayBuffer;
+  /** Bitmap, bit i set if encoding i is a valid point */
+  valid: ArrayBuffer;
+}
+
+/**
+ * BIP32 extended keys parsed by `parseExtendedKeys`, packed in input order.
+ */
+export interface ExtendedKeys {
+  /** 78 bytes per key, the BIP32 serialization; zero where invalid */
+  keys: ArrayBuffer;
+  /** 4 bytes per key, its HASH160 fingerprint; zero where invalid */
+  fingerprints: ArrayBuffer;
+  /** Bitmap, bit i set if string i is a valid extended key */
+  valid: ArrayBuffer;
+}
+
+/**
+ * Where the fields of a token account sit in its data, for
+ * `decodeTokenAccounts`. SPL Token and Token-2022 accounts hold the mint at
+ * 0, the owner at 32 and a u64 amount at 64, in at least 165 bytes.
+ */
+export interface TokenAccountLayout {
+  mintOffset: number;
+  ownerOffset: number;
+  amountOffset: number;
+  /** 8 for a u64 amount, 16 for a u128 */
+  amountSize: number;
+  /** Shorter accounts are invalid; raised to cover every field if lower */
+  minSize: number;
+  /** Bytes the data must start with, such as an Anchor discriminator */
+  discriminator: ArrayBuffer;
+}
+
+/**
+ * Token account fields decoded by `decodeTokenAccounts`, packed in input
+ * order; fields are zero where an account is invalid.
+ */
+export interface TokenAccounts {
+  /** 32 bytes per account */
+  mints: ArrayBuffer;
+  /** 32 bytes per account */
+  owners: ArrayBuffer;
+  /** 16 bytes per account, the amount as a little-endian u128 */
+  amounts: ArrayBuffer;
+  /** Bitmap, bit i set if account i matched the layout */
+  valid: ArrayBuffer;
+  /** Amounts as decimal strings if decimals were given, else empty */
+  formattedAmounts: string[];
+}
+
+/**
+ * Beacon chain containers with a native `hash_tree_root`, in their SSZ
+ * serialization:
+ * - `validator`: 121 bytes (pubkey, withdrawal credentials, effective
+ *   balance, slashed, activation eligibility, activation, exit and
+ *   withdrawable epochs)
+ * - `depositMessage`: 88 bytes (pubkey, withdrawal credentials, amount)
+ * - `depositData`: 184 bytes (`depositMessage` fields and signature)
+ */
+export type SszContainer = 'validator' | 'depositMessage' | 'depositData';
 
 export interface NativeUtils
   extends HybridObject<{ ios: 'c++'; android: 'c++' }> {
@@ -10,7 +135,119 @@ export interface NativeUtils
   ): ArrayBuffer;
   getPublicKeyEd25519(privateKey: string): ArrayBuffer;
   getPublicKeyEd25519FromBytes(privateKey: ArrayBuffer): ArrayBuffer;
+  createEd25519KeyHandle(privateKey: ArrayBuffer): Ed25519KeyHandle;
+  ed25519IsOnCurve(points: ArrayBuffer): ArrayBuffer;
+  ed25519DecompressPoints(points: ArrayBuffer): Ed25519Points;
+  createKeyring(): Keyring;
+  serializeExtendedKeys(keys: ArrayBuffer): string[];
+  parseExtendedKeys(encoded: string[]): ExtendedKeys;
+  bip322Sign(
+    privateKey: ArrayBuffer,
+    address: string,
+    message: ArrayBuffer,
+  ): string;
+  bip322Verify(
+    address: string,
+    message: ArrayBuffer,
+    signature: string,
+  ): boolean;
+  bip322VerifyBatch(
+    addresses: string[],
+    messages: ArrayBuffer,
+    messageLengths: number[],
+    signatures: string[],
+  ): ArrayBuffer;
+  compileSolanaMessage(addresses: string[], message: ArrayBuffer): ArrayBuffer;
+  decodeTokenAccounts(
+    data: ArrayBuffer,
+    dataLengths: number[],
+    layout: TokenAccountLayout,
+    decimals: number[],
+  ): TokenAccounts;
+  decodeTokenAccountsBase64(
+    data: string[],
+    layout: TokenAccountLayout,
+    decimals: number[],
+  ): TokenAccounts;
   keccak256FromBytes(data: ArrayBuffer): ArrayBuffer;
+  hash(algorithm: HashAlgorithm, data: ArrayBuffer): ArrayBuffer;
+  hashMany(
+    algorithm: HashAlgorithm,
+    items: ArrayBuffer,
+    itemLengths: number[],
+  ): ArrayBuffer;
+  createHasher(algorithm: HashAlgorithm): Hasher;
   pubToAddress(pubKey: ArrayBuffer, sanitize: boolean): ArrayBuffer;
   hmacSha512(key: ArrayBuffer, data: ArrayBuffer): ArrayBuffer;
+  keccak256Async(data: ArrayBuffer): Promise<ArrayBuffer>;
+  hmacSha512Async(key: ArrayBuffer, data: ArrayBuffer): Promise<ArrayBuffer>;
+  toPublicKeysAsync(
+    privateKeys: ArrayBuffer,
+    isCompressed: boolean,
+  ): Promise<ArrayBuffer>;
+  getPublicKeysEd25519Async(privateKeys: ArrayBuffer): Promise<ArrayBuffer>;
+  toPublicKeysStreaming(
+    privateKeys: ArrayBuffer,
+    isCompressed: boolean,
+    chunkSize: number,
+    onChunk: (startIndex: number, publicKeys: ArrayBuffer) => boolean,
+  ): Promise<number>;
+  getPublicKeysEd25519Streaming(
+    privateKeys: ArrayBuffer,
+    chunkSize: number,
+    onChunk: (startIndex: number, publicKeys: ArrayBuffer) => boolean,
+  ): Promise<number>;
+  getDispatchThresholds(): DispatchThreshold[];
+  createPipeline(stages: PipelineStage[], inputSize: number): Pipeline;
+  createSubmissionRing(capacity: number, dataSize: number): SubmissionRing;
+  createAddressSet(capacityHint: number): AddressSet;
+  bloomAdd(bloom: ArrayBuffer, items: ArrayBuffer, itemSize: number): void;
+  bloomBuild(items: ArrayBuffer, itemSize: number): ArrayBuffer;
+  bloomMatches(
+    blooms: ArrayBuffer,
+    queries: ArrayBuffer,
+    querySize: number,
+  ): ArrayBuffer;
+  createLogFilter(events: string[]): LogFilter;
+  openSelectorIndex(path: string): SelectorIndex;
+  buildSelectorIndex(signatures: string[], path: string): Promise<number>;
+  getTemporaryDirectory(): string;
+  openDomainIndex(path: string): DomainIndex;
+  buildDomainIndex(domains: string[], path: string): Promise<number>;
+  namehash(name: string): ArrayBuffer;
+  namehashMany(names: string[]): ArrayBuffer;
+  buildMerkleTree(
+    leaves: ArrayBuffer,
+    leafSize: number,
+    leafHash: MerkleLeafHash,
+    sortLeaves: boolean,
+  ): Promise<MerkleTree>;
+  merkleVerifyMany(
+    root: ArrayBuffer,
+    leaves: ArrayBuffer,
+    leafSize: number,
+    leafHash: MerkleLeafHash,
+    proofs: ArrayBuffer,
+    proofLengths: number[],
+  ): ArrayBuffer;
+  verifyStorageProofs(
+    stateRoot: ArrayBuffer,
+    address: ArrayBuffer,
+    accountProof: ArrayBuffer[],
+    slots: ArrayBuffer,
+    storageProofs: ArrayBuffer[],
+    storageProofLengths: number[],
+  ): VerifiedAccount;
+  orderedTrieRoot(items: ArrayBuffer, itemLengths: number[]): ArrayBuffer;
+  sszMerkleize(data: ArrayBuffer, limit: number): ArrayBuffer;
+  sszMixInLength(root: ArrayBuffer, length: number): ArrayBuffer;
+  sszContainerRoots(type: SszContainer, items: ArrayBuffer): ArrayBuffer;
+  sszContainerListRoot(
+    type: SszContainer,
+    items: ArrayBuffer,
+    limit: number,
+  ): Promise<ArrayBuffer>;
+  trimMemory(level: MemoryTrimLevel): number;
+  getCacheUsage(): CacheUsage[];
+  setCacheBudget(name: string, budgetBytes: number): number;
 }
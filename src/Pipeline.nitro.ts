@@ -0,0 +1,39 @@
+import type { HybridObject } from 'react-native-nitro-modules';
+
+/**
+ * Built-in pipeline stages. Each stage maps fixed-size items to fixed-size items:
+ * - `hexDecode`: 2n hex characters (ASCII) to n bytes
+ * - `hexEncode`: n bytes to 2n lowercase hex characters (ASCII)
+ * - `seckeyVerify`: rejects invalid 32-byte secp256k1 private keys, passes valid ones through
+ * - `secp256k1PublicKey`: 32-byte private key to 65-byte uncompressed public key
+ * - `secp256k1PublicKeyCompressed`: 32-byte private key to 33-byte compressed public key
+ * - `stripPrefix`: drops the first byte of each item
+ * - `keccak256`: any item to its 32-byte Keccak-256 hash
+ * - `last20`: keeps the last 20 bytes of each item
+ * - `checksumHex`: 20-byte address to its 40-character EIP-55 checksummed hex (ASCII, no `0x`)
+ * - `ed25519PublicKey`: 32-byte Ed25519 private key to 32-byte public key
+ */
+export type PipelineStage =
+  | 'hexDecode'
+  | 'hexEncode'
+  | 'seckeyVerify'
+  | 'secp256k1PublicKey'
+  | 'secp256k1PublicKeyCompressed'
+  | 'stripPrefix'
+  | 'keccak256'
+  | 'last20'
+  | 'checksumHex'
+  | 'ed25519PublicKey';
+
+/**
+ * A chain of stages compiled once and run natively over packed batches.
+ * Inputs are `inputSize`-byte items packed back to back; outputs are
+ * `outputSize`-byte items in the same order.
+ */
+export interface Pipeline
+  extends HybridObject<{ ios: 'c++'; android: 'c++' }> {
+  readonly inputSize: number;
+  readonly outputSize: number;
+  run(inputs: ArrayBuffer): ArrayBuffer;
+  runAsync(inputs: ArrayBuffer): Promise<ArrayBuffer>;
+}
@@ -0,0 +1,16 @@
+import type { HybridObject } from 'react-native-nitro-modules';
+
+/**
+ * Memory-mapped index from 4-byte function selectors to canonical
+ * signatures, built by `buildSelectorIndex`.
+ */
+export interface SelectorIndex
+  extends HybridObject<{ ios: 'c++'; android: 'c++' }> {
+  /** Number of signatures in the index */
+  readonly size: number;
+  /**
+   * Look up selectors packed back to back (4 bytes each). Returns the
+   * signatures of each selector; several signatures can share a selector.
+   */
+  lookup(selectors: ArrayBuffer): string[][];
+}
@@ -0,0 +1,17 @@
+import type { HybridObject } from 'react-native-nitro-modules';
+
+/**
+ * Request ring shared between the JS thread (single producer) and native
+ * worker threads (consumers). `buffer` is native memory visible to both sides:
+ * a 128-byte header (`head` u32 at 0, `completed` u32 at 64), `capacity`
+ * 32-byte request slots, then `dataSize` bytes of request data.
+ */
+export interface SubmissionRing
+  extends HybridObject<{ ios: 'c++'; android: 'c++' }> {
+  readonly buffer: ArrayBuffer;
+  readonly capacity: number;
+  readonly dataSize: number;
+  readonly completed: number;
+  submit(): void;
+  drain(): Promise<number>;
+}
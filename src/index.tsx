@@ -1,12 +1,59 @@
 import { NitroModules } from 'react-native-nitro-modules';
-import type { NativeUtils } from './NativeUtils.nitro';
+import type {
+  CacheUsage,
+  DispatchThreshold,
+  ExtendedKeys,
+  MemoryTrimLevel,
+  NativeUtils,
+  SszContainer,
+  TokenAccounts,
+} from './NativeUtils.nitro';
+import type { AddressSet } from './AddressSet.nitro';
+import type { DomainIndex } from './DomainIndex.nitro';
+import type { Ed25519KeyHandle } from './Ed25519KeyHandle.nitro';
+import type { HashAlgorithm, Hasher } from './Hasher.nitro';
+import type { Keyring } from './Keyring.nitro';
+import type {
+  LogFilter,
+  LogFilterEvent,
+  LogFilterMatches,
+} from './LogFilter.nitro';
+import type { MerkleLeafHash, MerkleTree } from './MerkleTree.nitro';
+import type { SelectorIndex } from './SelectorIndex.nitro';
+import type { Pipeline, PipelineStage } from './Pipeline.nitro';
+import type { SubmissionRing } from './SubmissionRing.nitro';
 import {
   bigintPrivateKeyToBytes,
   uint8ArrayToArrayBuffer,
   arrayBufferToUint8Array,
   numberArrayToUint8Array,
+  packFixedSize,
+  unpackFixedSize,
+  hexToBytes,
+  viewToArrayBuffer,
 } from './utils';
 
+export type {
+  CacheUsage,
+  DispatchThreshold,
+  MemoryTrimLevel,
+  SszContainer,
+} from './NativeUtils.nitro';
+export type { AddressSet } from './AddressSet.nitro';
+export type { DomainIndex } from './DomainIndex.nitro';
+export type { Ed25519KeyHandle } from './Ed25519KeyHandle.nitro';
+export type { HashAlgorithm, Hasher } from './Hasher.nitro';
+export type { Keyring } from './Keyring.nitro';
+export type {
+  LogFilter,
+  LogFilterEvent,
+  LogFilterMatches,
+} from './LogFilter.nitro';
+export type { MerkleLeafHash, MerkleTree } from './MerkleTree.nitro';
+export type { SelectorIndex } from './SelectorIndex.nitro';
+export type { Pipeline, PipelineStage } from './Pipeline.nitro';
+export type { SubmissionRing } from './SubmissionRing.nitro';
+
 const NativeUtilsHybridObject =
   NitroModules.createHybridObject<NativeUtils>('NativeUtils');
 
@@ -75,34 +122,123 @@ export function getPublicKey(
 export function keccak256(
   data: string | number[] | ArrayBuffer | Uint8Array,
 ): Uint8Array {
-  let result: ArrayBuffer;
+  const result = NativeUtilsHybridObject.keccak256FromBytes(
+    keccakInputToArrayBuffer(data),
+  );
+
+  // Convert result from ArrayBuffer to Uint8Array to match common crypto library APIs
+  return arrayBufferToUint8Array(result);
+}
+
+/**
+ * Compute Keccak-256 hash without blocking the JS thread on large inputs.
+ * Small inputs are hashed inline; inputs whose measured cost exceeds a thread
+ * hop are hashed on the native thread pool.
+ *
+ * @param data - The data to hash as string (UTF-8), number[], ArrayBuffer, or Uint8Array
+ * @returns Promise of a Uint8Array containing the 32-byte Keccak-256 hash
+ */
+export async function keccak256Async(
+  data: string | number[] | ArrayBuffer | Uint8Array,
+): Promise<Uint8Array> {
+  const result = await NativeUtilsHybridObject.keccak256Async(
+    keccakInputToArrayBuffer(data),
+  );
 
+  return arrayBufferToUint8Array(result);
+}
+
+function keccakInputToArrayBuffer(
+  data: string | number[] | ArrayBuffer | Uint8Array,
+): ArrayBuffer {
   if (typeof data === 'string') {
     // Match noble's behavior: treat string as UTF-8 text, not hex
     const encoder = new TextEncoder();
     const bytes = encoder.encode(data);
-    const buffer = uint8ArrayToArrayBuffer(bytes);
-    result = NativeUtilsHybridObject.keccak256FromBytes(buffer);
+    return uint8ArrayToArrayBuffer(bytes);
   } else if (Array.isArray(data)) {
     // Convert number array to Uint8Array, then to ArrayBuffer
     const bytes = numberArrayToUint8Array(data);
-    const buffer = uint8ArrayToArrayBuffer(bytes);
-    result = NativeUtilsHybridObject.keccak256FromBytes(buffer);
+    return uint8ArrayToArrayBuffer(bytes);
   } else if (data instanceof ArrayBuffer) {
     // Use ArrayBuffer directly
-    result = NativeUtilsHybridObject.keccak256FromBytes(data);
+    return data;
   } else if (data instanceof Uint8Array) {
     // Convert Uint8Array to ArrayBuffer
-    const buffer = uint8ArrayToArrayBuffer(data);
-    result = NativeUtilsHybridObject.keccak256FromBytes(buffer);
-  } else {
-    throw new Error(
-      'Data must be a string, number[], ArrayBuffer, or Uint8Array',
-    );
+    return uint8ArrayToArrayBuffer(data);
   }
 
-  // Convert result from ArrayBuffer to Uint8Array to match common crypto library APIs
-  return arrayBufferToUint8Array(result);
+  throw new Error(
+    'Data must be a string, number[], ArrayBuffer, or Uint8Array',
+  );
+}
+
+/**
+ * Hash data with any of the natively supported algorithms. Like
+ * {@link keccak256}, strings are hashed as UTF-8 text.
+ *
+ * @example
+ * const digest = hash('sha256', new Uint8Array([0x61, 0x62, 0x63]));
+ *
+ * @param algorithm - The hash function; see {@link HashAlgorithm}
+ * @param data - The data to hash as string (UTF-8), number[], ArrayBuffer, or Uint8Array
+ * @returns Uint8Array containing the digest
+ */
+export function hash(
+  algorithm: HashAlgorithm,
+  data: string | number[] | ArrayBuffer | Uint8Array,
+): Uint8Array {
+  return arrayBufferToUint8Array(
+    NativeUtilsHybridObject.hash(algorithm, keccakInputToArrayBuffer(data)),
+  );
+}
+
+/**
+ * Hash many messages in one native call, such as the leaves of a tree or the
+ * public keys of an account scan. Large batches are hashed in parallel.
+ *
+ * @param algorithm - The hash function; see {@link HashAlgorithm}
+ * @param items - The messages to hash
+ * @returns The digest of each message
+ */
+export function hashMany(
+  algorithm: HashAlgorithm,
+  items: Uint8Array[],
+): Uint8Array[] {
+  const packed = new Uint8Array(
+    items.reduce((total, item) => total + item.length, 0),
+  );
+  let offset = 0;
+  for (const item of items) {
+    packed.set(item, offset);
+    offset += item.length;
+  }
+  const digests = NativeUtilsHybridObject.hashMany(
+    algorithm,
+    packed.buffer,
+    items.map((item) => item.length),
+  );
+  return items.length === 0
+    ? []
+    : unpackFixedSize(digests, digests.byteLength / items.length);
+}
+
+/**
+ * Create an incremental hasher for data that arrives in parts, such as a
+ * file read in chunks, without joining the parts in JS.
+ *
+ * @example
+ * const hasher = createHasher('blake2b256');
+ * for (const chunk of chunks) {
+ *   hasher.update(chunk); // ArrayBuffer
+ * }
+ * const digest = new Uint8Array(hasher.digest());
+ *
+ * @param algorithm - The hash function; see {@link HashAlgorithm}
+ * @returns A new hasher with no data
+ */
+export function createHasher(algorithm: HashAlgorithm): Hasher {
+  return NativeUtilsHybridObject.createHasher(algorithm);
 }
 
 /**
@@ -139,6 +275,1231 @@ export function hmacSha512(key: Uint8Array, data: Uint8Array): Uint8Array {
   return arrayBufferToUint8Array(result);
 }
 
+/**
+ * Compute HMAC-SHA512 without blocking the JS thread on large inputs.
+ *
+ * @param key - The HMAC key as Uint8Array
+ * @param data - The data to authenticate as Uint8Array
+ * @returns Promise of a Uint8Array containing the 64-byte HMAC-SHA512 result
+ */
+export async function hmacSha512Async(
+  key: Uint8Array,
+  data: Uint8Array,
+): Promise<Uint8Array> {
+  const keyBuffer = uint8ArrayToArrayBuffer(key);
+  const dataBuffer = uint8ArrayToArrayBuffer(data);
+
+  const result = await NativeUtilsHybridObject.hmacSha512Async(
+    keyBuffer,
+    dataBuffer,
+  );
+
+  return arrayBufferToUint8Array(result);
+}
+
+/**
+ * Generate the secp256k1 public keys of many private keys in one native call.
+ * Small batches run inline; large batches run on the native thread pool.
+ *
+ * @param privateKeys - The 32-byte private keys
+ * @param isCompressed - Whether to return compressed (33 bytes) or uncompressed (65 bytes) public keys
+ * @returns Promise of the public keys, in input order
+ */
+export async function getPublicKeysAsync(
+  privateKeys: BytesPrivateKey[],
+  isCompressed: boolean = true,
+): Promise<Uint8Array[]> {
+  const result = await NativeUtilsHybridObject.toPublicKeysAsync(
+    packFixedSize(privateKeys, 32),
+    isCompressed,
+  );
+
+  return unpackFixedSize(result, isCompressed ? 33 : 65);
+}
+
+/**
+ * Generate the Ed25519 public keys of many private keys in one native call.
+ * Small batches run inline; large batches run on the native thread pool.
+ *
+ * @param privateKeys - The 32-byte Ed25519 private keys
+ * @returns Promise of the 32-byte public keys, in input order
+ */
+export async function getPublicKeysEd25519Async(
+  privateKeys: BytesPrivateKey[],
+): Promise<Uint8Array[]> {
+  const result = await NativeUtilsHybridObject.getPublicKeysEd25519Async(
+    packFixedSize(privateKeys, 32),
+  );
+
+  return unpackFixedSize(result, 32);
+}
+
+/** Options for streaming batch derivation. */
+export type StreamingOptions = {
+  /** Number of results per delivered chunk (default 256). */
+  chunkSize?: number;
+};
+
+/**
+ * Receives one chunk of streamed results.
+ * Return `false` to cancel the remaining work.
+ */
+export type ChunkHandler = (
+  startIndex: number,
+  results: Uint8Array[],
+) => boolean | void;
+
+const DEFAULT_STREAMING_CHUNK_SIZE = 256;
+
+/**
+ * Generate the secp256k1 public keys of a large batch of private keys on the
+ * native thread pool, delivering results in chunks as they complete.
+ * At most two chunks are queued for the JS thread at any time; derivation
+ * pauses until the handler has consumed them.
+ *
+ * @param privateKeys - The 32-byte private keys
+ * @param onChunk - Called with the index of the first key in the chunk and its public keys
+ * @param isCompressed - Whether to return compressed (33 bytes) or uncompressed (65 bytes) public keys
+ * @param options - Streaming options
+ * @returns Promise of the number of public keys delivered
+ */
+export function getPublicKeysStreaming(
+  privateKeys: BytesPrivateKey[],
+  onChunk: ChunkHandler,
+  isCompressed: boolean = true,
+  options: StreamingOptions = {},
+): Promise<number> {
+  const keySize = isCompressed ? 33 : 65;
+
+  return NativeUtilsHybridObject.toPublicKeysStreaming(
+    packFixedSize(privateKeys, 32),
+    isCompressed,
+    options.chunkSize ?? DEFAULT_STREAMING_CHUNK_SIZE,
+    (startIndex, publicKeys) =>
+      onChunk(startIndex, unpackFixedSize(publicKeys, keySize)) !== false,
+  );
+}
+
+/**
+ * Generate the Ed25519 public keys of a large batch of private keys on the
+ * native thread pool, delivering results in chunks as they complete.
+ *
+ * @param privateKeys - The 32-byte Ed25519 private keys
+ * @param onChunk - Called with the index of the first key in the chunk and its public keys
+ * @param options - Streaming options
+ * @returns Promise of the number of public keys delivered
+ */
+export function getPublicKeysEd25519Streaming(
+  privateKeys: BytesPrivateKey[],
+  onChunk: ChunkHandler,
+  options: StreamingOptions = {},
+): Promise<number> {
+  return NativeUtilsHybridObject.getPublicKeysEd25519Streaming(
+    packFixedSize(privateKeys, 32),
+    options.chunkSize ?? DEFAULT_STREAMING_CHUNK_SIZE,
+    (startIndex, publicKeys) =>
+      onChunk(startIndex, unpackFixedSize(publicKeys, 32)) !== false,
+  );
+}
+
+/**
+ * Return the cost models the adaptive dispatcher uses to decide whether an
+ * async request runs inline or on the native thread pool.
+ * Requests larger than `inlineMaxUnits` are offloaded. The models are seeded
+ * on the thread pool when the module loads; until then an operation reports
+ * zero samples and all of its requests are offloaded.
+ *
+ * @returns One entry per operation
+ */
+export function getDispatchThresholds(): DispatchThreshold[] {
+  return NativeUtilsHybridObject.getDispatchThresholds();
+}
+
+/**
+ * Compile a chain of native stages that runs over packed batches without
+ * returning intermediate results to JS. Stage sizes are checked once here.
+ *
+ * @example
+ * // Private keys to EIP-55 checksummed addresses in one native call
+ * const toAddresses = createPipeline(
+ *   ['secp256k1PublicKey', 'stripPrefix', 'keccak256', 'last20', 'checksumHex'],
+ *   32,
+ * );
+ * const addresses = toAddresses.run(packedPrivateKeys); // 40 ASCII bytes per key
+ *
+ * @param stages - The stages to run, in order
+ * @param inputSize - Size in bytes of each input item
+ * @returns The compiled pipeline
+ * @throws If the stages cannot be chained for the given input size
+ */
+export function createPipeline(
+  stages: PipelineStage[],
+  inputSize: number,
+): Pipeline {
+  return NativeUtilsHybridObject.createPipeline(stages, inputSize);
+}
+
+/** Operations a {@link SubmissionQueue} can run. */
+export type RingOp =
+  | 'keccak256'
+  | 'hmacSha512'
+  | 'secp256k1PublicKey'
+  | 'secp256k1PublicKeyCompressed'
+  | 'ed25519PublicKey';
+
+// Must match HybridSubmissionRing::Op
+const RING_OP_CODES: Record<RingOp, number> = {
+  keccak256: 0,
+  hmacSha512: 1,
+  secp256k1PublicKey: 2,
+  secp256k1PublicKeyCompressed: 3,
+  ed25519PublicKey: 4,
+};
+
+const RING_OUTPUT_SIZES: Record<RingOp, number> = {
+  keccak256: 32,
+  hmacSha512: 64,
+  secp256k1PublicKey: 65,
+  secp256k1PublicKeyCompressed: 33,
+  ed25519PublicKey: 32,
+};
+
+const RING_HEADER_SIZE = 128;
+const RING_SLOT_SIZE = 32;
+const RING_STATUS_OK = 1;
+
+/**
+ * Queue of hashing and key derivation requests written directly into memory
+ * shared with native worker threads, so sustained streams of small requests
+ * avoid per-call argument conversion.
+ *
+ * Enqueue requests until the queue is full, then `await drain()` to collect
+ * their results in order. `submit()` starts native work early so further
+ * requests can be written while earlier ones run.
+ *
+ * @example
+ * const queue = new SubmissionQueue();
+ * for (const key of privateKeys) {
+ *   if (!queue.enqueue('secp256k1PublicKeyCompressed', key)) {
+ *     results.push(...(await queue.drain()));
+ *     queue.enqueue('secp256k1PublicKeyCompressed', key);
+ *   }
+ * }
+ * results.push(...(await queue.drain()));
+ */
+export class SubmissionQueue {
+  private readonly ring: SubmissionRing;
+  private readonly view: DataView;
+  private readonly bytes: Uint8Array;
+  private readonly capacity: number;
+  private readonly dataStart: number;
+  private readonly dataSize: number;
+  // Requests enqueued / collected so far
+  private head = 0;
+  private tail = 0;
+  private dataUsed = 0;
+  private readonly pending: { op: RingOp; outputOffset: number }[] = [];
+
+  /**
+   * @param capacity - Number of request slots (power of two, default 256)
+   * @param dataSize - Bytes available for request inputs and outputs (default 64 KiB)
+   */
+  constructor(capacity: number = 256, dataSize: number = 64 * 1024) {
+    this.ring = NativeUtilsHybridObject.createSubmissionRing(
+      capacity,
+      dataSize,
+    );
+    const buffer = this.ring.buffer;
+    this.view = new DataView(buffer);
+    this.bytes = new Uint8Array(buffer);
+    this.capacity = capacity;
+    this.dataStart = RING_HEADER_SIZE + capacity * RING_SLOT_SIZE;
+    this.dataSize = dataSize;
+  }
+
+  /**
+   * Write a request into the next free slot. Nothing runs until `submit()`
+   * or `drain()` is called.
+   *
+   * @param op - The operation to run
+   * @param input - Data to hash or the 32-byte private key
+   * @param key - HMAC key (`hmacSha512` only)
+   * @returns false if the slots or the data region are full
+   */
+  enqueue(op: RingOp, input: Uint8Array, key?: Uint8Array): boolean {
+    const keyLength = op === 'hmacSha512' ? (key?.length ?? 0) : 0;
+    const outputLength = RING_OUTPUT_SIZES[op];
+    const needed = input.length + keyLength + outputLength;
+    if (
+      this.head - this.tail >= this.capacity ||
+      this.dataUsed + needed > this.dataSize
+    ) {
+      return false;
+    }
+
+    const inputOffset = this.dataUsed;
+    const keyOffset = inputOffset + input.length;
+    const outputOffset = keyOffset + keyLength;
+    this.bytes.set(input, this.dataStart + inputOffset);
+    if (keyLength > 0) {
+      this.bytes.set(key!, this.dataStart + keyOffset);
+    }
+    this.dataUsed += needed;
+
+    const slot =
+      RING_HEADER_SIZE + (this.head % this.capacity) * RING_SLOT_SIZE;
+    const words = [
+      RING_OP_CODES[op],
+      0,
+      inputOffset,
+      input.length,
+      keyOffset,
+      keyLength,
+      outputOffset,
+      outputLength,
+    ];
+    words.forEach((word, i) => this.view.setUint32(slot + i * 4, word, true));
+
+    this.pending.push({ op, outputOffset });
+    this.head++;
+    return true;
+  }
+
+  /** Start native work on every request enqueued so far. */
+  submit(): void {
+    this.view.setUint32(0, this.head >>> 0, true);
+    this.ring.submit();
+  }
+
+  /**
+   * Submit outstanding requests and wait for all of them to complete.
+   *
+   * @returns One result per request since the last drain, in enqueue order;
+   * `null` for requests with invalid input
+   */
+  async drain(): Promise<(Uint8Array | null)[]> {
+    this.submit();
+    const count = this.pending.length;
+    await this.ring.drain();
+
+    // Requests enqueued while waiting belong to the next drain
+    const completed = this.pending.splice(0, count);
+    const results = completed.map(({ op, outputOffset }, i) => {
+      const slot =
+        RING_HEADER_SIZE + ((this.tail + i) % this.capacity) * RING_SLOT_SIZE;
+      if (this.view.getUint32(slot + 4, true) !== RING_STATUS_OK) {
+        return null;
+      }
+      const start = this.dataStart + outputOffset;
+      return this.bytes.slice(start, start + RING_OUTPUT_SIZES[op]);
+    });
+
+    this.tail += count;
+    if (this.pending.length === 0) {
+      this.dataUsed = 0;
+    }
+    return results;
+  }
+}
+
+// Android ComponentCallbacks2.onTrimMemory levels
+const TRIM_MEMORY_RUNNING_LOW = 10;
+const TRIM_MEMORY_RUNNING_CRITICAL = 15;
+const TRIM_MEMORY_BACKGROUND = 40;
+const TRIM_MEMORY_COMPLETE = 80;
+
+/**
+ * Release native caches and pooled buffers, cheapest to rebuild first.
+ * Call it from Android `onTrimMemory` (the raw level is accepted) or with
+ * `'critical'` on an iOS memory warning.
+ *
+ * Covers what {@link getCacheUsage} lists: the secure key arena and, when
+ * built with Ed25519 tables, the base-point table (released only at
+ * `'critical'`). Keyring and AddressSet contents are not caches; release
+ * them with their `clear()` or `remove()` methods.
+ *
+ * @param level - Trim level, or an Android `onTrimMemory` level
+ * @returns Number of bytes released
+ */
+export function trimMemory(level: MemoryTrimLevel | number): number {
+  if (typeof level === 'number') {
+    if (
+      level >= TRIM_MEMORY_COMPLETE ||
+      level === TRIM_MEMORY_RUNNING_CRITICAL
+    ) {
+      level = 'critical';
+    } else if (
+      level >= TRIM_MEMORY_BACKGROUND ||
+      level === TRIM_MEMORY_RUNNING_LOW
+    ) {
+      level = 'low';
+    } else {
+      level = 'moderate';
+    }
+  }
+
+  return NativeUtilsHybridObject.trimMemory(level);
+}
+
+/**
+ * Report the size and byte budget of every native cache and pool that
+ * `trimMemory` can release.
+ *
+ * @returns One entry per cache or pool
+ */
+export function getCacheUsage(): CacheUsage[] {
+  return NativeUtilsHybridObject.getCacheUsage();
+}
+
+/**
+ * Change the byte budget of a native cache or pool, e.g. to hold less idle
+ * memory on low-RAM devices. Memory over the new budget is released at once,
+ * and the cache keeps itself within it from then on.
+ *
+ * @param name - Cache name, as reported by {@link getCacheUsage}
+ * @param budgetBytes - Requested budget in bytes
+ * @returns The budget in effect; caches clamp it to what they can honor
+ * @throws If there is no cache with that name or its budget is fixed
+ */
+export function setCacheBudget(name: string, budgetBytes: number): number {
+  return NativeUtilsHybridObject.setCacheBudget(name, budgetBytes);
+}
+
+/**
+ * Pack addresses into one buffer of 20-byte entries, the layout taken by
+ * {@link AddressSet} methods.
+ *
+ * @param addresses - 20-byte addresses, or hex strings with or without `0x`
+ * @returns Packed addresses
+ * @throws If an address is not 20 bytes or not valid hex
+ */
+export function packAddresses(addresses: (string | Uint8Array)[]): ArrayBuffer {
+  const packed = new Uint8Array(addresses.length * 20);
+  addresses.forEach((address, i) => {
+    const bytes = typeof address === 'string' ? hexToBytes(address) : address;
+    if (bytes.length !== 20) {
+      throw new Error(`Address at index ${i} must be 20 bytes`);
+    }
+    packed.set(bytes, i * 20);
+  });
+  return packed.buffer;
+}
+
+/**
+ * Create a native set of 20-byte addresses for exact membership checks over
+ * large batches, such as matching every log of a block against the wallet's
+ * accounts, address book and token contracts.
+ *
+ * @example
+ * const watched = createAddressSet(accounts);
+ * const bitmap = new Uint8Array(watched.contains(packAddresses(logAddresses)));
+ * const isWatched = (i: number) => (bitmap[i >> 3]! & (1 << (i & 7))) !== 0;
+ *
+ * @param addresses - Initial addresses, as for {@link packAddresses}
+ * @param capacityHint - Expected number of addresses, to avoid regrowing
+ * @returns The address set
+ */
+export function createAddressSet(
+  addresses: (string | Uint8Array)[] = [],
+  capacityHint: number = addresses.length,
+): AddressSet {
+  const set = NativeUtilsHybridObject.createAddressSet(capacityHint);
+  if (addresses.length > 0) {
+    set.insert(packAddresses(addresses));
+  }
+  return set;
+}
+
+// Pack items by length, since native bloom calls take equally sized items
+function packBySize(items: (string | Uint8Array)[]): Map<number, ArrayBuffer> {
+  const groups = new Map<number, Uint8Array[]>();
+  for (const item of items) {
+    const bytes = typeof item === 'string' ? hexToBytes(item) : item;
+    const group = groups.get(bytes.length);
+    if (group) {
+      group.push(bytes);
+    } else {
+      groups.set(bytes.length, [bytes]);
+    }
+  }
+
+  const packed = new Map<number, ArrayBuffer>();
+  groups.forEach((group, size) => {
+    if (size === 0) {
+      throw new Error('Bloom items must not be empty');
+    }
+    packed.set(size, packFixedSize(group, size));
+  });
+  return packed;
+}
+
+/**
+ * Add items (log addresses and topics) to a 256-byte Ethereum logsBloom.
+ *
+ * @param bloom - The bloom to update in place
+ * @param items - Items as bytes or hex strings
+ * @throws If the bloom is not 256 bytes
+ */
+export function bloomAdd(
+  bloom: Uint8Array,
+  items: (string | Uint8Array)[],
+): void {
+  if (bloom.length !== 256) {
+    throw new Error('Bloom must be 256 bytes');
+  }
+  const buffer = viewToArrayBuffer(bloom);
+  packBySize(items).forEach((packed, size) => {
+    NativeUtilsHybridObject.bloomAdd(buffer, packed, size);
+  });
+  if (buffer !== bloom.buffer) {
+    bloom.set(new Uint8Array(buffer));
+  }
+}
+
+/**
+ * Build the Ethereum logsBloom of a set of items, as found in block headers
+ * and receipts.
+ *
+ * @param items - Log addresses and topics as bytes or hex strings
+ * @returns The 256-byte bloom
+ */
+export function bloomBuild(items: (string | Uint8Array)[]): Uint8Array {
+  const bloom = new Uint8Array(256);
+  bloomAdd(bloom, items);
+  return bloom;
+}
+
+/**
+ * Test many blooms against a set of queries at once. Each query is hashed
+ * once natively, then every bloom is checked for its three bits.
+ *
+ * @example
+ * // Skip blocks that cannot contain logs of our accounts
+ * const bitmap = bloomMatches(packedHeaderBlooms, accounts);
+ * const mayMatch = (i: number) => (bitmap[i >> 3]! & (1 << (i & 7))) !== 0;
+ *
+ * @param blooms - 256-byte blooms, packed back to back or as an array
+ * @param queries - Addresses and topics as bytes or hex strings
+ * @returns Bitmap with bit `i % 8` of byte `i / 8` set if bloom `i` may
+ * contain at least one query (blooms have false positives, never false
+ * negatives)
+ */
+export function bloomMatches(
+  blooms: Uint8Array | Uint8Array[],
+  queries: (string | Uint8Array)[],
+): Uint8Array {
+  const packedBlooms = Array.isArray(blooms)
+    ? packFixedSize(blooms, 256)
+    : viewToArrayBuffer(blooms);
+  const count = packedBlooms.byteLength / 256;
+  if (!Number.isInteger(count)) {
+    throw new Error('Blooms must be a multiple of 256 bytes');
+  }
+
+  // Queries of different lengths are matched separately and combined
+  const bitmap = new Uint8Array(Math.ceil(count / 8));
+  packBySize(queries).forEach((packed, size) => {
+    const matches = new Uint8Array(
+      NativeUtilsHybridObject.bloomMatches(packedBlooms, packed, size),
+    );
+    for (let i = 0; i < bitmap.length; i++) {
+      bitmap[i] = bitmap[i]! | matches[i]!;
+    }
+  });
+  return bitmap;
+}
+
+/** A log as returned by `eth_getLogs`, with fields as hex strings or bytes. */
+export type RpcLog = {
+  address: string | Uint8Array;
+  topics: (string | Uint8Array)[];
+  data: string | Uint8Array;
+};
+
+/** Logs in the layout taken by {@link LogFilter.filter}. */
+export type PackedLogs = { logs: ArrayBuffer; data: ArrayBuffer };
+
+/** A log matched by a {@link LogFilter}, with its decoded parameters. */
+export type DecodedLog = {
+  logIndex: number;
+  event: string;
+  signature: string;
+  /** Decoded parameters by name, or by position if unnamed */
+  args: Record<string, string | bigint | boolean>;
+};
+
+// Must match HybridLogFilter
+const LOG_RECORD_SIZE = 160;
+const LOG_TOPICS_OFFSET = 32;
+
+function toBytes(value: string | Uint8Array): Uint8Array {
+  return typeof value === 'string' ? hexToBytes(value) : value;
+}
+
+function bytesToHex(bytes: Uint8Array): string {
+  let hex = '0x';
+  for (const byte of bytes) {
+    hex += byte.toString(16).padStart(2, '0');
+  }
+  return hex;
+}
+
+/**
+ * Pack logs into the layout taken by {@link LogFilter.filter}.
+ *
+ * @param logs - Logs as returned by `eth_getLogs`
+ * @returns Fixed-size log records and their concatenated data
+ * @throws If an address is not 20 bytes, a topic is not 32 bytes or a log
+ * has more than 4 topics
+ */
+export function packLogs(logs: RpcLog[]): PackedLogs {
+  const records = new Uint8Array(logs.length * LOG_RECORD_SIZE);
+  const view = new DataView(records.buffer);
+  const datas = logs.map((log) => toBytes(log.data));
+  const data = new Uint8Array(datas.reduce((sum, d) => sum + d.length, 0));
+
+  let dataOffset = 0;
+  logs.forEach((log, i) => {
+    const base = i * LOG_RECORD_SIZE;
+    const address = toBytes(log.address);
+    if (address.length !== 20) {
+      throw new Error(`Log at index ${i} must have a 20-byte address`);
+    }
+    if (log.topics.length > 4) {
+      throw new Error(`Log at index ${i} has more than 4 topics`);
+    }
+    records.set(address, base);
+    records[base + 20] = log.topics.length;
+    log.topics.forEach((topic, t) => {
+      const bytes = toBytes(topic);
+      if (bytes.length !== 32) {
+        throw new Error(`Topic ${t} of log at index ${i} must be 32 bytes`);
+      }
+      records.set(bytes, base + LOG_TOPICS_OFFSET + t * 32);
+    });
+
+    const logData = datas[i]!;
+    view.setUint32(base + 24, dataOffset, true);
+    view.setUint32(base + 28, logData.length, true);
+    data.set(logData, dataOffset);
+    dataOffset += logData.length;
+  });
+
+  return { logs: records.buffer, data: data.buffer };
+}
+
+function decodeWord(type: string, word: Uint8Array): bigint | boolean | string {
+  if (type === 'bool') {
+    return word[31] !== 0;
+  }
+  if (type.startsWith('bytes')) {
+    return bytesToHex(word.subarray(0, Number(type.slice(5))));
+  }
+  const value = BigInt(bytesToHex(word));
+  // intN values are sign-extended to 256 bits
+  return type.startsWith('int') && word[0]! >= 0x80
+    ? value - (1n << 256n)
+    : value;
+}
+
+/**
+ * Decode the matches returned by {@link LogFilter.filter}.
+ *
+ * @param events - The filter's `events`
+ * @param matches - The result of `filter`
+ * @returns One decoded log per match, in log order
+ */
+export function decodeLogMatches(
+  events: LogFilterEvent[],
+  matches: LogFilterMatches,
+): DecodedLog[] {
+  const logIndices = new Uint32Array(matches.logIndices);
+  const eventIndices = new Uint32Array(matches.eventIndices);
+  const addresses = new Uint8Array(matches.addresses);
+  const values = new Uint8Array(matches.values);
+
+  let addressOffset = 0;
+  let valueOffset = 0;
+  return Array.from(logIndices, (logIndex, i) => {
+    const event = events[eventIndices[i]!]!;
+    const args: Record<string, string | bigint | boolean> = {};
+    event.fieldTypes.forEach((type, f) => {
+      const key = event.fieldNames[f] || String(f);
+      if (type === 'address') {
+        args[key] = bytesToHex(
+          addresses.subarray(addressOffset, addressOffset + 20),
+        );
+        addressOffset += 20;
+      } else {
+        args[key] = decodeWord(
+          type,
+          values.subarray(valueOffset, valueOffset + 32),
+        );
+        valueOffset += 32;
+      }
+    });
+    return { logIndex, event: event.name, signature: event.signature, args };
+  });
+}
+
+/**
+ * Create a native filter for event logs. Event signatures are parsed and
+ * hashed once; each `filter` call then matches topic0 natively and extracts
+ * the address and value parameters of matching logs.
+ *
+ * @example
+ * const transfers = createLogFilter([
+ *   'event Transfer(address indexed from, address indexed to, uint256 value)',
+ * ]);
+ * const decoded = filterLogs(transfers, rpcLogs);
+ * // [{ logIndex: 3, event: 'Transfer', args: { from, to, value } }, ...]
+ *
+ * @param events - Human-readable event signatures; parameter names and
+ * `indexed` markers are used for decoding. Events marked `anonymous` have no
+ * topic0 and match any log with their indexed layout, so list them last:
+ * each log is matched to the first event that fits it
+ * @returns The compiled filter
+ * @throws If a signature cannot be parsed
+ */
+export function createLogFilter(events: string[]): LogFilter {
+  return NativeUtilsHybridObject.createLogFilter(events);
+}
+
+/**
+ * Match and decode logs with a filter from {@link createLogFilter}.
+ *
+ * @param filter - The log filter
+ * @param logs - Logs as returned by `eth_getLogs`, or already packed
+ * @returns One decoded log per match, in log order
+ */
+export function filterLogs(
+  filter: LogFilter,
+  logs: RpcLog[] | PackedLogs,
+): DecodedLog[] {
+  const packed = Array.isArray(logs) ? packLogs(logs) : logs;
+  return decodeLogMatches(
+    filter.events,
+    filter.filter(packed.logs, packed.data),
+  );
+}
+
+/**
+ * Build a selector index file from function signatures, off the JS thread.
+ * Selectors are computed natively with Keccak-256 from each signature's
+ * canonical form; signatures that cannot be parsed are skipped.
+ *
+ * @param signatures - Function signatures, e.g. `transfer(address,uint256)`
+ * @param path - Absolute path of the index file; an existing file is
+ * replaced atomically, so indexes opened from it stay valid
+ * @returns Number of distinct signatures indexed
+ */
+export function buildSelectorIndex(
+  signatures: string[],
+  path: string,
+): Promise<number> {
+  return NativeUtilsHybridObject.buildSelectorIndex(signatures, path);
+}
+
+/**
+ * Open a selector index built by {@link buildSelectorIndex}. The file is
+ * memory-mapped, so opening takes constant time regardless of its size.
+ *
+ * @example
+ * const index = openSelectorIndex(`${getTemporaryDirectory()}/selectors.idx`);
+ * const [signatures] = lookupSelectors(index, [tx.data]);
+ * // ['transfer(address,uint256)']
+ *
+ * @param path - Absolute path of the index file
+ * @returns The opened index
+ * @throws If the file is missing or not a valid index
+ */
+export function openSelectorIndex(path: string): SelectorIndex {
+  return NativeUtilsHybridObject.openSelectorIndex(path);
+}
+
+/**
+ * Look up the signatures of many selectors in one call.
+ *
+ * @param index - An index from {@link openSelectorIndex}
+ * @param selectors - 4-byte selectors or whole calldata (only the first 4
+ * bytes are used), as bytes or hex strings
+ * @returns The signatures of each selector; empty if unknown
+ * @throws If an item is shorter than 4 bytes
+ */
+export function lookupSelectors(
+  index: SelectorIndex,
+  selectors: (string | Uint8Array)[],
+): string[][] {
+  const packed = new Uint8Array(selectors.length * 4);
+  selectors.forEach((selector, i) => {
+    const bytes =
+      typeof selector === 'string'
+        ? hexToBytes(selector.replace(/^0x/i, '').slice(0, 8))
+        : selector;
+    if (bytes.length < 4) {
+      throw new Error(`Selector at index ${i} must be at least 4 bytes`);
+    }
+    packed.set(bytes.subarray(0, 4), i * 4);
+  });
+  return index.lookup(packed.buffer);
+}
+
+/**
+ * Directory for temporary and rebuildable native files, such as indexes:
+ * the app's tmp directory on iOS and its cache directory on Android, both
+ * as reported by the platform.
+ *
+ * @returns Absolute path without a trailing slash
+ * @throws If the platform does not provide the directory
+ */
+export function getTemporaryDirectory(): string {
+  return NativeUtilsHybridObject.getTemporaryDirectory();
+}
+
+/**
+ * Build a domain index file from a phishing block list or allow list, off
+ * the JS thread. Domains are stored as hashes in a sorted, memory-mapped
+ * table, so the list costs neither startup parsing nor JS heap once built.
+ *
+ * @param domains - Domain names; each also matches its subdomains. Case and
+ * a trailing dot are ignored, and invalid names are skipped
+ * @param path - Absolute path of the index file; an existing file is
+ * replaced atomically, and indexes opened from it keep the old list until
+ * {@link DomainIndex.reload} is called
+ * @returns Number of distinct domains indexed
+ */
+export function buildDomainIndex(
+  domains: string[],
+  path: string,
+): Promise<number> {
+  return NativeUtilsHybridObject.buildDomainIndex(domains, path);
+}
+
+/**
+ * Open a domain index built by {@link buildDomainIndex}. The file is
+ * memory-mapped, so opening takes constant time regardless of its size.
+ *
+ * @example
+ * const path = `${getTemporaryDirectory()}/blocklist.idx`;
+ * const blocklist = openDomainIndex(path);
+ * const [blocked] = matchDomains(blocklist, [new URL(url).hostname]);
+ *
+ * // When the list is updated
+ * await buildDomainIndex(updatedDomains, path);
+ * blocklist.reload();
+ *
+ * @param path - Absolute path of the index file
+ * @returns The opened index
+ * @throws If the file is missing or not a valid index
+ */
+export function openDomainIndex(path: string): DomainIndex {
+  return NativeUtilsHybridObject.openDomainIndex(path);
+}
+
+/**
+ * Check hostnames against a domain index in one call.
+ *
+ * @param index - An index from {@link openDomainIndex}
+ * @param hostnames - Hostnames, e.g. from `new URL(url).hostname`
+ * @returns Whether each hostname or one of its parent domains is listed
+ */
+export function matchDomains(
+  index: DomainIndex,
+  hostnames: string[],
+): boolean[] {
+  const bitmap = new Uint8Array(index.matches(hostnames));
+  return hostnames.map((_, i) => (bitmap[i >> 3]! & (1 << (i & 7))) !== 0);
+}
+
+/**
+ * Compute the ENS namehash (EIP-137) of a name natively. The name is hashed
+ * as given, so normalize it first (ENSIP-15, e.g. with `ens-normalize`).
+ *
+ * @param name - Dot-separated name such as `vitalik.eth`; empty for the root
+ * @returns The 32-byte node as a 0x-prefixed hex string
+ * @throws If the name has an empty label
+ */
+export function namehash(name: string): string {
+  return bytesToHex(
+    arrayBufferToUint8Array(NativeUtilsHybridObject.namehash(name)),
+  );
+}
+
+/**
+ * Compute the ENS namehash of many names in one native call. Parent nodes
+ * shared by several names, such as `eth`, are hashed once.
+ *
+ * @param names - Normalized names
+ * @returns The node of each name as a 0x-prefixed hex string
+ * @throws If a name has an empty label
+ */
+export function namehashMany(names: string[]): string[] {
+  const nodes = new Uint8Array(NativeUtilsHybridObject.namehashMany(names));
+  return names.map((_, i) => bytesToHex(nodes.subarray(i * 32, i * 32 + 32)));
+}
+
+/** Options for {@link buildMerkleTree}. */
+export type MerkleTreeOptions = {
+  /** How leaves are hashed; `doubleKeccak256` by default */
+  leafHash?: MerkleLeafHash;
+  /** Order leaves by hash before building, as OpenZeppelin does by default */
+  sortLeaves?: boolean;
+};
+
+/** A leaf and its proof, as passed to {@link verifyMerkleProofs}. */
+export type MerkleProofItem = {
+  leaf: string | Uint8Array;
+  proof: (string | Uint8Array)[];
+};
+
+// Pack equally sized leaves, since native Merkle calls take one leaf size
+function packLeaves(leaves: (string | Uint8Array)[]): {
+  packed: ArrayBuffer;
+  leafSize: number;
+} {
+  const bytes = leaves.map(toBytes);
+  const leafSize = bytes[0]?.length ?? 0;
+  if (leafSize === 0) {
+    throw new Error('Merkle leaves must not be empty');
+  }
+  return { packed: packFixedSize(bytes, leafSize), leafSize };
+}
+
+/**
+ * Build a Keccak-256 sorted-pair Merkle tree off the JS thread, identical to
+ * OpenZeppelin's @openzeppelin/merkle-tree and verifiable with its
+ * MerkleProof.sol. Leaves are hashed and levels are built natively, in
+ * parallel for large trees.
+ *
+ * @example
+ * // Same root as StandardMerkleTree.of(values, ['address', 'uint256'])
+ * const params = parseAbiParameters('address, uint256');
+ * const tree = await buildMerkleTree(
+ *   values.map((value) => encodeAbiParameters(params, value)), // viem
+ * );
+ * const proof = getMerkleProof(tree, 0);
+ *
+ * @param leaves - Equally sized leaves as bytes or hex strings, e.g. the
+ * `abi.encode` of each value for the default leaf hash
+ * @param options - Leaf hashing and sorting
+ * @returns Promise of the tree; leaf indices follow the order of `leaves`
+ * @throws If there are no leaves or they differ in size
+ */
+export function buildMerkleTree(
+  leaves: (string | Uint8Array)[],
+  { leafHash = 'doubleKeccak256', sortLeaves = true }: MerkleTreeOptions = {},
+): Promise<MerkleTree> {
+  const { packed, leafSize } = packLeaves(leaves);
+  return NativeUtilsHybridObject.buildMerkleTree(
+    packed,
+    leafSize,
+    leafHash,
+    sortLeaves,
+  );
+}
+
+/**
+ * Get the proof of a leaf as hex strings, in the format of OpenZeppelin's
+ * `getProof`.
+ *
+ * @param tree - A tree from {@link buildMerkleTree}
+ * @param index - Index of the leaf in the order it was given
+ * @returns Sibling hashes from the leaf up to the root
+ */
+export function getMerkleProof(tree: MerkleTree, index: number): string[] {
+  const proof = new Uint8Array(tree.getProof(index));
+  const nodes: string[] = [];
+  for (let offset = 0; offset < proof.length; offset += 32) {
+    nodes.push(bytesToHex(proof.subarray(offset, offset + 32)));
+  }
+  return nodes;
+}
+
+/**
+ * Verify many Merkle proofs against one root in a single native call, such
+ * as checking every claim of an airdrop allowlist.
+ *
+ * @param root - The 32-byte root
+ * @param items - Leaves (unhashed, as given to {@link buildMerkleTree}) and
+ * their proofs
+ * @param leafHash - How leaves are hashed; must match the tree
+ * @returns Bitmap with bit `i % 8` of byte `i / 8` set if proof `i` is valid
+ * @throws If leaves differ in size or a proof node is not 32 bytes
+ */
+export function verifyMerkleProofs(
+  root: string | Uint8Array,
+  items: MerkleProofItem[],
+  leafHash: MerkleLeafHash = 'doubleKeccak256',
+): Uint8Array {
+  if (items.length === 0) {
+    return new Uint8Array(0);
+  }
+  const { packed, leafSize } = packLeaves(items.map((item) => item.leaf));
+  const proofNodes = items.flatMap((item) => item.proof.map(toBytes));
+  return new Uint8Array(
+    NativeUtilsHybridObject.merkleVerifyMany(
+      viewToArrayBuffer(toBytes(root)),
+      packed,
+      leafSize,
+      leafHash,
+      packFixedSize(proofNodes, 32),
+      items.map((item) => item.proof.length),
+    ),
+  );
+}
+
+/** The parts of an `eth_getProof` (EIP-1186) response used for verification. */
+export type EthGetProofResponse = {
+  address: string;
+  accountProof: string[];
+  storageProof: { key: string; proof: string[] }[];
+};
+
+/** Account state proven by {@link verifyAccountProof}. */
+export type ProvenAccount = {
+  /** Whether the account exists; absent accounts have zero nonce and balance */
+  exists: boolean;
+  nonce: bigint;
+  balance: bigint;
+  storageHash: string;
+  codeHash: string;
+  /** Proven value of each requested slot, in the order of the response */
+  storage: { key: string; value: bigint; valid: boolean }[];
+};
+
+function bytesToBigInt(bytes: Uint8Array): bigint {
+  return bytes.length === 0 ? 0n : BigInt(bytesToHex(bytes));
+}
+
+/**
+ * Verify an `eth_getProof` response against a trusted state root, such as
+ * the `stateRoot` of a block header. The account proof is walked once and
+ * every storage proof is then checked against the proven storage root, all
+ * natively. Only values derived from the proofs are returned; the values the
+ * node claims in its response are not trusted.
+ *
+ * @example
+ * const response = await provider.send('eth_getProof', [token, slots, tag]);
+ * const account = verifyAccountProof(block.stateRoot, response);
+ * const balances = account.storage.map((slot) => slot.value);
+ *
+ * @param stateRoot - The 32-byte state root
+ * @param response - The `eth_getProof` response
+ * @returns The proven account and storage values; a storage slot whose proof
+ * is invalid has `valid: false` and a zero value
+ * @throws If the account proof is invalid for the state root
+ */
+export function verifyAccountProof(
+  stateRoot: string | Uint8Array,
+  response: EthGetProofResponse,
+): ProvenAccount {
+  const { storageProof } = response;
+  const slots = new Uint8Array(storageProof.length * 32);
+  storageProof.forEach(({ key }, i) => {
+    // Keys are quantities and may be shorter than 32 bytes, e.g. "0x0"
+    const digits = key.replace(/^0x/i, '');
+    if (digits.length > 64) {
+      throw new Error(`Storage key at index ${i} is longer than 32 bytes`);
+    }
+    slots.set(hexToBytes(digits.padStart(64, '0')), i * 32);
+  });
+  const toBuffer = (node: string) => viewToArrayBuffer(hexToBytes(node));
+
+  const account = NativeUtilsHybridObject.verifyStorageProofs(
+    viewToArrayBuffer(toBytes(stateRoot)),
+    viewToArrayBuffer(hexToBytes(response.address)),
+    response.accountProof.map(toBuffer),
+    slots.buffer,
+    storageProof.flatMap(({ proof }) => proof.map(toBuffer)),
+    storageProof.map(({ proof }) => proof.length),
+  );
+
+  const values = new Uint8Array(account.storageValues);
+  const valid = new Uint8Array(account.storageValid);
+  return {
+    exists: account.exists,
+    nonce: bytesToBigInt(new Uint8Array(account.nonce)),
+    balance: bytesToBigInt(new Uint8Array(account.balance)),
+    storageHash: bytesToHex(new Uint8Array(account.storageRoot)),
+    codeHash: bytesToHex(new Uint8Array(account.codeHash)),
+    storage: storageProof.map(({ key }, i) => ({
+      key,
+      value: bytesToBigInt(values.subarray(i * 32, i * 32 + 32)),
+      valid: (valid[i >> 3]! & (1 << (i & 7))) !== 0,
+    })),
+  };
+}
+
+/**
+ * Compute the root of the trie mapping `rlp(index)` to each item, to check a
+ * block's `transactionsRoot`, `receiptsRoot` or `withdrawalsRoot` against
+ * its contents. The trie is built and hashed natively.
+ *
+ * @example
+ * const rawTransactions = await Promise.all(
+ *   block.transactions.map((hash) =>
+ *     provider.send('eth_getRawTransactionByHash', [hash]),
+ *   ),
+ * );
+ * const valid = orderedTrieRoot(rawTransactions) === block.transactionsRoot;
+ *
+ * @param items - Encoded items in order, as bytes or hex strings:
+ * transactions in their network encoding, receipts in their consensus
+ * encoding (with the type byte for typed receipts)
+ * @returns The 32-byte root as a 0x-prefixed hex string
+ */
+export function orderedTrieRoot(items: (string | Uint8Array)[]): string {
+  const bytes = items.map(toBytes);
+  const packed = new Uint8Array(
+    bytes.reduce((total, item) => total + item.length, 0),
+  );
+  let offset = 0;
+  for (const item of bytes) {
+    packed.set(item, offset);
+    offset += item.length;
+  }
+  return bytesToHex(
+    new Uint8Array(
+      NativeUtilsHybridObject.orderedTrieRoot(
+        packed.buffer,
+        bytes.map((item) => item.length),
+      ),
+    ),
+  );
+}
+
+// Serialized sizes, must match ssz.cpp
+const SSZ_CONTAINER_SIZES: Record<SszContainer, number> = {
+  validator: 121,
+  depositMessage: 88,
+  depositData: 184,
+};
+
+function packContainers(
+  type: SszContainer,
+  items: (string | Uint8Array)[],
+): ArrayBuffer {
+  const size = SSZ_CONTAINER_SIZES[type];
+  const bytes = items.map(toBytes);
+  bytes.forEach((item, i) => {
+    if (item.length !== size) {
+      throw new Error(
+        `SSZ ${type} at index ${i} must be ${size} bytes, got ${item.length}`,
+      );
+    }
+  });
+  return packFixedSize(bytes, size);
+}
+
+/**
+ * SSZ `merkleize(pack(data), limit)`: the root of the 32-byte chunks of
+ * `data` in a tree with room for `limit` chunks, hashed natively with
+ * SHA-256. Use it for vectors and lists of basic values, and
+ * {@link sszMixInLength} to finish a list.
+ *
+ * @example
+ * // hash_tree_root(List[uint64, 2**40]) of balances (8 bytes each, LE)
+ * const root = sszMixInLength(
+ *   sszMerkleize(balanceBytes, 2 ** 40 / 4),
+ *   balances.length,
+ * );
+ *
+ * @param data - Packed serialized values; a partial last chunk is padded
+ * with zeros
+ * @param limit - Chunk limit, which sets the depth of the tree; defaults to
+ * the number of chunks, as for a vector
+ * @returns The 32-byte root as a 0x-prefixed hex string
+ * @throws If `data` has more than `limit` chunks
+ */
+export function sszMerkleize(
+  data: string | Uint8Array,
+  limit?: number,
+): string {
+  const bytes = toBytes(data);
+  return bytesToHex(
+    new Uint8Array(
+      NativeUtilsHybridObject.sszMerkleize(
+        viewToArrayBuffer(bytes),
+        limit ?? Math.ceil(bytes.length / 32),
+      ),
+    ),
+  );
+}
+
+/**
+ * SSZ `mix_in_length(root, length)`, the root of a list from the root of
+ * its chunks.
+ *
+ * @param root - The 32-byte root of the list's chunks
+ * @param length - Number of elements in the list
+ * @returns The 32-byte root as a 0x-prefixed hex string
+ */
+export function sszMixInLength(
+  root: string | Uint8Array,
+  length: number,
+): string {
+  return bytesToHex(
+    new Uint8Array(
+      NativeUtilsHybridObject.sszMixInLength(
+        viewToArrayBuffer(toBytes(root)),
+        length,
+      ),
+    ),
+  );
+}
+
+/**
+ * SSZ `hash_tree_root` of many beacon chain containers of one type, such as
+ * the deposit data roots checked by the deposit contract. Every tree level
+ * of the whole batch is hashed in one native pass.
+ *
+ * @param type - Container type; see {@link SszContainer} for the layouts
+ * @param items - SSZ-serialized containers, as bytes or hex strings
+ * @returns The 32-byte root of each item as a 0x-prefixed hex string
+ * @throws If an item has the wrong size or a boolean field is not 0 or 1
+ */
+export function sszContainerRoots(
+  type: SszContainer,
+  items: (string | Uint8Array)[],
+): string[] {
+  const roots = new Uint8Array(
+    NativeUtilsHybridObject.sszContainerRoots(
+      type,
+      packContainers(type, items),
+    ),
+  );
+  return items.map((_, i) => bytesToHex(roots.subarray(i * 32, i * 32 + 32)));
+}
+
+/**
+ * SSZ `hash_tree_root` of a `List[type, limit]` of containers, computed off
+ * the JS thread. Sized for the validator registry: the containers and the
+ * list tree are hashed in parallel, and the empty part of the tree comes
+ * from cached zero hashes.
+ *
+ * @example
+ * // hash_tree_root(state.validators)
+ * const root = await sszContainerListRoot('validator', validators, 2 ** 40);
+ *
+ * @param type - Container type; see {@link SszContainer} for the layouts
+ * @param items - SSZ-serialized containers, as bytes or hex strings
+ * @param limit - The list limit
+ * @returns Promise of the 32-byte root as a 0x-prefixed hex string
+ * @throws If an item has the wrong size or there are more than `limit` items
+ */
+export async function sszContainerListRoot(
+  type: SszContainer,
+  items: (string | Uint8Array)[],
+  limit: number,
+): Promise<string> {
+  const root = await NativeUtilsHybridObject.sszContainerListRoot(
+    type,
+    packContainers(type, items),
+    limit,
+  );
+  return bytesToHex(new Uint8Array(root));
+}
+
 /**
  * Generate an Ed25519 public key from a private key using native implementation.
  * This is a fast native implementation that matches the noble/curves ed25519 API.
@@ -177,3 +1538,717 @@ export function getPublicKeyEd25519(
 
   return arrayBufferToUint8Array(result);
 }
+
+/**
+ * Load an Ed25519 private key into native secure memory for repeated
+ * signing, so the key never crosses back into JS. Builds with the
+ * table-based Ed25519 backend (the `ed25519Tables` Gradle property or
+ * `NATIVEUTILS_ED25519_TABLES=1` for CocoaPods) also expand the seed once, so
+ * each signature skips its SHA-512; by default every signature hashes it.
+ *
+ * @example
+ * const key = createEd25519KeyHandle(seed);
+ * const publicKey = new Uint8Array(key.publicKey());
+ * const [signature] = signEd25519Batch(key, [message]);
+ *
+ * @param privateKey - The 32-byte Ed25519 private key as Uint8Array or hex string
+ * @returns A handle with `publicKey()`, `sign()` and `signBatch()`
+ * @throws If the private key is not 32 bytes
+ */
+export function createEd25519KeyHandle(
+  privateKey: BytesPrivateKey | HexPrivateKey,
+): Ed25519KeyHandle {
+  const bytes =
+    typeof privateKey === 'string' ? hexToBytes(privateKey) : privateKey;
+  if (bytes.length !== 32) {
+    throw new Error('Ed25519 private key must be 32 bytes');
+  }
+  const buffer = uint8ArrayToArrayBuffer(bytes);
+  try {
+    return NativeUtilsHybridObject.createEd25519KeyHandle(buffer);
+  } finally {
+    // Drop the copies made here; the handle holds its own
+    new Uint8Array(buffer).fill(0);
+    if (bytes !== privateKey) {
+      bytes.fill(0);
+    }
+  }
+}
+
+/**
+ * Sign many messages with one key in a single native call, such as the
+ * transactions of a batch. Large batches are signed in parallel.
+ *
+ * @param key - A handle from {@link createEd25519KeyHandle}
+ * @param messages - The messages to sign
+ * @returns The 64-byte signature of each message, in input order
+ */
+export function signEd25519Batch(
+  key: Ed25519KeyHandle,
+  messages: Uint8Array[],
+): Uint8Array[] {
+  const packed = new Uint8Array(
+    messages.reduce((total, message) => total + message.length, 0),
+  );
+  let offset = 0;
+  for (const message of messages) {
+    packed.set(message, offset);
+    offset += message.length;
+  }
+  return unpackFixedSize(
+    key.signBatch(packed.buffer, messages.map((message) => message.length)),
+    64,
+  );
+}
+
+function packEd25519Points(points: (string | Uint8Array)[]): ArrayBuffer {
+  return packFixedSize(points.map(toBytes), 32);
+}
+
+/**
+ * Check many 32-byte values for being valid Ed25519 point encodings in one
+ * native call, such as rejecting program derived address candidates or
+ * validating Solana public keys. Decoding follows RFC 8032 strictly, as
+ * `ed25519.ExtendedPoint.fromHex` in noble does.
+ *
+ * @example
+ * const bitmap = ed25519IsOnCurve(candidates);
+ * const onCurve = (i: number) => (bitmap[i >> 3]! & (1 << (i & 7))) !== 0;
+ *
+ * @param points - 32-byte encodings as Uint8Array or hex strings
+ * @returns Bitmap with bit `i % 8` of byte `i / 8` set if encoding `i` is a
+ * point on the curve
+ * @throws If an encoding is not 32 bytes
+ */
+export function ed25519IsOnCurve(points: (string | Uint8Array)[]): Uint8Array {
+  return new Uint8Array(
+    NativeUtilsHybridObject.ed25519IsOnCurve(packEd25519Points(points)),
+  );
+}
+
+/** Affine coordinates of an Ed25519 point. */
+export type Ed25519AffinePoint = { x: bigint; y: bigint };
+
+/**
+ * Decompress many Ed25519 point encodings natively, with the same rules as
+ * {@link ed25519IsOnCurve}.
+ *
+ * @example
+ * const [point] = ed25519DecompressPoints([publicKey]);
+ * const extended = point && ed25519.ExtendedPoint.fromAffine(point);
+ *
+ * @param points - 32-byte encodings as Uint8Array or hex strings
+ * @returns The affine coordinates of each point in input order, or null
+ * where the encoding is not a valid point
+ * @throws If an encoding is not 32 bytes
+ */
+export function ed25519DecompressPoints(
+  points: (string | Uint8Array)[],
+): (Ed25519AffinePoint | null)[] {
+  const decoded = NativeUtilsHybridObject.ed25519DecompressPoints(
+    packEd25519Points(points),
+  );
+  const coordinates = new Uint8Array(decoded.coordinates);
+  const valid = new Uint8Array(decoded.valid);
+  return points.map((_, i) =>
+    (valid[i >> 3]! & (1 << (i & 7))) !== 0
+      ? {
+          x: bytesToBigInt(coordinates.subarray(i * 64, i * 64 + 32)),
+          y: bytesToBigInt(coordinates.subarray(i * 64 + 32, i * 64 + 64)),
+        }
+      : null,
+  );
+}
+
+/**
+ * Create a native keyring of secp256k1 account keys. Keys are copied into
+ * native secure memory, and the JS copies made here are zeroed; callers
+ * should drop their own. Accounts are then used by address, without the key
+ * crossing back into JS.
+ *
+ * @example
+ * const keyring = createKeyring(privateKeys);
+ * const [account] = getKeyringAddresses(keyring);
+ * const signature = signByAddress(keyring, account!, messageHash);
+ *
+ * @param privateKeys - 32-byte private keys as Uint8Array or hex strings
+ * @returns The keyring
+ * @throws If a key is not 32 bytes or not a valid secp256k1 key
+ */
+export function createKeyring(
+  privateKeys: (BytesPrivateKey | HexPrivateKey)[] = [],
+): Keyring {
+  const keyring = NativeUtilsHybridObject.createKeyring();
+  if (privateKeys.length > 0) {
+    addKeyringKeys(keyring, privateKeys);
+  }
+  return keyring;
+}
+
+function addressesToHex(packed: ArrayBuffer): string[] {
+  return unpackFixedSize(packed, 20).map(bytesToHex);
+}
+
+/**
+ * Add accounts to a keyring. Keys already held are kept once. Nothing is
+ * added if any key is invalid.
+ *
+ * @param keyring - A keyring from {@link createKeyring}
+ * @param privateKeys - 32-byte private keys as Uint8Array or hex strings
+ * @returns The 0x-prefixed address of each key, in input order
+ * @throws If a key is not 32 bytes or not a valid secp256k1 key
+ */
+export function addKeyringKeys(
+  keyring: Keyring,
+  privateKeys: (BytesPrivateKey | HexPrivateKey)[],
+): string[] {
+  const packed = new Uint8Array(privateKeys.length * 32);
+  try {
+    privateKeys.forEach((privateKey, i) => {
+      const bytes =
+        typeof privateKey === 'string' ? hexToBytes(privateKey) : privateKey;
+      if (bytes.length !== 32) {
+        throw new Error(`Private key at index ${i} must be 32 bytes`);
+      }
+      packed.set(bytes, i * 32);
+      if (bytes !== privateKey) {
+        bytes.fill(0);
+      }
+    });
+    return addressesToHex(keyring.addKeys(packed.buffer));
+  } finally {
+    packed.fill(0);
+  }
+}
+
+/**
+ * List a keyring's accounts.
+ *
+ * @param keyring - A keyring from {@link createKeyring}
+ * @returns The 0x-prefixed address of every account, in the order added
+ */
+export function getKeyringAddresses(keyring: Keyring): string[] {
+  return addressesToHex(keyring.getAddresses());
+}
+
+/**
+ * Sign a 32-byte hash with a keyring account, such as a transaction or
+ * EIP-712 digest. Signing uses RFC 6979 nonces and low `s` values.
+ *
+ * @param keyring - A keyring from {@link createKeyring}
+ * @param address - The account's 20-byte address
+ * @param hash - The 32-byte hash to sign
+ * @returns 65 bytes: `r`, `s`, then the recovery id (0 or 1)
+ * @throws If the keyring has no account for the address
+ */
+export function signByAddress(
+  keyring: Keyring,
+  address: string | Uint8Array,
+  hash: string | Uint8Array,
+): Uint8Array {
+  return new Uint8Array(
+    keyring.signByAddress(
+      viewToArrayBuffer(toBytes(address)),
+      viewToArrayBuffer(toBytes(hash)),
+    ),
+  );
+}
+
+/**
+ * Get the public key of a keyring account, derived when it was added.
+ *
+ * @param keyring - A keyring from {@link createKeyring}
+ * @param address - The account's 20-byte address
+ * @param isCompressed - Whether to return the 33-byte compressed key rather
+ * than the 65-byte uncompressed one
+ * @returns The public key
+ * @throws If the keyring has no account for the address
+ */
+export function publicKeyByAddress(
+  keyring: Keyring,
+  address: string | Uint8Array,
+  isCompressed: boolean = true,
+): Uint8Array {
+  return new Uint8Array(
+    keyring.publicKeyByAddress(
+      viewToArrayBuffer(toBytes(address)),
+      isCompressed,
+    ),
+  );
+}
+
+/** Base58 prefix of a BIP32 extended key, naming its network and script. */
+export type ExtendedKeyVersion =
+  | 'xpub'
+  | 'xprv'
+  | 'ypub'
+  | 'yprv'
+  | 'zpub'
+  | 'zprv'
+  | 'tpub'
+  | 'tprv'
+  | 'upub'
+  | 'uprv'
+  | 'vpub'
+  | 'vprv';
+
+const EXTENDED_KEY_VERSIONS: Record<ExtendedKeyVersion, number> = {
+  xpub: 0x0488b21e,
+  xprv: 0x0488ade4,
+  ypub: 0x049d7cb2,
+  yprv: 0x049d7878,
+  zpub: 0x04b24746,
+  zprv: 0x04b2430c,
+  tpub: 0x043587cf,
+  tprv: 0x04358394,
+  upub: 0x044a5262,
+  uprv: 0x044a4e28,
+  vpub: 0x045f1cf6,
+  vprv: 0x045f18bc,
+};
+
+const EXTENDED_KEY_NAMES = new Map(
+  Object.entries(EXTENDED_KEY_VERSIONS).map(([name, version]) => [
+    version,
+    name as ExtendedKeyVersion,
+  ]),
+);
+
+/** Fields of a BIP32 extended key. */
+export type ExtendedKey = {
+  version: ExtendedKeyVersion;
+  depth: number;
+  /** First 4 bytes of the parent's HASH160, as a big-endian integer */
+  parentFingerprint: number;
+  childNumber: number;
+  chainCode: Uint8Array;
+  /** 33-byte compressed public key, or 32-byte private key */
+  key: Uint8Array;
+};
+
+/**
+ * Serialize many BIP32 extended keys natively, as Base58Check strings.
+ *
+ * @example
+ * const [xpub] = serializeExtendedKeys([
+ *   { version: 'xpub', depth: 0, parentFingerprint: 0, childNumber: 0,
+ *     chainCode, key: publicKey },
+ * ]);
+ *
+ * @param keys - The keys to serialize
+ * @returns The encoding of each key, in input order
+ * @throws If a version is unknown, a field is out of range, or a key is not a
+ * valid point or private key for its version
+ */
+export function serializeExtendedKeys(keys: ExtendedKey[]): string[] {
+  const packed = new Uint8Array(keys.length * 78);
+  const view = new DataView(packed.buffer);
+  try {
+    keys.forEach((key, i) => {
+      const version = EXTENDED_KEY_VERSIONS[key.version];
+      if (version === undefined) {
+        throw new Error(`Unknown extended key version ${key.version}`);
+      }
+      if (key.chainCode.length !== 32) {
+        throw new Error(`Chain code at index ${i} must be 32 bytes`);
+      }
+      if (key.key.length !== 32 && key.key.length !== 33) {
+        throw new Error(`Key at index ${i} must be 32 or 33 bytes`);
+      }
+      const offset = i * 78;
+      view.setUint32(offset, version);
+      view.setUint8(offset + 4, key.depth);
+      view.setUint32(offset + 5, key.parentFingerprint);
+      view.setUint32(offset + 9, key.childNumber);
+      packed.set(key.chainCode, offset + 13);
+      // Private keys are serialized behind a zero byte
+      packed.set(key.key, offset + 78 - key.key.length);
+    });
+    return NativeUtilsHybridObject.serializeExtendedKeys(packed.buffer);
+  } finally {
+    packed.fill(0);
+  }
+}
+
+/** A parsed BIP32 extended key with its own fingerprint. */
+export type ParsedExtendedKey = ExtendedKey & {
+  /** First 4 bytes of this key's HASH160, as a big-endian integer */
+  fingerprint: number;
+};
+
+/**
+ * Parse many Base58Check BIP32 extended keys natively. Each key is checked
+ * for its checksum, a known version, a valid point or private key, and a
+ * zero parent fingerprint and child number at depth 0.
+ *
+ * @example
+ * const [account] = parseExtendedKeys([xpub]);
+ * if (account) {
+ *   console.log(account.fingerprint.toString(16), account.depth);
+ * }
+ *
+ * @param encoded - Base58Check extended keys
+ * @returns The fields of each key in input order, or null where the string
+ * is not a valid extended key
+ */
+export function parseExtendedKeys(
+  encoded: string[],
+): (ParsedExtendedKey | null)[] {
+  const parsed: ExtendedKeys =
+    NativeUtilsHybridObject.parseExtendedKeys(encoded);
+  const keys = new Uint8Array(parsed.keys);
+  const view = new DataView(parsed.keys);
+  const fingerprints = new DataView(parsed.fingerprints);
+  const valid = new Uint8Array(parsed.valid);
+  try {
+    return encoded.map((_, i) => {
+      if ((valid[i >> 3]! & (1 << (i & 7))) === 0) {
+        return null;
+      }
+      const offset = i * 78;
+      return {
+        version: EXTENDED_KEY_NAMES.get(view.getUint32(offset))!,
+        depth: view.getUint8(offset + 4),
+        parentFingerprint: view.getUint32(offset + 5),
+        childNumber: view.getUint32(offset + 9),
+        chainCode: keys.slice(offset + 13, offset + 45),
+        key:
+          keys[offset + 45] === 0
+            ? keys.slice(offset + 46, offset + 78)
+            : keys.slice(offset + 45, offset + 78),
+        fingerprint: fingerprints.getUint32(i * 4),
+      };
+    });
+  } finally {
+    keys.fill(0);
+  }
+}
+
+/** A BIP322 signature over a message by the owner of a Bitcoin address. */
+export type Bip322Proof = {
+  /** bech32 P2WPKH or bech32m P2TR address */
+  address: string;
+  /** The message, as UTF-8 text or bytes */
+  message: string | Uint8Array;
+  /** Base64 "simple" signature */
+  signature: string;
+};
+
+function messageToBytes(message: string | Uint8Array): Uint8Array {
+  return typeof message === 'string'
+    ? new TextEncoder().encode(message)
+    : message;
+}
+
+/**
+ * Sign a message for a Bitcoin P2WPKH or P2TR address with BIP322 natively,
+ * in the "simple" format wallets exchange. P2WPKH signatures match Bitcoin
+ * Core's; P2TR signatures are randomized and use the BIP86 key tweak.
+ *
+ * @example
+ * const signature = bip322Sign(privateKey, 'bc1q...', 'Hello World');
+ *
+ * @param privateKey - The 32-byte key controlling the address, as a
+ * Uint8Array or hex string
+ * @param address - bech32 P2WPKH or bech32m P2TR address
+ * @param message - The message, as UTF-8 text or bytes
+ * @returns The base64 signature
+ * @throws If the key is invalid, the address is not P2WPKH or P2TR, or the
+ * key does not control it
+ */
+export function bip322Sign(
+  privateKey: BytesPrivateKey | HexPrivateKey,
+  address: string,
+  message: string | Uint8Array,
+): string {
+  // A private copy, zeroed once signed
+  const key =
+    typeof privateKey === 'string'
+      ? hexToBytes(privateKey)
+      : privateKey.slice();
+  try {
+    return NativeUtilsHybridObject.bip322Sign(
+      key.buffer,
+      address,
+      viewToArrayBuffer(messageToBytes(message)),
+    );
+  } finally {
+    key.fill(0);
+  }
+}
+
+/**
+ * Verify a "simple" BIP322 signature for a P2WPKH or P2TR address natively.
+ *
+ * @param address - bech32 P2WPKH or bech32m P2TR address
+ * @param message - The message, as UTF-8 text or bytes
+ * @param signature - Base64 signature
+ * @returns Whether the signature is valid; malformed input and other address
+ * types are invalid rather than errors
+ */
+export function bip322Verify(
+  address: string,
+  message: string | Uint8Array,
+  signature: string,
+): boolean {
+  return NativeUtilsHybridObject.bip322Verify(
+    address,
+    viewToArrayBuffer(messageToBytes(message)),
+    signature,
+  );
+}
+
+/**
+ * Verify many BIP322 signatures natively, in parallel, with the same rules
+ * as {@link bip322Verify}. Messages cross into native code as one buffer.
+ *
+ * @example
+ * const valid = bip322VerifyBatch(proofs);
+ * const accepted = proofs.filter((_, i) => valid[i]);
+ *
+ * @param proofs - Addresses, messages and signatures to check
+ * @returns Whether each proof is valid, in input order
+ */
+export function bip322VerifyBatch(proofs: Bip322Proof[]): boolean[] {
+  const messages = proofs.map((proof) => messageToBytes(proof.message));
+  const packed = new Uint8Array(
+    messages.reduce((total, message) => total + message.length, 0),
+  );
+  let offset = 0;
+  for (const message of messages) {
+    packed.set(message, offset);
+    offset += message.length;
+  }
+  const bitmap = new Uint8Array(
+    NativeUtilsHybridObject.bip322VerifyBatch(
+      proofs.map((proof) => proof.address),
+      packed.buffer,
+      messages.map((message) => message.length),
+      proofs.map((proof) => proof.signature),
+    ),
+  );
+  return proofs.map((_, i) => (bitmap[i >> 3]! & (1 << (i & 7))) !== 0);
+}
+
+/** An account used by a Solana instruction. */
+export type SolanaAccountMeta = {
+  /** Base58 address */
+  address: string;
+  isSigner: boolean;
+  isWritable: boolean;
+};
+
+/** A Solana instruction to compile. */
+export type SolanaInstruction = {
+  /** Base58 address of the program to invoke */
+  programAddress: string;
+  accounts: SolanaAccountMeta[];
+  data: Uint8Array;
+};
+
+/** An address lookup table and its addresses, in on-chain order. */
+export type SolanaLookupTable = {
+  /** Base58 address of the table account */
+  address: string;
+  addresses: string[];
+};
+
+/** A Solana transaction message before compilation. */
+export type SolanaMessage = {
+  version: 'legacy' | 0;
+  /** Base58 address of the fee payer, the first signer */
+  feePayer: string;
+  /** Base58 recent blockhash */
+  recentBlockhash: string;
+  instructions: SolanaInstruction[];
+  /** Tables to load accounts from; v0 messages only */
+  lookupTables?: SolanaLookupTable[];
+};
+
+/**
+ * Compile a Solana transaction message natively: account keys are
+ * deduplicated and ordered, lookup table entries are resolved for v0
+ * messages, and the message is serialized. Keys are ordered as in
+ * `@solana/web3.js` `MessageV0.compile`.
+ *
+ * @example
+ * const message = compileSolanaMessage({
+ *   version: 0,
+ *   feePayer: payer,
+ *   recentBlockhash: blockhash,
+ *   instructions,
+ *   lookupTables: [{ address: tableAddress, addresses: tableAddresses }],
+ * });
+ * const [signature] = signEd25519Batch(payerKey, [message]);
+ *
+ * @param message - The message to compile
+ * @returns The serialized message, the bytes each signer signs
+ * @throws If an address is not a base58 32-byte key, a legacy message has
+ * lookup tables, or the message needs more than 256 accounts
+ */
+export function compileSolanaMessage(message: SolanaMessage): Uint8Array {
+  const tables = message.lookupTables ?? [];
+  let size = 9;
+  for (const instruction of message.instructions) {
+    size += 6 + instruction.accounts.length * 3 + instruction.data.length;
+  }
+  for (const table of tables) {
+    size += 4 + table.addresses.length * 2;
+  }
+
+  // Addresses are passed as a list and named by position; duplicates are
+  // merged natively
+  const addresses: string[] = [];
+  const packed = new Uint8Array(size);
+  const view = new DataView(packed.buffer);
+  let offset = 0;
+  const writeU16 = (value: number, what: string) => {
+    if (value > 0xffff) {
+      throw new Error(`Solana message has too many ${what}`);
+    }
+    view.setUint16(offset, value, true);
+    offset += 2;
+  };
+  const writeAddress = (address: string) => {
+    writeU16(addresses.length, 'addresses');
+    addresses.push(address);
+  };
+
+  view.setUint8(offset++, message.version === 'legacy' ? 0xff : 0);
+  writeAddress(message.feePayer);
+  writeAddress(message.recentBlockhash);
+  writeU16(message.instructions.length, 'instructions');
+  for (const instruction of message.instructions) {
+    writeAddress(instruction.programAddress);
+    writeU16(instruction.accounts.length, 'instruction accounts');
+    for (const account of instruction.accounts) {
+      writeAddress(account.address);
+      view.setUint8(
+        offset++,
+        (account.isSigner ? 1 : 0) | (account.isWritable ? 2 : 0),
+      );
+    }
+    writeU16(instruction.data.length, 'instruction data bytes');
+    packed.set(instruction.data, offset);
+    offset += instruction.data.length;
+  }
+  writeU16(tables.length, 'lookup tables');
+  for (const table of tables) {
+    writeAddress(table.address);
+    writeU16(table.addresses.length, 'lookup table addresses');
+    table.addresses.forEach(writeAddress);
+  }
+  return new Uint8Array(
+    NativeUtilsHybridObject.compileSolanaMessage(addresses, packed.buffer),
+  );
+}
+
+/** Where the fields of a token account sit in its data. */
+export type TokenAccountFields = {
+  mintOffset: number;
+  ownerOffset: number;
+  amountOffset: number;
+  /** 8 for a u64 amount, 16 for a u128 */
+  amountSize: 8 | 16;
+  /** Shorter accounts are invalid; defaults to the end of the last field */
+  minSize?: number;
+  /** Bytes the data must start with, such as an Anchor discriminator */
+  discriminator?: Uint8Array;
+};
+
+/** SPL Token and Token-2022 accounts: mint, owner, then a u64 amount. */
+export const SPL_TOKEN_ACCOUNT_LAYOUT: TokenAccountFields = {
+  mintOffset: 0,
+  ownerOffset: 32,
+  amountOffset: 64,
+  amountSize: 8,
+  minSize: 165,
+};
+
+/** Fields of a decoded token account. */
+export type DecodedTokenAccount = {
+  mint: Uint8Array;
+  owner: Uint8Array;
+  amount: bigint;
+  /** The amount as a decimal string, if decimals were given */
+  formattedAmount?: string;
+};
+
+/**
+ * Decode many token accounts natively, such as the results of
+ * `getTokenAccountsByOwner`, from raw bytes or the base64 strings RPC nodes
+ * return. Amounts can be formatted with their mints' decimals on the way,
+ * trimmed like Solana's `uiAmountString`.
+ *
+ * @example
+ * const accounts = decodeTokenAccounts(
+ *   response.value.map((item) => item.account.data[0]),
+ *   { decimals: response.value.map((item) => decimalsByMint[item.mint]!) },
+ * );
+ *
+ * @param accounts - Account data, all as Uint8Array or all as base64
+ * @param options - Options
+ * @param options.layout - Field positions; SPL token accounts by default
+ * @param options.decimals - Decimals of each account's mint, to format amounts
+ * @returns The fields of each account in input order, or null where the data
+ * does not match the layout
+ * @throws If the layout is invalid or `decimals` has the wrong length
+ */
+export function decodeTokenAccounts(
+  accounts: Uint8Array[] | string[],
+  options: { layout?: TokenAccountFields; decimals?: number[] } = {},
+): (DecodedTokenAccount | null)[] {
+  const fields = options.layout ?? SPL_TOKEN_ACCOUNT_LAYOUT;
+  const layout = {
+    ...fields,
+    minSize: fields.minSize ?? 0,
+    discriminator: uint8ArrayToArrayBuffer(
+      fields.discriminator ?? new Uint8Array(),
+    ),
+  };
+  const decimals = options.decimals ?? [];
+  let decoded: TokenAccounts;
+  if (accounts.some((account) => typeof account === 'string')) {
+    decoded = NativeUtilsHybridObject.decodeTokenAccountsBase64(
+      accounts as string[],
+      layout,
+      decimals,
+    );
+  } else {
+    const raw = accounts as Uint8Array[];
+    const packed = new Uint8Array(
+      raw.reduce((total, account) => total + account.length, 0),
+    );
+    let offset = 0;
+    for (const account of raw) {
+      packed.set(account, offset);
+      offset += account.length;
+    }
+    decoded = NativeUtilsHybridObject.decodeTokenAccounts(
+      packed.buffer,
+      raw.map((account) => account.length),
+      layout,
+      decimals,
+    );
+  }
+
+  const mints = new Uint8Array(decoded.mints);
+  const owners = new Uint8Array(decoded.owners);
+  const amounts = new Uint8Array(decoded.amounts);
+  const valid = new Uint8Array(decoded.valid);
+  return accounts.map((_, i) => {
+    if ((valid[i >> 3]! & (1 << (i & 7))) === 0) {
+      return null;
+    }
+    const account: DecodedTokenAccount = {
+      mint: mints.slice(i * 32, i * 32 + 32),
+      owner: owners.slice(i * 32, i * 32 + 32),
+      // Little-endian on the wire
+      amount: bytesToBigInt(amounts.slice(i * 16, i * 16 + 16).reverse()),
+    };
+    if (decimals.length > 0) {
+      account.formattedAmount = decoded.formattedAmounts[i];
+    }
+    return account;
+  });
+}
@@ -59,3 +59,62 @@ export function numberArrayToUint8Array(arr: number[]): Uint8Array {
   }
   return new Uint8Array(arr);
 }
+
+/**
+ * Pack equally sized byte arrays into one ArrayBuffer
+ */
+export function packFixedSize(
+  items: Uint8Array[],
+  itemSize: number,
+): ArrayBuffer {
+  const buffer = new ArrayBuffer(items.length * itemSize);
+  const view = new Uint8Array(buffer);
+  items.forEach((item, i) => {
+    if (item.length !== itemSize) {
+      throw new Error(`Item at index ${i} must be ${itemSize} bytes`);
+    }
+    view.set(item, i * itemSize);
+  });
+  return buffer;
+}
+
+/**
+ * Split a packed ArrayBuffer into equally sized Uint8Array views
+ */
+export function unpackFixedSize(
+  buffer: ArrayBuffer,
+  itemSize: number,
+): Uint8Array[] {
+  const items: Uint8Array[] = [];
+  for (let offset = 0; offset < buffer.byteLength; offset += itemSize) {
+    items.push(new Uint8Array(buffer, offset, itemSize));
+  }
+  return items;
+}
+
+/**
+ * Decode a hex string, with or without a 0x prefix
+ */
+export function hexToBytes(hex: string): Uint8Array {
+  const digits =
+    hex.startsWith('0x') || hex.startsWith('0X') ? hex.slice(2) : hex;
+  if (digits.length % 2 !== 0 || !/^[0-9a-fA-F]*$/.test(digits)) {
+    throw new Error(`Invalid hex string: ${hex}`);
+  }
+  const bytes = new Uint8Array(digits.length / 2);
+  for (let i = 0; i < bytes.length; i++) {
+    bytes[i] = parseInt(digits.slice(i * 2, i * 2 + 2), 16);
+  }
+  return bytes;
+}
+
+/**
+ * Get the ArrayBuffer behind a Uint8Array, copying only if the view does not
+ * cover the whole buffer
+ */
+export function viewToArrayBuffer(view: Uint8Array): ArrayBuffer {
+  if (view.byteOffset === 0 && view.byteLength === view.buffer.byteLength) {
+    return view.buffer as ArrayBuffer;
+  }
+  return uint8ArrayToArrayBuffer(view);
+}